@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include <pthread.h>
+#ifdef __linux__
+# include <sched.h>
+#endif
+
+namespace bench
+{
+	/**
+	 * @brief Returns a monotonic time in seconds.
+	 */
+	inline double	now()
+	{
+		timespec	ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return double(ts.tv_sec) + double(ts.tv_nsec) * 1e-9;
+	}
+
+	/**
+	 * @brief Keep the compiler from optimizing away the computation of x.
+	 */
+	template<typename T>
+	inline void	keep(T const& x)
+	{ __asm__ __volatile__("" : : "r"(&x) : "memory"); }
+
+	/**
+	 * @brief Parse the n-th command line argument as a count, or return
+	 * fallback if it is missing.
+	 */
+	inline unsigned long	arg(int ac, char** av, int n,
+		unsigned long fallback)
+	{ return ac > n ? std::strtoul(av[n], 0, 10) : fallback; }
+
+	/**
+	 * @brief Print the time a run took, in total and per operation.
+	 */
+	inline void	report(char const* name, unsigned long ops, double seconds)
+	{
+		std::printf("%-32s %12lu ops %10.3f s %10.2f ns/op\n", name, ops,
+			seconds, seconds * 1e9 / double(ops));
+	}
+
+	/**
+	 * @brief Pin the calling thread to a CPU, if the platform allows it.
+	 */
+	inline void	pin(unsigned cpu)
+	{
+#ifdef __linux__
+		cpu_set_t	set;
+
+		CPU_ZERO(&set);
+		CPU_SET(cpu % CPU_SETSIZE, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+		(void)cpu;
+#endif
+	}
+}
@@ -0,0 +1,136 @@
+#include <map>
+
+#include <btree_map.hpp>
+#include <map.hpp>
+#include <memory.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	allocated = 0;
+
+/// An allocator that keeps track of the bytes it hands out.
+template<typename T>
+struct	counting_allocator	:	public ft::allocator<T>
+{
+	template<typename O>
+	struct	rebind
+	{ typedef counting_allocator<O> other; };
+
+	counting_allocator() throw() { }
+
+	template<typename O>
+	counting_allocator(counting_allocator<O> const&) throw() { }
+
+	T*		allocate(size_t n, void const* = 0)
+	{
+		allocated += n * sizeof(T);
+		return ft::allocator<T>::allocate(n);
+	}
+
+	void	deallocate(T* p, size_t n)
+	{
+		allocated -= n * sizeof(T);
+		ft::allocator<T>::deallocate(p, n);
+	}
+};
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+/**
+ * Insert n random keys, report the bytes allocated per key, and look each
+ * of them up in another random order.
+ */
+template<typename Map>
+static void	run(char const* name, ft::vector<unsigned long> const& keys,
+	ft::vector<unsigned long> const& order)
+{
+	unsigned long const	n = keys.size();
+	Map					m;
+	unsigned long		sum = 0;
+	char				label[64];
+	double				start;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		m.insert(typename Map::value_type(keys[i], i));
+	std::snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, n, bench::now() - start);
+	if (allocated)
+		std::printf("%-32s %12.1f bytes/key\n", name,
+			double(allocated) / double(n));
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		sum += m.find(keys[order[i]])->second;
+	std::snprintf(label, sizeof(label), "%s find", name);
+	bench::report(label, n, bench::now() - start);
+	bench::keep(sum);
+}
+
+/// Build a map from sorted keys, and report the bytes allocated per key.
+template<typename Map>
+static void	load(char const* name, ft::vector<unsigned long> const& keys)
+{
+	typedef	typename Map::key_type		key_type;
+	typedef	typename Map::mapped_type	mapped_type;
+
+	ft::vector<ft::pair<key_type, mapped_type> >	sorted;
+	char											label[64];
+	double											start;
+
+	for (unsigned long i = 0; i < keys.size(); ++i)
+		sorted.push_back(ft::make_pair(i, keys[i]));
+	start = bench::now();
+
+	Map const	m(sorted.begin(), sorted.end());
+
+	std::snprintf(label, sizeof(label), "%s sorted load", name);
+	bench::report(label, keys.size(), bench::now() - start);
+	std::printf("%-32s %12.1f bytes/key\n", name,
+		double(allocated) / double(keys.size()));
+}
+
+int	main(int ac, char** av)
+{
+	typedef	unsigned long	ul;
+	typedef	ft::pair<ul const, ul>	value_type;
+
+	unsigned long const	min_keys = bench::arg(ac, av, 1, 1000);
+	unsigned long const	max_keys = bench::arg(ac, av, 2, 10000000UL);
+	unsigned long		seed = 88172645463325252UL;
+
+	for (unsigned long n = min_keys; n <= max_keys; n *= 10)
+	{
+		ft::vector<unsigned long>	keys(n);
+		ft::vector<unsigned long>	order(n);
+
+		// Distinct keys, in random order.
+		for (unsigned long i = 0; i < n; ++i)
+			keys[i] = (next(seed) & ~0xfffffUL) | i;
+		for (unsigned long i = 0; i < n; ++i)
+			order[i] = i;
+		for (unsigned long i = n; i > 1; --i)
+			ft::swap(order[i - 1], order[next(seed) % i]);
+
+		std::printf("%lu keys\n", n);
+		run<ft::btree_map<ul, ul, ft::less<ul>, 256,
+			counting_allocator<value_type> > >("ft::btree_map", keys,
+			order);
+		run<ft::map<ul, ul> >("ft::map", keys, order);
+		run<ft::map<ul, ul, ft::less<ul>, counting_allocator<value_type> > >(
+			"ft::map, allocator", keys, order);
+		run<std::map<ul, ul> >("std::map", keys, order);
+		load<ft::btree_map<ul, ul, ft::less<ul>, 256,
+			counting_allocator<value_type> > >("ft::btree_map", keys);
+		load<ft::map<ul, ul, ft::less<ul>, counting_allocator<value_type> > >(
+			"ft::map, allocator", keys);
+	}
+	return 0;
+}
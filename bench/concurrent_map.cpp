@@ -0,0 +1,167 @@
+#include <concurrent_unordered_map.hpp>
+#include <unordered_map.hpp>
+
+#include <pthread.h>
+
+#include "bench.hpp"
+
+typedef	unsigned long	ul;
+
+/// The baseline: an ft::unordered_map protected by a single mutex.
+struct	locked_map
+{
+	pthread_mutex_t					lock;
+	ft::unordered_map<ul, ul>		map;
+
+	explicit locked_map(unsigned long)
+	{ pthread_mutex_init(&lock, 0); }
+
+	~locked_map()
+	{ pthread_mutex_destroy(&lock); }
+
+	template<typename F>
+	bool	visit(ul k, F f)
+	{
+		pthread_mutex_lock(&lock);
+
+		ft::unordered_map<ul, ul>::const_iterator const	i = map.find(k);
+		bool const										found = i != map.end();
+
+		if (found)
+			f(*i);
+		pthread_mutex_unlock(&lock);
+		return found;
+	}
+
+	template<typename F>
+	bool	insert_or_update(ft::pair<ul const, ul> const& x, F f)
+	{
+		pthread_mutex_lock(&lock);
+
+		ft::pair<ft::unordered_map<ul, ul>::iterator, bool> const	p
+			= map.insert(x);
+
+		if (!p.second)
+			f(p.first->second);
+		pthread_mutex_unlock(&lock);
+		return p.second;
+	}
+};
+
+/// A map of ft::concurrent_unordered_map with a given number of shards.
+template<unsigned long Shards>
+struct	sharded_map	:	public ft::concurrent_unordered_map<ul, ul>
+{
+	explicit sharded_map(unsigned long)
+		:	ft::concurrent_unordered_map<ul, ul>(Shards) { }
+};
+
+struct	read_value
+{
+	ul*	sum;
+
+	void	operator()(ft::pair<ul const, ul> const& x) const
+	{ *sum += x.second; }
+};
+
+struct	increment
+{
+	void	operator()(ul& x) const
+	{ ++x; }
+};
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+template<typename Map>
+struct	context
+{
+	Map*			map;
+	unsigned long	ops;
+	unsigned long	keys;
+	unsigned long	seed;
+	ul				sum;
+	pthread_t		thread;
+};
+
+/// Look up random keys, and update one lookup in ten.
+template<typename Map>
+static void*	work(void* arg)
+{
+	context<Map>&	ctx = *static_cast<context<Map>*>(arg);
+	read_value		read = { &ctx.sum };
+
+	for (unsigned long i = 0; i < ctx.ops; ++i)
+	{
+		unsigned long const	r = next(ctx.seed);
+		ul const			k = r % ctx.keys;
+
+		if ((r >> 32) % 10 == 0)
+			ctx.map->insert_or_update(ft::pair<ul const, ul>(k, 1),
+				increment());
+		else
+			ctx.map->visit(k, read);
+	}
+	return 0;
+}
+
+/**
+ * Run ops operations on a map of `keys` keys, spread over `threads`
+ * threads, and return the time it took.
+ */
+template<typename Map>
+static double	run(unsigned long ops, unsigned long threads,
+	unsigned long keys)
+{
+	Map				map(threads);
+	context<Map>	ctx[64];
+	increment const	inc = increment();
+
+	for (ul k = 0; k < keys; ++k)
+		map.insert_or_update(ft::pair<ul const, ul>(k, 0), inc);
+
+	double const	start = bench::now();
+
+	for (unsigned long i = 0; i < threads; ++i)
+	{
+		ctx[i].map = &map;
+		ctx[i].ops = ops / threads;
+		ctx[i].keys = keys;
+		ctx[i].seed = 88172645463325252UL + i;
+		ctx[i].sum = 0;
+		pthread_create(&ctx[i].thread, 0, work<Map>, ctx + i);
+	}
+	for (unsigned long i = 0; i < threads; ++i)
+		pthread_join(ctx[i].thread, 0);
+	return bench::now() - start;
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	ops = bench::arg(ac, av, 1, 4000000UL);
+	unsigned long const	max_threads = ft::min(bench::arg(ac, av, 2, 64),
+		64UL);
+	unsigned long const	keys = bench::arg(ac, av, 3, 100000);
+
+	std::printf("%lu keys, 90%% lookups, 10%% updates, in ns/op\n", keys);
+	std::printf("%-8s %12s %12s %12s %8s\n", "threads", "64 shards",
+		"1 shard", "mutex", "speedup");
+	for (unsigned long threads = 1; threads <= max_threads; threads *= 2)
+	{
+		unsigned long const	n = ops / threads * threads;
+		double const		sharded = run<sharded_map<64> >(n, threads,
+			keys);
+		double const		single = run<sharded_map<1> >(n, threads, keys);
+		double const		locked = run<locked_map>(n, threads, keys);
+
+		std::printf("%-8lu %12.2f %12.2f %12.2f %7.2fx\n", threads,
+			sharded * 1e9 / double(n), single * 1e9 / double(n),
+			locked * 1e9 / double(n), locked / sharded);
+	}
+	return 0;
+}
@@ -0,0 +1,163 @@
+#include <concurrent_skiplist_map.hpp>
+#include <map.hpp>
+
+#include <pthread.h>
+
+#include "bench.hpp"
+
+typedef	unsigned long	ul;
+
+/// The baseline: an ft::map protected by a single mutex.
+struct	locked_map
+{
+	pthread_mutex_t		lock;
+	ft::map<ul, ul>		map;
+
+	locked_map()
+	{ pthread_mutex_init(&lock, 0); }
+
+	~locked_map()
+	{ pthread_mutex_destroy(&lock); }
+
+	bool	find(ul k, ul& out)
+	{
+		pthread_mutex_lock(&lock);
+
+		ft::map<ul, ul>::const_iterator const	i = map.find(k);
+		bool const								found = i != map.end();
+
+		if (found)
+			out = i->second;
+		pthread_mutex_unlock(&lock);
+		return found;
+	}
+
+	bool	insert(ft::pair<ul const, ul> const& x)
+	{
+		pthread_mutex_lock(&lock);
+
+		bool const	inserted = map.insert(x).second;
+
+		pthread_mutex_unlock(&lock);
+		return inserted;
+	}
+
+	ul		erase(ul k)
+	{
+		pthread_mutex_lock(&lock);
+
+		ul const	n = map.erase(k);
+
+		pthread_mutex_unlock(&lock);
+		return n;
+	}
+};
+
+typedef	ft::concurrent_skiplist_map<ul, ul>	skiplist_map;
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+template<typename Map>
+struct	context
+{
+	Map*			map;
+	unsigned long	ops;
+	unsigned long	keys;
+	unsigned long	seed;
+	ul				sum;
+	pthread_t		thread;
+};
+
+/**
+ * Look up random keys, and insert or erase one in ten, which keeps the map
+ * about half full of the key range.
+ */
+template<typename Map>
+static void*	work(void* arg)
+{
+	context<Map>&	ctx = *static_cast<context<Map>*>(arg);
+
+	for (unsigned long i = 0; i < ctx.ops; ++i)
+	{
+		unsigned long const	r = next(ctx.seed);
+		ul const			k = r % ctx.keys;
+		ul					v;
+
+		switch ((r >> 32) % 20)
+		{
+			case 0:
+				ctx.map->insert(ft::pair<ul const, ul>(k, k));
+				break;
+			case 1:
+				ctx.map->erase(k);
+				break;
+			default:
+				if (ctx.map->find(k, v))
+					ctx.sum += v;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Run ops operations on a map of keys in [0, 2 * keys), half of them in
+ * the map, spread over `threads` threads, and return the time it took.
+ */
+template<typename Map>
+static double	run(unsigned long ops, unsigned long threads,
+	unsigned long keys)
+{
+	Map				map;
+	context<Map>	ctx[64];
+
+	for (ul k = 0; k < 2 * keys; k += 2)
+		map.insert(ft::pair<ul const, ul>(k, k));
+
+	double const	start = bench::now();
+
+	for (unsigned long i = 0; i < threads; ++i)
+	{
+		ctx[i].map = &map;
+		ctx[i].ops = ops / threads;
+		ctx[i].keys = 2 * keys;
+		ctx[i].seed = 88172645463325252UL + i;
+		ctx[i].sum = 0;
+		pthread_create(&ctx[i].thread, 0, work<Map>, ctx + i);
+	}
+	for (unsigned long i = 0; i < threads; ++i)
+	{
+		pthread_join(ctx[i].thread, 0);
+		bench::keep(ctx[i].sum);
+	}
+	return bench::now() - start;
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	ops = bench::arg(ac, av, 1, 2000000UL);
+	unsigned long const	max_threads = ft::min(bench::arg(ac, av, 2, 64),
+		64UL);
+	unsigned long const	keys = bench::arg(ac, av, 3, 100000);
+
+	std::printf("%lu keys, 90%% lookups, 5%% inserts, 5%% erases, in ns/op\n",
+		keys);
+	std::printf("%-8s %12s %12s %8s\n", "threads", "skiplist", "mutex",
+		"speedup");
+	for (unsigned long threads = 1; threads <= max_threads; threads *= 2)
+	{
+		unsigned long const	n = ops / threads * threads;
+		double const		skiplist = run<skiplist_map>(n, threads, keys);
+		double const		locked = run<locked_map>(n, threads, keys);
+
+		std::printf("%-8lu %12.2f %12.2f %7.2fx\n", threads,
+			skiplist * 1e9 / double(n), locked * 1e9 / double(n),
+			locked / skiplist);
+	}
+	return 0;
+}
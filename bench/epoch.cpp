@@ -0,0 +1,124 @@
+#include <epoch.hpp>
+#include <memory.hpp>
+#include <pool_allocator.hpp>
+
+#include <pthread.h>
+
+#include "bench.hpp"
+
+/// A node the size of a small map's.
+struct	node
+{
+	unsigned long	key;
+	unsigned long	value;
+	node*			next;
+};
+
+struct	context
+{
+	unsigned long	ops;
+	pthread_t		thread;
+};
+
+/// Pin and unpin the calling thread.
+static void*	pin(void* arg)
+{
+	context&	ctx = *static_cast<context*>(arg);
+
+	for (unsigned long i = 0; i < ctx.ops; ++i)
+	{
+		ft::epoch::guard const	g;
+
+		bench::keep(i);
+	}
+	return 0;
+}
+
+/// Allocate a node, and free it at once, as if no other thread could see
+/// it.
+template<typename A>
+static void*	free_now(void* arg)
+{
+	context&	ctx = *static_cast<context*>(arg);
+	A			a;
+	node const	x = node();
+
+	for (unsigned long i = 0; i < ctx.ops; ++i)
+	{
+		node* const	p = a.allocate(1);
+
+		a.construct(p, x);
+		bench::keep(p);
+		a.destroy(p);
+		a.deallocate(p, 1);
+	}
+	return 0;
+}
+
+/// Allocate a node while pinned, and retire it.
+template<typename A>
+static void*	retire(void* arg)
+{
+	context&	ctx = *static_cast<context*>(arg);
+	A			a;
+	node const	x = node();
+
+	for (unsigned long i = 0; i < ctx.ops; ++i)
+	{
+		ft::epoch::guard const	g;
+		node* const				p = a.allocate(1);
+
+		a.construct(p, x);
+		bench::keep(p);
+		ft::epoch::retire(p, a);
+	}
+	ft::epoch::collect();
+	return 0;
+}
+
+/// Run ops calls of f's loop over `threads` threads, and return the time.
+static double	run(void* (*f)(void*), unsigned long ops,
+	unsigned long threads)
+{
+	context			ctx[64];
+	double const	start = bench::now();
+
+	for (unsigned long i = 0; i < threads; ++i)
+	{
+		ctx[i].ops = ops / threads;
+		pthread_create(&ctx[i].thread, 0, f, ctx + i);
+	}
+	for (unsigned long i = 0; i < threads; ++i)
+		pthread_join(ctx[i].thread, 0);
+	return bench::now() - start;
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	ops = bench::arg(ac, av, 1, 10000000UL);
+	unsigned long const	max_threads = ft::min(bench::arg(ac, av, 2, 64),
+		64UL);
+
+	std::printf("in ns/op\n");
+	std::printf("%-8s %10s %10s %10s %10s %10s\n", "threads", "pin",
+		"free", "retire", "pool free", "pool ret.");
+	for (unsigned long threads = 1; threads <= max_threads; threads *= 2)
+	{
+		unsigned long const	n = ops / threads * threads;
+		double const		pinned = run(pin, n, threads);
+		double const		freed = run(free_now<ft::allocator<node> >, n,
+			threads);
+		double const		retired = run(retire<ft::allocator<node> >, n,
+			threads);
+		double const		pool_freed = run(
+			free_now<ft::pool_allocator<node> >, n, threads);
+		double const		pool_retired = run(
+			retire<ft::pool_allocator<node> >, n, threads);
+
+		std::printf("%-8lu %10.2f %10.2f %10.2f %10.2f %10.2f\n", threads,
+			pinned * 1e9 / double(n), freed * 1e9 / double(n),
+			retired * 1e9 / double(n), pool_freed * 1e9 / double(n),
+			pool_retired * 1e9 / double(n));
+	}
+	return 0;
+}
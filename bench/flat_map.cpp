@@ -0,0 +1,93 @@
+#include <btree_map.hpp>
+#include <flat_map.hpp>
+#include <map.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+/**
+ * Build a map from a range of n elements in random order, look each of
+ * them up in another random order, and time both phases.
+ */
+template<typename Map>
+static void	run(char const* name,
+	ft::vector<ft::pair<unsigned long, unsigned long> > const& values,
+	ft::vector<unsigned long> const& order)
+{
+	unsigned long const	n = values.size();
+	unsigned long		sum = 0;
+	char				label[64];
+	double				start;
+
+	start = bench::now();
+
+	Map const	m(values.begin(), values.end());
+
+	std::snprintf(label, sizeof(label), "%s build", name);
+	bench::report(label, n, bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		sum += m.find(values[order[i]].first)->second;
+	std::snprintf(label, sizeof(label), "%s find", name);
+	bench::report(label, n, bench::now() - start);
+	bench::keep(sum);
+}
+
+int	main(int ac, char** av)
+{
+	typedef	unsigned long	ul;
+
+	unsigned long const	min_keys = bench::arg(ac, av, 1, 1000);
+	unsigned long const	max_keys = bench::arg(ac, av, 2, 10000000UL);
+	unsigned long		seed = 88172645463325252UL;
+
+	for (unsigned long n = min_keys; n <= max_keys; n *= 10)
+	{
+		ft::vector<ft::pair<ul, ul> >	values;
+		ft::vector<ft::pair<ul, ul> >	sorted;
+		ft::vector<unsigned long>		order(n);
+		double							start;
+
+		// Distinct keys, in random order.
+		for (unsigned long i = 0; i < n; ++i)
+			values.push_back(ft::make_pair((next(seed) & ~0xfffffUL) | i, i));
+		for (unsigned long i = 0; i < n; ++i)
+			order[i] = i;
+		for (unsigned long i = n; i > 1; --i)
+			ft::swap(order[i - 1], order[next(seed) % i]);
+
+		std::printf("%lu keys\n", n);
+		run<ft::flat_map<ul, ul> >("ft::flat_map", values, order);
+		run<ft::btree_map<ul, ul> >("ft::btree_map", values, order);
+		run<ft::map<ul, ul> >("ft::map", values, order);
+
+		for (unsigned long i = 0; i < n; ++i)
+			sorted.push_back(ft::make_pair(i, i));
+		start = bench::now();
+		{
+			ft::flat_map<ul, ul> const	m(ft::sorted_unique, sorted.begin(),
+				sorted.end());
+
+			bench::report("ft::flat_map sorted build", n,
+				bench::now() - start);
+		}
+
+		ft::flat_map<ul, ul>	m(sorted.begin(), sorted.end());
+
+		for (unsigned long i = 0; i < n; ++i)
+			values[i].first = 2 * values[i].first + 1;
+		start = bench::now();
+		m.insert_range(values.begin(), values.end());
+		bench::report("ft::flat_map insert_range", n, bench::now() - start);
+	}
+	return 0;
+}
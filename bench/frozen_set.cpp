@@ -0,0 +1,83 @@
+#include <algorithm>
+
+#include <algorithm.hpp>
+#include <frozen_set.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+/**
+ * Look up random keys, about half of them in the set, with the lower_bound
+ * of a frozen_set, and with binary searches of the same keys in a sorted
+ * array, timing each.
+ */
+static void	run(ft::vector<unsigned> const& sorted,
+	ft::vector<unsigned> const& queries)
+{
+	ft::frozen_set<unsigned> const	set(sorted.begin(), sorted.end());
+	unsigned const*					first = &sorted[0];
+	unsigned const*					last = first + sorted.size();
+	unsigned long					sum = 0;
+	double							start;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < queries.size(); ++i)
+	{
+		ft::frozen_set<unsigned>::iterator const	j
+			= set.lower_bound(queries[i]);
+
+		sum += j == set.end() ? 0 : *j;
+	}
+	bench::report("ft::frozen_set lower_bound", queries.size(),
+		bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < queries.size(); ++i)
+	{
+		unsigned const*	j = ft::lower_bound(first, last, queries[i]);
+
+		sum += j == last ? 0 : *j;
+	}
+	bench::report("ft::lower_bound", queries.size(), bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < queries.size(); ++i)
+	{
+		unsigned const*	j = std::lower_bound(first, last, queries[i]);
+
+		sum += j == last ? 0 : *j;
+	}
+	bench::report("std::lower_bound", queries.size(), bench::now() - start);
+	bench::keep(sum);
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const		min_keys = bench::arg(ac, av, 1, 1000);
+	unsigned long const		max_keys = bench::arg(ac, av, 2, 10000000UL);
+	unsigned long const		lookups = bench::arg(ac, av, 3, 1000000);
+	unsigned long			seed = 88172645463325252UL;
+
+	for (unsigned long n = min_keys; n <= max_keys; n *= 10)
+	{
+		ft::vector<unsigned>	sorted(n);
+		ft::vector<unsigned>	queries(lookups);
+
+		// Even keys, spread over twice their range, and queries of any.
+		for (unsigned long i = 0; i < n; ++i)
+			sorted[i] = static_cast<unsigned>(4 * i);
+		for (unsigned long i = 0; i < lookups; ++i)
+			queries[i] = static_cast<unsigned>(next(seed) % (4 * n));
+		std::printf("%lu keys\n", n);
+		run(sorted, queries);
+	}
+	return 0;
+}
@@ -0,0 +1,256 @@
+#include <map>
+
+#include <map.hpp>
+#include <memory.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+/**
+ * Insert n random keys, look each of them up, and erase them in another
+ * random order, timing each phase.
+ */
+template<typename Map>
+static void	run(char const* name, ft::vector<unsigned long> const& keys,
+	ft::vector<unsigned long> const& order)
+{
+	unsigned long const	n = keys.size();
+	Map					m;
+	unsigned long		sum = 0;
+	char				label[64];
+	double				start;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		m[keys[i]] = i;
+	std::snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, n, bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		sum += m.find(keys[order[i]])->second;
+	std::snprintf(label, sizeof(label), "%s find", name);
+	bench::report(label, n, bench::now() - start);
+	bench::keep(sum);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		m.erase(keys[order[i]]);
+	std::snprintf(label, sizeof(label), "%s erase", name);
+	bench::report(label, n, bench::now() - start);
+}
+
+/**
+ * Build a map from n sorted keys with its range constructor, and time it.
+ */
+template<typename Map, typename Sorted>
+static void	load(char const* name, Sorted const& sorted)
+{
+	char	label[64];
+	double	start;
+
+	start = bench::now();
+
+	Map const	m(sorted.begin(), sorted.end());
+
+	std::snprintf(label, sizeof(label), "%s sorted build", name);
+	bench::report(label, m.size(), bench::now() - start);
+}
+
+/**
+ * Insert a nearly sorted stream of keys, hinting each insertion at the end
+ * of the map, and time it.
+ */
+template<typename Map>
+static void	stream(char const* name, ft::vector<unsigned long> const& keys)
+{
+	Map		m;
+	char	label[64];
+	double	start;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < keys.size(); ++i)
+		m.insert(m.end(), typename Map::value_type(keys[i], i));
+	std::snprintf(label, sizeof(label), "%s stream", name);
+	bench::report(label, keys.size(), bench::now() - start);
+}
+
+/**
+ * Find the element at 1000 random positions of a map holding the given keys,
+ * and time it.
+ */
+template<typename Map, typename Select>
+static void	select(char const* name, ft::vector<unsigned long> const& keys,
+	Select at)
+{
+	Map				m;
+	unsigned long	seed = 2463534242UL;
+	unsigned long	sum = 0;
+	char			label[64];
+	double			start;
+
+	for (unsigned long i = 0; i < keys.size(); ++i)
+		m.insert(typename Map::value_type(keys[i], i));
+	start = bench::now();
+	for (unsigned long i = 0; i < 1000; ++i)
+		sum += at(m, next(seed) % m.size())->second;
+	std::snprintf(label, sizeof(label), "%s select", name);
+	bench::report(label, 1000, bench::now() - start);
+	bench::keep(sum);
+}
+
+/**
+ * Split a map of the given keys at random keys, and join the halves back
+ * each time, timing each pair of operations.
+ */
+template<typename Map>
+static void	split_join(char const* name, ft::vector<unsigned long> const& keys,
+	unsigned long rounds)
+{
+	Map				m;
+	Map				left;
+	Map				right;
+	unsigned long	seed = 2463534242UL;
+	char			label[64];
+	double			start;
+
+	for (unsigned long i = 0; i < keys.size(); ++i)
+		m.insert(typename Map::value_type(keys[i], i));
+	start = bench::now();
+	for (unsigned long i = 0; i < rounds; ++i)
+	{
+		m.split(keys[next(seed) % keys.size()], left, right);
+		m.join(left, right);
+	}
+	std::snprintf(label, sizeof(label), "%s split+join", name);
+	bench::report(label, rounds, bench::now() - start);
+}
+
+/**
+ * Move the keys greater than a random one to another std::map and back, as
+ * split and join have to without them, and time it.
+ */
+template<typename Map>
+static void	move_range(char const* name, ft::vector<unsigned long> const& keys)
+{
+	Map				m;
+	Map				right;
+	unsigned long	seed = 2463534242UL;
+	char			label[64];
+	double			start;
+
+	for (unsigned long i = 0; i < keys.size(); ++i)
+		m.insert(typename Map::value_type(keys[i], i));
+	start = bench::now();
+	for (unsigned long i = 0; i < 100; ++i)
+	{
+		typename Map::iterator const	pos
+			= m.lower_bound(keys[next(seed) % keys.size()]);
+
+		right.insert(pos, m.end());
+		m.erase(pos, m.end());
+		m.insert(right.begin(), right.end());
+		right.clear();
+	}
+	std::snprintf(label, sizeof(label), "%s split+join", name);
+	bench::report(label, 100, bench::now() - start);
+}
+
+template<typename Map>
+static typename Map::iterator	select_tree(Map& m, unsigned long i)
+{ return m.select(i); }
+
+template<typename Map>
+static typename Map::iterator	select_walk(Map& m, unsigned long i)
+{
+	typename Map::iterator	it = m.begin();
+
+	std::advance(it, i);
+	return it;
+}
+
+int	main(int ac, char** av)
+{
+	typedef	ft::map<unsigned long, unsigned long, ft::less<unsigned long>,
+		ft::pool_allocator<ft::pair<unsigned long const, unsigned long> >,
+		ft::rb_order_statistics>	stat_map;
+
+	unsigned long const	min_keys = bench::arg(ac, av, 1, 1000);
+	unsigned long const	max_keys = bench::arg(ac, av, 2, 10000000UL);
+	unsigned long		seed = 88172645463325252UL;
+
+	for (unsigned long n = min_keys; n <= max_keys; n *= 10)
+	{
+		ft::vector<unsigned long>	keys(n);
+		ft::vector<unsigned long>	order(n);
+
+		// Distinct keys, in random order.
+		for (unsigned long i = 0; i < n; ++i)
+			keys[i] = (next(seed) & ~0xfffffUL) | i;
+		for (unsigned long i = 0; i < n; ++i)
+			order[i] = i;
+		for (unsigned long i = n; i > 1; --i)
+			ft::swap(order[i - 1], order[next(seed) % i]);
+
+		std::printf("%lu keys\n", n);
+		run<ft::map<unsigned long, unsigned long> >("ft::map", keys, order);
+		run<ft::map<unsigned long, unsigned long,
+			ft::less<unsigned long>, ft::allocator<ft::pair<
+				unsigned long const, unsigned long> > > >(
+			"ft::map, allocator", keys, order);
+		run<stat_map>("ft::map, statistics", keys, order);
+		run<std::map<unsigned long, unsigned long> >("std::map", keys,
+			order);
+		select<stat_map>("ft::map, statistics", keys,
+			select_tree<stat_map>);
+		split_join<stat_map>("ft::map, statistics", keys, 1000);
+		// Counting the elements on each side of a split without the
+		// statistics, walking to a position, and moving elements are all
+		// linear, so keep them to small maps.
+		if (n <= 100000)
+		{
+			split_join<ft::map<unsigned long, unsigned long> >("ft::map",
+				keys, 100);
+			move_range<std::map<unsigned long, unsigned long> >("std::map",
+				keys);
+			select<std::map<unsigned long, unsigned long> >("std::map",
+				keys, select_walk<std::map<unsigned long, unsigned long> >);
+		}
+
+		ft::vector<ft::pair<unsigned long, unsigned long> >	sorted;
+		std::map<unsigned long, unsigned long>				std_sorted;
+
+		for (unsigned long i = 0; i < n; ++i)
+		{
+			sorted.push_back(ft::make_pair(i, i));
+			std_sorted.insert(std_sorted.end(), std::make_pair(i, i));
+		}
+		load<ft::map<unsigned long, unsigned long> >("ft::map", sorted);
+		load<std::map<unsigned long, unsigned long> >("std::map",
+			std_sorted);
+
+		// Increasing keys, with one in 16 arriving up to 64 places late.
+		for (unsigned long i = 0; i < n; ++i)
+			keys[i] = i;
+		for (unsigned long i = 64; i < n; i += 16)
+		{
+			unsigned long		j = i - 1 - next(seed) % 64;
+			unsigned long const	late = keys[j];
+
+			for (; j < i; ++j)
+				keys[j] = keys[j + 1];
+			keys[i] = late;
+		}
+		stream<ft::map<unsigned long, unsigned long> >("ft::map", keys);
+		stream<std::map<unsigned long, unsigned long> >("std::map", keys);
+	}
+	return 0;
+}
@@ -0,0 +1,152 @@
+#include <queue.hpp>
+
+#include <pthread.h>
+
+#include "bench.hpp"
+
+/// The baseline: a bounded ft::queue protected by a mutex and two
+/// condition variables.
+struct	locked_queue
+{
+	pthread_mutex_t					lock;
+	pthread_cond_t					not_empty;
+	pthread_cond_t					not_full;
+	ft::queue<unsigned long>		q;
+	unsigned long					capacity;
+
+	explicit locked_queue(unsigned long n)	:	capacity(n)
+	{
+		pthread_mutex_init(&lock, 0);
+		pthread_cond_init(&not_empty, 0);
+		pthread_cond_init(&not_full, 0);
+	}
+
+	~locked_queue()
+	{
+		pthread_cond_destroy(&not_full);
+		pthread_cond_destroy(&not_empty);
+		pthread_mutex_destroy(&lock);
+	}
+
+	void	push(unsigned long x)
+	{
+		pthread_mutex_lock(&lock);
+		while (q.size() == capacity)
+			pthread_cond_wait(&not_full, &lock);
+		q.push(x);
+		pthread_cond_signal(&not_empty);
+		pthread_mutex_unlock(&lock);
+	}
+
+	void	pop(unsigned long& x)
+	{
+		pthread_mutex_lock(&lock);
+		while (q.empty())
+			pthread_cond_wait(&not_empty, &lock);
+		x = q.front();
+		q.pop();
+		pthread_cond_signal(&not_full);
+		pthread_mutex_unlock(&lock);
+	}
+};
+
+template<typename Q>
+struct	context
+{
+	Q*				q;
+	unsigned long	per_thread;
+	unsigned long	sum;
+	pthread_t		thread;
+};
+
+template<typename Q>
+static void*	produce(void* arg)
+{
+	context<Q>&	ctx = *static_cast<context<Q>*>(arg);
+
+	for (unsigned long i = 1; i <= ctx.per_thread; ++i)
+		ctx.q->push(i);
+	return 0;
+}
+
+template<typename Q>
+static void*	consume(void* arg)
+{
+	context<Q>&	ctx = *static_cast<context<Q>*>(arg);
+
+	for (unsigned long i = 0; i < ctx.per_thread; ++i)
+	{
+		unsigned long	x;
+
+		ctx.q->pop(x);
+		ctx.sum += x;
+	}
+	return 0;
+}
+
+/**
+ * Move count values through a queue with `threads` producers and as many
+ * consumers, and check they all arrived.
+ */
+template<typename Q>
+static double	run(unsigned long count, unsigned long threads,
+	unsigned long capacity)
+{
+	Q				q(capacity);
+	context<Q>		producers[64];
+	context<Q>		consumers[64];
+	unsigned long	sum = 0;
+
+	double const	start = bench::now();
+
+	for (unsigned long i = 0; i < threads; ++i)
+	{
+		context<Q>* const	sides[2] = { producers + i, consumers + i };
+
+		for (unsigned long j = 0; j < 2; ++j)
+		{
+			sides[j]->q = &q;
+			sides[j]->per_thread = count / threads;
+			sides[j]->sum = 0;
+			pthread_create(&sides[j]->thread, 0,
+				j ? consume<Q> : produce<Q>, sides[j]);
+		}
+	}
+	for (unsigned long i = 0; i < threads; ++i)
+	{
+		pthread_join(producers[i].thread, 0);
+		pthread_join(consumers[i].thread, 0);
+		sum += consumers[i].sum;
+	}
+
+	double const		seconds = bench::now() - start;
+	unsigned long const	n = count / threads;
+
+	if (sum != threads * (n * (n + 1) / 2))
+		std::printf("checksum mismatch!\n");
+	return seconds;
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	count = bench::arg(ac, av, 1, 4000000UL);
+	unsigned long const	max_threads = ft::min(bench::arg(ac, av, 2, 64),
+		64UL);
+	unsigned long const	capacity = bench::arg(ac, av, 3, 1024);
+
+	std::printf("%-8s %16s %16s %8s\n", "threads", "mpmc ns/op",
+		"mutex ns/op", "speedup");
+	for (unsigned long threads = 1; threads <= max_threads; threads *= 2)
+	{
+		unsigned long const	ops = count / threads * threads;
+		double const		lock_free = run<ft::mpmc_queue<unsigned long> >(
+			ops, threads, capacity);
+		double const		locked = run<locked_queue>(ops, threads,
+			capacity);
+
+		std::printf("%-8lu %16.2f %16.2f %7.2fx\n", threads,
+			lock_free * 1e9 / double(ops), locked * 1e9 / double(ops),
+			locked / lock_free);
+	}
+	return 0;
+}
@@ -0,0 +1,184 @@
+#include <pairing_heap.hpp>
+#include <pool_allocator.hpp>
+#include <queue.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+/// A vertex and its tentative distance, ordered by distance.
+struct	entry
+{
+	unsigned long	dist;
+	unsigned		vertex;
+
+	entry(unsigned long d = 0, unsigned v = 0)	:	dist(d), vertex(v) { }
+
+	bool	operator>(entry const& x) const
+	{ return dist > x.dist; }
+};
+
+/// A directed graph in compressed sparse row form.
+struct	graph
+{
+	ft::vector<unsigned>	offsets;
+	ft::vector<unsigned>	targets;
+	ft::vector<unsigned>	weights;
+
+	/// Draw `edges` random edges between `vertices` vertices.
+	graph(unsigned vertices, unsigned long edges)
+		:	offsets(vertices + 1), targets(edges), weights(edges)
+	{
+		ft::vector<unsigned>	sources(edges);
+		unsigned long			seed = 88172645463325252UL;
+
+		for (unsigned long i = 0; i < edges; ++i)
+		{
+			sources[i] = unsigned(next(seed) % vertices);
+			++offsets[sources[i] + 1];
+		}
+		for (unsigned v = 0; v < vertices; ++v)
+			offsets[v + 1] += offsets[v];
+
+		ft::vector<unsigned>	fill(offsets.begin(), offsets.end() - 1);
+
+		for (unsigned long i = 0; i < edges; ++i)
+		{
+			unsigned const	slot = fill[sources[i]]++;
+
+			targets[slot] = unsigned(next(seed) % vertices);
+			weights[slot] = unsigned(next(seed) % 1000) + 1;
+		}
+	}
+
+	unsigned	size() const
+	{ return unsigned(offsets.size() - 1); }
+
+	static unsigned long	next(unsigned long& seed)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		return seed;
+	}
+};
+
+static unsigned long const	infinity = ~0UL;
+
+static unsigned long	checksum(ft::vector<unsigned long> const& dist)
+{
+	unsigned long	sum = 0;
+
+	for (unsigned long i = 0; i < dist.size(); ++i)
+		if (dist[i] != infinity)
+			sum += dist[i] ^ i;
+	return sum;
+}
+
+/**
+ * Dijkstra's algorithm with one heap element per vertex, whose key is
+ * lowered in place.
+ */
+template<typename A>
+static unsigned long	dijkstra_pairing(graph const& g, unsigned source)
+{
+	typedef ft::pairing_heap<entry, ft::greater<entry>, A>	heap_type;
+
+	ft::vector<unsigned long>				dist(g.size(), infinity);
+	ft::vector<typename heap_type::handle>	handles(g.size());
+	ft::vector<bool>						queued(g.size());
+	heap_type								heap;
+
+	dist[source] = 0;
+	handles[source] = heap.push(entry(0, source));
+	queued[source] = true;
+	while (!heap.empty())
+	{
+		unsigned const	u = heap.top().vertex;
+
+		heap.pop();
+		queued[u] = false;
+		for (unsigned i = g.offsets[u]; i < g.offsets[u + 1]; ++i)
+		{
+			unsigned const		v = g.targets[i];
+			unsigned long const	d = dist[u] + g.weights[i];
+
+			if (d >= dist[v])
+				continue;
+			if (queued[v])
+				heap.decrease_key(handles[v], entry(d, v));
+			else if (dist[v] == infinity)
+			{
+				handles[v] = heap.push(entry(d, v));
+				queued[v] = true;
+			}
+			dist[v] = d;
+		}
+	}
+	return checksum(dist);
+}
+
+/**
+ * Dijkstra's algorithm with a binary heap that gets a new element for
+ * every improvement, and skips the stale ones when they are popped.
+ */
+static unsigned long	dijkstra_lazy(graph const& g, unsigned source)
+{
+	ft::vector<unsigned long>	dist(g.size(), infinity);
+	ft::priority_queue<entry, ft::vector<entry>, ft::greater<entry>, 2>
+		heap;
+
+	dist[source] = 0;
+	heap.push(entry(0, source));
+	while (!heap.empty())
+	{
+		entry const	e = heap.top();
+
+		heap.pop();
+		if (e.dist != dist[e.vertex])
+			continue;
+		for (unsigned i = g.offsets[e.vertex]; i < g.offsets[e.vertex + 1];
+			++i)
+		{
+			unsigned const		v = g.targets[i];
+			unsigned long const	d = e.dist + g.weights[i];
+
+			if (d >= dist[v])
+				continue;
+			dist[v] = d;
+			heap.push(entry(d, v));
+		}
+	}
+	return checksum(dist);
+}
+
+int	main(int ac, char** av)
+{
+	unsigned const		vertices = unsigned(bench::arg(ac, av, 1, 1000000));
+	unsigned long const	edges = bench::arg(ac, av, 2, 10000000UL);
+	graph const			g(vertices, edges);
+	double				start;
+
+	std::printf("%u vertices, %lu edges\n", vertices, edges);
+
+	start = bench::now();
+	unsigned long const	pooled
+		= dijkstra_pairing<ft::pool_allocator<entry> >(g, 0);
+	double const		pooled_time = bench::now() - start;
+	bench::report("pairing_heap, pool_allocator", edges, pooled_time);
+
+	start = bench::now();
+	unsigned long const	plain = dijkstra_pairing<ft::allocator<entry> >(g, 0);
+	double const		plain_time = bench::now() - start;
+	bench::report("pairing_heap, allocator", edges, plain_time);
+
+	start = bench::now();
+	unsigned long const	lazy = dijkstra_lazy(g, 0);
+	double const		lazy_time = bench::now() - start;
+	bench::report("lazy-deletion binary heap", edges, lazy_time);
+
+	if (pooled != lazy || plain != lazy)
+		std::printf("distance mismatch!\n");
+	std::printf("pooled pairing heap speedup: %.2fx\n",
+		lazy_time / pooled_time);
+	return 0;
+}
@@ -0,0 +1,116 @@
+#include <map.hpp>
+#include <memory.hpp>
+#include <persistent_map.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	allocated = 0;
+
+/// An allocator that keeps track of the bytes it hands out.
+template<typename T>
+struct	counting_allocator	:	public ft::allocator<T>
+{
+	template<typename O>
+	struct	rebind
+	{ typedef counting_allocator<O> other; };
+
+	counting_allocator() throw() { }
+
+	template<typename O>
+	counting_allocator(counting_allocator<O> const&) throw() { }
+
+	T*		allocate(size_t n, void const* = 0)
+	{
+		allocated += n * sizeof(T);
+		return ft::allocator<T>::allocate(n);
+	}
+
+	void	deallocate(T* p, size_t n)
+	{
+		allocated -= n * sizeof(T);
+		ft::allocator<T>::deallocate(p, n);
+	}
+};
+
+typedef	unsigned long									ul;
+typedef	counting_allocator<ft::pair<ul const, ul> >		alloc;
+typedef	ft::map<ul, ul, ft::less<ul>, alloc>			plain_map;
+typedef	ft::persistent_map<ul, ul, ft::less<ul>, alloc>	snapshot_map;
+
+/// The snapshots kept alive at a time.
+enum { live = 16 };
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+static void	assign(plain_map& m, ul k, ul v)
+{ m[k] = v; }
+
+static void	assign(snapshot_map& m, ul k, ul v)
+{ m.insert_or_assign(ft::pair<ul const, ul>(k, v)); }
+
+/**
+ * Fill a map with n keys and look them up, then run rounds of an update
+ * followed by a snapshot, keeping the last few snapshots alive as readers
+ * would, and report the time of each phase and the bytes the snapshots
+ * hold on top of the map.
+ */
+template<typename Map>
+static void	run(char const* name, ft::vector<ul> const& keys,
+	unsigned long rounds)
+{
+	unsigned long const	n = keys.size();
+	Map					m;
+	ft::vector<Map>		snapshots(live);
+	ul					sum = 0;
+	unsigned long		seed = 2463534242UL;
+	char				label[64];
+	double				start;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		assign(m, keys[i], i);
+	std::snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, n, bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = n; i-- > 0;)
+		sum += m.count(keys[i]);
+	std::snprintf(label, sizeof(label), "%s find", name);
+	bench::report(label, n, bench::now() - start);
+	bench::keep(sum);
+
+	unsigned long const	base = allocated;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < rounds; ++i)
+	{
+		assign(m, keys[next(seed) % n], i);
+		snapshots[i % live] = m;
+	}
+	std::snprintf(label, sizeof(label), "%s update+snapshot", name);
+	bench::report(label, rounds, bench::now() - start);
+	std::printf("%-32s %12.1f bytes/snapshot\n", name,
+		double(allocated - base) / live);
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	n = bench::arg(ac, av, 1, 1000000);
+	unsigned long const	rounds = bench::arg(ac, av, 2, 100000);
+	unsigned long		seed = 88172645463325252UL;
+	ft::vector<ul>		keys;
+
+	for (unsigned long i = 0; i < n; ++i)
+		keys.push_back(next(seed));
+	std::printf("%lu keys, %d live snapshots\n", n, int(live));
+	run<snapshot_map>("ft::persistent_map", keys, rounds);
+	run<plain_map>("ft::map", keys, ft::max(rounds / 5000, 16UL));
+	return 0;
+}
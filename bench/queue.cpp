@@ -0,0 +1,48 @@
+#include <queue.hpp>
+#include <list.hpp>
+
+#include "bench.hpp"
+
+/**
+ * Push/pop cycles on a queue that holds `depth` elements, so that every
+ * cycle allocates at the back and frees at the front.
+ */
+template<typename Q>
+static double	run(unsigned long cycles, unsigned long depth)
+{
+	Q				q;
+	unsigned long	sum = 0;
+
+	for (unsigned long i = 0; i < depth; ++i)
+		q.push(int(i));
+
+	double const	start = bench::now();
+
+	for (unsigned long i = 0; i < cycles; ++i)
+	{
+		q.push(int(i));
+		sum += q.front();
+		q.pop();
+	}
+
+	double const	seconds = bench::now() - start;
+
+	bench::keep(sum);
+	return seconds;
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	cycles = bench::arg(ac, av, 1, 100000000UL);
+	unsigned long const	depth = bench::arg(ac, av, 2, 1024);
+
+	double const	deque_time = run<ft::queue<int> >(cycles, depth);
+	bench::report("queue<int, deque<int> >", cycles, deque_time);
+
+	double const	list_time = run<ft::queue<int, ft::list<int> > >(cycles,
+		depth);
+	bench::report("queue<int, list<int> >", cycles, list_time);
+
+	std::printf("deque speedup: %.2fx\n", list_time / deque_time);
+	return 0;
+}
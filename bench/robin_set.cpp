@@ -0,0 +1,155 @@
+#include <tr1/unordered_set>
+
+#include <memory.hpp>
+#include <robin_set.hpp>
+#include <unordered_set.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	allocated = 0;
+
+/// An allocator that keeps track of the bytes it hands out.
+template<typename T>
+struct	counting_allocator	:	public ft::allocator<T>
+{
+	template<typename O>
+	struct	rebind
+	{ typedef counting_allocator<O> other; };
+
+	counting_allocator() throw() { }
+
+	template<typename O>
+	counting_allocator(counting_allocator<O> const&) throw() { }
+
+	T*		allocate(size_t n, void const* = 0)
+	{
+		allocated += n * sizeof(T);
+		return ft::allocator<T>::allocate(n);
+	}
+
+	void	deallocate(T* p, size_t n)
+	{
+		allocated -= n * sizeof(T);
+		ft::allocator<T>::deallocate(p, n);
+	}
+};
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+/// The longest probe of a robin_set.
+template<typename T, typename H, typename P, typename A>
+static unsigned long	longest(ft::robin_set<T, H, P, A> const& s)
+{ return s.max_probe_length(); }
+
+/// The longest probe of an ft::unordered_set is not tracked.
+template<typename T, typename H, typename P, typename A>
+static unsigned long	longest(ft::unordered_set<T, H, P, A> const&)
+{ return 0; }
+
+/// The longest chain of a std::tr1::unordered_set.
+template<typename T, typename H, typename P, typename A>
+static unsigned long	longest(std::tr1::unordered_set<T, H, P, A> const& s)
+{
+	unsigned long	m = 0;
+
+	for (unsigned long i = 0; i < s.bucket_count(); ++i)
+		m = ft::max(m, static_cast<unsigned long>(s.bucket_size(i)));
+	return m;
+}
+
+/// Set the maximum load factor of a set.
+template<typename Set>
+static void	set_load(Set& s, float z)
+{ s.max_load_factor(z); }
+
+/// ft::unordered_set's is fixed at 7/8.
+template<typename T, typename H, typename P, typename A>
+static void	set_load(ft::unordered_set<T, H, P, A>&, float)
+{ }
+
+/**
+ * Insert n keys into a set with the given maximum load factor, report the
+ * bytes allocated per key and the longest probe, look each of them up,
+ * look up as many keys that are not in the set, and erase them all, timing
+ * each phase.
+ */
+template<typename Set>
+static void	run(char const* name, float z,
+	ft::vector<unsigned> const& keys, ft::vector<unsigned> const& missing)
+{
+	unsigned long const	n = keys.size();
+	Set					s;
+	unsigned long		sum = 0;
+	char				label[64];
+	double				start;
+
+	set_load(s, z);
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		s.insert(keys[i]);
+	std::snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, n, bench::now() - start);
+	std::printf("%-32s %12.1f bytes/key %5.2f load", name,
+		double(allocated) / double(n), s.load_factor());
+	if (longest(s))
+		std::printf(" %4lu longest", longest(s));
+	std::printf("\n");
+
+	start = bench::now();
+	for (unsigned long i = n; i-- > 0;)
+		sum += s.count(keys[i]);
+	std::snprintf(label, sizeof(label), "%s find hit", name);
+	bench::report(label, n, bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		sum += s.count(missing[i]);
+	std::snprintf(label, sizeof(label), "%s find miss", name);
+	bench::report(label, n, bench::now() - start);
+	bench::keep(sum);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		s.erase(keys[i]);
+	std::snprintf(label, sizeof(label), "%s erase", name);
+	bench::report(label, n, bench::now() - start);
+}
+
+int	main(int ac, char** av)
+{
+	typedef	counting_allocator<unsigned>	alloc;
+
+	unsigned long const		n = bench::arg(ac, av, 1, 1000000);
+	unsigned long			seed = 88172645463325252UL;
+	ft::vector<unsigned>	keys;
+	ft::vector<unsigned>	missing;
+	float const				loads[] = { 0.5f, 0.9f };
+
+	// Random 32-bit identifiers: even ones are in the set, odd ones not.
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		keys.push_back(static_cast<unsigned>(next(seed)) & ~1U);
+		missing.push_back(static_cast<unsigned>(next(seed)) | 1U);
+	}
+	for (unsigned long i = 0; i < sizeof(loads) / sizeof(*loads); ++i)
+	{
+		std::printf("%lu keys, load factor up to %.2f\n", n, loads[i]);
+		run<ft::robin_set<unsigned, ft::hash<unsigned>,
+			ft::equal_to<unsigned>, alloc> >("ft::robin_set", loads[i],
+			keys, missing);
+		run<std::tr1::unordered_set<unsigned, std::tr1::hash<unsigned>,
+			std::equal_to<unsigned>, alloc> >("std::tr1::unordered_set",
+			loads[i], keys, missing);
+	}
+	run<ft::unordered_set<unsigned, ft::hash<unsigned>,
+		ft::equal_to<unsigned>, alloc> >("ft::unordered_set", 0.875f, keys,
+		missing);
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include <set.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+static void	fill(ft::vector<unsigned long>& keys, unsigned long n,
+	unsigned long& seed)
+{
+	keys.clear();
+	for (unsigned long i = 0; i < n; ++i)
+		keys.push_back(next(seed) % (4 * n + 1000));
+}
+
+/**
+ * Combine a set of n random keys with one of m, with the merge members,
+ * and time each operation.
+ */
+static void	run_ft(ft::vector<unsigned long> const& big,
+	ft::vector<unsigned long> const& small)
+{
+	typedef	ft::set<unsigned long>	set;
+
+	double	start;
+
+	{
+		set	a(big.begin(), big.end());
+		set	b(small.begin(), small.end());
+
+		start = bench::now();
+		a.merge_union(b);
+		bench::report("ft::set union", small.size(),
+			bench::now() - start);
+	}
+	{
+		set	a(big.begin(), big.end());
+		set	b(small.begin(), small.end());
+
+		start = bench::now();
+		b.merge_union(a);
+		bench::report("ft::set union, swapped", small.size(),
+			bench::now() - start);
+	}
+	{
+		set	a(big.begin(), big.end());
+		set	b(small.begin(), small.end());
+
+		start = bench::now();
+		a.merge_difference(b);
+		bench::report("ft::set difference", small.size(),
+			bench::now() - start);
+	}
+	{
+		set	a(big.begin(), big.end());
+		set	b(small.begin(), small.end());
+
+		start = bench::now();
+		b.merge_intersection(a);
+		bench::report("ft::set intersection", small.size(),
+			bench::now() - start);
+	}
+}
+
+/**
+ * The same with std::set: inserting or erasing each element of the
+ * smaller set, and std::set_union into a new set.
+ */
+static void	run_std(ft::vector<unsigned long> const& big,
+	ft::vector<unsigned long> const& small)
+{
+	typedef	std::set<unsigned long>	set;
+
+	set const	a(big.begin(), big.end());
+	set const	b(small.begin(), small.end());
+	double		start;
+
+	{
+		set	c(a);
+
+		start = bench::now();
+		c.insert(b.begin(), b.end());
+		bench::report("std::set insert", small.size(),
+			bench::now() - start);
+	}
+	{
+		set	c;
+
+		start = bench::now();
+		std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+			std::inserter(c, c.end()));
+		bench::report("std::set_union", small.size(),
+			bench::now() - start);
+	}
+	{
+		set	c(a);
+
+		start = bench::now();
+		for (set::const_iterator i = b.begin(); i != b.end(); ++i)
+			c.erase(*i);
+		bench::report("std::set erase", small.size(),
+			bench::now() - start);
+	}
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const			n = bench::arg(ac, av, 1, 1000000);
+	unsigned long				seed = 88172645463325252UL;
+	ft::vector<unsigned long>	big;
+	ft::vector<unsigned long>	small;
+
+	fill(big, n, seed);
+	for (unsigned long m = n; m >= 10; m /= 10)
+	{
+		fill(small, m, seed);
+		std::printf("%lu and %lu keys\n", n, m);
+		run_ft(big, small);
+		run_std(big, small);
+	}
+	return 0;
+}
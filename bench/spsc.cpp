@@ -0,0 +1,277 @@
+#include <queue.hpp>
+
+#include <pthread.h>
+
+#include "bench.hpp"
+
+/// Number of elements moved per push_n/pop_n in the batched runs.
+static unsigned long const	batch = 64;
+
+struct	options
+{
+	unsigned long	count;
+	unsigned long	batch;
+};
+
+template<typename Q>
+struct	context
+{
+	Q*				q;
+	options			opt;
+	unsigned long	sum;
+};
+
+/**
+ * Producer side: push the values 1 to count, spinning while the queue is
+ * full.
+ */
+static void*	produce_spsc(void* arg)
+{
+	context<ft::spsc_queue<unsigned long> >&	ctx
+		= *static_cast<context<ft::spsc_queue<unsigned long> >*>(arg);
+	unsigned long								buf[batch];
+
+	bench::pin(1);
+	for (unsigned long i = 1; i <= ctx.opt.count;)
+	{
+		if (ctx.opt.batch == 1)
+		{
+			while (!ctx.q->try_push(i))
+				ft::cpu_relax();
+			++i;
+			continue;
+		}
+
+		unsigned long	n = ft::min(ctx.opt.batch, ctx.opt.count - i + 1);
+
+		for (unsigned long j = 0; j < n; ++j)
+			buf[j] = i + j;
+		for (unsigned long done = 0; done < n;)
+		{
+			unsigned long const	pushed = ctx.q->push_n(buf + done, n - done);
+
+			if (!pushed)
+				ft::cpu_relax();
+			done += pushed;
+		}
+		i += n;
+	}
+	return 0;
+}
+
+/**
+ * Move count values from a producer thread to this one, and check they all
+ * arrived.
+ */
+static double	throughput_spsc(unsigned long count, unsigned long n,
+	unsigned long capacity)
+{
+	ft::spsc_queue<unsigned long>					q(capacity);
+	context<ft::spsc_queue<unsigned long> >			ctx;
+	pthread_t										producer;
+	unsigned long									buf[batch];
+	unsigned long									received = 0;
+
+	ctx.q = &q;
+	ctx.opt.count = count;
+	ctx.opt.batch = n;
+	ctx.sum = 0;
+	bench::pin(0);
+
+	double const	start = bench::now();
+
+	pthread_create(&producer, 0, produce_spsc, &ctx);
+	while (received < count)
+	{
+		if (n == 1)
+		{
+			unsigned long	x;
+
+			if (q.try_pop(x))
+			{
+				ctx.sum += x;
+				++received;
+			}
+			else
+				ft::cpu_relax();
+			continue;
+		}
+
+		unsigned long const	popped = q.pop_n(buf, n);
+
+		if (!popped)
+			ft::cpu_relax();
+		for (unsigned long j = 0; j < popped; ++j)
+			ctx.sum += buf[j];
+		received += popped;
+	}
+	pthread_join(producer, 0);
+
+	double const	seconds = bench::now() - start;
+
+	if (ctx.sum != count * (count + 1) / 2)
+		std::printf("checksum mismatch!\n");
+	return seconds;
+}
+
+/// The baseline: a circular_buffer protected by a mutex.
+struct	locked_queue
+{
+	pthread_mutex_t						lock;
+	ft::circular_buffer<unsigned long>	buf;
+
+	explicit locked_queue(unsigned long capacity)	:	buf(capacity)
+	{ pthread_mutex_init(&lock, 0); }
+
+	~locked_queue()
+	{ pthread_mutex_destroy(&lock); }
+
+	bool	try_push(unsigned long x)
+	{
+		pthread_mutex_lock(&lock);
+
+		bool const	pushed = buf.push_back(x);
+
+		pthread_mutex_unlock(&lock);
+		return pushed;
+	}
+
+	bool	try_pop(unsigned long& x)
+	{
+		pthread_mutex_lock(&lock);
+
+		bool const	popped = buf.pop_n(&x, 1);
+
+		pthread_mutex_unlock(&lock);
+		return popped;
+	}
+};
+
+static void*	produce_locked(void* arg)
+{
+	context<locked_queue>&	ctx = *static_cast<context<locked_queue>*>(arg);
+
+	bench::pin(1);
+	for (unsigned long i = 1; i <= ctx.opt.count; ++i)
+		while (!ctx.q->try_push(i))
+			ft::cpu_relax();
+	return 0;
+}
+
+static double	throughput_locked(unsigned long count, unsigned long capacity)
+{
+	locked_queue			q(capacity);
+	context<locked_queue>	ctx;
+	pthread_t				producer;
+	unsigned long			received = 0;
+
+	ctx.q = &q;
+	ctx.opt.count = count;
+	ctx.opt.batch = 1;
+	ctx.sum = 0;
+	bench::pin(0);
+
+	double const	start = bench::now();
+
+	pthread_create(&producer, 0, produce_locked, &ctx);
+	while (received < count)
+	{
+		unsigned long	x;
+
+		if (q.try_pop(x))
+		{
+			ctx.sum += x;
+			++received;
+		}
+		else
+			ft::cpu_relax();
+	}
+	pthread_join(producer, 0);
+
+	double const	seconds = bench::now() - start;
+
+	if (ctx.sum != count * (count + 1) / 2)
+		std::printf("checksum mismatch!\n");
+	return seconds;
+}
+
+struct	ping_pong
+{
+	ft::spsc_queue<unsigned long>	ping;
+	ft::spsc_queue<unsigned long>	pong;
+	unsigned long					rounds;
+
+	explicit ping_pong(unsigned long n)	:	ping(64), pong(64), rounds(n) { }
+};
+
+/// Echo every value received on ping back on pong.
+static void*	echo(void* arg)
+{
+	ping_pong&	pp = *static_cast<ping_pong*>(arg);
+
+	bench::pin(1);
+	for (unsigned long i = 0; i < pp.rounds; ++i)
+	{
+		unsigned long	x;
+
+		while (!pp.ping.try_pop(x))
+			ft::cpu_relax();
+		pp.pong.try_push(x);
+	}
+	return 0;
+}
+
+/**
+ * Bounce one value between two threads through a pair of queues, and
+ * return the time of a round trip.
+ */
+static double	latency(unsigned long rounds)
+{
+	ping_pong	pp(rounds);
+	pthread_t	peer;
+
+	bench::pin(0);
+	pthread_create(&peer, 0, echo, &pp);
+
+	double const	start = bench::now();
+
+	for (unsigned long i = 0; i < rounds; ++i)
+	{
+		unsigned long	x;
+
+		pp.ping.try_push(i);
+		while (!pp.pong.try_pop(x))
+			ft::cpu_relax();
+	}
+
+	double const	seconds = bench::now() - start;
+
+	pthread_join(peer, 0);
+	return seconds;
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const	count = bench::arg(ac, av, 1, 50000000UL);
+	unsigned long const	capacity = bench::arg(ac, av, 2, 4096);
+	unsigned long const	rounds = bench::arg(ac, av, 3, 1000000UL);
+
+	double const	single = throughput_spsc(count, 1, capacity);
+	bench::report("spsc_queue try_push/try_pop", count, single);
+
+	double const	batched = throughput_spsc(count, batch, capacity);
+	bench::report("spsc_queue push_n/pop_n (64)", count, batched);
+
+	unsigned long const	locked_count = count / 10;
+	double const		locked = throughput_locked(locked_count, capacity);
+	bench::report("mutex + circular_buffer", locked_count, locked);
+
+	std::printf("spsc speedup over mutex: %.2fx, with batches: %.2fx\n",
+		locked / double(locked_count) / (single / double(count)),
+		locked / double(locked_count) / (batched / double(count)));
+
+	double const	rtt = latency(rounds);
+	bench::report("spsc_queue round trip", rounds, rtt);
+	std::printf("one-way latency: %.1f ns\n", rtt * 1e9 / double(rounds) / 2);
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <tr1/unordered_map>
+
+#include <map.hpp>
+#include <unordered_map.hpp>
+#include <vector.hpp>
+
+#include "bench.hpp"
+
+static unsigned long	next(unsigned long& seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+/**
+ * Insert n random keys, look each of them up, look up as many keys that
+ * are not in the map, and erase them all, timing each phase.
+ */
+template<typename Map>
+static void	run(char const* name, ft::vector<unsigned long> const& keys,
+	ft::vector<unsigned long> const& missing)
+{
+	unsigned long const	n = keys.size();
+	Map					m;
+	unsigned long		sum = 0;
+	char				label[64];
+	double				start;
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		m[keys[i]] = i;
+	std::snprintf(label, sizeof(label), "%s insert", name);
+	bench::report(label, n, bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = n; i-- > 0;)
+		sum += m.find(keys[i])->second;
+	std::snprintf(label, sizeof(label), "%s find hit", name);
+	bench::report(label, n, bench::now() - start);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		sum += m.find(missing[i]) == m.end();
+	std::snprintf(label, sizeof(label), "%s find miss", name);
+	bench::report(label, n, bench::now() - start);
+	bench::keep(sum);
+
+	start = bench::now();
+	for (unsigned long i = 0; i < n; ++i)
+		m.erase(keys[i]);
+	std::snprintf(label, sizeof(label), "%s erase", name);
+	bench::report(label, n, bench::now() - start);
+}
+
+int	main(int ac, char** av)
+{
+	unsigned long const			n = bench::arg(ac, av, 1, 1000000);
+	unsigned long				seed = 88172645463325252UL;
+	ft::vector<unsigned long>	keys;
+	ft::vector<unsigned long>	missing;
+
+	// Even keys are in the map, odd ones are not.
+	for (unsigned long i = 0; i < n; ++i)
+	{
+		keys.push_back(next(seed) & ~1UL);
+		missing.push_back(next(seed) | 1UL);
+	}
+	run<ft::unordered_map<unsigned long, unsigned long> >(
+		"ft::unordered_map", keys, missing);
+	run<std::tr1::unordered_map<unsigned long, unsigned long> >(
+		"std::tr1::unordered_map", keys, missing);
+	run<ft::map<unsigned long, unsigned long> >("ft::map", keys, missing);
+	return 0;
+}
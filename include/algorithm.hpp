@@ -0,0 +1,558 @@
+#pragma once
+
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+
+namespace ft
+{
+	template<typename T>
+	inline T const&	min(T const& a, T const& b)
+	{ return b < a ? b : a; }
+
+	template<typename T>
+	inline T const&	max(T const& a, T const& b)
+	{ return a < b ? b : a; }
+
+	/**
+	 * @brief Apply a function to every element of a range.
+	 *
+	 * @return F	The function object, after it has been applied.
+	 */
+	template<typename I, typename F>
+	F	for_each(I first, I last, F f)
+	{
+		for (; first != last; ++first)
+			f(*first);
+		return f;
+	}
+
+	/**
+	 * @brief Find the first element of a range that is equal to value.
+	 *
+	 * @return I	The element's iterator, or last if there is none.
+	 */
+	template<typename I, typename T>
+	I	find(I first, I last, T const& value)
+	{
+		while (first != last && !(*first == value))
+			++first;
+		return first;
+	}
+
+	/**
+	 * @brief Find the first element of a range that satisfies pred.
+	 *
+	 * @return I	The element's iterator, or last if there is none.
+	 */
+	template<typename I, typename Predicate>
+	I	find_if(I first, I last, Predicate pred)
+	{
+		while (first != last && !pred(*first))
+			++first;
+		return first;
+	}
+
+	/**
+	 * @brief Count the elements of a range that are equal to value.
+	 */
+	template<typename I, typename T>
+	typename iterator_traits<I>::difference_type
+		count(I first, I last, T const& value)
+	{
+		typename iterator_traits<I>::difference_type	n = 0;
+
+		for (; first != last; ++first)
+			if (*first == value)
+				++n;
+		return n;
+	}
+
+	/**
+	 * @brief Count the elements of a range that satisfy pred.
+	 */
+	template<typename I, typename Predicate>
+	typename iterator_traits<I>::difference_type
+		count_if(I first, I last, Predicate pred)
+	{
+		typename iterator_traits<I>::difference_type	n = 0;
+
+		for (; first != last; ++first)
+			if (pred(*first))
+				++n;
+		return n;
+	}
+
+	/**
+	 * @brief Assign value to every element of a range.
+	 */
+	template<typename F, typename T>
+	void	fill(F first, F last, T const& value)
+	{
+		for (; first != last; ++first)
+			*first = value;
+	}
+
+	/**
+	 * @brief Assign value to the n first elements of a range.
+	 *
+	 * @return O	An iterator past the last assigned element.
+	 */
+	template<typename O, typename Size, typename T>
+	O	fill_n(O first, Size n, T const& value)
+	{
+		for (; n > 0; --n, ++first)
+			*first = value;
+		return first;
+	}
+
+	/**
+	 * @brief Copy a range to the range beginning at result.
+	 *
+	 * The ranges may overlap if result is not inside [first, last).
+	 *
+	 * @return O	An iterator past the last copied element.
+	 */
+	template<typename I, typename O>
+	O	copy(I first, I last, O result)
+	{
+		for (; first != last; ++first, ++result)
+			*result = *first;
+		return result;
+	}
+
+	/**
+	 * @brief Copy a range to the range ending at result, starting from the
+	 * last element.
+	 *
+	 * The ranges may overlap if result is not inside (first, last].
+	 *
+	 * @return B	An iterator to the last copied element.
+	 */
+	template<typename Bi, typename Bo>
+	Bo	copy_backward(Bi first, Bi last, Bo result)
+	{
+		while (first != last)
+			*--result = *--last;
+		return result;
+	}
+
+	/**
+	 * @brief Tests a range for element-wise equality with the range beginning
+	 * at first2.
+	 */
+	template<typename I1, typename I2>
+	bool	equal(I1 first1, I1 last1, I2 first2)
+	{
+		for (; first1 != last1; ++first1, ++first2)
+			if (!(*first1 == *first2))
+				return false;
+		return true;
+	}
+
+	template<typename I1, typename I2, typename BinaryPredicate>
+	bool	equal(I1 first1, I1 last1, I2 first2, BinaryPredicate pred)
+	{
+		for (; first1 != last1; ++first1, ++first2)
+			if (!pred(*first1, *first2))
+				return false;
+		return true;
+	}
+
+	/**
+	 * @brief Tests whether the first range compares lexicographically less
+	 * than the second one.
+	 */
+	template<typename I1, typename I2>
+	bool	lexicographical_compare(I1 first1, I1 last1, I2 first2, I2 last2)
+	{
+		for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+		{
+			if (*first1 < *first2)
+				return true;
+			if (*first2 < *first1)
+				return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
+	template<typename I1, typename I2, typename Compare>
+	bool	lexicographical_compare(I1 first1, I1 last1, I2 first2, I2 last2,
+		Compare cmp)
+	{
+		for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+		{
+			if (cmp(*first1, *first2))
+				return true;
+			if (cmp(*first2, *first1))
+				return false;
+		}
+		return first1 == last1 && first2 != last2;
+	}
+
+	/**
+	 * @brief Swaps the values two iterators point to.
+	 */
+	template<typename I1, typename I2>
+	inline void	iter_swap(I1 a, I2 b)
+	{ ft::swap(*a, *b); }
+
+	namespace detail
+	{
+		/**
+		 * @brief Move value up from hole towards top, in the binary heap
+		 * that begins at first.
+		 */
+		template<typename R, typename Distance, typename T, typename Compare>
+		void	_push_heap(R first, Distance hole, Distance top, T value,
+			Compare cmp)
+		{
+			Distance	parent = (hole - 1) / 2;
+
+			while (hole > top && cmp(first[parent], value))
+			{
+				first[hole] = first[parent];
+				hole = parent;
+				parent = (hole - 1) / 2;
+			}
+			first[hole] = value;
+		}
+
+		/**
+		 * @brief Fill the hole by moving its larger child up until it
+		 * reaches a leaf, then push value back up from there.
+		 */
+		template<typename R, typename Distance, typename T, typename Compare>
+		void	_adjust_heap(R first, Distance hole, Distance len, T value,
+			Compare cmp)
+		{
+			Distance const	top = hole;
+			Distance		child = hole;
+
+			while (child < (len - 1) / 2)
+			{
+				child = 2 * (child + 1);
+				if (cmp(first[child], first[child - 1]))
+					--child;
+				first[hole] = first[child];
+				hole = child;
+			}
+			if ((len & 1) == 0 && child == (len - 2) / 2)
+			{
+				child = 2 * (child + 1);
+				first[hole] = first[child - 1];
+				hole = child - 1;
+			}
+			_push_heap(first, hole, top, value, cmp);
+		}
+	}
+
+	/**
+	 * @brief Push the last element of a range into the heap formed by the
+	 * elements before it.
+	 */
+	template<typename R, typename Compare>
+	void	push_heap(R first, R last, Compare cmp)
+	{
+		typedef typename iterator_traits<R>::difference_type	Distance;
+		typedef typename iterator_traits<R>::value_type			T;
+
+		T	value = *(last - 1);
+
+		detail::_push_heap(first, Distance(last - first - 1), Distance(0),
+			value, cmp);
+	}
+
+	template<typename R>
+	void	push_heap(R first, R last)
+	{
+		ft::push_heap(first, last,
+			less<typename iterator_traits<R>::value_type>());
+	}
+
+	/**
+	 * @brief Move the largest element of a heap to the end of the range,
+	 * and make a heap of the remaining elements.
+	 */
+	template<typename R, typename Compare>
+	void	pop_heap(R first, R last, Compare cmp)
+	{
+		typedef typename iterator_traits<R>::difference_type	Distance;
+		typedef typename iterator_traits<R>::value_type			T;
+
+		if (last - first < 2)
+			return;
+
+		T	value = *--last;
+
+		*last = *first;
+		detail::_adjust_heap(first, Distance(0), Distance(last - first),
+			value, cmp);
+	}
+
+	template<typename R>
+	void	pop_heap(R first, R last)
+	{
+		ft::pop_heap(first, last,
+			less<typename iterator_traits<R>::value_type>());
+	}
+
+	/**
+	 * @brief Rearrange a range into a heap, in linear time.
+	 */
+	template<typename R, typename Compare>
+	void	make_heap(R first, R last, Compare cmp)
+	{
+		typedef typename iterator_traits<R>::difference_type	Distance;
+		typedef typename iterator_traits<R>::value_type			T;
+
+		Distance const	len = last - first;
+
+		if (len < 2)
+			return;
+		for (Distance parent = (len - 2) / 2; ; --parent)
+		{
+			T	value = first[parent];
+
+			detail::_adjust_heap(first, parent, len, value, cmp);
+			if (parent == 0)
+				return;
+		}
+	}
+
+	template<typename R>
+	void	make_heap(R first, R last)
+	{
+		ft::make_heap(first, last,
+			less<typename iterator_traits<R>::value_type>());
+	}
+
+	/**
+	 * @brief Sort a heap in ascending order.
+	 */
+	template<typename R, typename Compare>
+	void	sort_heap(R first, R last, Compare cmp)
+	{
+		for (; last - first > 1; --last)
+			ft::pop_heap(first, last, cmp);
+	}
+
+	template<typename R>
+	void	sort_heap(R first, R last)
+	{
+		ft::sort_heap(first, last,
+			less<typename iterator_traits<R>::value_type>());
+	}
+
+	namespace detail
+	{
+		/// Ranges at most this long are left for the final insertion sort.
+		enum { _sort_threshold = 16 };
+
+		template<typename R, typename Compare>
+		void	_insertion_sort(R first, R last, Compare cmp)
+		{
+			typedef typename iterator_traits<R>::value_type	T;
+
+			if (first == last)
+				return;
+			for (R i = first + 1; i != last; ++i)
+			{
+				T	value = *i;
+				R	hole = i;
+
+				if (cmp(value, *first))
+				{
+					ft::copy_backward(first, i, i + 1);
+					*first = value;
+					continue;
+				}
+				for (R prev = i - 1; cmp(value, *prev); --prev)
+				{
+					*hole = *prev;
+					hole = prev;
+				}
+				*hole = value;
+			}
+		}
+
+		/**
+		 * @brief Move the median of a, b and c to result.
+		 */
+		template<typename R, typename Compare>
+		void	_move_median_to_first(R result, R a, R b, R c, Compare cmp)
+		{
+			if (cmp(*a, *b))
+			{
+				if (cmp(*b, *c))
+					ft::iter_swap(result, b);
+				else if (cmp(*a, *c))
+					ft::iter_swap(result, c);
+				else
+					ft::iter_swap(result, a);
+			}
+			else if (cmp(*a, *c))
+				ft::iter_swap(result, a);
+			else if (cmp(*b, *c))
+				ft::iter_swap(result, c);
+			else
+				ft::iter_swap(result, b);
+		}
+
+		/**
+		 * @brief Hoare partition of [first, last) around *pivot, which
+		 * must be outside the range and bound it on both sides.
+		 */
+		template<typename R, typename Compare>
+		R	_unguarded_partition(R first, R last, R pivot, Compare cmp)
+		{
+			for (;;)
+			{
+				while (cmp(*first, *pivot))
+					++first;
+				--last;
+				while (cmp(*pivot, *last))
+					--last;
+				if (!(first < last))
+					return first;
+				ft::iter_swap(first, last);
+				++first;
+			}
+		}
+
+		/**
+		 * @brief Partition a range of at least 3 elements around the
+		 * median of its first, middle and last elements.
+		 *
+		 * @return R	The first element of the upper part, which is never
+		 * first.
+		 */
+		template<typename R, typename Compare>
+		R	_partition_pivot(R first, R last, Compare cmp)
+		{
+			R const	mid = first + (last - first) / 2;
+
+			_move_median_to_first(first, first + 1, mid, last - 1, cmp);
+			return _unguarded_partition(first + 1, last, first, cmp);
+		}
+
+		template<typename Size>
+		inline Size	_lg(Size n)
+		{
+			Size	k = 0;
+
+			for (; n > 1; n >>= 1)
+				++k;
+			return k;
+		}
+
+		/**
+		 * @brief Quicksort down to _sort_threshold elements, switching to
+		 * heapsort for the parts that recurse deeper than depth.
+		 */
+		template<typename R, typename Size, typename Compare>
+		void	_introsort_loop(R first, R last, Size depth, Compare cmp)
+		{
+			while (last - first > _sort_threshold)
+			{
+				if (depth == 0)
+				{
+					ft::make_heap(first, last, cmp);
+					ft::sort_heap(first, last, cmp);
+					return;
+				}
+				--depth;
+
+				R const	cut = _partition_pivot(first, last, cmp);
+
+				_introsort_loop(cut, last, depth, cmp);
+				last = cut;
+			}
+		}
+	}
+
+	/**
+	 * @brief Sort a random access range with introsort, in O(n log n) in
+	 * the worst case. The sort is not stable.
+	 */
+	template<typename R, typename Compare>
+	void	sort(R first, R last, Compare cmp)
+	{
+		if (last - first < 2)
+			return;
+		detail::_introsort_loop(first, last, 2 * detail::_lg(last - first),
+			cmp);
+		detail::_insertion_sort(first, last, cmp);
+	}
+
+	template<typename R>
+	void	sort(R first, R last)
+	{
+		ft::sort(first, last,
+			less<typename iterator_traits<R>::value_type>());
+	}
+
+	/**
+	 * @brief Returns the first element of a sorted range that is not less
+	 * than value, with O(log n) comparisons.
+	 */
+	template<typename F, typename T, typename Compare>
+	F	lower_bound(F first, F last, T const& value, Compare cmp)
+	{
+		typedef typename iterator_traits<F>::difference_type	Distance;
+
+		Distance	len = ft::distance(first, last);
+
+		while (len > 0)
+		{
+			Distance const	half = len / 2;
+			F				mid = first;
+
+			ft::advance(mid, half);
+			if (cmp(*mid, value))
+			{
+				first = ++mid;
+				len -= half + 1;
+			}
+			else
+				len = half;
+		}
+		return first;
+	}
+
+	template<typename F, typename T>
+	F	lower_bound(F first, F last, T const& value)
+	{ return ft::lower_bound(first, last, value, less<T>()); }
+
+	/**
+	 * @brief Returns the first element of a sorted range that is greater
+	 * than value, with O(log n) comparisons.
+	 */
+	template<typename F, typename T, typename Compare>
+	F	upper_bound(F first, F last, T const& value, Compare cmp)
+	{
+		typedef typename iterator_traits<F>::difference_type	Distance;
+
+		Distance	len = ft::distance(first, last);
+
+		while (len > 0)
+		{
+			Distance const	half = len / 2;
+			F				mid = first;
+
+			ft::advance(mid, half);
+			if (cmp(value, *mid))
+				len = half;
+			else
+			{
+				first = ++mid;
+				len -= half + 1;
+			}
+		}
+		return first;
+	}
+
+	template<typename F, typename T>
+	F	upper_bound(F first, F last, T const& value)
+	{ return ft::upper_bound(first, last, value, less<T>()); }
+}
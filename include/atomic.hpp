@@ -0,0 +1,313 @@
+#pragma once
+
+#include <cstddef>
+#include <climits>
+
+#include <sched.h>
+
+#ifdef __linux__
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+namespace ft
+{
+	/// Size of a cache line on the targets we care about.
+	enum { cache_line_size = 64 };
+
+	/**
+	 * @brief Ordering constraints of atomic operations, with the meaning of
+	 * their C++11 counterparts.
+	 */
+	enum	memory_order
+	{
+		memory_order_relaxed = __ATOMIC_RELAXED,
+		memory_order_consume = __ATOMIC_CONSUME,
+		memory_order_acquire = __ATOMIC_ACQUIRE,
+		memory_order_release = __ATOMIC_RELEASE,
+		memory_order_acq_rel = __ATOMIC_ACQ_REL,
+		memory_order_seq_cst = __ATOMIC_SEQ_CST
+	};
+
+	/**
+	 * @brief Issue a memory fence of the given order.
+	 */
+	inline void	atomic_thread_fence(memory_order order) throw()
+	{ __atomic_thread_fence(order); }
+
+	/**
+	 * @brief Keep the compiler from reordering memory accesses across this
+	 * point, without emitting a fence.
+	 */
+	inline void	atomic_signal_fence(memory_order order) throw()
+	{ __atomic_signal_fence(order); }
+
+	/**
+	 * @brief Hint the processor that the caller is spinning.
+	 */
+	inline void	cpu_relax() throw()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__("yield" ::: "memory");
+#else
+		__atomic_signal_fence(__ATOMIC_SEQ_CST);
+#endif
+	}
+
+	/**
+	 * @brief An integral or pointer value that is accessed atomically,
+	 * implemented with the GCC/Clang __atomic builtins.
+	 *
+	 * @tparam T	An integral or pointer type of at most the machine word
+	 * size, so that it is lock-free.
+	 */
+	template<typename T>
+	class	atomic
+	{
+	private:
+		T	value;
+
+		atomic(atomic const&);
+		atomic&	operator=(atomic const&);
+
+	public:
+		typedef	T	value_type;
+
+		atomic() throw()	:	value() { }
+
+		explicit atomic(T x) throw()	:	value(x) { }
+
+		T		load(memory_order order = memory_order_seq_cst) const throw()
+		{ return __atomic_load_n(&value, order); }
+
+		void	store(T x, memory_order order = memory_order_seq_cst) throw()
+		{ __atomic_store_n(&value, x, order); }
+
+		/**
+		 * @brief Replace the value with x.
+		 *
+		 * @return T	The previous value.
+		 */
+		T		exchange(T x, memory_order order = memory_order_seq_cst)
+			throw()
+		{ return __atomic_exchange_n(&value, x, order); }
+
+		/**
+		 * @brief Replace the value with x if it is equal to expected, and
+		 * load the current value into expected otherwise.
+		 *
+		 * @return bool	true if the value was replaced.
+		 */
+		bool	compare_exchange_strong(T& expected, T x,
+			memory_order success = memory_order_seq_cst,
+			memory_order failure = memory_order_seq_cst) throw()
+		{
+			return __atomic_compare_exchange_n(&value, &expected, x, false,
+				success, failure);
+		}
+
+		/**
+		 * @brief Like compare_exchange_strong, but may fail spuriously,
+		 * which is cheaper on LL/SC architectures when called in a loop.
+		 */
+		bool	compare_exchange_weak(T& expected, T x,
+			memory_order success = memory_order_seq_cst,
+			memory_order failure = memory_order_seq_cst) throw()
+		{
+			return __atomic_compare_exchange_n(&value, &expected, x, true,
+				success, failure);
+		}
+
+		/**
+		 * @brief Add n to an integral value.
+		 *
+		 * @return T	The previous value.
+		 */
+		T		fetch_add(T n, memory_order order = memory_order_seq_cst)
+			throw()
+		{ return __atomic_fetch_add(&value, n, order); }
+
+		T		fetch_sub(T n, memory_order order = memory_order_seq_cst)
+			throw()
+		{ return __atomic_fetch_sub(&value, n, order); }
+
+		T		fetch_and(T x, memory_order order = memory_order_seq_cst)
+			throw()
+		{ return __atomic_fetch_and(&value, x, order); }
+
+		T		fetch_or(T x, memory_order order = memory_order_seq_cst)
+			throw()
+		{ return __atomic_fetch_or(&value, x, order); }
+
+		/**
+		 * @brief Returns the address of the value, for system calls that
+		 * wait on it.
+		 */
+		T*		address() throw()
+		{ return &value; }
+	};
+
+	/**
+	 * @brief Block the calling thread while *addr is equal to expected, or
+	 * until it is woken by _futex_wake. May return spuriously.
+	 */
+	inline void	_futex_wait(int* addr, int expected) throw()
+	{
+#ifdef __linux__
+		::syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, 0, 0, 0);
+#else
+		if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) == expected)
+			::sched_yield();
+#endif
+	}
+
+	/**
+	 * @brief Wake up to n threads blocked in _futex_wait on addr.
+	 */
+	inline void	_futex_wake(int* addr, int n) throw()
+	{
+#ifdef __linux__
+		::syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, n, 0, 0, 0);
+#else
+		(void)addr;
+		(void)n;
+#endif
+	}
+
+	/**
+	 * @brief Lets threads sleep until a condition they poll without locks
+	 * may have changed.
+	 *
+	 * A waiter calls prepare_wait(), checks its condition again, and then
+	 * either cancel_wait() or wait() with the returned key. A notifier
+	 * makes its change visible and calls notify_one() or notify_all(),
+	 * which cost a single load when nobody is waiting.
+	 */
+	class	event_count
+	{
+	private:
+		atomic<int>	key;
+		atomic<int>	waiters;
+
+		event_count(event_count const&);
+		event_count&	operator=(event_count const&);
+
+	public:
+		event_count() throw()	:	key(0), waiters(0) { }
+
+		int		prepare_wait() throw()
+		{
+			int const	k = key.load(memory_order_acquire);
+
+			waiters.fetch_add(1, memory_order_seq_cst);
+			atomic_thread_fence(memory_order_seq_cst);
+			return k;
+		}
+
+		void	cancel_wait() throw()
+		{ waiters.fetch_sub(1, memory_order_relaxed); }
+
+		/**
+		 * @brief Sleep unless a notification happened since prepare_wait()
+		 * returned k.
+		 */
+		void	wait(int k) throw()
+		{
+			_futex_wait(key.address(), k);
+			waiters.fetch_sub(1, memory_order_relaxed);
+		}
+
+		void	notify_one() throw()
+		{ notify(1); }
+
+		void	notify_all() throw()
+		{ notify(INT_MAX); }
+
+	private:
+		void	notify(int n) throw()
+		{
+			atomic_thread_fence(memory_order_seq_cst);
+			if (waiters.load(memory_order_relaxed) == 0)
+				return;
+			key.fetch_add(1, memory_order_release);
+			_futex_wake(key.address(), n);
+		}
+	};
+
+	/**
+	 * @brief A reader-writer lock that spins, for critical sections of a
+	 * few hundred cycles, where sleeping would cost more than waiting.
+	 *
+	 * A waiting writer sets a pending bit that keeps new readers out, so
+	 * that a steady stream of readers cannot starve it. Waiters yield the
+	 * processor after spinning a while, so that a holder that was
+	 * preempted gets to run.
+	 */
+	class	rw_spinlock
+	{
+	private:
+		enum
+		{
+			writer = 1,
+			pending = 2,
+			reader = 4,
+			spin_limit = 64
+		};
+
+		atomic<unsigned>	state;
+
+		rw_spinlock(rw_spinlock const&);
+		rw_spinlock&	operator=(rw_spinlock const&);
+
+		static void	backoff(unsigned& spins) throw()
+		{
+			if (++spins < spin_limit)
+				cpu_relax();
+			else
+			{
+				::sched_yield();
+				spins = 0;
+			}
+		}
+
+	public:
+		rw_spinlock() throw()	:	state(0) { }
+
+		void	lock() throw()
+		{
+			for (unsigned spins = 0;; backoff(spins))
+			{
+				unsigned	s = state.load(memory_order_relaxed);
+
+				if ((s & ~unsigned(pending)) == 0
+					&& state.compare_exchange_weak(s, writer,
+						memory_order_acquire, memory_order_relaxed))
+					return;
+				if (!(s & pending))
+					state.fetch_or(pending, memory_order_relaxed);
+			}
+		}
+
+		void	unlock() throw()
+		{ state.fetch_sub(writer, memory_order_release); }
+
+		void	lock_shared() throw()
+		{
+			for (unsigned spins = 0;; backoff(spins))
+			{
+				unsigned	s = state.load(memory_order_relaxed);
+
+				if (!(s & (writer | pending))
+					&& state.compare_exchange_weak(s, s + reader,
+						memory_order_acquire, memory_order_relaxed))
+					return;
+			}
+		}
+
+		void	unlock_shared() throw()
+		{ state.fetch_sub(reader, memory_order_release); }
+	};
+}
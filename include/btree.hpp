@@ -0,0 +1,955 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <type_traits.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief Tells whether a value can be moved between node slots with
+	 * memmove. Pairs with a const key qualify when both members do, even
+	 * though the const member makes them not assignable.
+	 */
+	template<typename V>
+	struct	_btree_relocatable	:	public is_trivially_copyable<V> { };
+
+	template<typename K, typename T>
+	struct	_btree_relocatable<pair<K const, T> >
+		:	public integral_constant<bool, is_trivially_copyable<K>::value
+			&& is_trivially_copyable<T>::value> { };
+
+	struct	_btree_node_header
+	{
+		void*			parent;
+		unsigned short	position;
+		unsigned short	count;
+		bool			leaf;
+	};
+
+	template<typename V, size_t NodeBytes>
+	struct	_btree_internal_node;
+
+	/**
+	 * @brief A B-tree node, holding a sorted array of values. Internal
+	 * nodes are followed by their children.
+	 *
+	 * @tparam V			The value type.
+	 * @tparam NodeBytes	The target size of a leaf, that sets how many
+	 * values a node holds.
+	 */
+	template<typename V, size_t NodeBytes>
+	struct	_btree_node
+	{
+		enum { capacity = NodeBytes > sizeof(_btree_node_header)
+			+ 3 * sizeof(V)
+			? (NodeBytes - sizeof(_btree_node_header)) / sizeof(V) : 3 };
+
+		_btree_node*	parent;
+		/// Index of this node among its parent's children.
+		unsigned short	position;
+		unsigned short	count;
+		bool			leaf;
+		char			storage[capacity * sizeof(V)]
+			__attribute__((aligned(__alignof__(V))));
+
+		V*				slot(size_t i) throw()
+		{ return reinterpret_cast<V*>(storage) + i; }
+
+		V const*		slot(size_t i) const throw()
+		{ return reinterpret_cast<V const*>(storage) + i; }
+
+		_btree_node*&	child(size_t i) throw()
+		{
+			return static_cast<_btree_internal_node<V, NodeBytes>*>(this)
+				->children[i];
+		}
+	};
+
+	template<typename V, size_t NodeBytes>
+	struct	_btree_internal_node	:	public _btree_node<V, NodeBytes>
+	{
+		_btree_node<V, NodeBytes>*
+			children[_btree_node<V, NodeBytes>::capacity + 1];
+	};
+
+	/**
+	 * @brief A _btree::iterator, that designates a slot of a node.
+	 *
+	 * The end iterator is one past the last slot of the rightmost leaf.
+	 */
+	template<typename V, size_t NodeBytes, typename Ref, typename Ptr>
+	struct	_btree_iterator
+	{
+		typedef	_btree_iterator<V, NodeBytes, V&, V*>	iterator;
+		typedef	_btree_iterator<V, NodeBytes, V const&, V const*>
+			const_iterator;
+		typedef	_btree_iterator							_self;
+		typedef	_btree_node<V, NodeBytes>				node_type;
+
+		typedef	bidirectional_iterator_tag	iterator_category;
+		typedef	V							value_type;
+		typedef	Ptr							pointer;
+		typedef	Ref							reference;
+		typedef	ptrdiff_t					difference_type;
+
+		node_type*	node;
+		int			position;
+
+		_btree_iterator() throw()
+			:	node(), position(0) { }
+
+		_btree_iterator(node_type* n, int p) throw()
+			:	node(n), position(p) { }
+
+		_btree_iterator(iterator const& x) throw()
+			:	node(x.node), position(x.position) { }
+
+		iterator	_const_cast() const throw()
+		{ return iterator(node, position); }
+
+		reference	operator*() const throw()
+		{ return *node->slot(position); }
+
+		pointer		operator->() const throw()
+		{ return node->slot(position); }
+
+		_self&		operator++() throw()
+		{
+			if (!node->leaf || ++position == node->count)
+				increment_slow();
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_self&		operator--() throw()
+		{
+			if (!node->leaf || --position < 0)
+				decrement_slow();
+			return *this;
+		}
+
+		_self		operator--(int) throw()
+		{
+			_self	tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+	private:
+		void	increment_slow() throw()
+		{
+			if (node->leaf)
+			{
+				// Past the end of a leaf: the next value is in the first
+				// ancestor that is not also past its end.
+				node_type*	n = node;
+				int			p = position;
+
+				while (p == n->count && n->parent)
+				{
+					p = n->position;
+					n = n->parent;
+				}
+				if (p < n->count)
+				{
+					node = n;
+					position = p;
+				}
+				return;
+			}
+			node = node->child(position + 1);
+			while (!node->leaf)
+				node = node->child(0);
+			position = 0;
+		}
+
+		void	decrement_slow() throw()
+		{
+			if (node->leaf)
+			{
+				node_type*	n = node;
+				int			p = position;
+
+				while (p < 0 && n->parent)
+				{
+					p = n->position - 1;
+					n = n->parent;
+				}
+				if (p >= 0)
+				{
+					node = n;
+					position = p;
+				}
+				return;
+			}
+			node = node->child(position);
+			while (!node->leaf)
+				node = node->child(node->count);
+			position = node->count - 1;
+		}
+	};
+
+	template<typename V, size_t N, typename Rl, typename Pl, typename Rr,
+		typename Pr>
+	inline bool	operator==(_btree_iterator<V, N, Rl, Pl> const& x,
+		_btree_iterator<V, N, Rr, Pr> const& y) throw()
+	{ return x.node == y.node && x.position == y.position; }
+
+	template<typename V, size_t N, typename Rl, typename Pl, typename Rr,
+		typename Pr>
+	inline bool	operator!=(_btree_iterator<V, N, Rl, Pl> const& x,
+		_btree_iterator<V, N, Rr, Pr> const& y) throw()
+	{ return !(x == y); }
+
+	/**
+	 * @brief A B-tree of unique keys, shared by btree_map and btree_set.
+	 *
+	 * Each node holds a sorted array of up to capacity values, so that a
+	 * search touches one node, usually a few cache lines, per level, and
+	 * the tree is about log_capacity(n) levels deep instead of log2(n).
+	 * A full node is split when a value is inserted into it, keeping all
+	 * the values on the side of an insertion at either end, so that
+	 * sorted input fills nodes. A node that falls under half full after an
+	 * erasure borrows from or merges with a sibling.
+	 *
+	 * Values move between slots on insertion and erasure, so iterators
+	 * are invalidated by both. Moves use memmove when V allows it, and
+	 * copy-construct otherwise, in which case V's copy constructor must
+	 * not throw.
+	 *
+	 * @tparam K			The key type.
+	 * @tparam V			The value type.
+	 * @tparam KeyOfValue	Extracts the key of a value.
+	 * @tparam Compare		The key ordering.
+	 * @tparam NodeBytes	The target size of a leaf.
+	 * @tparam A			The allocator type.
+	 */
+	template<typename K, typename V, typename KeyOfValue, typename Compare,
+		size_t NodeBytes, typename A>
+	class	_btree
+	{
+	private:
+		typedef	_btree_node<V, NodeBytes>			node_type;
+		typedef	_btree_internal_node<V, NodeBytes>	internal_type;
+		typedef	typename _alloc_traits<A>::template rebind<V>::other
+			V_alloc_type;
+		typedef	typename _alloc_traits<A>::template rebind<node_type>::other
+			leaf_alloc_type;
+		typedef	_alloc_traits<leaf_alloc_type>		leaf_alloc_traits;
+		typedef	typename _alloc_traits<A>::template rebind<internal_type>
+			::other									internal_alloc_type;
+		typedef	_alloc_traits<internal_alloc_type>	internal_alloc_traits;
+
+		enum { capacity = node_type::capacity, min_count = capacity / 2 };
+
+		struct	_btree_impl	:	public leaf_alloc_type
+		{
+			Compare		comp;
+			node_type*	root;
+			node_type*	leftmost;
+			node_type*	rightmost;
+			size_t		size;
+
+			_btree_impl(Compare const& c, leaf_alloc_type const& a)
+				:	leaf_alloc_type(a), comp(c), root(), leftmost(),
+					rightmost(), size(0) { }
+		};
+
+		_btree_impl	impl;
+
+	public:
+		typedef	K											key_type;
+		typedef	V											value_type;
+		typedef	size_t										size_type;
+		typedef	ptrdiff_t									difference_type;
+		typedef	A											allocator_type;
+		typedef	_btree_iterator<V, NodeBytes, V&, V*>		iterator;
+		typedef	_btree_iterator<V, NodeBytes, V const&, V const*>
+			const_iterator;
+		typedef	ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef	ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		/// Number of values a node holds.
+		static size_type const	node_capacity = capacity;
+
+		_btree(Compare const& cmp, allocator_type const& a)
+			:	impl(cmp, leaf_alloc_type(a)) { }
+
+		_btree(_btree const& x)
+			:	impl(x.impl.comp, leaf_alloc_traits::select_on_copy(x.impl))
+		{
+			try
+			{
+				append_all(x.begin(), x.end());
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+		}
+
+		~_btree() throw()
+		{ clear(); }
+
+		_btree&	operator=(_btree const& x)
+		{
+			if (this != &x)
+			{
+				clear();
+				impl.comp = x.impl.comp;
+				append_all(x.begin(), x.end());
+			}
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		Compare			key_comp() const
+		{ return impl.comp; }
+
+		iterator				begin() throw()
+		{ return iterator(impl.leftmost, 0); }
+
+		const_iterator			begin() const throw()
+		{ return const_iterator(impl.leftmost, 0); }
+
+		iterator				end() throw()
+		{ return iterator(impl.rightmost, last_count()); }
+
+		const_iterator			end() const throw()
+		{ return const_iterator(impl.rightmost, last_count()); }
+
+		reverse_iterator		rbegin() throw()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
+		bool		empty() const throw()
+		{ return impl.size == 0; }
+
+		size_type	size() const throw()
+		{ return impl.size; }
+
+		size_type	max_size() const throw()
+		{ return V_alloc_type(impl).max_size(); }
+
+		/**
+		 * @brief Insert v unless an element with an equivalent key exists.
+		 *
+		 * @return pair<iterator, bool>	The element with v's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert_unique(value_type const& v)
+		{
+			node_type*	n;
+			size_t		pos;
+
+			if (!impl.root)
+				return pair<iterator, bool>(append(v), true);
+			if (locate(KeyOfValue()(v), n, pos))
+				return pair<iterator, bool>(iterator(n, int(pos)), false);
+			return pair<iterator, bool>(insert_leaf(n, pos, v), true);
+		}
+
+		/**
+		 * @brief Insert a range, appending each value greater than every
+		 * key without a search, so that sorted input loads in O(n) into
+		 * nodes that are full but for one slot.
+		 */
+		template<typename I>
+		void	insert_unique(I first, I last)
+		{
+			for (; first != last; ++first)
+				if (greater_than_all(KeyOfValue()(*first)))
+					append(*first);
+				else
+					insert_unique(*first);
+		}
+
+		void	erase(iterator pos) throw()
+		{
+			node_type*	n = pos.node;
+			size_t		i = size_t(pos.position);
+
+			V_alloc_type(impl).destroy(n->slot(i));
+			if (!n->leaf)
+			{
+				// Fill the hole with the predecessor, from a leaf.
+				node_type*	leaf = n->child(i);
+
+				while (!leaf->leaf)
+					leaf = leaf->child(leaf->count);
+				relocate(n->slot(i), leaf->slot(leaf->count - 1), 1);
+				n = leaf;
+			}
+			else
+				relocate(n->slot(i), n->slot(i + 1), n->count - i - 1);
+			--n->count;
+			--impl.size;
+			rebalance(n);
+		}
+
+		void	erase(iterator first, iterator last)
+		{
+			size_t	n = size_t(ft::distance(first, last));
+
+			if (n == size())
+			{
+				clear();
+				return;
+			}
+			if (n == 0)
+				return;
+
+			// Erasing moves values, so the next one is found again by key.
+			key_type	k = KeyOfValue()(*first);
+
+			while (n--)
+			{
+				iterator const	i = lower_bound(k);
+				iterator		next = i;
+
+				if (n)
+					k = KeyOfValue()(*++next);
+				erase(i);
+			}
+		}
+
+		/**
+		 * @brief Erase the element with a key equivalent to k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase_key(key_type const& k)
+		{
+			iterator const	i = find(k);
+
+			if (i == end())
+				return 0;
+			erase(i);
+			return 1;
+		}
+
+		void	clear() throw()
+		{
+			if (impl.root)
+				destroy_subtree(impl.root);
+			impl.root = impl.leftmost = impl.rightmost = 0;
+			impl.size = 0;
+		}
+
+		void	swap(_btree& x) throw()
+		{
+			ft::swap(impl.comp, x.impl.comp);
+			ft::swap(impl.root, x.impl.root);
+			ft::swap(impl.leftmost, x.impl.leftmost);
+			ft::swap(impl.rightmost, x.impl.rightmost);
+			ft::swap(impl.size, x.impl.size);
+			leaf_alloc_traits::on_swap(impl, x.impl);
+		}
+
+		iterator		find(key_type const& k)
+		{
+			node_type*	n;
+			size_t		pos;
+
+			if (impl.root && locate(k, n, pos))
+				return iterator(n, int(pos));
+			return end();
+		}
+
+		const_iterator	find(key_type const& k) const
+		{ return const_cast<_btree*>(this)->find(k); }
+
+		/**
+		 * @brief Returns the first element whose key is not less than k.
+		 */
+		iterator		lower_bound(key_type const& k)
+		{
+			node_type*	n = impl.root;
+			size_t		pos = 0;
+
+			while (n)
+			{
+				pos = lower_slot(n, k);
+				if (pos < n->count && !impl.comp(k, key(n, pos)))
+					return iterator(n, int(pos));
+				if (n->leaf)
+					break;
+				n = n->child(pos);
+			}
+			return next_valid(n, pos);
+		}
+
+		const_iterator	lower_bound(key_type const& k) const
+		{ return const_cast<_btree*>(this)->lower_bound(k); }
+
+		/**
+		 * @brief Returns the first element whose key is greater than k.
+		 */
+		iterator		upper_bound(key_type const& k)
+		{
+			node_type*	n = impl.root;
+			size_t		pos = 0;
+
+			while (n)
+			{
+				pos = upper_slot(n, k);
+				if (n->leaf)
+					break;
+				n = n->child(pos);
+			}
+			return next_valid(n, pos);
+		}
+
+		const_iterator	upper_bound(key_type const& k) const
+		{ return const_cast<_btree*>(this)->upper_bound(k); }
+
+		pair<iterator, iterator>	equal_range(key_type const& k)
+		{
+			iterator	first = lower_bound(k);
+			iterator	last = first;
+
+			if (last != end() && !impl.comp(k, KeyOfValue()(*last)))
+				++last;
+			return pair<iterator, iterator>(first, last);
+		}
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{
+			pair<iterator, iterator> const	r
+				= const_cast<_btree*>(this)->equal_range(k);
+
+			return pair<const_iterator, const_iterator>(r.first, r.second);
+		}
+
+	private:
+		int			last_count() const throw()
+		{ return impl.rightmost ? impl.rightmost->count : 0; }
+
+		static key_type const&	key(node_type const* n, size_t i)
+		{ return KeyOfValue()(*n->slot(i)); }
+
+		/// Returns the first slot of n whose key is not less than k.
+		size_t		lower_slot(node_type const* n, key_type const& k) const
+		{
+			size_t	lo = 0;
+			size_t	hi = n->count;
+
+			while (lo < hi)
+			{
+				size_t const	mid = (lo + hi) / 2;
+
+				if (impl.comp(key(n, mid), k))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		/// Returns the first slot of n whose key is greater than k.
+		size_t		upper_slot(node_type const* n, key_type const& k) const
+		{
+			size_t	lo = 0;
+			size_t	hi = n->count;
+
+			while (lo < hi)
+			{
+				size_t const	mid = (lo + hi) / 2;
+
+				if (!impl.comp(k, key(n, mid)))
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			return lo;
+		}
+
+		/**
+		 * @brief Find the slot of k, or the slot of a leaf where it would be
+		 * inserted. The tree must not be empty.
+		 *
+		 * @return bool	true if k was found.
+		 */
+		bool		locate(key_type const& k, node_type*& n, size_t& pos)
+			const
+		{
+			n = impl.root;
+			for (;;)
+			{
+				pos = lower_slot(n, k);
+				if (pos < n->count && !impl.comp(k, key(n, pos)))
+					return true;
+				if (n->leaf)
+					return false;
+				n = n->child(pos);
+			}
+		}
+
+		/// Returns (n, pos), or the next value if pos is past n's end.
+		iterator	next_valid(node_type* n, size_t pos) throw()
+		{
+			if (!n)
+				return end();
+			while (pos == n->count && n->parent)
+			{
+				pos = n->position;
+				n = n->parent;
+			}
+			return pos == n->count ? end() : iterator(n, int(pos));
+		}
+
+		bool		greater_than_all(key_type const& k) const
+		{
+			return impl.size
+				&& impl.comp(key(impl.rightmost, impl.rightmost->count - 1), k);
+		}
+
+		/// Insert v after every other value.
+		iterator	append(value_type const& v)
+		{
+			if (!impl.root)
+				impl.root = impl.leftmost = impl.rightmost = new_node(true);
+			return insert_leaf(impl.rightmost, impl.rightmost->count, v);
+		}
+
+		template<typename I>
+		void		append_all(I first, I last)
+		{
+			for (; first != last; ++first)
+				append(*first);
+		}
+
+		node_type*	new_node(bool leaf)
+		{
+			node_type*	n;
+
+			if (leaf)
+				n = leaf_alloc_traits::allocate(impl, 1);
+			else
+			{
+				internal_alloc_type	alloc(impl);
+
+				n = internal_alloc_traits::allocate(alloc, 1);
+			}
+			n->parent = 0;
+			n->position = 0;
+			n->count = 0;
+			n->leaf = leaf;
+			return n;
+		}
+
+		void		delete_node(node_type* n) throw()
+		{
+			if (n->leaf)
+				leaf_alloc_traits::deallocate(impl, n, 1);
+			else
+			{
+				internal_alloc_type	alloc(impl);
+
+				internal_alloc_traits::deallocate(alloc,
+					static_cast<internal_type*>(n), 1);
+			}
+		}
+
+		void		destroy_subtree(node_type* n) throw()
+		{
+			V_alloc_type	alloc(impl);
+
+			if (!n->leaf)
+				for (size_t i = 0; i <= n->count; ++i)
+					destroy_subtree(n->child(i));
+			for (size_t i = 0; i < n->count; ++i)
+				alloc.destroy(n->slot(i));
+			delete_node(n);
+		}
+
+		/**
+		 * @brief Move n values from src to dst, leaving src uninitialized.
+		 * The ranges may overlap.
+		 */
+		void		relocate(V* dst, V* src, size_t n) throw()
+		{
+			if (_btree_relocatable<V>::value)
+			{
+				std::memmove(static_cast<void*>(dst), src, n * sizeof(V));
+				return;
+			}
+
+			V_alloc_type	alloc(impl);
+
+			if (dst < src)
+				for (size_t i = 0; i < n; ++i)
+				{
+					alloc.construct(dst + i, src[i]);
+					alloc.destroy(src + i);
+				}
+			else
+				for (size_t i = n; i-- > 0;)
+				{
+					alloc.construct(dst + i, src[i]);
+					alloc.destroy(src + i);
+				}
+		}
+
+		static void	set_child(node_type* n, size_t i, node_type* c) throw()
+		{
+			n->child(i) = c;
+			c->parent = n;
+			c->position = static_cast<unsigned short>(i);
+		}
+
+		/**
+		 * @brief Insert v at slot pos of the leaf n, splitting it first if
+		 * it is full.
+		 */
+		iterator	insert_leaf(node_type* n, size_t pos, value_type const& v)
+		{
+			if (n->count == capacity)
+				split(n, pos);
+			relocate(n->slot(pos + 1), n->slot(pos), n->count - pos);
+			try
+			{
+				V_alloc_type(impl).construct(n->slot(pos), v);
+			}
+			catch (...)
+			{
+				relocate(n->slot(pos), n->slot(pos + 1), n->count - pos);
+				throw;
+			}
+			++n->count;
+			++impl.size;
+			return iterator(n, int(pos));
+		}
+
+		/**
+		 * @brief Split the full node n, whose slot or child pos is about to
+		 * get a new value, moving its median up to its parent, which is
+		 * split first if it is full as well.
+		 *
+		 * Inserting at either end keeps all the other values on the
+		 * opposite side, rather than splitting them in halves, so that
+		 * sorted insertions leave full nodes behind.
+		 *
+		 * @param n		The node, updated to the half that gets the value.
+		 * @param pos	The slot, updated to the same value's slot.
+		 */
+		void		split(node_type*& n, size_t& pos)
+		{
+			node_type* const	sibling = new_node(n->leaf);
+			node_type*			parent = n->parent;
+
+			try
+			{
+				if (!parent)
+				{
+					parent = new_node(false);
+					set_child(parent, 0, n);
+					impl.root = parent;
+				}
+				else if (parent->count == capacity)
+				{
+					size_t	ppos = n->position;
+
+					split(parent, ppos);
+					parent = n->parent;
+				}
+			}
+			catch (...)
+			{
+				delete_node(sibling);
+				throw;
+			}
+
+			size_t const	right = pos == capacity ? 0
+				: pos == 0 ? capacity - 1 : capacity / 2;
+			size_t const	left = capacity - 1 - right;
+			size_t const	p = n->position;
+
+			relocate(sibling->slot(0), n->slot(left + 1), right);
+			if (!n->leaf)
+				for (size_t i = 0; i <= right; ++i)
+					set_child(sibling, i, n->child(left + 1 + i));
+			sibling->count = static_cast<unsigned short>(right);
+
+			relocate(parent->slot(p + 1), parent->slot(p),
+				parent->count - p);
+			relocate(parent->slot(p), n->slot(left), 1);
+			for (size_t i = parent->count; i > p; --i)
+				set_child(parent, i + 1, parent->child(i));
+			set_child(parent, p + 1, sibling);
+			++parent->count;
+			n->count = static_cast<unsigned short>(left);
+
+			if (n == impl.rightmost)
+				impl.rightmost = sibling;
+			if (pos > left)
+			{
+				n = sibling;
+				pos -= left + 1;
+			}
+		}
+
+		/**
+		 * @brief Refill n after an erasure left it under half full, by
+		 * merging it with a sibling, which may leave the parent under half
+		 * full in turn, or by borrowing a value from a sibling.
+		 */
+		void		rebalance(node_type* n) throw()
+		{
+			while (n != impl.root && n->count < min_count)
+			{
+				node_type* const	parent = n->parent;
+				size_t const		i = n->position;
+
+				if (i > 0)
+				{
+					node_type* const	left = parent->child(i - 1);
+
+					if (left->count > min_count)
+					{
+						borrow_left(n, left);
+						return;
+					}
+					merge(left, n);
+				}
+				else
+				{
+					node_type* const	right = parent->child(1);
+
+					if (right->count > min_count)
+					{
+						borrow_right(n, right);
+						return;
+					}
+					merge(n, right);
+				}
+				n = parent;
+			}
+			if (n == impl.root && n->count == 0)
+			{
+				if (n->leaf)
+					impl.root = impl.leftmost = impl.rightmost = 0;
+				else
+				{
+					impl.root = n->child(0);
+					impl.root->parent = 0;
+					impl.root->position = 0;
+				}
+				delete_node(n);
+			}
+		}
+
+		/// Move the last value of left up to the parent, and its separator
+		/// down to the front of n.
+		void		borrow_left(node_type* n, node_type* left) throw()
+		{
+			node_type* const	parent = n->parent;
+			size_t const		i = n->position;
+
+			relocate(n->slot(1), n->slot(0), n->count);
+			relocate(n->slot(0), parent->slot(i - 1), 1);
+			relocate(parent->slot(i - 1), left->slot(left->count - 1), 1);
+			if (!n->leaf)
+			{
+				for (size_t j = n->count + 1; j > 0; --j)
+					set_child(n, j, n->child(j - 1));
+				set_child(n, 0, left->child(left->count));
+			}
+			--left->count;
+			++n->count;
+		}
+
+		/// Move the first value of right up to the parent, and its
+		/// separator down to the back of n.
+		void		borrow_right(node_type* n, node_type* right) throw()
+		{
+			node_type* const	parent = n->parent;
+			size_t const		i = n->position;
+
+			relocate(n->slot(n->count), parent->slot(i), 1);
+			relocate(parent->slot(i), right->slot(0), 1);
+			relocate(right->slot(0), right->slot(1), right->count - 1);
+			if (!n->leaf)
+			{
+				set_child(n, n->count + 1, right->child(0));
+				for (size_t j = 0; j < right->count; ++j)
+					set_child(right, j, right->child(j + 1));
+			}
+			++n->count;
+			--right->count;
+		}
+
+		/// Move the separator and all of right into left, and free right.
+		void		merge(node_type* left, node_type* right) throw()
+		{
+			node_type* const	parent = left->parent;
+			size_t const		p = left->position;
+
+			relocate(left->slot(left->count), parent->slot(p), 1);
+			relocate(left->slot(left->count + 1), right->slot(0),
+				right->count);
+			if (!left->leaf)
+				for (size_t j = 0; j <= right->count; ++j)
+					set_child(left, left->count + 1 + j, right->child(j));
+			left->count += 1 + right->count;
+
+			relocate(parent->slot(p), parent->slot(p + 1),
+				parent->count - p - 1);
+			for (size_t j = p + 1; j < parent->count; ++j)
+				set_child(parent, j, parent->child(j + 1));
+			--parent->count;
+
+			if (impl.rightmost == right)
+				impl.rightmost = left;
+			delete_node(right);
+		}
+	};
+
+	template<typename K, typename V, typename KoV, typename C, size_t N,
+		typename A>
+	typename _btree<K, V, KoV, C, N, A>::size_type const
+		_btree<K, V, KoV, C, N, A>::node_capacity;
+
+	template<typename K, typename V, typename KoV, typename C, size_t N,
+		typename A>
+	inline bool	operator==(_btree<K, V, KoV, C, N, A> const& x,
+		_btree<K, V, KoV, C, N, A> const& y)
+	{
+		return x.size() == y.size()
+			&& ft::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template<typename K, typename V, typename KoV, typename C, size_t N,
+		typename A>
+	inline bool	operator<(_btree<K, V, KoV, C, N, A> const& x,
+		_btree<K, V, KoV, C, N, A> const& y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(),
+			y.begin(), y.end());
+	}
+}
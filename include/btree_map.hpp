@@ -0,0 +1,278 @@
+#pragma once
+
+#include <btree.hpp>
+#include <exception.hpp>
+#include <functional.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A sorted associative container of unique keys, each mapped to
+	 * a value, with the interface of map but stored in a B-tree.
+	 *
+	 * Nodes hold sorted arrays of elements, which makes lookups miss the
+	 * cache about once per level of a much shallower tree than a map's,
+	 * and takes a few bytes of overhead per element instead of a map's
+	 * three pointers. Iterators are invalidated by every insertion and
+	 * erasure.
+	 *
+	 * @tparam K			The key type.
+	 * @tparam T			The mapped type.
+	 * @tparam Compare		The key ordering.
+	 * @tparam NodeBytes	The size of a leaf node, best a few cache lines.
+	 * @tparam A			The allocator type, rebound to nodes.
+	 */
+	template<typename K, typename T, typename Compare = less<K>,
+		size_t NodeBytes = 256, typename A = allocator<pair<K const, T> > >
+	class	btree_map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Compare				key_compare;
+		typedef	A					allocator_type;
+
+		/**
+		 * @brief Orders values by their keys.
+		 */
+		class	value_compare
+			:	public binary_function<value_type, value_type, bool>
+		{
+			friend class	btree_map;
+
+		protected:
+			Compare	comp;
+
+			value_compare(Compare c)	:	comp(c) { }
+
+		public:
+			bool	operator()(value_type const& x, value_type const& y) const
+			{ return comp(x.first, y.first); }
+		};
+
+	private:
+		typedef	_btree<key_type, value_type, _select1st<value_type>,
+			key_compare, NodeBytes, allocator_type>	tree_type;
+
+		tree_type	tree;
+
+	public:
+		typedef	typename A::pointer							pointer;
+		typedef	typename A::const_pointer					const_pointer;
+		typedef	typename A::reference						reference;
+		typedef	typename A::const_reference					const_reference;
+		typedef	typename tree_type::iterator				iterator;
+		typedef	typename tree_type::const_iterator			const_iterator;
+		typedef	typename tree_type::reverse_iterator		reverse_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			const_reverse_iterator;
+		typedef	typename tree_type::size_type				size_type;
+		typedef	typename tree_type::difference_type			difference_type;
+
+		explicit btree_map(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a) { }
+
+		/**
+		 * @brief Construct a map from a range, in O(n) if it is sorted.
+		 */
+		template<typename I>
+		btree_map(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a)
+		{ tree.insert_unique(first, last); }
+
+		btree_map(btree_map const& x)	:	tree(x.tree) { }
+
+		btree_map&	operator=(btree_map const& x)
+		{
+			tree = x.tree;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return tree.get_allocator(); }
+
+		iterator				begin() throw()
+		{ return tree.begin(); }
+
+		const_iterator			begin() const throw()
+		{ return tree.begin(); }
+
+		iterator				end() throw()
+		{ return tree.end(); }
+
+		const_iterator			end() const throw()
+		{ return tree.end(); }
+
+		reverse_iterator		rbegin() throw()
+		{ return tree.rbegin(); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return tree.rbegin(); }
+
+		reverse_iterator		rend() throw()
+		{ return tree.rend(); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return tree.rend(); }
+
+		bool		empty() const throw()
+		{ return tree.empty(); }
+
+		size_type	size() const throw()
+		{ return tree.size(); }
+
+		size_type	max_size() const throw()
+		{ return tree.max_size(); }
+
+		/**
+		 * @brief Returns the value mapped to k, inserting a default one if
+		 * k is not in the map.
+		 */
+		mapped_type&	operator[](key_type const& k)
+		{
+			iterator	i = lower_bound(k);
+
+			if (i == end() || key_comp()(k, i->first))
+				i = tree.insert_unique(value_type(k, mapped_type())).first;
+			return i->second;
+		}
+
+		/**
+		 * @brief Returns the value mapped to k.
+		 *
+		 * @throw OutOfRangeException if k is not in the map.
+		 */
+		mapped_type&		at(key_type const& k)
+		{
+			iterator const	i = find(k);
+
+			if (i == end())
+				throw OutOfRangeException();
+			return i->second;
+		}
+
+		mapped_type const&	at(key_type const& k) const
+		{
+			const_iterator const	i = find(k);
+
+			if (i == end())
+				throw OutOfRangeException();
+			return i->second;
+		}
+
+		/**
+		 * @brief Insert x unless its key is already in the map.
+		 *
+		 * @return pair<iterator, bool>	The element with x's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{ return tree.insert_unique(x); }
+
+		/**
+		 * @brief Insert x unless its key is already in the map. The hint is
+		 * not used, and the insertion costs a full search.
+		 */
+		iterator				insert(iterator, value_type const& x)
+		{ return tree.insert_unique(x).first; }
+
+		/**
+		 * @brief Insert a range, appending the elements that are greater
+		 * than every key without a search.
+		 */
+		template<typename I>
+		void					insert(I first, I last)
+		{ tree.insert_unique(first, last); }
+
+		void		erase(iterator pos)
+		{ tree.erase(pos); }
+
+		/**
+		 * @brief Erase the element with key k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{ return tree.erase_key(k); }
+
+		void		erase(iterator first, iterator last)
+		{ tree.erase(first, last); }
+
+		void		swap(btree_map& x) throw()
+		{ tree.swap(x.tree); }
+
+		void		clear() throw()
+		{ tree.clear(); }
+
+		key_compare		key_comp() const
+		{ return tree.key_comp(); }
+
+		value_compare	value_comp() const
+		{ return value_compare(tree.key_comp()); }
+
+		iterator		find(key_type const& k)
+		{ return tree.find(k); }
+
+		const_iterator	find(key_type const& k) const
+		{ return tree.find(k); }
+
+		size_type		count(key_type const& k) const
+		{ return tree.find(k) == tree.end() ? 0 : 1; }
+
+		iterator		lower_bound(key_type const& k)
+		{ return tree.lower_bound(k); }
+
+		const_iterator	lower_bound(key_type const& k) const
+		{ return tree.lower_bound(k); }
+
+		iterator		upper_bound(key_type const& k)
+		{ return tree.upper_bound(k); }
+
+		const_iterator	upper_bound(key_type const& k) const
+		{ return tree.upper_bound(k); }
+
+		pair<iterator, iterator>				equal_range(
+			key_type const& k)
+		{ return tree.equal_range(k); }
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{ return tree.equal_range(k); }
+
+		friend bool	operator==(btree_map const& x, btree_map const& y)
+		{ return x.tree == y.tree; }
+
+		friend bool	operator<(btree_map const& x, btree_map const& y)
+		{ return x.tree < y.tree; }
+	};
+
+	template<typename K, typename T, typename C, size_t N, typename A>
+	inline bool	operator!=(btree_map<K, T, C, N, A> const& x,
+		btree_map<K, T, C, N, A> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename T, typename C, size_t N, typename A>
+	inline bool	operator>(btree_map<K, T, C, N, A> const& x,
+		btree_map<K, T, C, N, A> const& y)
+	{ return y < x; }
+
+	template<typename K, typename T, typename C, size_t N, typename A>
+	inline bool	operator<=(btree_map<K, T, C, N, A> const& x,
+		btree_map<K, T, C, N, A> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename T, typename C, size_t N, typename A>
+	inline bool	operator>=(btree_map<K, T, C, N, A> const& x,
+		btree_map<K, T, C, N, A> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename T, typename C, size_t N, typename A>
+	inline void	swap(btree_map<K, T, C, N, A>& x,
+		btree_map<K, T, C, N, A>& y) throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <btree.hpp>
+#include <functional.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A sorted associative container of unique keys, with the
+	 * interface of set but stored in a B-tree.
+	 *
+	 * Iterators are invalidated by every insertion and erasure.
+	 *
+	 * @tparam K			The key type.
+	 * @tparam Compare		The key ordering.
+	 * @tparam NodeBytes	The size of a leaf node, best a few cache lines.
+	 * @tparam A			The allocator type, rebound to nodes.
+	 */
+	template<typename K, typename Compare = less<K>, size_t NodeBytes = 256,
+		typename A = allocator<K> >
+	class	btree_set
+	{
+	public:
+		typedef	K			key_type;
+		typedef	K			value_type;
+		typedef	Compare		key_compare;
+		typedef	Compare		value_compare;
+		typedef	A			allocator_type;
+
+	private:
+		typedef	_btree<key_type, value_type, _identity<value_type>,
+			key_compare, NodeBytes, allocator_type>	tree_type;
+
+		tree_type	tree;
+
+	public:
+		typedef	typename A::pointer							pointer;
+		typedef	typename A::const_pointer					const_pointer;
+		typedef	typename A::reference						reference;
+		typedef	typename A::const_reference					const_reference;
+		typedef	typename tree_type::const_iterator			iterator;
+		typedef	typename tree_type::const_iterator			const_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			reverse_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			const_reverse_iterator;
+		typedef	typename tree_type::size_type				size_type;
+		typedef	typename tree_type::difference_type			difference_type;
+
+		explicit btree_set(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a) { }
+
+		/**
+		 * @brief Construct a set from a range, in O(n) if it is sorted.
+		 */
+		template<typename I>
+		btree_set(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a)
+		{ tree.insert_unique(first, last); }
+
+		btree_set(btree_set const& x)	:	tree(x.tree) { }
+
+		btree_set&	operator=(btree_set const& x)
+		{
+			tree = x.tree;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return tree.get_allocator(); }
+
+		iterator			begin() const throw()
+		{ return tree.begin(); }
+
+		iterator			end() const throw()
+		{ return tree.end(); }
+
+		reverse_iterator	rbegin() const throw()
+		{ return tree.rbegin(); }
+
+		reverse_iterator	rend() const throw()
+		{ return tree.rend(); }
+
+		bool		empty() const throw()
+		{ return tree.empty(); }
+
+		size_type	size() const throw()
+		{ return tree.size(); }
+
+		size_type	max_size() const throw()
+		{ return tree.max_size(); }
+
+		/**
+		 * @brief Insert x unless an equivalent key is already in the set.
+		 *
+		 * @return pair<iterator, bool>	The element equivalent to x, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{
+			pair<typename tree_type::iterator, bool> const	p
+				= tree.insert_unique(x);
+
+			return pair<iterator, bool>(p.first, p.second);
+		}
+
+		/**
+		 * @brief Insert x unless an equivalent key is already in the set.
+		 * The hint is not used, and the insertion costs a full search.
+		 */
+		iterator				insert(iterator, value_type const& x)
+		{ return tree.insert_unique(x).first; }
+
+		/**
+		 * @brief Insert a range, appending the keys that are greater than
+		 * every other without a search.
+		 */
+		template<typename I>
+		void					insert(I first, I last)
+		{ tree.insert_unique(first, last); }
+
+		void		erase(iterator pos)
+		{ tree.erase(pos._const_cast()); }
+
+		/**
+		 * @brief Erase the key equivalent to k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{ return tree.erase_key(k); }
+
+		void		erase(iterator first, iterator last)
+		{ tree.erase(first._const_cast(), last._const_cast()); }
+
+		void		swap(btree_set& x) throw()
+		{ tree.swap(x.tree); }
+
+		void		clear() throw()
+		{ tree.clear(); }
+
+		key_compare		key_comp() const
+		{ return tree.key_comp(); }
+
+		value_compare	value_comp() const
+		{ return tree.key_comp(); }
+
+		iterator	find(key_type const& k) const
+		{ return tree.find(k); }
+
+		size_type	count(key_type const& k) const
+		{ return tree.find(k) == tree.end() ? 0 : 1; }
+
+		iterator	lower_bound(key_type const& k) const
+		{ return tree.lower_bound(k); }
+
+		iterator	upper_bound(key_type const& k) const
+		{ return tree.upper_bound(k); }
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{ return tree.equal_range(k); }
+
+		friend bool	operator==(btree_set const& x, btree_set const& y)
+		{ return x.tree == y.tree; }
+
+		friend bool	operator<(btree_set const& x, btree_set const& y)
+		{ return x.tree < y.tree; }
+	};
+
+	template<typename K, typename C, size_t N, typename A>
+	inline bool	operator!=(btree_set<K, C, N, A> const& x,
+		btree_set<K, C, N, A> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename C, size_t N, typename A>
+	inline bool	operator>(btree_set<K, C, N, A> const& x,
+		btree_set<K, C, N, A> const& y)
+	{ return y < x; }
+
+	template<typename K, typename C, size_t N, typename A>
+	inline bool	operator<=(btree_set<K, C, N, A> const& x,
+		btree_set<K, C, N, A> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename C, size_t N, typename A>
+	inline bool	operator>=(btree_set<K, C, N, A> const& x,
+		btree_set<K, C, N, A> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename C, size_t N, typename A>
+	inline void	swap(btree_set<K, C, N, A>& x, btree_set<K, C, N, A>& y)
+		throw()
+	{ x.swap(y); }
+}
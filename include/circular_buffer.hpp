@@ -0,0 +1,589 @@
+#pragma once
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <type_traits.hpp>
+
+namespace ft
+{
+	namespace detail
+	{
+		/**
+		 * @brief Returns the smallest power of two that is not less than n,
+		 * or 0 if n is 0.
+		 */
+		inline size_t	_ceil_pow2(size_t n) throw()
+		{
+			if (n <= 1)
+				return n;
+
+			size_t	p = 1;
+
+			while (p < n)
+				p <<= 1;
+			return p;
+		}
+	}
+
+	/**
+	 * @brief What a bounded container does when an element is pushed while
+	 * it is full.
+	 */
+	enum	overflow_policy
+	{
+		/// Refuse the new element.
+		reject_when_full,
+		/// Drop the oldest element to make room.
+		overwrite_oldest
+	};
+
+	/**
+	 * @brief A circular_buffer::iterator or circular_buffer::const_iterator.
+	 *
+	 * Positions are free-running indices, that are masked with the
+	 * buffer's capacity - 1 on access.
+	 */
+	template<typename T, typename Ref, typename Ptr>
+	struct	_circular_buffer_iterator
+	{
+		typedef	_circular_buffer_iterator<T, T&, T*>			iterator;
+		typedef	_circular_buffer_iterator<T, T const&, T const*>
+			const_iterator;
+		typedef	_circular_buffer_iterator						_self;
+
+		typedef	random_access_iterator_tag	iterator_category;
+		typedef	T							value_type;
+		typedef	Ptr							pointer;
+		typedef	Ref							reference;
+		typedef	ptrdiff_t					difference_type;
+
+		T*		buf;
+		size_t	mask;
+		size_t	pos;
+
+		_circular_buffer_iterator() throw()
+			:	buf(), mask(0), pos(0) { }
+
+		_circular_buffer_iterator(T* b, size_t m, size_t p) throw()
+			:	buf(b), mask(m), pos(p) { }
+
+		_circular_buffer_iterator(iterator const& x) throw()
+			:	buf(x.buf), mask(x.mask), pos(x.pos) { }
+
+		reference	operator*() const throw()
+		{ return buf[pos & mask]; }
+
+		pointer		operator->() const throw()
+		{ return buf + (pos & mask); }
+
+		_self&		operator++() throw()
+		{ ++pos; return *this; }
+
+		_self		operator++(int) throw()
+		{ _self	tmp = *this; ++pos; return tmp; }
+
+		_self&		operator--() throw()
+		{ --pos; return *this; }
+
+		_self		operator--(int) throw()
+		{ _self	tmp = *this; --pos; return tmp; }
+
+		_self&		operator+=(difference_type n) throw()
+		{ pos += n; return *this; }
+
+		_self&		operator-=(difference_type n) throw()
+		{ pos -= n; return *this; }
+
+		_self		operator+(difference_type n) const throw()
+		{ return _self(buf, mask, pos + n); }
+
+		_self		operator-(difference_type n) const throw()
+		{ return _self(buf, mask, pos - n); }
+
+		reference	operator[](difference_type n) const throw()
+		{ return buf[(pos + n) & mask]; }
+	};
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator==(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return x.pos == y.pos; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator!=(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return x.pos != y.pos; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline ptrdiff_t	operator-(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return ptrdiff_t(x.pos - y.pos); }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator<(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return x - y < 0; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator>(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return y < x; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator<=(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return !(y < x); }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator>=(_circular_buffer_iterator<T, Rl, Pl> const& x,
+		_circular_buffer_iterator<T, Rr, Pr> const& y) throw()
+	{ return !(x < y); }
+
+	template<typename T, typename R, typename P>
+	inline _circular_buffer_iterator<T, R, P>	operator+(ptrdiff_t n,
+		_circular_buffer_iterator<T, R, P> const& x) throw()
+	{ return x + n; }
+
+	template<typename T, typename A>
+	class	_circular_buffer_base
+	{
+	protected:
+		typedef	typename _alloc_traits<A>::template rebind<T>::other
+			T_alloc_type;
+		typedef	_alloc_traits<T_alloc_type>		T_alloc_traits;
+
+		struct	_circular_buffer_impl	:	public T_alloc_type
+		{
+			T*		buf;
+			size_t	capacity;
+			size_t	head;
+			size_t	tail;
+
+			_circular_buffer_impl(T_alloc_type const& a)
+				:	T_alloc_type(a), buf(), capacity(0), head(0), tail(0) { }
+
+			void	swap_data(_circular_buffer_impl& x) throw()
+			{
+				ft::swap(buf, x.buf);
+				ft::swap(capacity, x.capacity);
+				ft::swap(head, x.head);
+				ft::swap(tail, x.tail);
+			}
+		};
+
+		_circular_buffer_impl	impl;
+
+	public:
+		typedef	A	allocator_type;
+
+		T_alloc_type&		get_T_allocator() throw()
+		{ return impl; }
+
+		T_alloc_type const&	get_T_allocator() const throw()
+		{ return impl; }
+
+		allocator_type		get_allocator() const throw()
+		{ return allocator_type(get_T_allocator()); }
+
+		/**
+		 * @brief Allocate room for n elements, rounded up to a power of
+		 * two.
+		 */
+		_circular_buffer_base(size_t n, allocator_type const& a)	:	impl(a)
+		{
+			size_t const	capacity = detail::_ceil_pow2(n);
+
+			if (capacity < n || capacity > T_alloc_traits::max_size(impl))
+				throw LengthErrorException();
+			if (capacity)
+				impl.buf = T_alloc_traits::allocate(impl, capacity);
+			impl.capacity = capacity;
+		}
+
+		~_circular_buffer_base() throw()
+		{
+			if (impl.buf)
+				T_alloc_traits::deallocate(impl, impl.buf, impl.capacity);
+		}
+	};
+
+	/**
+	 * @brief A bounded FIFO of elements stored in a ring, whose capacity is
+	 * a power of two so that positions wrap with a mask.
+	 *
+	 * The storage is allocated once on construction, and pushing into a
+	 * full buffer either fails or drops the oldest element depending on the
+	 * overflow_policy. Bulk transfers copy at most two contiguous segments.
+	 *
+	 * Can be used as the container of a queue, that must then be given a
+	 * buffer with a non-zero capacity. A push that the buffer rejects
+	 * because it is full makes queue::push() throw LengthErrorException.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename A = allocator<T> >
+	class	circular_buffer	:	protected _circular_buffer_base<T, A>
+	{
+	private:
+		typedef	_circular_buffer_base<T, A>		base;
+		typedef	typename base::T_alloc_type		T_alloc_type;
+		typedef	typename base::T_alloc_traits	T_alloc_traits;
+
+	public:
+		typedef T											value_type;
+		typedef typename T_alloc_traits::pointer			pointer;
+		typedef typename T_alloc_traits::const_pointer		const_pointer;
+		typedef typename T_alloc_traits::reference			reference;
+		typedef typename T_alloc_traits::const_reference	const_reference;
+
+		typedef _circular_buffer_iterator<T, T&, T*>		iterator;
+		typedef _circular_buffer_iterator<T, T const&, T const*>
+			const_iterator;
+		typedef ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>
+			const_reverse_iterator;
+
+		typedef size_t					size_type;
+		typedef ptrdiff_t				difference_type;
+		typedef A						allocator_type;
+
+	protected:
+		using	base::impl;
+		using	base::get_T_allocator;
+
+		overflow_policy	policy;
+
+	public:
+		/**
+		 * @brief Construct an empty buffer that holds at least n elements.
+		 *
+		 * @param n			The minimal capacity, rounded up to a power of two.
+		 * @param policy	What to do when pushing into a full buffer.
+		 */
+		explicit circular_buffer(size_type n = 0,
+			overflow_policy p = reject_when_full,
+			allocator_type const& a = allocator_type())
+			:	base(n, a), policy(p) { }
+
+		circular_buffer(circular_buffer const& x)
+			:	base(x.capacity(),
+				T_alloc_traits::select_on_copy(x.get_T_allocator())),
+				policy(x.policy)
+		{ push_n(x.begin(), x.size()); }
+
+		~circular_buffer() throw()
+		{ clear(); }
+
+		circular_buffer&	operator=(circular_buffer const& x)
+		{
+			if (&x != this)
+			{
+				circular_buffer	tmp(x);
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		using	base::get_allocator;
+
+		iterator				begin() throw()
+		{ return iterator(impl.buf, mask(), impl.head); }
+
+		const_iterator			begin() const throw()
+		{ return const_iterator(impl.buf, mask(), impl.head); }
+
+		iterator				end() throw()
+		{ return iterator(impl.buf, mask(), impl.tail); }
+
+		const_iterator			end() const throw()
+		{ return const_iterator(impl.buf, mask(), impl.tail); }
+
+		reverse_iterator		rbegin() throw()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
+		/**
+		 * @brief Returns the number of elements in the buffer.
+		 */
+		size_type	size() const throw()
+		{ return impl.tail - impl.head; }
+
+		/**
+		 * @brief Returns the number of elements the buffer can hold.
+		 */
+		size_type	capacity() const throw()
+		{ return impl.capacity; }
+
+		size_type	max_size() const throw()
+		{ return capacity(); }
+
+		bool		empty() const throw()
+		{ return impl.tail == impl.head; }
+
+		bool		full() const throw()
+		{ return size() == capacity(); }
+
+		overflow_policy	get_policy() const throw()
+		{ return policy; }
+
+		void			set_policy(overflow_policy p) throw()
+		{ policy = p; }
+
+		reference		operator[](size_type n) throw()
+		{ return impl.buf[(impl.head + n) & mask()]; }
+
+		const_reference	operator[](size_type n) const throw()
+		{ return impl.buf[(impl.head + n) & mask()]; }
+
+		/**
+		 * @brief Returns a reference to the element at index n.
+		 *
+		 * @throw OutOfRangeException if n is not less than size().
+		 */
+		reference		at(size_type n)
+		{ range_check(n); return (*this)[n]; }
+
+		const_reference	at(size_type n) const
+		{ range_check(n); return (*this)[n]; }
+
+		/**
+		 * @brief Returns a reference to the oldest element.
+		 */
+		reference		front() throw()
+		{ return impl.buf[impl.head & mask()]; }
+
+		const_reference	front() const throw()
+		{ return impl.buf[impl.head & mask()]; }
+
+		/**
+		 * @brief Returns a reference to the newest element.
+		 */
+		reference		back() throw()
+		{ return impl.buf[(impl.tail - 1) & mask()]; }
+
+		const_reference	back() const throw()
+		{ return impl.buf[(impl.tail - 1) & mask()]; }
+
+		/**
+		 * @brief Add data at the end of the buffer.
+		 *
+		 * @param x The data to be added.
+		 * @return bool	false if the buffer is full and rejects new elements.
+		 */
+		bool	push_back(value_type const& x)
+		{
+			if (full())
+			{
+				if (policy == reject_when_full || !capacity())
+					return false;
+				back_slot() = x;
+				++impl.head;
+				++impl.tail;
+				return true;
+			}
+			T_alloc_traits::construct(get_T_allocator(), &back_slot(), x);
+			++impl.tail;
+			return true;
+		}
+
+		/**
+		 * @brief Removes the oldest element.
+		 */
+		void	pop_front() throw()
+		{
+			T_alloc_traits::destroy(get_T_allocator(), &front());
+			++impl.head;
+		}
+
+		/**
+		 * @brief Removes the newest element.
+		 */
+		void	pop_back() throw()
+		{
+			--impl.tail;
+			T_alloc_traits::destroy(get_T_allocator(), &back_slot());
+		}
+
+		/**
+		 * @brief Push up to n elements from first, in at most two contiguous
+		 * copies.
+		 *
+		 * When rejecting, only the elements that fit are pushed. When
+		 * overwriting, the oldest elements are dropped to make room, and
+		 * only the capacity() last of the n elements are kept.
+		 *
+		 * @return size_type	The number of elements that were pushed.
+		 */
+		template<typename I>
+		size_type	push_n(I first, size_type n)
+		{
+			if (policy == reject_when_full)
+				n = ft::min(n, capacity() - size());
+			else
+			{
+				if (n > capacity())
+				{
+					ft::advance(first, n - capacity());
+					n = capacity();
+				}
+				if (n > capacity() - size())
+					destroy_front(n - (capacity() - size()));
+			}
+			if (n == 0)
+				return 0;
+
+			size_type const	offset = impl.tail & mask();
+			size_type const	first_len = ft::min(n, capacity() - offset);
+			I				mid = first;
+
+			ft::advance(mid, first_len);
+			_uninitialized_copy_a(first, mid, impl.buf + offset,
+				get_T_allocator());
+			try
+			{
+				_uninitialized_copy_a(mid, mid_end(mid, n - first_len),
+					impl.buf, get_T_allocator());
+			}
+			catch (...)
+			{
+				ft::destroy(impl.buf + offset, impl.buf + offset + first_len,
+					get_T_allocator());
+				throw;
+			}
+			impl.tail += n;
+			return n;
+		}
+
+		/**
+		 * @brief Pop up to n of the oldest elements into out, in at most two
+		 * contiguous copies.
+		 *
+		 * @return size_type	The number of elements that were popped.
+		 */
+		template<typename O>
+		size_type	pop_n(O out, size_type n)
+		{
+			n = ft::min(n, size());
+			if (n == 0)
+				return 0;
+
+			size_type const	offset = impl.head & mask();
+			size_type const	first_len = ft::min(n, capacity() - offset);
+
+			out = ft::copy(impl.buf + offset, impl.buf + offset + first_len,
+				out);
+			ft::copy(impl.buf, impl.buf + (n - first_len), out);
+			destroy_front(n);
+			return n;
+		}
+
+		/**
+		 * @brief Swaps data with another buffer.
+		 *
+		 * @param x	A buffer of the same element and allocator types.
+		 */
+		void	swap(circular_buffer& x) throw()
+		{
+			impl.swap_data(x.impl);
+			ft::swap(policy, x.policy);
+			T_alloc_traits::on_swap(get_T_allocator(), x.get_T_allocator());
+		}
+
+		/**
+		 * @brief Erases all the elements, keeping the storage.
+		 */
+		void	clear() throw()
+		{ destroy_front(size()); }
+
+	protected:
+		size_type	mask() const throw()
+		{ return impl.capacity - 1; }
+
+		T&			back_slot() throw()
+		{ return impl.buf[impl.tail & mask()]; }
+
+		void		range_check(size_type n) const
+		{
+			if (n >= size())
+				throw OutOfRangeException();
+		}
+
+		template<typename I>
+		static I	mid_end(I mid, size_type n)
+		{
+			ft::advance(mid, n);
+			return mid;
+		}
+
+		/**
+		 * @brief Destroy the n oldest elements, in at most two contiguous
+		 * segments.
+		 */
+		void		destroy_front(size_type n) throw()
+		{
+			if (n == 0)
+				return;
+
+			size_type const	offset = impl.head & mask();
+			size_type const	first_len = ft::min(n, capacity() - offset);
+
+			ft::destroy(impl.buf + offset, impl.buf + offset + first_len,
+				get_T_allocator());
+			ft::destroy(impl.buf, impl.buf + (n - first_len),
+				get_T_allocator());
+			impl.head += n;
+		}
+	};
+
+	template<typename T, typename A>
+	inline bool	operator==(circular_buffer<T, A> const& x,
+		circular_buffer<T, A> const& y)
+	{
+		return x.size() == y.size()
+			&& ft::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator!=(circular_buffer<T, A> const& x,
+		circular_buffer<T, A> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename A>
+	inline bool	operator<(circular_buffer<T, A> const& x,
+		circular_buffer<T, A> const& y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(),
+			y.begin(), y.end());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator>(circular_buffer<T, A> const& x,
+		circular_buffer<T, A> const& y)
+	{ return y < x; }
+
+	template<typename T, typename A>
+	inline bool	operator<=(circular_buffer<T, A> const& x,
+		circular_buffer<T, A> const& y)
+	{ return !(y < x); }
+
+	template<typename T, typename A>
+	inline bool	operator>=(circular_buffer<T, A> const& x,
+		circular_buffer<T, A> const& y)
+	{ return !(x < y); }
+
+	template<typename T, typename A>
+	inline void	swap(circular_buffer<T, A>& x, circular_buffer<T, A>& y)
+		throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,558 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <atomic.hpp>
+#include <epoch.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A node of a concurrent_skiplist_map, allocated with room for
+	 * as many links as its height.
+	 *
+	 * A link holds the address of the next node at its level, with the low
+	 * bit set once the node is being erased, which keeps a new node from
+	 * being linked after it.
+	 */
+	template<typename V>
+	struct	_skip_node
+	{
+		V				value;
+		unsigned		height;
+		/// The threads still working on the node: the one inserting it,
+		/// until it is done linking it, and the one erasing it. The last
+		/// one to let go retires it, as only then is it linked nowhere.
+		atomic<int>		owners;
+		atomic<size_t>	next[1];
+
+		static _skip_node*	ptr(size_t link) throw()
+		{ return reinterpret_cast<_skip_node*>(link & ~size_t(1)); }
+
+		static bool			marked(size_t link) throw()
+		{ return link & 1; }
+
+		/// The size of a node of height h.
+		static size_t		bytes(unsigned h) throw()
+		{ return sizeof(_skip_node) + (h - 1) * sizeof(atomic<size_t>); }
+	};
+
+	/**
+	 * @brief A concurrent_skiplist_map::iterator, that keeps the calling
+	 * thread pinned while it lives, so that the node it points to is not
+	 * freed under it.
+	 *
+	 * Iteration is weakly consistent: it visits keys in order, skipping
+	 * the ones erased before it gets to them, and may or may not see the
+	 * keys inserted while it runs. An iterator must stay on the thread
+	 * that created it.
+	 */
+	template<typename V>
+	class	_skiplist_iterator
+	{
+	private:
+		typedef	_skip_node<V>	node;
+
+		epoch::guard			guard;
+		node*					n;
+
+	public:
+		typedef	forward_iterator_tag	iterator_category;
+		typedef	V						value_type;
+		typedef	V const*				pointer;
+		typedef	V const&				reference;
+		typedef	ptrdiff_t				difference_type;
+
+		_skiplist_iterator()
+			:	n() { }
+
+		explicit _skiplist_iterator(node* x)
+			:	n(x) { }
+
+		_skiplist_iterator(_skiplist_iterator const& x)
+			:	n(x.n) { }
+
+		_skiplist_iterator&	operator=(_skiplist_iterator const& x) throw()
+		{
+			n = x.n;
+			return *this;
+		}
+
+		reference			operator*() const throw()
+		{ return n->value; }
+
+		pointer				operator->() const throw()
+		{ return &n->value; }
+
+		/// Move on to the next node that is not being erased.
+		_skiplist_iterator&	operator++() throw()
+		{
+			do
+				n = node::ptr(n->next[0].load(memory_order_acquire));
+			while (n && node::marked(n->next[0].load(memory_order_acquire)));
+			return *this;
+		}
+
+		_skiplist_iterator	operator++(int)
+		{
+			_skiplist_iterator	tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		friend bool	operator==(_skiplist_iterator const& x,
+			_skiplist_iterator const& y) throw()
+		{ return x.n == y.n; }
+
+		friend bool	operator!=(_skiplist_iterator const& x,
+			_skiplist_iterator const& y) throw()
+		{ return x.n != y.n; }
+	};
+
+	/**
+	 * @brief A sorted map of unique keys that many threads can read and
+	 * update at once without a lock, as a lock-free skip list in the
+	 * manner of Fraser's and Herlihy and Shavit's.
+	 *
+	 * A node is inserted by linking it at the bottom level with a
+	 * compare-and-swap, which makes it part of the map, and then at each
+	 * level of its random height. It is erased logically by marking its
+	 * links from the top down, the bottom one deciding which thread erased
+	 * it, and then physically by unlinking it at every level. Searches
+	 * that come across a marked node help unlink it. Erasing does not wait
+	 * for a node to be linked at every level: the inserting thread stops
+	 * linking it once it is marked, and helps unlink it.
+	 *
+	 * Unlinked nodes are freed by epoch based reclamation: operations pin
+	 * the calling thread, and a node is only freed once every thread that
+	 * was pinned when it was unlinked has unpinned, so that lookups never
+	 * wait and never read freed memory.
+	 *
+	 * Values are immutable once inserted. The allocator must be stateless,
+	 * as nodes may be freed after the map is destroyed.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type, rebound to bytes.
+	 */
+	template<typename K, typename T, typename Compare = less<K>,
+		typename A = allocator<pair<K const, T> > >
+	class	concurrent_skiplist_map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Compare				key_compare;
+		typedef	A					allocator_type;
+		typedef	size_t				size_type;
+
+		typedef	_skiplist_iterator<value_type>	iterator;
+		typedef	_skiplist_iterator<value_type>	const_iterator;
+
+		/// The greatest height of a node, enough for 4^16 keys.
+		enum { max_height = 16 };
+
+	private:
+		typedef	_skip_node<value_type>	node;
+		typedef	typename _alloc_traits<A>::template rebind<char>::other
+			byte_alloc_type;
+		typedef	_alloc_traits<byte_alloc_type>	byte_alloc_traits;
+		typedef	typename _alloc_traits<A>::template rebind<value_type>::other
+			value_alloc_type;
+		typedef	_alloc_traits<value_alloc_type>	value_alloc_traits;
+
+		/// A level's predecessors and successors of a key.
+		struct	_window
+		{
+			atomic<size_t>*	preds[max_height];
+			node*			succs[max_height];
+		};
+
+		struct	_skiplist_impl	:	public byte_alloc_type
+		{
+			Compare			comp;
+			atomic<size_t>	head[max_height];
+			char			pad[cache_line_size];
+			atomic<size_t>	size;
+
+			_skiplist_impl(Compare const& c, byte_alloc_type const& a)
+				:	byte_alloc_type(a), comp(c), size(0) { }
+		};
+
+		_skiplist_impl	impl;
+
+		concurrent_skiplist_map(concurrent_skiplist_map const&);
+		concurrent_skiplist_map&	operator=(concurrent_skiplist_map const&);
+
+	public:
+		explicit concurrent_skiplist_map(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	impl(cmp, byte_alloc_type(a)) { }
+
+		/// Free the nodes. No other thread may use the map anymore.
+		~concurrent_skiplist_map() throw()
+		{
+			node*	x = node::ptr(impl.head[0].load());
+
+			while (x)
+			{
+				node* const	next = node::ptr(x->next[0].load());
+
+				reclaim(x);
+				x = next;
+			}
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		key_compare		key_comp() const
+		{ return impl.comp; }
+
+		/**
+		 * @brief Returns the number of elements, which is only exact if no
+		 * other thread changes the map meanwhile.
+		 */
+		size_type	size() const throw()
+		{ return impl.size.load(memory_order_relaxed); }
+
+		bool		empty() const throw()
+		{ return size() == 0; }
+
+		/**
+		 * @brief Returns an iterator to the first element. The iterator
+		 * keeps the calling thread pinned while it lives.
+		 */
+		iterator	begin() const
+		{
+			epoch::guard const			g;
+			node*						n = node::ptr(
+				impl.head[0].load(memory_order_acquire));
+
+			while (n && node::marked(n->next[0].load(memory_order_acquire)))
+				n = node::ptr(n->next[0].load(memory_order_acquire));
+			return iterator(n);
+		}
+
+		iterator	end() const
+		{ return iterator(); }
+
+		/**
+		 * @brief Insert x unless its key is already in the map.
+		 *
+		 * @return bool	Whether x was inserted.
+		 */
+		bool		insert(value_type const& x)
+		{
+			epoch::guard const			g;
+			_window						w;
+			unsigned const				h = random_height();
+			node*						n = 0;
+
+			for (;;)
+			{
+				if (search(x.first, w))
+				{
+					if (n)
+						reclaim(n);
+					return false;
+				}
+				if (!n)
+					n = create(x, h);
+				for (unsigned i = 0; i < h; ++i)
+					n->next[i].store(link(w.succs[i]), memory_order_relaxed);
+
+				size_t	expected = link(w.succs[0]);
+
+				if (w.preds[0][0].compare_exchange_strong(expected, link(n),
+						memory_order_release, memory_order_relaxed))
+					break;
+			}
+			impl.size.fetch_add(1, memory_order_relaxed);
+			for (unsigned i = 1; i < h && link_level(n, i, w); ++i)
+				;
+			// Either this thread sees n marked, or the eraser sees n's
+			// last link when it unlinks n.
+			atomic_thread_fence(memory_order_seq_cst);
+			if (node::marked(n->next[0].load(memory_order_relaxed)))
+				search(x.first, w);
+			release(n);
+			return true;
+		}
+
+		/**
+		 * @brief Erase the element with key k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			epoch::guard const			g;
+			_window						w;
+
+			if (!search(k, w))
+				return 0;
+
+			node* const	n = w.succs[0];
+
+			for (unsigned i = n->height; i-- > 1;)
+				mark(n->next[i]);
+			if (!mark(n->next[0]))
+				return 0;
+			impl.size.fetch_sub(1, memory_order_relaxed);
+			atomic_thread_fence(memory_order_seq_cst);
+			// Unlinks n at every level, as it lies on the search path.
+			search(k, w);
+			release(n);
+			return 1;
+		}
+
+		/**
+		 * @brief Returns an iterator to the element with key k, or end().
+		 * The iterator keeps the calling thread pinned while it lives.
+		 */
+		iterator	find(key_type const& k) const
+		{
+			iterator const	i = lower_bound(k);
+
+			return i == end() || impl.comp(k, i->first) ? end() : i;
+		}
+
+		/**
+		 * @brief Copy the value mapped to k into out, if k is in the map.
+		 *
+		 * @return bool	Whether k was found.
+		 */
+		bool		find(key_type const& k, mapped_type& out) const
+		{
+			epoch::guard const			g;
+			node* const					n = lookup(k);
+
+			if (n)
+				out = n->value.second;
+			return n != 0;
+		}
+
+		size_type	count(key_type const& k) const
+		{
+			epoch::guard const			g;
+
+			return lookup(k) != 0;
+		}
+
+		/**
+		 * @brief Call f with the element with key k, if any, while the
+		 * calling thread is pinned.
+		 *
+		 * @return bool	Whether k was found.
+		 */
+		template<typename F>
+		bool		visit(key_type const& k, F f) const
+		{
+			epoch::guard const			g;
+			node* const					n = lookup(k);
+
+			if (n)
+				f(static_cast<value_type const&>(n->value));
+			return n != 0;
+		}
+
+		/// The first element whose key is not less than k.
+		iterator	lower_bound(key_type const& k) const
+		{
+			epoch::guard const			g;
+			atomic<size_t> const*		preds = impl.head;
+			node*						n = 0;
+
+			for (unsigned i = max_height; i-- > 0;)
+				for (n = node::ptr(preds[i].load(memory_order_acquire)); n
+					&& impl.comp(n->value.first, k);
+					n = node::ptr(preds[i].load(memory_order_acquire)))
+					preds = n->next;
+			while (n && node::marked(n->next[0].load(memory_order_acquire)))
+				n = node::ptr(n->next[0].load(memory_order_acquire));
+			return iterator(n);
+		}
+
+	private:
+		static size_t	link(node* n) throw()
+		{ return reinterpret_cast<size_t>(n); }
+
+		/**
+		 * @brief Returns the node with key k that is not being erased, or
+		 * a null pointer, without writing to the list.
+		 */
+		node*		lookup(key_type const& k) const
+		{
+			atomic<size_t> const*	preds = impl.head;
+			node*					n = 0;
+
+			for (unsigned i = max_height; i-- > 0;)
+				for (n = node::ptr(preds[i].load(memory_order_acquire)); n
+					&& impl.comp(n->value.first, k);
+					n = node::ptr(preds[i].load(memory_order_acquire)))
+					preds = n->next;
+			if (!n || impl.comp(k, n->value.first)
+				|| node::marked(n->next[0].load(memory_order_acquire)))
+				return 0;
+			return n;
+		}
+
+		/**
+		 * @brief Find the links before and the nodes after k at every
+		 * level, unlinking the marked nodes met on the way.
+		 *
+		 * @return bool	Whether the node after k at the bottom level has
+		 * key k.
+		 */
+		bool		search(key_type const& k, _window& w)
+		{
+		retry:
+			atomic<size_t>*	preds = impl.head;
+			node*			curr = 0;
+
+			for (unsigned i = max_height; i-- > 0;)
+			{
+				curr = node::ptr(preds[i].load(memory_order_acquire));
+				while (curr)
+				{
+					size_t	succ = curr->next[i].load(memory_order_acquire);
+
+					while (node::marked(succ))
+					{
+						size_t	expected = link(curr);
+
+						if (!preds[i].compare_exchange_strong(expected,
+								succ & ~size_t(1), memory_order_release,
+								memory_order_relaxed))
+							goto retry;
+						curr = node::ptr(succ);
+						if (!curr)
+							break;
+						succ = curr->next[i].load(memory_order_acquire);
+					}
+					if (!curr || !impl.comp(curr->value.first, k))
+						break;
+					preds = curr->next;
+					curr = node::ptr(succ);
+				}
+				w.preds[i] = preds;
+				w.succs[i] = curr;
+			}
+			return curr && !impl.comp(k, curr->value.first);
+		}
+
+		/**
+		 * @brief Link n, which is linked at the bottom level, at level i,
+		 * searching again each time the list changed around it.
+		 *
+		 * @return bool	false if n is being erased, in which case it is
+		 * not to be linked any higher.
+		 */
+		bool		link_level(node* n, unsigned i, _window& w)
+		{
+			for (;;)
+			{
+				size_t	next = n->next[i].load(memory_order_acquire);
+
+				// Only an eraser changes the link meanwhile, by marking it.
+				if (node::marked(next))
+					return false;
+				if (next != link(w.succs[i])
+					&& !n->next[i].compare_exchange_strong(next,
+						link(w.succs[i]), memory_order_relaxed,
+						memory_order_relaxed))
+					return false;
+
+				size_t	expected = link(w.succs[i]);
+
+				if (w.preds[i][i].compare_exchange_strong(expected, link(n),
+						memory_order_release, memory_order_relaxed))
+					return true;
+				search(n->value.first, w);
+			}
+		}
+
+		/// Let go of n, and retire it if no other thread works on it.
+		static void	release(node* n)
+		{
+			if (n->owners.fetch_sub(1, memory_order_acq_rel) == 1)
+				epoch::defer(n, reclaim);
+		}
+
+		/**
+		 * @brief Set the mark of a link.
+		 *
+		 * @return bool	false if it was already set.
+		 */
+		static bool	mark(atomic<size_t>& l) throw()
+		{
+			size_t	x = l.load(memory_order_relaxed);
+
+			while (!node::marked(x))
+				if (l.compare_exchange_weak(x, x | 1, memory_order_acq_rel,
+						memory_order_relaxed))
+					return true;
+			return false;
+		}
+
+		/**
+		 * @brief Returns a height from 1 to max_height, each one a quarter
+		 * as likely as the one below it.
+		 */
+		static unsigned	random_height() throw()
+		{
+			static __thread unsigned long	seed = 0;
+
+			if (!seed)
+				seed = reinterpret_cast<size_t>(&seed) | 1;
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+			return 1 + __builtin_ctzl(seed | 1UL << (2 * max_height - 2)) / 2;
+		}
+
+		node*		create(value_type const& x, unsigned h)
+		{
+			node* const			n = reinterpret_cast<node*>(
+				byte_alloc_traits::allocate(impl, node::bytes(h)));
+			value_alloc_type	va(impl);
+
+			try
+			{
+				value_alloc_traits::construct(va, &n->value, x);
+			}
+			catch (...)
+			{
+				byte_alloc_traits::deallocate(impl,
+					reinterpret_cast<char*>(n), node::bytes(h));
+				throw;
+			}
+			n->height = h;
+			::new(static_cast<void*>(&n->owners)) atomic<int>(2);
+			for (unsigned i = 0; i < h; ++i)
+				::new(static_cast<void*>(n->next + i)) atomic<size_t>(0);
+			return n;
+		}
+
+		/// Destroy and free a node, with a new allocator as it may outlive
+		/// the map.
+		static void	reclaim(void* p)
+		{
+			node* const			n = static_cast<node*>(p);
+			byte_alloc_type		a;
+			value_alloc_type	va(a);
+
+			value_alloc_traits::destroy(va, &n->value);
+			byte_alloc_traits::deallocate(a, reinterpret_cast<char*>(n),
+				node::bytes(n->height));
+		}
+	};
+}
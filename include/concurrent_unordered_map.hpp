@@ -0,0 +1,366 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <atomic.hpp>
+#include <functional.hpp>
+#include <memory.hpp>
+#include <unordered_map.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief An unordered map of unique keys that many threads can read and
+	 * update at once.
+	 *
+	 * Keys are split by hash across a power of two number of shards, each
+	 * an unordered_map of its own behind a reader-writer spinlock on its
+	 * own cache lines. Threads working on keys of different shards never
+	 * contend, and lookups of the same shard share it.
+	 *
+	 * Elements are never handed out by reference, as another thread could
+	 * erase them or rehash their table as soon as the lock is released:
+	 * visit() and the update functions call a function object with the
+	 * element while its shard is locked instead. These function objects
+	 * must be short, and must not call back into the map.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Hash		The hash function, called once to pick a shard and
+	 * once more within it.
+	 * @tparam Pred		The key equality.
+	 * @tparam A		The allocator type.
+	 */
+	template<typename K, typename T, typename Hash = hash<K>,
+		typename Pred = equal_to<K>, typename A = allocator<pair<K const, T> > >
+	class	concurrent_unordered_map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Hash				hasher;
+		typedef	Pred				key_equal;
+		typedef	A					allocator_type;
+		typedef	size_t				size_type;
+
+	private:
+		typedef	unordered_map<K, T, Hash, Pred, A>	map_type;
+		typedef	typename map_type::iterator			map_iterator;
+		typedef	typename map_type::const_iterator	map_const_iterator;
+
+		/// A table and its lock, padded so that no two shards share a line.
+		struct	_shard
+		{
+			rw_spinlock	lock;
+			map_type	map;
+			char		pad[cache_line_size];
+
+			_shard(Hash const& h, Pred const& eq, A const& a)
+				:	map(0, h, eq, a) { }
+		};
+
+		typedef	typename _alloc_traits<A>::template rebind<_shard>::other
+			shard_alloc_type;
+		typedef	_alloc_traits<shard_alloc_type>	shard_alloc_traits;
+
+		/// Holds a shard's lock for writing until the end of the scope.
+		struct	_write_guard
+		{
+			rw_spinlock&	lock;
+
+			explicit _write_guard(rw_spinlock& l) throw()
+				:	lock(l)
+			{ lock.lock(); }
+
+			~_write_guard() throw()
+			{ lock.unlock(); }
+		};
+
+		/// Holds a shard's lock for reading until the end of the scope.
+		struct	_read_guard
+		{
+			rw_spinlock&	lock;
+
+			explicit _read_guard(rw_spinlock& l) throw()
+				:	lock(l)
+			{ lock.lock_shared(); }
+
+			~_read_guard() throw()
+			{ lock.unlock_shared(); }
+		};
+
+		struct	_concurrent_impl	:	public shard_alloc_type
+		{
+			Hash		hash;
+			_shard*		shards;
+			size_t		count;
+			/// 64 minus the base 2 logarithm of count.
+			unsigned	shift;
+
+			_concurrent_impl(Hash const& h, shard_alloc_type const& a)
+				:	shard_alloc_type(a), hash(h), shards(), count(), shift()
+			{ }
+		};
+
+		_concurrent_impl	impl;
+
+		concurrent_unordered_map(concurrent_unordered_map const&);
+		concurrent_unordered_map&	operator=(concurrent_unordered_map const&);
+
+	public:
+		/**
+		 * @brief Construct an empty map of at least n shards, rounded up to
+		 * a power of two. A few times the number of threads that update
+		 * the map at once keeps them from waiting on each other.
+		 */
+		explicit concurrent_unordered_map(size_type n = 64,
+			hasher const& h = hasher(), key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	impl(h, shard_alloc_type(a))
+		{
+			size_t	count = 1;
+			size_t	built = 0;
+
+			while (count < n)
+				count *= 2;
+			impl.shards = shard_alloc_traits::allocate(impl, count);
+			try
+			{
+				for (; built < count; ++built)
+					::new(static_cast<void*>(impl.shards + built))
+						_shard(h, eq, a);
+			}
+			catch (...)
+			{
+				while (built--)
+					impl.shards[built].~_shard();
+				shard_alloc_traits::deallocate(impl, impl.shards, count);
+				throw;
+			}
+			impl.count = count;
+			impl.shift = sizeof(size_t) * 8 - __builtin_ctzl(count);
+		}
+
+		~concurrent_unordered_map() throw()
+		{
+			for (size_t i = 0; i < impl.count; ++i)
+				impl.shards[i].~_shard();
+			shard_alloc_traits::deallocate(impl, impl.shards, impl.count);
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		hasher		hash_function() const
+		{ return impl.hash; }
+
+		/// The number of shards.
+		size_type	shard_count() const throw()
+		{ return impl.count; }
+
+		/**
+		 * @brief Returns the number of elements, summed over the shards one
+		 * at a time, which is only exact if no other thread changes the
+		 * map meanwhile.
+		 */
+		size_type	size() const
+		{
+			size_t	n = 0;
+
+			for (size_t i = 0; i < impl.count; ++i)
+			{
+				_read_guard const	g(impl.shards[i].lock);
+
+				n += impl.shards[i].map.size();
+			}
+			return n;
+		}
+
+		bool		empty() const
+		{ return size() == 0; }
+
+		/**
+		 * @brief Insert x unless its key is already in the map.
+		 *
+		 * @return bool	Whether x was inserted.
+		 */
+		bool		insert(value_type const& x)
+		{
+			_shard&				s = shard_of(x.first);
+			_write_guard const	g(s.lock);
+
+			return s.map.insert(x).second;
+		}
+
+		/**
+		 * @brief Insert x if its key is not in the map, and call f with the
+		 * mapped value of the element with that key otherwise.
+		 *
+		 * @return bool	Whether x was inserted.
+		 */
+		template<typename F>
+		bool		insert_or_update(value_type const& x, F f)
+		{
+			_shard&				s = shard_of(x.first);
+			_write_guard const	g(s.lock);
+			pair<map_iterator, bool> const	p = s.map.insert(x);
+
+			if (!p.second)
+				f(p.first->second);
+			return p.second;
+		}
+
+		/**
+		 * @brief Insert x, or assign x's mapped value to the element with
+		 * its key.
+		 *
+		 * @return bool	Whether x was inserted.
+		 */
+		bool		insert_or_assign(value_type const& x)
+		{
+			_shard&				s = shard_of(x.first);
+			_write_guard const	g(s.lock);
+			pair<map_iterator, bool> const	p = s.map.insert(x);
+
+			if (!p.second)
+				p.first->second = x.second;
+			return p.second;
+		}
+
+		/**
+		 * @brief Call f with the element with key k, if any, while holding
+		 * its shard for reading.
+		 *
+		 * @return bool	Whether k was found.
+		 */
+		template<typename F>
+		bool		visit(key_type const& k, F f) const
+		{
+			_shard&				s = shard_of(k);
+			_read_guard const	g(s.lock);
+			map_const_iterator	i = s.map.find(k);
+
+			if (i == s.map.end())
+				return false;
+			f(*i);
+			return true;
+		}
+
+		/**
+		 * @brief Call f with the mapped value of the element with key k, if
+		 * any, while holding its shard for writing.
+		 *
+		 * @return bool	Whether k was found.
+		 */
+		template<typename F>
+		bool		update(key_type const& k, F f)
+		{
+			_shard&				s = shard_of(k);
+			_write_guard const	g(s.lock);
+			map_iterator		i = s.map.find(k);
+
+			if (i == s.map.end())
+				return false;
+			f(i->second);
+			return true;
+		}
+
+		/**
+		 * @brief Call f with every element, holding each shard for reading
+		 * in turn, so that f sees each shard at a single point in time but
+		 * not the whole map.
+		 */
+		template<typename F>
+		void		visit_all(F f) const
+		{
+			for (size_t i = 0; i < impl.count; ++i)
+			{
+				map_type const&		m = impl.shards[i].map;
+				_read_guard const	g(impl.shards[i].lock);
+
+				for (map_const_iterator j = m.begin(); j != m.end(); ++j)
+					f(*j);
+			}
+		}
+
+		/**
+		 * @brief Copy the value mapped to k into out, if k is in the map.
+		 *
+		 * @return bool	Whether k was found.
+		 */
+		bool		find(key_type const& k, mapped_type& out) const
+		{
+			_shard&				s = shard_of(k);
+			_read_guard const	g(s.lock);
+			map_const_iterator	i = s.map.find(k);
+
+			if (i == s.map.end())
+				return false;
+			out = i->second;
+			return true;
+		}
+
+		size_type	count(key_type const& k) const
+		{
+			_shard&				s = shard_of(k);
+			_read_guard const	g(s.lock);
+
+			return s.map.count(k);
+		}
+
+		/**
+		 * @brief Erase the element with key k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			_shard&				s = shard_of(k);
+			_write_guard const	g(s.lock);
+
+			return s.map.erase(k);
+		}
+
+		/// Erase every element, one shard at a time.
+		void		clear()
+		{
+			for (size_t i = 0; i < impl.count; ++i)
+			{
+				_write_guard const	g(impl.shards[i].lock);
+
+				impl.shards[i].map.clear();
+			}
+		}
+
+		/// Make room for n elements in total, spread evenly over the shards.
+		void		reserve(size_type n)
+		{
+			// Shards get more keys than the average, by a few deviations.
+			size_t const	per_shard = n / impl.count + n / impl.count / 8
+				+ 1;
+
+			for (size_t i = 0; i < impl.count; ++i)
+			{
+				_write_guard const	g(impl.shards[i].lock);
+
+				impl.shards[i].map.reserve(per_shard);
+			}
+		}
+
+	private:
+		/**
+		 * @brief The shard of k, from the high bits of its hash times a
+		 * constant other than the one its table mixes it with, so that the
+		 * keys of a shard are spread over its table.
+		 */
+		_shard&		shard_of(key_type const& k) const
+		{
+			size_t const	h = impl.hash(k) * size_t(0xC2B2AE3D27D4EB4FUL);
+
+			return impl.shards[impl.count > 1 ? h >> impl.shift : 0];
+		}
+	};
+}
@@ -0,0 +1,1111 @@
+#pragma once
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <type_traits.hpp>
+
+namespace ft
+{
+	/// The size in bytes of a deque block.
+	enum { _deque_block_bytes = 512 };
+
+	/**
+	 * @brief Returns the number of elements of a given size that fit in a
+	 * deque block, at least one.
+	 */
+	inline size_t	_deque_buf_size(size_t size) throw()
+	{ return size < _deque_block_bytes ? _deque_block_bytes / size : 1; }
+
+	/**
+	 * @brief A deque::iterator or deque::const_iterator.
+	 *
+	 * Holds the element, the bounds of the block it lives in, and the slot of
+	 * that block in the deque's map.
+	 *
+	 * @tparam T	The deque's data type.
+	 * @tparam Ref	The reference type.
+	 * @tparam Ptr	The pointer type.
+	 */
+	template<typename T, typename Ref, typename Ptr>
+	struct	_deque_iterator
+	{
+		typedef	_deque_iterator<T, T&, T*>				iterator;
+		typedef	_deque_iterator<T, T const&, T const*>	const_iterator;
+		typedef	_deque_iterator							_self;
+		typedef	T**										map_pointer;
+
+		typedef	random_access_iterator_tag	iterator_category;
+		typedef	T							value_type;
+		typedef	Ptr							pointer;
+		typedef	Ref							reference;
+		typedef	ptrdiff_t					difference_type;
+
+		T*			cur;
+		T*			first;
+		T*			last;
+		map_pointer	node;
+
+		static difference_type	buffer_size() throw()
+		{ return difference_type(_deque_buf_size(sizeof(T))); }
+
+		_deque_iterator() throw()
+			:	cur(), first(), last(), node() { }
+
+		_deque_iterator(T* x, map_pointer y) throw()
+			:	cur(x), first(*y), last(*y + buffer_size()), node(y) { }
+
+		_deque_iterator(iterator const& x) throw()
+			:	cur(x.cur), first(x.first), last(x.last), node(x.node) { }
+
+		iterator	_const_cast() const throw()
+		{ return iterator(cur, node); }
+
+		reference	operator*() const throw()
+		{ return *cur; }
+
+		pointer		operator->() const throw()
+		{ return cur; }
+
+		_self&		operator++() throw()
+		{
+			if (++cur == last)
+			{
+				set_node(node + 1);
+				cur = first;
+			}
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_self&		operator--() throw()
+		{
+			if (cur == first)
+			{
+				set_node(node - 1);
+				cur = last;
+			}
+			--cur;
+			return *this;
+		}
+
+		_self		operator--(int) throw()
+		{
+			_self	tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		_self&		operator+=(difference_type n) throw()
+		{
+			difference_type const	offset = n + (cur - first);
+
+			if (offset >= 0 && offset < buffer_size())
+				cur += n;
+			else
+			{
+				difference_type const	node_offset = offset > 0
+					? offset / buffer_size()
+					: -difference_type((-offset - 1) / buffer_size()) - 1;
+
+				set_node(node + node_offset);
+				cur = first + (offset - node_offset * buffer_size());
+			}
+			return *this;
+		}
+
+		_self&		operator-=(difference_type n) throw()
+		{ return *this += -n; }
+
+		_self		operator+(difference_type n) const throw()
+		{
+			_self	tmp = *this;
+			return tmp += n;
+		}
+
+		_self		operator-(difference_type n) const throw()
+		{
+			_self	tmp = *this;
+			return tmp -= n;
+		}
+
+		reference	operator[](difference_type n) const throw()
+		{ return *(*this + n); }
+
+		/**
+		 * @brief Move to another block, without changing cur.
+		 */
+		void		set_node(map_pointer new_node) throw()
+		{
+			node = new_node;
+			first = *new_node;
+			last = first + buffer_size();
+		}
+	};
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator==(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{ return x.cur == y.cur; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator!=(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{ return x.cur != y.cur; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator<(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{ return x.node == y.node ? x.cur < y.cur : x.node < y.node; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator>(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{ return y < x; }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator<=(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{ return !(y < x); }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator>=(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{ return !(x < y); }
+
+	template<typename T, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline ptrdiff_t	operator-(_deque_iterator<T, Rl, Pl> const& x,
+		_deque_iterator<T, Rr, Pr> const& y) throw()
+	{
+		return _deque_iterator<T, Rl, Pl>::buffer_size()
+			* (x.node - y.node - 1) + (x.cur - x.first) + (y.last - y.cur);
+	}
+
+	template<typename T, typename R, typename P>
+	inline _deque_iterator<T, R, P>	operator+(ptrdiff_t n,
+		_deque_iterator<T, R, P> const& x) throw()
+	{ return x + n; }
+
+	template<typename T, typename A>
+	class	_deque_base
+	{
+	protected:
+		typedef	typename _alloc_traits<A>::template rebind<T>::other
+			T_alloc_type;
+		typedef	_alloc_traits<T_alloc_type>		T_alloc_traits;
+		typedef	typename T_alloc_traits::template rebind<T*>::other
+			map_alloc_type;
+		typedef	_alloc_traits<map_alloc_type>	map_alloc_traits;
+
+		typedef	_deque_iterator<T, T&, T*>				iterator;
+		typedef	_deque_iterator<T, T const&, T const*>	const_iterator;
+		typedef	T**										map_pointer;
+
+		/// The smallest number of slots in a map.
+		enum { initial_map_size = 8 };
+
+		struct	_deque_impl	:	public T_alloc_type
+		{
+			map_pointer	map;
+			size_t		map_size;
+			iterator	start;
+			iterator	finish;
+
+			_deque_impl()
+				:	T_alloc_type(), map(), map_size(0), start(), finish() { }
+
+			_deque_impl(T_alloc_type const& a)
+				:	T_alloc_type(a), map(), map_size(0), start(), finish() { }
+
+			void	swap_data(_deque_impl& x) throw()
+			{
+				ft::swap(map, x.map);
+				ft::swap(map_size, x.map_size);
+				ft::swap(start, x.start);
+				ft::swap(finish, x.finish);
+			}
+		};
+
+		_deque_impl	impl;
+
+		T*			allocate_node()
+		{ return T_alloc_traits::allocate(impl, _deque_buf_size(sizeof(T))); }
+
+		void		deallocate_node(T* p) throw()
+		{ T_alloc_traits::deallocate(impl, p, _deque_buf_size(sizeof(T))); }
+
+		map_pointer	allocate_map(size_t n)
+		{
+			map_alloc_type	map_alloc(get_T_allocator());
+			return map_alloc_traits::allocate(map_alloc, n);
+		}
+
+		void		deallocate_map(map_pointer p, size_t n) throw()
+		{
+			map_alloc_type	map_alloc(get_T_allocator());
+			map_alloc_traits::deallocate(map_alloc, p, n);
+		}
+
+		void	create_nodes(map_pointer nstart, map_pointer nfinish)
+		{
+			map_pointer	cur = nstart;
+
+			try
+			{
+				for (; cur < nfinish; ++cur)
+					*cur = allocate_node();
+			}
+			catch (...)
+			{
+				destroy_nodes(nstart, cur);
+				throw;
+			}
+		}
+
+		void	destroy_nodes(map_pointer nstart, map_pointer nfinish) throw()
+		{
+			for (map_pointer n = nstart; n < nfinish; ++n)
+				deallocate_node(*n);
+		}
+
+		/**
+		 * @brief Allocate a map with room to grow at both ends, and the
+		 * blocks that are needed to hold num_elements elements.
+		 */
+		void	initialize_map(size_t num_elements)
+		{
+			size_t const	buf_size = _deque_buf_size(sizeof(T));
+			size_t const	num_nodes = num_elements / buf_size + 1;
+
+			impl.map_size = ft::max(size_t(initial_map_size), num_nodes + 2);
+			impl.map = allocate_map(impl.map_size);
+
+			map_pointer	nstart = impl.map + (impl.map_size - num_nodes) / 2;
+			map_pointer	nfinish = nstart + num_nodes;
+
+			try
+			{
+				create_nodes(nstart, nfinish);
+			}
+			catch (...)
+			{
+				deallocate_map(impl.map, impl.map_size);
+				impl.map = map_pointer();
+				impl.map_size = 0;
+				throw;
+			}
+			impl.start.set_node(nstart);
+			impl.finish.set_node(nfinish - 1);
+			impl.start.cur = impl.start.first;
+			impl.finish.cur = impl.finish.first + num_elements % buf_size;
+		}
+
+	public:
+		typedef	A	allocator_type;
+
+		T_alloc_type&		get_T_allocator() throw()
+		{ return impl; }
+
+		T_alloc_type const&	get_T_allocator() const throw()
+		{ return impl; }
+
+		allocator_type		get_allocator() const throw()
+		{ return allocator_type(get_T_allocator()); }
+
+		_deque_base()
+		{ initialize_map(0); }
+
+		_deque_base(allocator_type const& a, size_t num_elements)
+			:	impl(a)
+		{ initialize_map(num_elements); }
+
+		~_deque_base() throw()
+		{
+			if (impl.map)
+			{
+				destroy_nodes(impl.start.node, impl.finish.node + 1);
+				deallocate_map(impl.map, impl.map_size);
+			}
+		}
+	};
+
+	/**
+	 * @brief A double-ended queue, stored as a map of fixed-size blocks.
+	 *
+	 * Pushing and popping at either end is constant time and never moves the
+	 * other elements, growing only reallocates the map of block pointers.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename A = allocator<T> >
+	class	deque	:	protected _deque_base<T, A>
+	{
+	private:
+		typedef	_deque_base<T, A>				base;
+		typedef	typename base::T_alloc_type		T_alloc_type;
+		typedef	typename base::T_alloc_traits	T_alloc_traits;
+		typedef	typename base::map_pointer		map_pointer;
+
+	public:
+		typedef T											value_type;
+		typedef typename T_alloc_traits::pointer			pointer;
+		typedef typename T_alloc_traits::const_pointer		const_pointer;
+		typedef typename T_alloc_traits::reference			reference;
+		typedef typename T_alloc_traits::const_reference	const_reference;
+
+		typedef typename base::iterator					iterator;
+		typedef typename base::const_iterator			const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		typedef size_t					size_type;
+		typedef ptrdiff_t				difference_type;
+		typedef A						allocator_type;
+
+	protected:
+		using	base::impl;
+		using	base::allocate_node;
+		using	base::deallocate_node;
+		using	base::allocate_map;
+		using	base::deallocate_map;
+		using	base::create_nodes;
+		using	base::destroy_nodes;
+		using	base::get_T_allocator;
+
+		static size_type	buffer_size() throw()
+		{ return _deque_buf_size(sizeof(T)); }
+
+	public:
+		deque() { }
+
+		explicit deque(allocator_type const& a)	:	base(a, 0) { }
+
+		explicit deque(size_type n, value_type const& value = value_type(),
+			allocator_type const& a = allocator_type())
+			:	base(a, check_init_len(n, a))
+		{ fill_initialize(value); }
+
+		deque(deque const& x)
+			:	base(T_alloc_traits::select_on_copy(x.get_T_allocator()),
+				x.size())
+		{
+			_uninitialized_copy_a(x.begin(), x.end(), impl.start,
+				get_T_allocator());
+		}
+
+		template<typename I>
+		deque(I first, I last, allocator_type const& a = allocator_type())
+			:	base(a, 0)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			initialize_dispatch(first, last, Integral());
+		}
+
+		~deque() throw()
+		{ destroy_data(begin(), end()); }
+
+		deque&	operator=(deque const& x)
+		{
+			if (&x != this)
+			{
+				size_type const	len = size();
+
+				if (len >= x.size())
+					erase_at_end(ft::copy(x.begin(), x.end(), begin()));
+				else
+				{
+					const_iterator	mid = x.begin()
+						+ difference_type(len);
+
+					ft::copy(x.begin(), mid, begin());
+					range_insert_aux(end(), mid, x.end(),
+						forward_iterator_tag());
+				}
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Replace the contents with n copies of val.
+		 */
+		void	assign(size_type n, value_type const& val)
+		{ fill_assign(n, val); }
+
+		/**
+		 * @brief Replace the contents with a copy of the range [first, last).
+		 */
+		template<typename I>
+		void	assign(I first, I last)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			assign_dispatch(first, last, Integral());
+		}
+
+		using	base::get_allocator;
+
+		iterator				begin() throw()
+		{ return impl.start; }
+
+		const_iterator			begin() const throw()
+		{ return impl.start; }
+
+		iterator				end() throw()
+		{ return impl.finish; }
+
+		const_iterator			end() const throw()
+		{ return impl.finish; }
+
+		reverse_iterator		rbegin() throw()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
+		/**
+		 * @brief Returns the number of elements in the deque.
+		 */
+		size_type	size() const throw()
+		{ return size_type(impl.finish - impl.start); }
+
+		/**
+		 * @brief Returns the size of the largest possible deque.
+		 */
+		size_type	max_size() const throw()
+		{ return T_alloc_traits::max_size(get_T_allocator()); }
+
+		/**
+		 * @brief Resizes the deque to the specified number of elements.
+		 *
+		 * Longer deques are truncated, otherwise it is extended with copies
+		 * of the given value.
+		 *
+		 * @param new_size	The new number of elements
+		 * @param x			The new elements value
+		 */
+		void	resize(size_type new_size, value_type x = value_type())
+		{
+			size_type const	len = size();
+
+			if (new_size > len)
+				fill_insert(end(), new_size - len, x);
+			else if (new_size < len)
+				erase_at_end(begin() + difference_type(new_size));
+		}
+
+		/**
+		 * @brief Returns true if the deque is empty.
+		 */
+		bool	empty() const throw()
+		{ return impl.finish == impl.start; }
+
+		reference		operator[](size_type n) throw()
+		{ return impl.start[difference_type(n)]; }
+
+		const_reference	operator[](size_type n) const throw()
+		{ return impl.start[difference_type(n)]; }
+
+		/**
+		 * @brief Returns a reference to the element at index n.
+		 *
+		 * @throw OutOfRangeException if n is not less than size().
+		 */
+		reference		at(size_type n)
+		{ range_check(n); return (*this)[n]; }
+
+		const_reference	at(size_type n) const
+		{ range_check(n); return (*this)[n]; }
+
+		reference		front() throw()
+		{ return *begin(); }
+
+		const_reference	front() const throw()
+		{ return *begin(); }
+
+		reference		back() throw()
+		{
+			iterator	tmp = end();
+			--tmp;
+			return *tmp;
+		}
+
+		const_reference	back() const throw()
+		{
+			const_iterator	tmp = end();
+			--tmp;
+			return *tmp;
+		}
+
+		/**
+		 * @brief Add data to the front of the deque.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	push_front(value_type const& x)
+		{
+			if (impl.start.cur != impl.start.first)
+			{
+				get_T_allocator().construct(impl.start.cur - 1, x);
+				--impl.start.cur;
+			}
+			else
+				push_front_aux(x);
+		}
+
+		/**
+		 * @brief Add data to the back of the deque.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	push_back(value_type const& x)
+		{
+			if (impl.finish.cur != impl.finish.last - 1)
+			{
+				get_T_allocator().construct(impl.finish.cur, x);
+				++impl.finish.cur;
+			}
+			else
+				push_back_aux(x);
+		}
+
+		/**
+		 * @brief Removes the deque's first element.
+		 */
+		void	pop_front() throw()
+		{
+			if (impl.start.cur != impl.start.last - 1)
+			{
+				get_T_allocator().destroy(impl.start.cur);
+				++impl.start.cur;
+			}
+			else
+				pop_front_aux();
+		}
+
+		/**
+		 * @brief Removes the deque's last element.
+		 */
+		void	pop_back() throw()
+		{
+			if (impl.finish.cur != impl.finish.first)
+			{
+				--impl.finish.cur;
+				get_T_allocator().destroy(impl.finish.cur);
+			}
+			else
+				pop_back_aux();
+		}
+
+		/**
+		 * @brief Insert given value before the specified iterator.
+		 *
+		 * @param position	The next element's iterator.
+		 * @param x			The data to be added.
+		 * @return			The new element's iterator.
+		 */
+		iterator	insert(iterator position, value_type const& x)
+		{
+			if (position.cur == impl.start.cur)
+			{
+				push_front(x);
+				return impl.start;
+			}
+			if (position.cur == impl.finish.cur)
+			{
+				push_back(x);
+				iterator	tmp = impl.finish;
+				--tmp;
+				return tmp;
+			}
+
+			difference_type const	index = position - begin();
+
+			fill_insert(position, 1, x);
+			return begin() + index;
+		}
+
+		/**
+		 * @brief Insert given value before the specified iterator multiple
+		 * times.
+		 *
+		 * @param position	The next element's iterator.
+		 * @param n			The number of elements to add.
+		 * @param x			The data to be added.
+		 */
+		void	insert(iterator position, size_type n, value_type const& x)
+		{ fill_insert(position, n, x); }
+
+		/**
+		 * @brief Inserts a range into the deque.
+		 *
+		 * @param position	The next element's iterator.
+		 * @param first		An input iterator.
+		 * @param last		An input iterator.
+		 */
+		template<typename I>
+		void	insert(iterator position, I first, I last)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			insert_dispatch(position, first, last, Integral());
+		}
+
+		/**
+		 * @brief Remove an element, shifting the shorter side of the deque.
+		 */
+		iterator	erase(iterator position)
+		{
+			iterator				next = position;
+			difference_type const	index = position - begin();
+
+			++next;
+			if (size_type(index) < size() / 2)
+			{
+				if (position != begin())
+					ft::copy_backward(begin(), position, next);
+				pop_front();
+			}
+			else
+			{
+				if (next != end())
+					ft::copy(next, end(), position);
+				pop_back();
+			}
+			return begin() + index;
+		}
+
+		/**
+		 * @brief Remove a range of elements, shifting the shorter side of the
+		 * deque.
+		 */
+		iterator	erase(iterator first, iterator last)
+		{
+			if (first == last)
+				return first;
+			if (first == begin() && last == end())
+			{
+				clear();
+				return end();
+			}
+
+			difference_type const	n = last - first;
+			difference_type const	elems_before = first - begin();
+
+			if (size_type(elems_before) < (size() - n) / 2)
+			{
+				if (first != begin())
+					ft::copy_backward(begin(), first, last);
+				erase_at_begin(begin() + n);
+			}
+			else
+			{
+				if (last != end())
+					ft::copy(last, end(), first);
+				erase_at_end(end() - n);
+			}
+			return begin() + elems_before;
+		}
+
+		/**
+		 * @brief Swaps data with another deque.
+		 *
+		 * @param x	A deque of the same element and allocator types.
+		 */
+		void	swap(deque& x) throw()
+		{
+			impl.swap_data(x.impl);
+			T_alloc_traits::on_swap(get_T_allocator(), x.get_T_allocator());
+		}
+
+		/**
+		 * @brief Erases all the elements, keeping a single block.
+		 */
+		void	clear() throw()
+		{ erase_at_end(begin()); }
+
+	protected:
+		static size_type	check_init_len(size_type n,
+			allocator_type const& a)
+		{
+			if (n > T_alloc_traits::max_size(T_alloc_type(a)))
+				throw LengthErrorException();
+			return n;
+		}
+
+		void	range_check(size_type n) const
+		{
+			if (n >= size())
+				throw OutOfRangeException();
+		}
+
+		void	destroy_data(iterator first, iterator last) throw()
+		{ ft::destroy(first, last, get_T_allocator()); }
+
+		void	fill_initialize(value_type const& value)
+		{
+			map_pointer	cur = impl.start.node;
+
+			try
+			{
+				for (; cur < impl.finish.node; ++cur)
+					_uninitialized_fill_n_a(*cur, buffer_size(), value,
+						get_T_allocator());
+				_uninitialized_fill_n_a(impl.finish.first,
+					impl.finish.cur - impl.finish.first, value,
+					get_T_allocator());
+			}
+			catch (...)
+			{
+				destroy_data(impl.start, iterator(*cur, cur));
+				throw;
+			}
+		}
+
+		template<typename Integer>
+		void	initialize_dispatch(Integer n, Integer x, true_type)
+		{ fill_insert(end(), static_cast<size_type>(n), x); }
+
+		template<typename I>
+		void	initialize_dispatch(I first, I last, false_type)
+		{
+			range_insert_aux(end(), first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		/**
+		 * @brief Make sure that the map has room for nodes_to_add more
+		 * blocks after the last one.
+		 */
+		void	reserve_map_at_back(size_type nodes_to_add = 1)
+		{
+			if (nodes_to_add + 1
+				> impl.map_size - (impl.finish.node - impl.map))
+				reallocate_map(nodes_to_add, false);
+		}
+
+		/**
+		 * @brief Make sure that the map has room for nodes_to_add more
+		 * blocks before the first one.
+		 */
+		void	reserve_map_at_front(size_type nodes_to_add = 1)
+		{
+			if (nodes_to_add > size_type(impl.start.node - impl.map))
+				reallocate_map(nodes_to_add, true);
+		}
+
+		/**
+		 * @brief Recenter the block pointers in the map, or move them to a
+		 * larger map. The elements themselves never move.
+		 */
+		void	reallocate_map(size_type nodes_to_add, bool add_at_front)
+		{
+			size_type const	old_num_nodes
+				= impl.finish.node - impl.start.node + 1;
+			size_type const	new_num_nodes = old_num_nodes + nodes_to_add;
+			map_pointer		new_nstart;
+
+			if (impl.map_size > 2 * new_num_nodes)
+			{
+				new_nstart = impl.map + (impl.map_size - new_num_nodes) / 2
+					+ (add_at_front ? nodes_to_add : 0);
+				if (new_nstart < impl.start.node)
+					ft::copy(impl.start.node, impl.finish.node + 1,
+						new_nstart);
+				else
+					ft::copy_backward(impl.start.node, impl.finish.node + 1,
+						new_nstart + old_num_nodes);
+			}
+			else
+			{
+				size_type const	new_map_size = impl.map_size
+					+ ft::max(impl.map_size, nodes_to_add) + 2;
+				map_pointer		new_map = allocate_map(new_map_size);
+
+				new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+					+ (add_at_front ? nodes_to_add : 0);
+				ft::copy(impl.start.node, impl.finish.node + 1, new_nstart);
+				deallocate_map(impl.map, impl.map_size);
+				impl.map = new_map;
+				impl.map_size = new_map_size;
+			}
+			impl.start.set_node(new_nstart);
+			impl.finish.set_node(new_nstart + old_num_nodes - 1);
+		}
+
+		void	push_back_aux(value_type const& x)
+		{
+			reserve_map_at_back();
+			*(impl.finish.node + 1) = allocate_node();
+			try
+			{
+				get_T_allocator().construct(impl.finish.cur, x);
+				impl.finish.set_node(impl.finish.node + 1);
+				impl.finish.cur = impl.finish.first;
+			}
+			catch (...)
+			{
+				deallocate_node(*(impl.finish.node + 1));
+				throw;
+			}
+		}
+
+		void	push_front_aux(value_type const& x)
+		{
+			reserve_map_at_front();
+			*(impl.start.node - 1) = allocate_node();
+			try
+			{
+				impl.start.set_node(impl.start.node - 1);
+				impl.start.cur = impl.start.last - 1;
+				get_T_allocator().construct(impl.start.cur, x);
+			}
+			catch (...)
+			{
+				++impl.start;
+				deallocate_node(*(impl.start.node - 1));
+				throw;
+			}
+		}
+
+		void	pop_back_aux() throw()
+		{
+			deallocate_node(impl.finish.first);
+			impl.finish.set_node(impl.finish.node - 1);
+			impl.finish.cur = impl.finish.last - 1;
+			get_T_allocator().destroy(impl.finish.cur);
+		}
+
+		void	pop_front_aux() throw()
+		{
+			get_T_allocator().destroy(impl.start.cur);
+			deallocate_node(impl.start.first);
+			impl.start.set_node(impl.start.node + 1);
+			impl.start.cur = impl.start.first;
+		}
+
+		/**
+		 * @brief Destroy the elements before pos, and free their blocks.
+		 */
+		void	erase_at_begin(iterator pos) throw()
+		{
+			destroy_data(begin(), pos);
+			destroy_nodes(impl.start.node, pos.node);
+			impl.start = pos;
+		}
+
+		/**
+		 * @brief Destroy the elements from pos, and free their blocks.
+		 */
+		void	erase_at_end(iterator pos) throw()
+		{
+			destroy_data(pos, end());
+			destroy_nodes(pos.node + 1, impl.finish.node + 1);
+			impl.finish = pos;
+		}
+
+		void	fill_assign(size_type n, value_type const& val)
+		{
+			if (n > size())
+			{
+				ft::fill(begin(), end(), val);
+				fill_insert(end(), n - size(), val);
+			}
+			else
+			{
+				erase_at_end(begin() + difference_type(n));
+				ft::fill(begin(), end(), val);
+			}
+		}
+
+		template<typename Integer>
+		void	assign_dispatch(Integer n, Integer val, true_type)
+		{ fill_assign(static_cast<size_type>(n), val); }
+
+		template<typename I>
+		void	assign_dispatch(I first, I last, false_type)
+		{
+			iterator	cur = begin();
+
+			for (; first != last && cur != end(); ++cur, ++first)
+				*cur = *first;
+			if (first == last)
+				erase_at_end(cur);
+			else
+				range_insert_aux(end(), first, last,
+					typename iterator_traits<I>::iterator_category());
+		}
+
+		template<typename Integer>
+		void	insert_dispatch(iterator pos, Integer n, Integer x, true_type)
+		{ fill_insert(pos, static_cast<size_type>(n), x); }
+
+		template<typename I>
+		void	insert_dispatch(iterator pos, I first, I last, false_type)
+		{
+			range_insert_aux(pos, first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		/**
+		 * @brief Open a gap of n copies of filler before position, by
+		 * pushing them at the closest end and shifting the elements in
+		 * between.
+		 *
+		 * @return iterator	The gap's first element.
+		 */
+		iterator	open_gap(iterator position, size_type n,
+			value_type const& filler)
+		{
+			difference_type const	elems_before = position - begin();
+			size_type				pushed = 0;
+
+			if (size_type(elems_before) < size() / 2)
+			{
+				try
+				{
+					for (; pushed < n; ++pushed)
+						push_front(filler);
+				}
+				catch (...)
+				{
+					for (; pushed; --pushed)
+						pop_front();
+					throw;
+				}
+
+				iterator const	start = begin();
+
+				ft::copy(start + difference_type(n),
+					start + difference_type(n) + elems_before, start);
+			}
+			else
+			{
+				try
+				{
+					for (; pushed < n; ++pushed)
+						push_back(filler);
+				}
+				catch (...)
+				{
+					for (; pushed; --pushed)
+						pop_back();
+					throw;
+				}
+
+				iterator const	finish = end();
+
+				ft::copy_backward(begin() + elems_before,
+					finish - difference_type(n), finish);
+			}
+			return begin() + elems_before;
+		}
+
+		void	fill_insert(iterator position, size_type n, value_type const& x)
+		{
+			if (n == 0)
+				return;
+
+			value_type const	x_copy = x;
+
+			if (position.cur == impl.finish.cur)
+			{
+				for (; n; --n)
+					push_back(x_copy);
+			}
+			else if (position.cur == impl.start.cur)
+			{
+				for (; n; --n)
+					push_front(x_copy);
+			}
+			else
+			{
+				iterator const	gap = open_gap(position, n, x_copy);
+
+				ft::fill(gap, gap + difference_type(n), x_copy);
+			}
+		}
+
+		template<typename I>
+		void	range_insert_aux(iterator pos, I first, I last,
+			input_iterator_tag)
+		{
+			if (pos.cur == impl.finish.cur)
+			{
+				for (; first != last; ++first)
+					push_back(*first);
+			}
+			else
+			{
+				deque	tmp(first, last, get_allocator());
+
+				range_insert_aux(pos, tmp.begin(), tmp.end(),
+					forward_iterator_tag());
+			}
+		}
+
+		template<typename F>
+		void	range_insert_aux(iterator pos, F first, F last,
+			forward_iterator_tag)
+		{
+			if (first == last)
+				return;
+			if (pos.cur == impl.finish.cur)
+			{
+				for (; first != last; ++first)
+					push_back(*first);
+				return;
+			}
+
+			iterator const	gap = open_gap(pos, ft::distance(first, last),
+				*first);
+
+			ft::copy(first, last, gap);
+		}
+	};
+
+	template<typename T, typename A>
+	inline bool	operator==(deque<T, A> const& x, deque<T, A> const& y)
+	{
+		return x.size() == y.size()
+			&& ft::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator!=(deque<T, A> const& x, deque<T, A> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename A>
+	inline bool	operator<(deque<T, A> const& x, deque<T, A> const& y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(),
+			y.begin(), y.end());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator>(deque<T, A> const& x, deque<T, A> const& y)
+	{ return y < x; }
+
+	template<typename T, typename A>
+	inline bool	operator<=(deque<T, A> const& x, deque<T, A> const& y)
+	{ return !(y < x); }
+
+	template<typename T, typename A>
+	inline bool	operator>=(deque<T, A> const& x, deque<T, A> const& y)
+	{ return !(x < y); }
+
+	template<typename T, typename A>
+	inline void	swap(deque<T, A>& x, deque<T, A>& y) throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <cstddef>
+
+#include <pthread.h>
+
+#include <atomic.hpp>
+#include <memory.hpp>
+#include <vector.hpp>
+
+namespace ft
+{
+	namespace detail
+	{
+		/// Frees a node that no thread can reach anymore.
+		typedef	void	(*_reclaim_fn)(void*);
+
+		/// A node unlinked in some epoch, to be freed two epochs later.
+		struct	_retired
+		{
+			void*		node;
+			_reclaim_fn	reclaim;
+			size_t		epoch;
+		};
+
+		/**
+		 * @brief The state of a thread that takes part in epoch based
+		 * reclamation. Records are never freed: a thread that exits gives
+		 * its up for the next new thread to take over, along with the
+		 * nodes it retired and did not free yet.
+		 */
+		struct	_epoch_record
+		{
+			/// The epoch announced while pinned, shifted left, with the low
+			/// bit set, or 0 while not pinned.
+			atomic<size_t>		state;
+			atomic<int>			owned;
+			/// The depth of nested pins, only touched by the owner.
+			unsigned			pins;
+			unsigned			since_collect;
+			/// Set while freeing nodes, whose reclaim functions may retire
+			/// more, so that they do not start freeing nodes too.
+			bool				collecting;
+			vector<_retired>	retired;
+			_epoch_record*		next;
+
+			_epoch_record() throw()
+				:	state(0), owned(1), pins(0), since_collect(0),
+					collecting(false), next() { }
+		};
+
+		template<typename Dummy>
+		struct	_epoch_globals
+		{
+			static atomic<size_t>			epoch;
+			static atomic<_epoch_record*>	records;
+			static pthread_key_t			key;
+			static pthread_once_t			once;
+		};
+
+		template<typename Dummy>
+		atomic<size_t>			_epoch_globals<Dummy>::epoch;
+
+		template<typename Dummy>
+		atomic<_epoch_record*>	_epoch_globals<Dummy>::records;
+
+		template<typename Dummy>
+		pthread_key_t			_epoch_globals<Dummy>::key;
+
+		template<typename Dummy>
+		pthread_once_t			_epoch_globals<Dummy>::once = PTHREAD_ONCE_INIT;
+
+		typedef	_epoch_globals<void>	_epoch;
+
+		/// Retired nodes per thread between attempts to free some.
+		enum { _epoch_batch = 64 };
+
+		/**
+		 * @brief Try to move the global epoch on, which takes every pinned
+		 * thread to have announced the current one.
+		 *
+		 * @return size_t	The global epoch.
+		 */
+		inline size_t	_epoch_try_advance() throw()
+		{
+			size_t	e = _epoch::epoch.load();
+
+			for (_epoch_record* r = _epoch::records.load(); r; r = r->next)
+			{
+				size_t const	s = r->state.load();
+
+				if ((s & 1) && s >> 1 != e)
+					return e;
+			}
+			if (_epoch::epoch.compare_exchange_strong(e, e + 1))
+				return e + 1;
+			return e;
+		}
+
+		/**
+		 * @brief Free the nodes r retired at least two epochs ago, after
+		 * trying to advance the epoch. No pinned thread can still hold
+		 * them: it would have kept the epoch from moving on twice.
+		 *
+		 * The nodes due are taken off the list before any is freed, as a
+		 * reclaim function may retire more nodes onto it.
+		 */
+		inline void		_epoch_collect(_epoch_record* r)
+		{
+			size_t				e;
+			size_t				n = 0;
+			vector<_retired>	due;
+
+			if (r->collecting)
+				return;
+			e = _epoch_try_advance();
+			r->since_collect = 0;
+			while (n < r->retired.size() && r->retired[n].epoch + 2 <= e)
+				++n;
+			if (n == r->retired.size())
+				due.swap(r->retired);
+			else
+			{
+				due.assign(r->retired.begin(), r->retired.begin() + n);
+				r->retired.erase(r->retired.begin(), r->retired.begin() + n);
+			}
+			r->collecting = true;
+			for (size_t i = 0; i < due.size(); ++i)
+				due[i].reclaim(due[i].node);
+			r->collecting = false;
+		}
+
+		/// Give up the record of a thread that exits.
+		inline void		_epoch_release(void* arg)
+		{
+			_epoch_record* const	r = static_cast<_epoch_record*>(arg);
+
+			_epoch_collect(r);
+			r->owned.store(0, memory_order_release);
+		}
+
+		/// Free what the records of exited threads can, taking each over
+		/// meanwhile.
+		inline void		_epoch_collect_orphans()
+		{
+			for (_epoch_record* r = _epoch::records.load(); r; r = r->next)
+			{
+				int	expected = 0;
+
+				if (r->owned.compare_exchange_strong(expected, 1))
+				{
+					_epoch_collect(r);
+					r->owned.store(0, memory_order_release);
+				}
+			}
+		}
+
+		inline void		_epoch_make_key()
+		{ pthread_key_create(&_epoch::key, _epoch_release); }
+
+		/**
+		 * @brief Take over the record of a thread that exited, or add a new
+		 * one to the list.
+		 */
+		inline _epoch_record*	_epoch_acquire()
+		{
+			_epoch_record*	r;
+
+			pthread_once(&_epoch::once, _epoch_make_key);
+			for (r = _epoch::records.load(); r; r = r->next)
+			{
+				int	expected = 0;
+
+				if (r->owned.compare_exchange_strong(expected, 1))
+					break;
+			}
+			if (!r)
+			{
+				r = new _epoch_record();
+				r->next = _epoch::records.load();
+				while (!_epoch::records.compare_exchange_weak(r->next, r))
+					;
+			}
+			pthread_setspecific(_epoch::key, r);
+			return r;
+		}
+
+		/// The calling thread's record.
+		inline _epoch_record*	_epoch_self()
+		{
+			static __thread _epoch_record*	self = 0;
+
+			if (!self)
+				self = _epoch_acquire();
+			return self;
+		}
+
+		/**
+		 * @brief Keep the nodes that the calling thread can reach from
+		 * being freed until the matching _epoch_unpin(). Pins nest.
+		 */
+		inline _epoch_record*	_epoch_pin()
+		{
+			_epoch_record* const	r = _epoch_self();
+
+			if (r->pins++ == 0)
+			{
+				r->state.store(_epoch::epoch.load(memory_order_relaxed) << 1
+					| 1, memory_order_relaxed);
+				// The announcement must be visible before any pointer to a
+				// node is read.
+				atomic_thread_fence(memory_order_seq_cst);
+			}
+			return r;
+		}
+
+		inline void		_epoch_unpin(_epoch_record* r) throw()
+		{
+			if (--r->pins == 0)
+				r->state.store(0, memory_order_release);
+		}
+
+		/**
+		 * @brief Hand a node that was unlinked, and that no new traversal
+		 * can reach, over to be freed once the threads that may still be
+		 * reading it have unpinned.
+		 */
+		inline void		_epoch_retire(void* node, _reclaim_fn reclaim)
+		{
+			_epoch_record* const	r = _epoch_self();
+			_retired const			x = { node, reclaim, _epoch::epoch.load() };
+
+			r->retired.push_back(x);
+			if (++r->since_collect >= _epoch_batch)
+				_epoch_collect(r);
+		}
+
+		/// Destroys and frees a T with a default constructed allocator.
+		template<typename T, typename A>
+		struct	_epoch_deleter
+		{
+			typedef	typename _alloc_traits<A>::template rebind<T>::other
+				alloc_type;
+			typedef	_alloc_traits<alloc_type>	alloc_traits;
+
+			static void	reclaim(void* p)
+			{
+				alloc_type	a;
+				T* const	x = static_cast<T*>(p);
+
+				alloc_traits::destroy(a, x);
+				alloc_traits::deallocate(a, x, 1);
+			}
+		};
+	}
+
+	/**
+	 * @brief Epoch based reclamation, which lets lock-free containers free
+	 * the nodes they unlink while other threads may still be reading them.
+	 *
+	 * A thread pins itself, with a guard, around every access to shared
+	 * nodes. A node that was unlinked, so that no new access can reach it,
+	 * is retired to the calling thread's list along with the global epoch
+	 * of the time, instead of being freed. Every few retirements, the
+	 * thread tries to move the global epoch on, which only succeeds once
+	 * every pinned thread has seen the current one, and frees in a batch
+	 * the nodes it retired two epochs ago or more, as no thread that was
+	 * pinned then can still be.
+	 *
+	 * Pinning costs a fence and a few loads. A thread that stays pinned
+	 * keeps every node retired meanwhile from being freed, so guards should
+	 * be short lived.
+	 */
+	class	epoch
+	{
+	public:
+		/// Frees a retired node.
+		typedef	detail::_reclaim_fn	reclaim_fn;
+
+		/// Pins the calling thread until the end of the scope. Guards nest.
+		class	guard
+		{
+		private:
+			detail::_epoch_record* const	record;
+
+			guard(guard const&);
+			guard&	operator=(guard const&);
+
+		public:
+			guard()
+				:	record(detail::_epoch_pin()) { }
+
+			~guard() throw()
+			{ detail::_epoch_unpin(record); }
+		};
+
+		/**
+		 * @brief Keep the nodes that the calling thread can reach from
+		 * being freed until the matching unpin(). Pins nest.
+		 */
+		static void	pin()
+		{ detail::_epoch_pin(); }
+
+		static void	unpin() throw()
+		{ detail::_epoch_unpin(detail::_epoch_self()); }
+
+		/// Whether the calling thread is pinned.
+		static bool	pinned()
+		{ return detail::_epoch_self()->pins != 0; }
+
+		/**
+		 * @brief Destroy and free p, once no thread can still be reading
+		 * it, with an allocator of type A.
+		 *
+		 * Nodes go back where A takes them from, such as the free list of
+		 * a pool_allocator. A must be stateless, as a default constructed
+		 * A frees them, possibly on another thread.
+		 *
+		 * @param p	A node that no new traversal can reach anymore.
+		 * @param a	The allocator p was allocated with, of which only the
+		 * type is used.
+		 */
+		template<typename T, typename A>
+		static void	retire(T* p, A const& a)
+		{
+			static_cast<void>(a);
+			detail::_epoch_retire(p, detail::_epoch_deleter<T, A>::reclaim);
+		}
+
+		/// Destroy and free p, allocated with an ft::allocator, once no
+		/// thread can still be reading it.
+		template<typename T>
+		static void	retire(T* p)
+		{ retire(p, allocator<T>()); }
+
+		/**
+		 * @brief Call f with p once no thread can still be reading it, for
+		 * nodes that are not freed one at a time with an allocator.
+		 */
+		static void	defer(void* p, reclaim_fn f)
+		{ detail::_epoch_retire(p, f); }
+
+		/**
+		 * @brief Try to move the global epoch on, and free the nodes that
+		 * the calling thread, or threads that exited, retired long enough
+		 * ago, without waiting for a batch to fill.
+		 */
+		static void	collect()
+		{
+			detail::_epoch_collect(detail::_epoch_self());
+			detail::_epoch_collect_orphans();
+		}
+
+	private:
+		epoch();
+	};
+}
@@ -5,12 +5,22 @@ namespace ft
 	class exception
 	{
 	public:
-		exception() throw() {};
-		exception(exception const& other) throw() { };
-		virtual ~exception() {};
+		exception() throw() { }
+		exception(exception const&) throw() { }
+		virtual ~exception() throw() { }
 
 		virtual char const*	what() throw() = 0;
 
-		virtual exception&	operator=(exception const&) = 0;
+		exception&	operator=(exception const&) throw()
+		{ return *this; }
 	};
+
+	class OutOfRangeException	:	public exception
+	{ char const*	what() throw() { return "Index out of range!"; } };
+
+	class LengthErrorException	:	public exception
+	{ char const*	what() throw() { return "Length exceeds max size!"; } };
+
+	class InvalidArgumentException	:	public exception
+	{ char const*	what() throw() { return "Invalid argument!"; } };
 }
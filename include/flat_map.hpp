@@ -0,0 +1,818 @@
+#pragma once
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <type_traits.hpp>
+#include <utility.hpp>
+#include <vector.hpp>
+
+namespace ft
+{
+	/// Marks input that is already sorted by key and free of duplicates.
+	struct	sorted_unique_t { };
+
+	sorted_unique_t const	sorted_unique = sorted_unique_t();
+
+	namespace detail
+	{
+		/**
+		 * @brief A pair of references to a key and its mapped value, which
+		 * an iterator of flat_map dereferences to.
+		 */
+		template<typename KR, typename MR>
+		struct	_flat_map_reference
+		{
+			KR	first;
+			MR	second;
+
+			_flat_map_reference(KR k, MR m)	:	first(k), second(m) { }
+
+			/// Allow reference to const_reference conversion.
+			template<typename KRr, typename MRr>
+			_flat_map_reference(_flat_map_reference<KRr, MRr> const& x)
+				:	first(x.first), second(x.second)
+			{ }
+
+			/// Copy the referred to key and mapped value.
+			template<typename T1, typename T2>
+			operator pair<T1, T2>() const
+			{ return pair<T1, T2>(first, second); }
+		};
+
+		template<typename KRl, typename MRl, typename KRr, typename MRr>
+		inline bool	operator==(_flat_map_reference<KRl, MRl> const& x,
+			_flat_map_reference<KRr, MRr> const& y)
+		{ return x.first == y.first && x.second == y.second; }
+
+		/**
+		 * @brief Compares first, and then second if the firsts are
+		 * equivalent.
+		 */
+		template<typename KRl, typename MRl, typename KRr, typename MRr>
+		inline bool	operator<(_flat_map_reference<KRl, MRl> const& x,
+			_flat_map_reference<KRr, MRr> const& y)
+		{
+			return x.first < y.first
+				|| (!(y.first < x.first) && x.second < y.second);
+		}
+
+		/**
+		 * @brief Holds the _flat_map_reference an iterator dereferences to,
+		 * so that the iterator can have an operator->.
+		 */
+		template<typename Ref>
+		class	_flat_map_arrow
+		{
+			Ref	ref;
+
+		public:
+			_flat_map_arrow(Ref const& r)	:	ref(r) { }
+
+			Ref const*	operator->() const throw()
+			{ return &ref; }
+		};
+
+		/**
+		 * @brief Orders indices into a sequence of keys by key, and then by
+		 * index, so that sorting them is stable.
+		 */
+		template<typename K, typename Compare>
+		class	_flat_index_less
+		{
+			K const*	keys;
+			Compare		comp;
+
+		public:
+			_flat_index_less(K const* k, Compare c)	:	keys(k), comp(c) { }
+
+			bool	operator()(size_t x, size_t y) const
+			{
+				return comp(keys[x], keys[y])
+					|| (!comp(keys[y], keys[x]) && x < y);
+			}
+		};
+	}
+
+	/**
+	 * @brief Walks the keys and the mapped values of a flat_map in step,
+	 * and dereferences to a pair of references to both.
+	 *
+	 * @tparam KI	The key container's const_iterator.
+	 * @tparam MI	The mapped container's iterator or const_iterator.
+	 * @tparam C	The flat_map, which only iterators of mix with.
+	 */
+	template<typename KI, typename MI, typename C>
+	class	_flat_map_iterator
+	{
+		typedef	iterator_traits<KI>	key_traits;
+		typedef	iterator_traits<MI>	mapped_traits;
+
+		KI	key;
+		MI	mapped;
+
+	public:
+		typedef	random_access_iterator_tag					iterator_category;
+		typedef	pair<typename key_traits::value_type,
+			typename mapped_traits::value_type>				value_type;
+		typedef	ptrdiff_t									difference_type;
+		typedef	detail::_flat_map_reference<typename key_traits::reference,
+			typename mapped_traits::reference>				reference;
+		typedef	detail::_flat_map_arrow<reference>			pointer;
+
+		_flat_map_iterator()	:	key(), mapped() { }
+
+		_flat_map_iterator(KI const& k, MI const& m)	:	key(k), mapped(m)
+		{ }
+
+		/// Allow iterator to const_iterator conversion.
+		template<typename MIr>
+		_flat_map_iterator(_flat_map_iterator<KI, MIr, typename enable_if<
+			is_same<MIr, typename C::mapped_iterator>::value, C>::type> const&
+			i)
+			:	key(i.base()), mapped(i.mapped_base())
+		{ }
+
+		reference	operator*() const
+		{ return reference(*key, *mapped); }
+
+		pointer		operator->() const
+		{ return pointer(**this); }
+
+		_flat_map_iterator&	operator++()
+		{ ++key; ++mapped; return *this; }
+
+		_flat_map_iterator	operator++(int)
+		{ _flat_map_iterator	tmp = *this; ++*this; return tmp; }
+
+		_flat_map_iterator&	operator--()
+		{ --key; --mapped; return *this; }
+
+		_flat_map_iterator	operator--(int)
+		{ _flat_map_iterator	tmp = *this; --*this; return tmp; }
+
+		reference			operator[](difference_type n) const
+		{ return reference(key[n], mapped[n]); }
+
+		_flat_map_iterator&	operator+=(difference_type n)
+		{ key += n; mapped += n; return *this; }
+
+		_flat_map_iterator&	operator-=(difference_type n)
+		{ key -= n; mapped -= n; return *this; }
+
+		_flat_map_iterator	operator+(difference_type n) const
+		{ return _flat_map_iterator(key + n, mapped + n); }
+
+		_flat_map_iterator	operator-(difference_type n) const
+		{ return _flat_map_iterator(key - n, mapped - n); }
+
+		/// The iterator to the key.
+		KI const&	base() const
+		{ return key; }
+
+		/// The iterator to the mapped value.
+		MI const&	mapped_base() const
+		{ return mapped; }
+	};
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline bool	operator==(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() == b.base(); }
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline bool	operator!=(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() != b.base(); }
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline bool	operator<(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() < b.base(); }
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline bool	operator>(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() > b.base(); }
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline bool	operator<=(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() <= b.base(); }
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline bool	operator>=(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() >= b.base(); }
+
+	template<typename KI, typename MIl, typename MIr, typename C>
+	inline ptrdiff_t	operator-(_flat_map_iterator<KI, MIl, C> const& a,
+		_flat_map_iterator<KI, MIr, C> const& b)
+	{ return a.base() - b.base(); }
+
+	template<typename KI, typename MI, typename C>
+	inline _flat_map_iterator<KI, MI, C>	operator+(ptrdiff_t n,
+		_flat_map_iterator<KI, MI, C> const& a)
+	{ return a + n; }
+
+	/**
+	 * @brief A sorted associative container of unique keys, each mapped to
+	 * a value, with the interface of map but stored in two sorted vectors.
+	 *
+	 * Keys and mapped values are kept apart, so that a lookup binary
+	 * searches a dense array of keys and touches a single mapped value.
+	 * Lookups take O(log n), and inserting or erasing a single element
+	 * takes O(n) to shift the ones after it, which makes this best for
+	 * tables that are built at once and then mostly read. Iterators
+	 * dereference to a pair of references rather than to a value_type&, and
+	 * are invalidated by every insertion and erasure.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam KA		The allocator type of the keys.
+	 * @tparam TA		The allocator type of the mapped values.
+	 */
+	template<typename K, typename T, typename Compare = less<K>,
+		typename KA = allocator<K>, typename TA = allocator<T> >
+	class	flat_map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K, T>			value_type;
+		typedef	Compare				key_compare;
+		typedef	vector<K, KA>		key_container_type;
+		typedef	vector<T, TA>		mapped_container_type;
+
+	private:
+		typedef	typename key_container_type::const_iterator	key_iterator;
+		typedef	typename mapped_container_type::const_iterator
+			mapped_const_iterator;
+		typedef	typename mapped_container_type::reference
+			mapped_reference;
+		typedef	typename mapped_container_type::const_reference
+			mapped_const_reference;
+
+	public:
+		typedef	typename mapped_container_type::iterator	mapped_iterator;
+		typedef	_flat_map_iterator<key_iterator, mapped_iterator, flat_map>
+			iterator;
+		typedef	_flat_map_iterator<key_iterator, mapped_const_iterator,
+			flat_map>										const_iterator;
+		typedef	ft::reverse_iterator<iterator>				reverse_iterator;
+		typedef	ft::reverse_iterator<const_iterator>
+			const_reverse_iterator;
+		typedef	typename iterator::reference				reference;
+		typedef	typename const_iterator::reference			const_reference;
+		typedef	size_t										size_type;
+		typedef	ptrdiff_t									difference_type;
+
+		/**
+		 * @brief Orders values by their keys.
+		 */
+		class	value_compare
+		{
+			friend class	flat_map;
+
+		protected:
+			Compare	comp;
+
+			value_compare(Compare c)	:	comp(c) { }
+
+		public:
+			typedef	bool	result_type;
+
+			bool	operator()(const_reference x, const_reference y) const
+			{ return comp(x.first, y.first); }
+		};
+
+	private:
+		key_container_type		key_seq;
+		mapped_container_type	mapped_seq;
+		key_compare				comp;
+
+	public:
+		explicit flat_map(Compare const& cmp = Compare())	:	comp(cmp) { }
+
+		/**
+		 * @brief Construct a map from a range by sorting it, in
+		 * O(n log n), or in O(n) if it turns out to be sorted already.
+		 *
+		 * Of elements with equivalent keys, the first one is kept, as if
+		 * they were inserted one by one.
+		 */
+		template<typename I>
+		flat_map(I first, I last, Compare const& cmp = Compare())
+			:	comp(cmp)
+		{
+			append(first, last);
+			sort_unique();
+		}
+
+		/**
+		 * @brief Construct a map from a range sorted by key without
+		 * duplicates, in O(n).
+		 */
+		template<typename I>
+		flat_map(sorted_unique_t, I first, I last,
+			Compare const& cmp = Compare())
+			:	comp(cmp)
+		{ append(first, last); }
+
+		/**
+		 * @brief Construct a map from parallel sequences of keys and mapped
+		 * values, by sorting them as the range constructor does.
+		 *
+		 * @throw InvalidArgumentException if the sequences have distinct
+		 * sizes.
+		 */
+		flat_map(key_container_type const& keys,
+			mapped_container_type const& values,
+			Compare const& cmp = Compare())
+			:	key_seq(keys), mapped_seq(values), comp(cmp)
+		{
+			check_sizes();
+			sort_unique();
+		}
+
+		/**
+		 * @brief Construct a map from parallel sequences of keys and mapped
+		 * values, with the keys sorted and free of duplicates, in O(n).
+		 *
+		 * @throw InvalidArgumentException if the sequences have distinct
+		 * sizes.
+		 */
+		flat_map(sorted_unique_t, key_container_type const& keys,
+			mapped_container_type const& values,
+			Compare const& cmp = Compare())
+			:	key_seq(keys), mapped_seq(values), comp(cmp)
+		{ check_sizes(); }
+
+		flat_map(flat_map const& x)
+			:	key_seq(x.key_seq), mapped_seq(x.mapped_seq), comp(x.comp)
+		{ }
+
+		flat_map&	operator=(flat_map const& x)
+		{
+			if (&x != this)
+			{
+				flat_map	tmp(x);
+
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		iterator				begin()
+		{ return iterator(key_seq.begin(), mapped_seq.begin()); }
+
+		const_iterator			begin() const
+		{ return const_iterator(key_seq.begin(), mapped_seq.begin()); }
+
+		iterator				end()
+		{ return iterator(key_seq.end(), mapped_seq.end()); }
+
+		const_iterator			end() const
+		{ return const_iterator(key_seq.end(), mapped_seq.end()); }
+
+		reverse_iterator		rbegin()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const
+		{ return const_reverse_iterator(begin()); }
+
+		bool		empty() const throw()
+		{ return key_seq.empty(); }
+
+		size_type	size() const throw()
+		{ return key_seq.size(); }
+
+		size_type	max_size() const throw()
+		{ return ft::min(key_seq.max_size(), mapped_seq.max_size()); }
+
+		/**
+		 * @brief Reserve room for n elements, so that insertions up to
+		 * that size do not reallocate.
+		 */
+		void		reserve(size_type n)
+		{
+			key_seq.reserve(n);
+			mapped_seq.reserve(n);
+		}
+
+		/// The sorted keys.
+		key_container_type const&		keys() const throw()
+		{ return key_seq; }
+
+		/// The mapped values, in the order of their keys.
+		mapped_container_type const&	values() const throw()
+		{ return mapped_seq; }
+
+		/**
+		 * @brief Returns the value mapped to k, inserting a default one if
+		 * k is not in the map.
+		 */
+		mapped_reference	operator[](key_type const& k)
+		{
+			size_type const	i = lower_index(k);
+
+			if (i == size() || comp(k, key_seq[i]))
+				insert_at(i, value_type(k, mapped_type()));
+			return mapped_seq[i];
+		}
+
+		/**
+		 * @brief Returns the value mapped to k.
+		 *
+		 * @throw OutOfRangeException if k is not in the map.
+		 */
+		mapped_reference		at(key_type const& k)
+		{
+			size_type const	i = find_index(k);
+
+			if (i == size())
+				throw OutOfRangeException();
+			return mapped_seq[i];
+		}
+
+		mapped_const_reference	at(key_type const& k) const
+		{
+			size_type const	i = find_index(k);
+
+			if (i == size())
+				throw OutOfRangeException();
+			return mapped_seq[i];
+		}
+
+		/**
+		 * @brief Insert x unless its key is already in the map.
+		 *
+		 * @return pair<iterator, bool>	The element with x's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{
+			size_type const	i = lower_index(x.first);
+
+			if (i != size() && !comp(x.first, key_seq[i]))
+				return pair<iterator, bool>(begin() + i, false);
+			return pair<iterator, bool>(insert_at(i, x), true);
+		}
+
+		/**
+		 * @brief Insert x unless its key is already in the map, skipping
+		 * the search if x belongs right before hint.
+		 */
+		iterator				insert(iterator hint, value_type const& x)
+		{
+			size_type const	i = hint - begin();
+
+			if ((i == 0 || comp(key_seq[i - 1], x.first))
+				&& (i == size() || comp(x.first, key_seq[i])))
+				return insert_at(i, x);
+			return insert(x).first;
+		}
+
+		/**
+		 * @brief Insert a range, as insert_range does.
+		 */
+		template<typename I>
+		void					insert(I first, I last)
+		{ insert_range(first, last); }
+
+		/**
+		 * @brief Insert a range of m elements by sorting it and merging it
+		 * in, in O(n + m log m) rather than O(n) per element. Keys that
+		 * are already in the map keep their mapped values.
+		 */
+		template<typename I>
+		void					insert_range(I first, I last)
+		{
+			flat_map const	x(first, last, comp);
+
+			merge_sorted(x);
+		}
+
+		/**
+		 * @brief Insert a range sorted by key without duplicates, by
+		 * merging it in, in O(n + m).
+		 */
+		template<typename I>
+		void					insert_range(sorted_unique_t, I first, I last)
+		{
+			flat_map const	x(sorted_unique, first, last, comp);
+
+			merge_sorted(x);
+		}
+
+		void		erase(iterator pos)
+		{
+			size_type const	i = pos - begin();
+
+			key_seq.erase(key_seq.begin() + i);
+			mapped_seq.erase(mapped_seq.begin() + i);
+		}
+
+		/**
+		 * @brief Erase the element with key k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			size_type const	i = find_index(k);
+
+			if (i == size())
+				return 0;
+			key_seq.erase(key_seq.begin() + i);
+			mapped_seq.erase(mapped_seq.begin() + i);
+			return 1;
+		}
+
+		void		erase(iterator first, iterator last)
+		{
+			size_type const	i = first - begin();
+			size_type const	j = last - begin();
+
+			key_seq.erase(key_seq.begin() + i, key_seq.begin() + j);
+			mapped_seq.erase(mapped_seq.begin() + i, mapped_seq.begin() + j);
+		}
+
+		void		swap(flat_map& x) throw()
+		{
+			key_seq.swap(x.key_seq);
+			mapped_seq.swap(x.mapped_seq);
+			ft::swap(comp, x.comp);
+		}
+
+		void		clear() throw()
+		{
+			key_seq.clear();
+			mapped_seq.clear();
+		}
+
+		key_compare		key_comp() const
+		{ return comp; }
+
+		value_compare	value_comp() const
+		{ return value_compare(comp); }
+
+		iterator		find(key_type const& k)
+		{ return begin() + find_index(k); }
+
+		const_iterator	find(key_type const& k) const
+		{ return begin() + find_index(k); }
+
+		size_type		count(key_type const& k) const
+		{ return find_index(k) == size() ? 0 : 1; }
+
+		iterator		lower_bound(key_type const& k)
+		{ return begin() + lower_index(k); }
+
+		const_iterator	lower_bound(key_type const& k) const
+		{ return begin() + lower_index(k); }
+
+		iterator		upper_bound(key_type const& k)
+		{ return begin() + upper_index(k); }
+
+		const_iterator	upper_bound(key_type const& k) const
+		{ return begin() + upper_index(k); }
+
+		pair<iterator, iterator>				equal_range(
+			key_type const& k)
+		{
+			iterator const	i = lower_bound(k);
+
+			if (i == end() || comp(k, i->first))
+				return pair<iterator, iterator>(i, i);
+			return pair<iterator, iterator>(i, i + 1);
+		}
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{
+			const_iterator const	i = lower_bound(k);
+
+			if (i == end() || comp(k, i->first))
+				return pair<const_iterator, const_iterator>(i, i);
+			return pair<const_iterator, const_iterator>(i, i + 1);
+		}
+
+		friend bool	operator==(flat_map const& x, flat_map const& y)
+		{ return x.key_seq == y.key_seq && x.mapped_seq == y.mapped_seq; }
+
+		friend bool	operator<(flat_map const& x, flat_map const& y)
+		{
+			return ft::lexicographical_compare(x.begin(), x.end(),
+				y.begin(), y.end());
+		}
+
+	private:
+		size_type	lower_index(key_type const& k) const
+		{
+			return ft::lower_bound(key_seq.begin(), key_seq.end(), k, comp)
+				- key_seq.begin();
+		}
+
+		size_type	upper_index(key_type const& k) const
+		{
+			return ft::upper_bound(key_seq.begin(), key_seq.end(), k, comp)
+				- key_seq.begin();
+		}
+
+		/// The index of k, or size() if k is not in the map.
+		size_type	find_index(key_type const& k) const
+		{
+			size_type const	i = lower_index(k);
+
+			if (i == size() || comp(k, key_seq[i]))
+				return size();
+			return i;
+		}
+
+		void		check_sizes() const
+		{
+			if (key_seq.size() != mapped_seq.size())
+				throw InvalidArgumentException();
+		}
+
+		/**
+		 * @brief Insert x at index i, undoing the insertion of its key if
+		 * that of its mapped value throws.
+		 */
+		iterator	insert_at(size_type i, value_type const& x)
+		{
+			key_seq.insert(key_seq.begin() + i, x.first);
+			try
+			{
+				mapped_seq.insert(mapped_seq.begin() + i, x.second);
+			}
+			catch (...)
+			{
+				key_seq.erase(key_seq.begin() + i);
+				throw;
+			}
+			return begin() + i;
+		}
+
+		/**
+		 * @brief Append a range to the unsorted sequences, reserving room
+		 * for it first if it can be measured.
+		 */
+		template<typename I>
+		void		append(I first, I last)
+		{
+			reserve_range(first, last,
+				typename iterator_traits<I>::iterator_category());
+			for (; first != last; ++first)
+			{
+				key_seq.push_back((*first).first);
+				mapped_seq.push_back((*first).second);
+			}
+		}
+
+		template<typename I>
+		void		reserve_range(I, I, input_iterator_tag)
+		{ }
+
+		template<typename I>
+		void		reserve_range(I first, I last, forward_iterator_tag)
+		{ reserve(size() + ft::distance(first, last)); }
+
+		/**
+		 * @brief Sort the sequences by key and keep the first of each run
+		 * of equivalent keys, unless they are sorted already.
+		 *
+		 * Indices are sorted rather than elements, so that every element
+		 * is copied once, and equivalent keys keep their order.
+		 */
+		void		sort_unique()
+		{
+			size_type const	n = size();
+			size_type		i = 1;
+
+			while (i < n && comp(key_seq[i - 1], key_seq[i]))
+				++i;
+			if (i >= n)
+				return;
+
+			vector<size_type>		order(n);
+			key_container_type		keys;
+			mapped_container_type	values;
+
+			for (i = 0; i < n; ++i)
+				order[i] = i;
+			ft::sort(order.begin(), order.end(),
+				detail::_flat_index_less<K, Compare>(key_seq.data(), comp));
+			keys.reserve(n);
+			values.reserve(n);
+			for (i = 0; i < n; ++i)
+			{
+				size_type const	j = order[i];
+
+				if (!keys.empty() && !comp(keys.back(), key_seq[j]))
+					continue;
+				keys.push_back(key_seq[j]);
+				values.push_back(mapped_seq[j]);
+			}
+			key_seq.swap(keys);
+			mapped_seq.swap(values);
+		}
+
+		/**
+		 * @brief Merge the elements of x whose keys are not in the map, in
+		 * O(n + m). A range that sorts after the map is appended in place.
+		 */
+		void		merge_sorted(flat_map const& x)
+		{
+			size_type const	n = size();
+			size_type const	m = x.size();
+
+			if (m == 0)
+				return;
+			if (n == 0 || comp(key_seq.back(), x.key_seq.front()))
+			{
+				key_seq.insert(key_seq.end(), x.key_seq.begin(),
+					x.key_seq.end());
+				try
+				{
+					mapped_seq.insert(mapped_seq.end(), x.mapped_seq.begin(),
+						x.mapped_seq.end());
+				}
+				catch (...)
+				{
+					key_seq.erase(key_seq.begin() + n, key_seq.end());
+					throw;
+				}
+				return;
+			}
+
+			key_container_type		keys;
+			mapped_container_type	values;
+			size_type				i = 0;
+			size_type				j = 0;
+
+			keys.reserve(n + m);
+			values.reserve(n + m);
+			while (i < n && j < m)
+			{
+				if (comp(x.key_seq[j], key_seq[i]))
+				{
+					keys.push_back(x.key_seq[j]);
+					values.push_back(x.mapped_seq[j++]);
+					continue;
+				}
+				if (!comp(key_seq[i], x.key_seq[j]))
+					++j;
+				keys.push_back(key_seq[i]);
+				values.push_back(mapped_seq[i++]);
+			}
+			for (; i < n; ++i)
+			{
+				keys.push_back(key_seq[i]);
+				values.push_back(mapped_seq[i]);
+			}
+			for (; j < m; ++j)
+			{
+				keys.push_back(x.key_seq[j]);
+				values.push_back(x.mapped_seq[j]);
+			}
+			key_seq.swap(keys);
+			mapped_seq.swap(values);
+		}
+	};
+
+	template<typename K, typename T, typename C, typename KA, typename TA>
+	inline bool	operator!=(flat_map<K, T, C, KA, TA> const& x,
+		flat_map<K, T, C, KA, TA> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename T, typename C, typename KA, typename TA>
+	inline bool	operator>(flat_map<K, T, C, KA, TA> const& x,
+		flat_map<K, T, C, KA, TA> const& y)
+	{ return y < x; }
+
+	template<typename K, typename T, typename C, typename KA, typename TA>
+	inline bool	operator<=(flat_map<K, T, C, KA, TA> const& x,
+		flat_map<K, T, C, KA, TA> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename T, typename C, typename KA, typename TA>
+	inline bool	operator>=(flat_map<K, T, C, KA, TA> const& x,
+		flat_map<K, T, C, KA, TA> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename T, typename C, typename KA, typename TA>
+	inline void	swap(flat_map<K, T, C, KA, TA>& x,
+		flat_map<K, T, C, KA, TA>& y) throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	namespace detail
+	{
+		/**
+		 * @brief Returns the node after k in an Eytzinger tree of n nodes,
+		 * in order, or 0 after the last one.
+		 */
+		inline size_t	_eytzinger_next(size_t k, size_t n) throw()
+		{
+			if (2 * k + 1 <= n)
+			{
+				for (k = 2 * k + 1; 2 * k <= n;)
+					k *= 2;
+				return k;
+			}
+			k >>= __builtin_ctzl(~k);
+			return k >> 1;
+		}
+
+		/**
+		 * @brief Returns the node before k in an Eytzinger tree of n nodes,
+		 * in order, the last one if k is 0, or 0 before the first one.
+		 */
+		inline size_t	_eytzinger_prev(size_t k, size_t n) throw()
+		{
+			if (k == 0 || 2 * k <= n)
+			{
+				for (k = k ? 2 * k : 1; 2 * k + 1 <= n;)
+					k = 2 * k + 1;
+				return k <= n ? k : 0;
+			}
+			k >>= __builtin_ctzl(k);
+			return k >> 1;
+		}
+
+		/// The first node of an Eytzinger tree of n nodes, in order.
+		inline size_t	_eytzinger_first(size_t n) throw()
+		{ return n ? size_t(1) << (sizeof(n) * 8 - 1 - __builtin_clzl(n)) : 0; }
+	}
+
+	/**
+	 * @brief A frozen_set::iterator, that walks the implicit tree in order.
+	 */
+	template<typename K>
+	struct	_frozen_iterator
+	{
+		typedef	_frozen_iterator	_self;
+
+		typedef	bidirectional_iterator_tag	iterator_category;
+		typedef	K							value_type;
+		typedef	K const*					pointer;
+		typedef	K const&					reference;
+		typedef	ptrdiff_t					difference_type;
+
+		K const*	keys;
+		size_t		n;
+		/// The node, 1 for the root, or 0 for the end.
+		size_t		k;
+
+		_frozen_iterator() throw()
+			:	keys(), n(), k() { }
+
+		_frozen_iterator(K const* a, size_t size, size_t node) throw()
+			:	keys(a), n(size), k(node) { }
+
+		reference	operator*() const throw()
+		{ return keys[k]; }
+
+		pointer		operator->() const throw()
+		{ return keys + k; }
+
+		_self&		operator++() throw()
+		{
+			k = detail::_eytzinger_next(k, n);
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		_self&		operator--() throw()
+		{
+			k = detail::_eytzinger_prev(k, n);
+			return *this;
+		}
+
+		_self		operator--(int) throw()
+		{
+			_self	tmp = *this;
+			--*this;
+			return tmp;
+		}
+
+		friend bool	operator==(_self const& x, _self const& y) throw()
+		{ return x.k == y.k; }
+
+		friend bool	operator!=(_self const& x, _self const& y) throw()
+		{ return x.k != y.k; }
+	};
+
+	/**
+	 * @brief An immutable sorted set of unique keys, stored in the breadth
+	 * first order of a complete binary search tree, as in Eytzinger's
+	 * layout.
+	 *
+	 * Node k's children are nodes 2k and 2k + 1, so the first levels of
+	 * the tree share a few cache lines, and a search reads no index. Each
+	 * step of a search picks a child with a comparison whose result only
+	 * feeds arithmetic, which compiles to a conditional move rather than a
+	 * branch to mispredict, and prefetches the descendants a cache line
+	 * down the tree, so that the misses of the next levels overlap. The
+	 * array is aligned so that those descendants share a cache line.
+	 *
+	 * A search costs about log2(n) comparisons, as a binary search of a
+	 * sorted array does, but without its mispredictions and with a cache
+	 * miss at most every few levels instead of one per level.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type.
+	 */
+	template<typename K, typename Compare = less<K>, typename A = allocator<K> >
+	class	frozen_set
+	{
+	public:
+		typedef	K		key_type;
+		typedef	K		value_type;
+		typedef	Compare	key_compare;
+		typedef	Compare	value_compare;
+		typedef	A		allocator_type;
+
+	private:
+		typedef	_alloc_traits<A>	alloc_traits;
+
+		enum
+		{
+			line = 64,
+			/// The nodes a cache line holds, a power of two if K's size is.
+			per_line = sizeof(K) < line ? line / sizeof(K) : 1
+		};
+
+		struct	_frozen_impl	:	public A
+		{
+			Compare	comp;
+			/// The allocated block, and its size in keys.
+			K*		block;
+			size_t	block_size;
+			/// The nodes, from keys[1] to keys[n].
+			K*		keys;
+			size_t	n;
+
+			_frozen_impl(Compare const& c, A const& a)
+				:	A(a), comp(c), block(), block_size(), keys(), n() { }
+		};
+
+		_frozen_impl	impl;
+
+	public:
+		typedef	typename A::pointer					pointer;
+		typedef	typename A::const_pointer			const_pointer;
+		typedef	typename A::reference				reference;
+		typedef	typename A::const_reference			const_reference;
+		typedef	_frozen_iterator<K>					iterator;
+		typedef	_frozen_iterator<K>					const_iterator;
+		typedef	ft::reverse_iterator<iterator>		reverse_iterator;
+		typedef	ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef	size_t								size_type;
+		typedef	ptrdiff_t							difference_type;
+
+		explicit frozen_set(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	impl(cmp, a) { }
+
+		/**
+		 * @brief Construct a set from a sorted range of unique keys, such
+		 * as an ft::set's or a sorted ft::vector's, in O(n).
+		 *
+		 * @throw InvalidArgumentException if the range is not sorted, or
+		 * has duplicates.
+		 */
+		template<typename I>
+		frozen_set(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	impl(cmp, a)
+		{ build(first, last, size_t(ft::distance(first, last))); }
+
+		frozen_set(frozen_set const& x)
+			:	impl(x.impl.comp, alloc_traits::select_on_copy(x.impl))
+		{ build(x.begin(), x.end(), x.size()); }
+
+		~frozen_set() throw()
+		{ release(); }
+
+		frozen_set&	operator=(frozen_set const& x)
+		{
+			if (this != &x)
+			{
+				frozen_set	tmp(x);
+
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		iterator			begin() const throw()
+		{ return at(detail::_eytzinger_first(impl.n)); }
+
+		iterator			end() const throw()
+		{ return at(0); }
+
+		reverse_iterator	rbegin() const throw()
+		{ return reverse_iterator(end()); }
+
+		reverse_iterator	rend() const throw()
+		{ return reverse_iterator(begin()); }
+
+		bool		empty() const throw()
+		{ return impl.n == 0; }
+
+		size_type	size() const throw()
+		{ return impl.n; }
+
+		size_type	max_size() const throw()
+		{ return alloc_traits::max_size(impl) - per_line - 1; }
+
+		void		swap(frozen_set& x) throw()
+		{
+			ft::swap(impl.comp, x.impl.comp);
+			ft::swap(impl.block, x.impl.block);
+			ft::swap(impl.block_size, x.impl.block_size);
+			ft::swap(impl.keys, x.impl.keys);
+			ft::swap(impl.n, x.impl.n);
+			alloc_traits::on_swap(impl, x.impl);
+		}
+
+		key_compare		key_comp() const
+		{ return impl.comp; }
+
+		value_compare	value_comp() const
+		{ return impl.comp; }
+
+		iterator	find(key_type const& k) const
+		{
+			iterator const	i = lower_bound(k);
+
+			return i == end() || impl.comp(k, *i) ? end() : i;
+		}
+
+		size_type	count(key_type const& k) const
+		{ return find(k) != end(); }
+
+		/// The first key not less than k.
+		iterator	lower_bound(key_type const& k) const
+		{ return at(descend<false>(k)); }
+
+		/// The first key greater than k.
+		iterator	upper_bound(key_type const& k) const
+		{ return at(descend<true>(k)); }
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{
+			iterator const	i = lower_bound(k);
+
+			if (i == end() || impl.comp(k, *i))
+				return pair<iterator, iterator>(i, i);
+			return pair<iterator, iterator>(i, ++iterator(i));
+		}
+
+		friend bool	operator==(frozen_set const& x, frozen_set const& y)
+		{
+			return x.size() == y.size()
+				&& ft::equal(x.begin(), x.end(), y.begin());
+		}
+
+		friend bool	operator<(frozen_set const& x, frozen_set const& y)
+		{
+			return ft::lexicographical_compare(x.begin(), x.end(),
+				y.begin(), y.end());
+		}
+
+	private:
+		iterator	at(size_t k) const throw()
+		{ return iterator(impl.keys, impl.n, k); }
+
+		/**
+		 * @brief Descend from the root to a leaf, going right past every
+		 * node less than k, or not greater than k if Upper.
+		 *
+		 * The path is the bits of the final node, each 1 a right turn. The
+		 * node sought is the last one where the path turned left: shifting
+		 * out the trailing right turns and that left one finds it, or 0 if
+		 * the path never turned left.
+		 */
+		template<bool Upper>
+		size_t		descend(key_type const& k) const
+		{
+			K const* const	keys = impl.keys;
+			size_t const	n = impl.n;
+			size_t			i = 1;
+
+			while (i <= n)
+			{
+				__builtin_prefetch(keys + i * per_line);
+				i = 2 * i + (Upper ? !impl.comp(k, keys[i])
+					: impl.comp(keys[i], k));
+			}
+			return i >> __builtin_ffsl(~i);
+		}
+
+		/**
+		 * @brief Allocate room for n nodes, with the first of each cache
+		 * line's worth of descendants at the start of a line, and copy the
+		 * keys of a sorted range into them in order.
+		 */
+		template<typename I>
+		void		build(I first, I last, size_t n)
+		{
+			size_t	k = detail::_eytzinger_first(n);
+			size_t	prev = 0;
+			size_t	built = 0;
+
+			if (n == 0)
+				return;
+			impl.block_size = n + 1 + per_line;
+			impl.block = alloc_traits::allocate(impl, impl.block_size);
+			impl.keys = align(impl.block);
+			try
+			{
+				for (; first != last; ++first, ++built)
+				{
+					if (built && !impl.comp(impl.keys[prev], *first))
+						throw InvalidArgumentException();
+					alloc_traits::construct(impl, impl.keys + k, *first);
+					prev = k;
+					k = detail::_eytzinger_next(k, n);
+				}
+			}
+			catch (...)
+			{
+				impl.n = n;
+				destroy(built);
+				alloc_traits::deallocate(impl, impl.block, impl.block_size);
+				impl.block = 0;
+				impl.keys = 0;
+				impl.n = 0;
+				throw;
+			}
+			impl.n = n;
+		}
+
+		/**
+		 * @brief Offset a block so that &keys[per_line] starts a cache line,
+		 * and with it the descendants of every node at the same depth.
+		 */
+		static K*	align(K* block) throw()
+		{
+			size_t const	addr = reinterpret_cast<size_t>(block + per_line);
+			size_t const	skip = (line - addr % line) % line;
+
+			if (line % sizeof(K) || skip % sizeof(K))
+				return block;
+			return block + skip / sizeof(K);
+		}
+
+		/// Destroy the first count nodes in order.
+		void		destroy(size_t count) throw()
+		{
+			for (size_t k = detail::_eytzinger_first(impl.n); count--;
+				k = detail::_eytzinger_next(k, impl.n))
+				alloc_traits::destroy(impl, impl.keys + k);
+		}
+
+		void		release() throw()
+		{
+			if (!impl.n)
+				return;
+			destroy(impl.n);
+			alloc_traits::deallocate(impl, impl.block, impl.block_size);
+		}
+	};
+
+	template<typename K, typename C, typename A>
+	inline bool	operator!=(frozen_set<K, C, A> const& x,
+		frozen_set<K, C, A> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename C, typename A>
+	inline bool	operator>(frozen_set<K, C, A> const& x,
+		frozen_set<K, C, A> const& y)
+	{ return y < x; }
+
+	template<typename K, typename C, typename A>
+	inline bool	operator<=(frozen_set<K, C, A> const& x,
+		frozen_set<K, C, A> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename C, typename A>
+	inline bool	operator>=(frozen_set<K, C, A> const& x,
+		frozen_set<K, C, A> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename C, typename A>
+	inline void	swap(frozen_set<K, C, A>& x, frozen_set<K, C, A>& y) throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ft
+{
+	template<typename Arg, typename Result>
+	struct	unary_function
+	{
+		typedef	Arg		argument_type;
+		typedef	Result	result_type;
+	};
+
+	template<typename Arg1, typename Arg2, typename Result>
+	struct	binary_function
+	{
+		typedef	Arg1	first_argument_type;
+		typedef	Arg2	second_argument_type;
+		typedef	Result	result_type;
+	};
+
+	/**
+	 * @brief Compares two values with operator<.
+	 */
+	template<typename T>
+	struct	less	:	public binary_function<T, T, bool>
+	{
+		bool	operator()(T const& x, T const& y) const
+		{ return x < y; }
+	};
+
+	/**
+	 * @brief Compares two values with operator>.
+	 */
+	template<typename T>
+	struct	greater	:	public binary_function<T, T, bool>
+	{
+		bool	operator()(T const& x, T const& y) const
+		{ return x > y; }
+	};
+
+	/**
+	 * @brief Compares two values with operator==.
+	 */
+	template<typename T>
+	struct	equal_to	:	public binary_function<T, T, bool>
+	{
+		bool	operator()(T const& x, T const& y) const
+		{ return x == y; }
+	};
+
+	/**
+	 * @brief Returns its argument, as the key of a set's element.
+	 */
+	template<typename T>
+	struct	_identity	:	public unary_function<T, T>
+	{
+		T const&	operator()(T const& x) const
+		{ return x; }
+	};
+
+	/**
+	 * @brief Returns the first member of a pair, as the key of a map's
+	 * element.
+	 */
+	template<typename Pair>
+	struct	_select1st
+		:	public unary_function<Pair, typename Pair::first_type>
+	{
+		typename Pair::first_type const&	operator()(Pair const& x) const
+		{ return x.first; }
+	};
+
+	/**
+	 * @brief Hashes a key for the unordered containers. Defined for
+	 * integers and pointers; other keys need a hash function of their own.
+	 */
+	template<typename T>
+	struct	hash;
+
+	/**
+	 * @brief Hashes an integer to itself. The hash tables mix the bits of
+	 * every hash before using them, which makes the identity good enough.
+	 */
+	template<typename T>
+	struct	_integer_hash	:	public unary_function<T, size_t>
+	{
+		size_t	operator()(T x) const
+		{ return static_cast<size_t>(x); }
+	};
+
+	template<> struct	hash<bool>	:	public _integer_hash<bool> { };
+	template<> struct	hash<char>	:	public _integer_hash<char> { };
+	template<> struct	hash<signed char>
+		:	public _integer_hash<signed char> { };
+	template<> struct	hash<unsigned char>
+		:	public _integer_hash<unsigned char> { };
+	template<> struct	hash<wchar_t>	:	public _integer_hash<wchar_t> { };
+	template<> struct	hash<short>	:	public _integer_hash<short> { };
+	template<> struct	hash<unsigned short>
+		:	public _integer_hash<unsigned short> { };
+	template<> struct	hash<int>	:	public _integer_hash<int> { };
+	template<> struct	hash<unsigned int>
+		:	public _integer_hash<unsigned int> { };
+	template<> struct	hash<long>	:	public _integer_hash<long> { };
+	template<> struct	hash<unsigned long>
+		:	public _integer_hash<unsigned long> { };
+
+	template<typename T>
+	struct	hash<T*>	:	public unary_function<T*, size_t>
+	{
+		size_t	operator()(T* p) const
+		{ return reinterpret_cast<size_t>(p); }
+	};
+}
@@ -2,6 +2,8 @@
 
 #include <cstddef>
 
+#include <type_traits.hpp>
+
 namespace ft
 {
 	/// Input iterators.
@@ -26,45 +28,38 @@ namespace ft
 		typedef	typename I::value_type			value_type;
 		typedef	typename I::difference_type		difference_type;
 		typedef	typename I::pointer				pointer;
-		typedef	typename I::reference			value_type;
+		typedef	typename I::reference			reference;
 	};
 
 	/// Partial specialization for pointer types.
 	template<typename T>
 	struct iterator_traits<T*>
 	{
-		typedef	typename random_access_iterator_tag	iterator_category;
-		typedef	typename T							value_type;
-		typedef	typename ptrdiff_t					difference_type;
-		typedef	typename T*							pointer;
-		typedef	typename T&							value_type;
+		typedef	random_access_iterator_tag	iterator_category;
+		typedef	T							value_type;
+		typedef	ptrdiff_t					difference_type;
+		typedef	T*							pointer;
+		typedef	T&							reference;
 	};
 
 	/// Partial specialization for const pointer types.
 	template<typename T>
 	struct iterator_traits<T const*>
 	{
-		typedef	typename random_access_iterator_tag	iterator_category;
-		typedef	typename T							value_type;
-		typedef	typename ptrdiff_t					difference_type;
-		typedef	typename const T*					pointer;
-		typedef	typename const T&					value_type;
+		typedef	random_access_iterator_tag	iterator_category;
+		typedef	T							value_type;
+		typedef	ptrdiff_t					difference_type;
+		typedef	const T*					pointer;
+		typedef	const T&					reference;
 	};
 
-	template<typename Base, typename Derived>
-	bool	is_base_of(Base const&, Derived const&)
-	{
-		Base const*const
-			baseNull = dynamic_cast<Base*>(dynamic_cast<Derived*>(nullptr));
-		Derived	const*const derivedNull == dynamic_cast<Derived*>(nullptr);
-
-		return (baseNull == derivedNull);
-	}
-
 	template<typename I, typename Traits = iterator_traits<I>,
 		typename Category = typename Traits::iterator_category>
 	struct	is_random_access_iter
-	{ enum { value = is_base_of(random_access_iterator_tag, Category) }; };
+	{
+		enum
+		{ value = is_base_of<random_access_iterator_tag, Category>::value };
+	};
 
 	template<typename Category, typename T, typename Distance = ptrdiff_t,
 		typename Pointer = T*, typename Reference = T&>
@@ -112,7 +107,7 @@ namespace ft
 		 *
 		 * @param it	The iterator to reverse.
 		 */
-		explicit reverse_iterator(iterator_type it)	:	current(x);
+		explicit reverse_iterator(iterator_type it)	:	current(it) { }
 
 		reverse_iterator(reverse_iterator const& x)	:	current(x.current) { }
 
@@ -127,19 +122,19 @@ namespace ft
 		 */
 		iterator_type	base() const { return current; }
 
-		reverse_iterator	operator*() const
+		reference			operator*() const
 		{ I	tmp = current; return *--tmp; }
 
-		reverse_iterator	operator->() const
-		{ I	tmp = current; return --tmp.operator->(); }
+		pointer				operator->() const
+		{ I	tmp = current; --tmp; return _to_pointer(tmp); }
 
-		reverse_iterator	operator++()
+		reverse_iterator&	operator++()
 		{ --current; return *this; }
 
 		reverse_iterator	operator++(int)
 		{ reverse_iterator	tmp = *this; --current; return tmp; }
 
-		reverse_iterator	operator--()
+		reverse_iterator&	operator--()
 		{ ++current; return *this; }
 
 		reverse_iterator	operator--(int)
@@ -148,59 +143,33 @@ namespace ft
 		reverse_iterator	operator+(difference_type n) const
 		{ return reverse_iterator(current - n); }
 
-		reverse_iterator	operator+=(difference_type n) const
+		reverse_iterator&	operator+=(difference_type n)
 		{ current -= n; return *this; }
 
 		reverse_iterator	operator-(difference_type n) const
 		{ return reverse_iterator(current + n); }
 
-		reverse_iterator	operator-=(difference_type n) const
+		reverse_iterator&	operator-=(difference_type n)
 		{ current += n; return *this; }
 
 		reference			operator[](difference_type n) const
 		{ return (*(*this + n)); }
-	};
 
-	template<typename I_>
-	inline bool	operator==(reverse_iterator<I_> const& a,
-		reverse_iterator<I_> const& b)
-	{ return a.base() == b.base(); }
-
-	template<typename I_>
-	inline bool	operator<(reverse_iterator<I_> const& a,
-		reverse_iterator<I_> const& b)
-	{ return a.base() < b.base(); }
-
-	template<typename I_>
-	inline bool	operator<(reverse_iterator<I_> const& a,
-		reverse_iterator<I_> const& b)
-	{ return !(a == b); }
+	private:
+		template<typename T>
+		static T*		_to_pointer(T* p)
+		{ return p; }
 
-	template<typename I_>
-	inline bool	operator>(reverse_iterator<I_> const& a,
-		reverse_iterator<I_> const& b)
-	{ return b < a; }
-
-	template<typename I_>
-	inline bool	operator<=(reverse_iterator<I_> const& a,
-		reverse_iterator<I_> const& b)
-	{ return !(y < a); }
-
-	template<typename I_>
-	inline bool	operator>=(reverse_iterator<I_> const& a,
-		reverse_iterator<I_> const& b)
-	{ return !(a < b); }
+		template<typename It>
+		static pointer	_to_pointer(It it)
+		{ return it.operator->(); }
+	};
 
 	template<typename Il, typename Ir>
 	inline bool	operator==(reverse_iterator<Il> const& a,
 		reverse_iterator<Ir> const& b)
 	{ return a.base() == b.base(); }
 
-	template<typename Il, typename Ir>
-	inline bool	operator>(reverse_iterator<Il> const& a,
-		reverse_iterator<Ir> const& b)
-	{ return a.base() > b.base(); }
-
 	template<typename Il, typename Ir>
 	inline bool	operator!=(reverse_iterator<Il> const& a,
 		reverse_iterator<Ir> const& b)
@@ -209,22 +178,22 @@ namespace ft
 	template<typename Il, typename Ir>
 	inline bool	operator<(reverse_iterator<Il> const& a,
 		reverse_iterator<Ir> const& b)
-	{ return a.base() < b.base(); }
+	{ return b.base() < a.base(); }
 
 	template<typename Il, typename Ir>
-	inline bool	operator>=(reverse_iterator<Il> const& a,
+	inline bool	operator>(reverse_iterator<Il> const& a,
 		reverse_iterator<Ir> const& b)
-	{ return a.base() >= b.base(); }
+	{ return b.base() > a.base(); }
 
 	template<typename Il, typename Ir>
 	inline bool	operator<=(reverse_iterator<Il> const& a,
 		reverse_iterator<Ir> const& b)
-	{ return a.base() <= b.base(); }
+	{ return b.base() <= a.base(); }
 
-	template<typename I>
-	inline typename reverse_iterator<I>::difference_type
-		operator-(reverse_iterator<I> const& a, reverse_iterator<I> const& b)
-	{ return b.base() - a.base(); }
+	template<typename Il, typename Ir>
+	inline bool	operator>=(reverse_iterator<Il> const& a,
+		reverse_iterator<Ir> const& b)
+	{ return b.base() >= a.base(); }
 
 	template<typename Il, typename Ir>
 	inline typename	reverse_iterator<Il>::difference_type
@@ -235,8 +204,13 @@ namespace ft
 	inline reverse_iterator<I>	operator+(
 		typename reverse_iterator<I>::difference_type n,
 		reverse_iterator<I> const& a)
-	{ return reverse_iterator(a.base() - n); }
+	{ return reverse_iterator<I>(a.base() - n); }
 
+	/**
+	 * @brief Wraps a pointer into a class iterator, so that containers C
+	 * don't expose raw pointers and iterators of distinct containers don't
+	 * mix.
+	 */
 	template<typename I, typename C>
 	class	_normal_iterator
 	{
@@ -257,9 +231,17 @@ namespace ft
 			: current(I())
 		{}
 
-		_normal_iterator(I const& i) throw()
+		explicit _normal_iterator(I const& i) throw()
 			:	current(i)
-		{};
+		{}
+
+		/// Allow iterator to const_iterator conversion.
+		template<typename Ir>
+		_normal_iterator(_normal_iterator<Ir, typename enable_if<
+			is_same<Ir, typename C::pointer>::value, C>::type> const& i)
+			throw()
+			:	current(i.base())
+		{}
 
 		reference	operator*() const throw()
 		{ return *current; }
@@ -270,13 +252,13 @@ namespace ft
 		_normal_iterator&	operator++() throw()
 		{ ++current; return *this; }
 
-		_normal_iterator&	operator++(int) throw()
+		_normal_iterator	operator++(int) throw()
 		{ return _normal_iterator(current++); }
 
 		_normal_iterator&	operator--() throw()
 		{ --current; return *this; }
 
-		_normal_iterator&	operator--(int) throw()
+		_normal_iterator	operator--(int) throw()
 		{ return _normal_iterator(current--); }
 
 		reference			operator[](difference_type n) const throw()
@@ -288,10 +270,108 @@ namespace ft
 		_normal_iterator&	operator-=(difference_type n) throw()
 		{ current -= n; return *this; }
 
+		_normal_iterator	operator+(difference_type n) const throw()
+		{ return _normal_iterator(current + n); }
+
 		_normal_iterator	operator-(difference_type n) const throw()
 		{ return _normal_iterator(current - n); }
 
 		const I&	base() const throw()
 		{ return current; }
 	};
+
+	template<typename Il, typename Ir, typename C>
+	inline bool	operator==(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() == b.base(); }
+
+	template<typename Il, typename Ir, typename C>
+	inline bool	operator!=(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() != b.base(); }
+
+	template<typename Il, typename Ir, typename C>
+	inline bool	operator<(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() < b.base(); }
+
+	template<typename Il, typename Ir, typename C>
+	inline bool	operator>(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() > b.base(); }
+
+	template<typename Il, typename Ir, typename C>
+	inline bool	operator<=(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() <= b.base(); }
+
+	template<typename Il, typename Ir, typename C>
+	inline bool	operator>=(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() >= b.base(); }
+
+	template<typename Il, typename Ir, typename C>
+	inline typename _normal_iterator<Il, C>::difference_type
+		operator-(_normal_iterator<Il, C> const& a,
+		_normal_iterator<Ir, C> const& b) throw()
+	{ return a.base() - b.base(); }
+
+	template<typename I, typename C>
+	inline _normal_iterator<I, C>	operator+(
+		typename _normal_iterator<I, C>::difference_type n,
+		_normal_iterator<I, C> const& a) throw()
+	{ return _normal_iterator<I, C>(a.base() + n); }
+
+	template<typename I>
+	inline typename iterator_traits<I>::difference_type
+		_distance(I first, I last, input_iterator_tag)
+	{
+		typename iterator_traits<I>::difference_type	n = 0;
+
+		for (; first != last; ++first)
+			++n;
+		return n;
+	}
+
+	template<typename I>
+	inline typename iterator_traits<I>::difference_type
+		_distance(I first, I last, random_access_iterator_tag)
+	{ return last - first; }
+
+	/**
+	 * @brief Returns the number of increments needed to get from first to
+	 * last.
+	 */
+	template<typename I>
+	inline typename iterator_traits<I>::difference_type
+		distance(I first, I last)
+	{
+		return _distance(first, last,
+			typename iterator_traits<I>::iterator_category());
+	}
+
+	template<typename I, typename Distance>
+	inline void	_advance(I& it, Distance n, input_iterator_tag)
+	{ while (n-- > 0) ++it; }
+
+	template<typename I, typename Distance>
+	inline void	_advance(I& it, Distance n, bidirectional_iterator_tag)
+	{
+		if (n > 0)
+			while (n-- > 0) ++it;
+		else
+			while (n++ < 0) --it;
+	}
+
+	template<typename I, typename Distance>
+	inline void	_advance(I& it, Distance n, random_access_iterator_tag)
+	{ it += n; }
+
+	/**
+	 * @brief Moves an iterator by n elements, n may be negative for
+	 * bidirectional iterators.
+	 */
+	template<typename I, typename Distance>
+	inline void	advance(I& it, Distance n)
+	{ _advance(it, n, typename iterator_traits<I>::iterator_category()); }
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm.hpp>
 #include <memory.hpp>
 #include <iterator.hpp>
+#include <type_traits.hpp>
 
 namespace ft
 {
@@ -16,26 +18,128 @@ namespace ft
 			void		transfer(_list_node_base* const first,
 				_list_node_base* const last) throw();
 			void		reverse() throw();
+			void		hook(_list_node_base* const position) throw();
 			void		unhook() throw();
 		};
 
 		struct	_list_node_header	:	public _list_node_base
 		{
+			size_t	size;
+
 			_list_node_header() throw()
-			{ next = prev = this; }
+			{ init(); }
+
+			void	init() throw()
+			{
+				next = prev = this;
+				size = 0;
+			}
 
 		private:
 			_list_node_base*	base()
 			{ return this; }
 		};
+
+		/**
+		 * @brief Swap the nodes of two circular lists, given their headers.
+		 */
+		inline void	_list_node_base::swap(_list_node_base& x,
+			_list_node_base& y) throw()
+		{
+			if (x.next != &x)
+			{
+				if (y.next != &y)
+				{
+					ft::swap(x.next, y.next);
+					ft::swap(x.prev, y.prev);
+					x.next->prev = x.prev->next = &x;
+					y.next->prev = y.prev->next = &y;
+				}
+				else
+				{
+					y.next = x.next;
+					y.prev = x.prev;
+					y.next->prev = y.prev->next = &y;
+					x.next = x.prev = &x;
+				}
+			}
+			else if (y.next != &y)
+			{
+				x.next = y.next;
+				x.prev = y.prev;
+				x.next->prev = x.prev->next = &x;
+				y.next = y.prev = &y;
+			}
+		}
+
+		/**
+		 * @brief Move the nodes [first, last) before this node, in constant
+		 * time.
+		 */
+		inline void	_list_node_base::transfer(_list_node_base* const first,
+			_list_node_base* const last) throw()
+		{
+			if (this == last)
+				return;
+
+			// Remove [first, last) from its list.
+			last->prev->next = this;
+			first->prev->next = last;
+			prev->next = first;
+
+			// Splice it before this.
+			_list_node_base* const	tmp = prev;
+			prev = last->prev;
+			last->prev = first->prev;
+			first->prev = tmp;
+		}
+
+		/**
+		 * @brief Reverse the order of a circular list, given its header.
+		 */
+		inline void	_list_node_base::reverse() throw()
+		{
+			_list_node_base*	tmp = this;
+
+			do
+			{
+				ft::swap(tmp->next, tmp->prev);
+				tmp = tmp->prev;
+			}
+			while (tmp != this);
+		}
+
+		/**
+		 * @brief Link this node before position.
+		 */
+		inline void	_list_node_base::hook(_list_node_base* const position)
+			throw()
+		{
+			next = position;
+			prev = position->prev;
+			position->prev->next = this;
+			position->prev = this;
+		}
+
+		/**
+		 * @brief Unlink this node from its list.
+		 */
+		inline void	_list_node_base::unhook() throw()
+		{
+			_list_node_base* const	next_node = next;
+			_list_node_base* const	prev_node = prev;
+
+			prev_node->next = next_node;
+			next_node->prev = prev_node;
+		}
 	}
 
 	template<typename T>
 	struct _list_node	:	public detail::_list_node_base
 	{
 		T	data;
-		T*			valptr() { return static_cast<T*>&data; };
-		T const*	valptr() const { return static_cast<T const*>&data; };
+		T*			valptr() { return &data; }
+		T const*	valptr() const { return &data; }
 	};
 
 	/**
@@ -65,10 +169,10 @@ namespace ft
 		{ return *this; }
 
 		reference	operator*() const throw()
-		{ return *static_cast<node*>(node)->valptr(); }
+		{ return *static_cast<_node*>(node)->valptr(); }
 
 		pointer		operator->() const throw()
-		{ return static_cast<node*>(node)->valptr(); }
+		{ return static_cast<_node*>(node)->valptr(); }
 
 		_self&		operator++() throw()
 		{
@@ -89,17 +193,17 @@ namespace ft
 			return *this;
 		}
 
-		_self&		operator--(int) throw()
+		_self		operator--(int) throw()
 		{
 			_self	previous = *this;
 			node = node->prev;
 			return previous;
 		}
 
-		friend bool	operator==(_self& const x, _self& const y) throw()
+		friend bool	operator==(_self const& x, _self const& y) throw()
 		{ return x.node == y.node; }
 
-		friend bool	operator!=(_self& const x, _self& const y) throw()
+		friend bool	operator!=(_self const& x, _self const& y) throw()
 		{ return x.node != y.node; }
 
 		detail::_list_node_base*	node;
@@ -115,31 +219,32 @@ namespace ft
 	{
 		typedef _list_const_iterator<T>	_self;
 		typedef const _list_node<T>		_node;
-		typedef _list_iterator			iterator;
+		typedef _list_iterator<T>		iterator;
 
 		typedef	ptrdiff_t					difference_type;
 		typedef bidirectional_iterator_tag	iterator_category;
 		typedef	T							value_type;
-		typedef	T*							pointer;
-		typedef	T&							reference;
+		typedef	T const*					pointer;
+		typedef	T const&					reference;
 
 		_list_const_iterator() throw()
-		: _node() { }
+			: node() { }
 
-		explicit _list_iterator(detail::_list_node_base const* x) throw()
-			: _node(x) { }
+		explicit _list_const_iterator(detail::_list_node_base const* x)
+			throw()
+			: node(x) { }
 
 		_list_const_iterator(iterator const& x) throw()
-			: _node(x._node) { }
+			: node(x.node) { }
 
-		_self _const_cast() const throw()
-		{ return iterator(const_cast<detail::_list_node_base*>(this)); }
+		iterator _const_cast() const throw()
+		{ return iterator(const_cast<detail::_list_node_base*>(node)); }
 
 		reference	operator*() const throw()
-		{ return *static_cast<node*>(node)->valptr(); }
+		{ return *static_cast<_node*>(node)->valptr(); }
 
 		pointer		operator->() const throw()
-		{ return static_cast<node*>(node)->valptr(); }
+		{ return static_cast<_node*>(node)->valptr(); }
 
 		_self&		operator++() throw()
 		{
@@ -160,7 +265,7 @@ namespace ft
 			return *this;
 		}
 
-		_self&		operator--(int) throw()
+		_self		operator--(int) throw()
 		{
 			_self	previous = *this;
 			node = node->prev;
@@ -173,7 +278,7 @@ namespace ft
 		friend bool	operator!=(_self const& x, _self const& y) throw()
 		{ return x.node != y.node; }
 
-		detail::_list_node_base*	node;
+		detail::_list_node_base const*	node;
 	};
 
 	template<typename T, typename A>
@@ -199,28 +304,32 @@ namespace ft
 			return n;
 		}
 
-		struct	_list_impl	:	public _node_alloc_type
+		struct	_list_impl	:	public node_alloc_type
 		{
 			detail::_list_node_header	node;
 
-			_list_impl()	:	_node_alloc_type() { }
-			_list_impl(const _node_alloc_type& a)	:	_node_alloc_type(a) { }
+			_list_impl()	:	node_alloc_type() { }
+			_list_impl(const node_alloc_type& a)	:	node_alloc_type(a) { }
 		};
 
 		_list_impl	impl;
 
-		size_t	get_size() const { return 0; }
+		size_t	get_size() const { return impl.node.size; }
+		void	set_size(size_t n) { impl.node.size = n; }
+		void	inc_size(size_t n) { impl.node.size += n; }
+		void	dec_size(size_t n) { impl.node.size -= n; }
+
 		size_t	node_count() const
-		{ return distance(impl.node.next, &impl.node); }
+		{ return get_size(); }
 
 		typename node_alloc_traits::pointer	get_node()
-		{ return node_alloc_traits::allocate(impl, p, 1); }
+		{ return node_alloc_traits::allocate(impl, 1); }
 
 		void	put_node(typename node_alloc_traits::pointer p) throw()
 		{ node_alloc_traits::deallocate(impl, p, 1); }
 
 	public:
-		typedef	A&	allocator_type;
+		typedef	A	allocator_type;
 
 		node_alloc_type&		get_node_allocator() throw()
 		{ return impl; }
@@ -228,10 +337,23 @@ namespace ft
 		node_alloc_type const&	get_node_allocator() const throw()
 		{ return impl; }
 
-		void	clear() throw();
+		void	clear() throw()
+		{
+			detail::_list_node_base*	cur = impl.node.next;
+
+			while (cur != &impl.node)
+			{
+				_list_node<T>* const	tmp = static_cast<_list_node<T>*>(cur);
+				T_alloc_type			alloc(get_node_allocator());
+
+				cur = tmp->next;
+				alloc.destroy(tmp->valptr());
+				put_node(tmp);
+			}
+		}
 
 		void	init() throw()
-		{ this->impl.node.init(); };
+		{ this->impl.node.init(); }
 
 		_list_base() { }
 
@@ -260,6 +382,8 @@ namespace ft
 
 		typedef _list_iterator<T>		iterator;
 		typedef _list_const_iterator<T>	const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
 
 		typedef size_t					size_type;
 		typedef ptrdiff_t				difference_type;
@@ -272,6 +396,11 @@ namespace ft
 		using	base::put_node;
 		using	base::get_node;
 		using	base::get_node_allocator;
+		using	base::get_size;
+		using	base::set_size;
+		using	base::inc_size;
+		using	base::dec_size;
+		using	base::node_count;
 
 		node*	create_node(value_type const& value)
 		{
@@ -291,7 +420,7 @@ namespace ft
 		}
 
 	public:
-		list() { };
+		list() { }
 
 		explicit list(allocator_type const& a) throw()
 			:	base(node_alloc_type(a)) { }
@@ -303,7 +432,7 @@ namespace ft
 
 		list(list const& x)
 			:	base(node_alloc_traits::select_on_copy(x.get_node_allocator()))
-		{ initialize_dispatch(x.begin(), x.end(), false); }
+		{ initialize_dispatch(x.begin(), x.end(), false_type()); }
 
 		template<typename I>
 		list(I first, I last, allocator_type const& a = allocator_type())
@@ -313,7 +442,12 @@ namespace ft
 			initialize_dispatch(first, last, Integral());
 		}
 
-		list&	operator=(list const& x);
+		list&	operator=(list const& x)
+		{
+			if (this != &x)
+				assign(x.begin(), x.end());
+			return *this;
+		}
 
 		void	assign(size_type n, value_type const& val)
 		{ fill_assign(n, val); }
@@ -328,26 +462,35 @@ namespace ft
 		allocator_type	get_allocator() const throw()
 		{ return allocator_type(base::get_node_allocator()); }
 
-		iterator	begin() const throw()
+		iterator				begin() throw()
 		{ return iterator(this->impl.node.next); }
 
-		iterator	end() const throw()
-		{ return iterator(this->impl.node); }
+		const_iterator			begin() const throw()
+		{ return const_iterator(this->impl.node.next); }
+
+		iterator				end() throw()
+		{ return iterator(&this->impl.node); }
 
-		const_iterator	end() const throw()
-		{ return const_iterator(this->impl.node); }
+		const_iterator			end() const throw()
+		{ return const_iterator(&this->impl.node); }
 
-		reverse_iterator	rbegin() throw()
+		reverse_iterator		rbegin() throw()
 		{ return reverse_iterator(end()); }
 
-		reverse_iterator	rend() throw()
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
 		{ return reverse_iterator(begin()); }
 
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
 		/**
 		 * @brief Returns true if the list is empty.
 		 */
 		bool	empty() const throw()
-		{ return this->impl.node.next; == &this->impl.node; }
+		{ return this->impl.node.next == &this->impl.node; }
 
 		/**
 		 * @brief Returns the number of elements in the list.
@@ -374,7 +517,26 @@ namespace ft
 		 */
 		void	resize(size_type new_size, value_type x = value_type())
 		{
+			size_type	len = size();
 
+			if (new_size < len)
+			{
+				iterator	i;
+
+				if (new_size <= len / 2)
+				{
+					i = begin();
+					ft::advance(i, new_size);
+				}
+				else
+				{
+					i = end();
+					ft::advance(i, -difference_type(len - new_size));
+				}
+				erase(i, end());
+			}
+			else if (new_size > len)
+				insert(end(), new_size - len, x);
 		}
 
 		/**
@@ -387,7 +549,7 @@ namespace ft
 		 * @brief Returns a constant reference to the data at the list's first
 		 * element.
 		 */
-		const_reference front() throw()
+		const_reference front() const throw()
 		{ return *begin(); }
 
 		/**
@@ -400,7 +562,7 @@ namespace ft
 		 * @brief Returns a constant reference to the data at the list's last
 		 * element.
 		 */
-		const_reference back() throw()
+		const_reference back() const throw()
 		{ return *--end(); }
 
 		/**
@@ -428,8 +590,8 @@ namespace ft
 		/**
 		 * @brief Removes the list's last element.
 		 */
-		void	pop_back()
-		{ this->erase(end()); }
+		void	pop_back() throw()
+		{ this->erase(iterator(this->impl.node.prev)); }
 
 		/**
 		 * @brief Insert given value before the specified iterator.
@@ -440,7 +602,11 @@ namespace ft
 		 */
 		iterator insert(iterator position, const value_type& x)
 		{
-			// TODO
+			node*	tmp = create_node(x);
+
+			tmp->hook(position.node);
+			inc_size(1);
+			return iterator(tmp);
 		}
 
 		/**
@@ -450,10 +616,12 @@ namespace ft
 		 * @param position	The next element's iterator.
 		 * @param n			The number of elements to add.
 		 * @param x			The data to be added.
-		 * @return			The new element's iterator.
 		 */
-		iterator insert(iterator position, size_type n, const value_type& x)
-		{ splice(position, list(n, x, get_allocator)); }
+		void	insert(iterator position, size_type n, const value_type& x)
+		{
+			list	tmp(n, x, get_allocator());
+			splice(position, tmp);
+		}
 
 		/**
 		 * @brief Inserts a range into the list.
@@ -464,15 +632,22 @@ namespace ft
 		 * @param last		An input iterator.
 		 */
 		template<typename InputIterator>
-		void	insert(iterator position, InputIterator first, InputIterator last)
-		{ splice(position, list(first, last, get_allocator); }
+		void	insert(iterator position, InputIterator first,
+			InputIterator last)
+		{
+			list	tmp(first, last, get_allocator());
+			splice(position, tmp);
+		}
 
-		iterator	erase(iterator position)
+		iterator	erase(iterator position) throw()
 		{
-			// TODO
+			iterator const	ret(position.node->next);
+
+			erase_node(position);
+			return ret;
 		}
 
-		iterator	erase(iterator first, iterator last)
+		iterator	erase(iterator first, iterator last) throw()
 		{
 			while (first != last)
 				first = erase(first);
@@ -486,12 +661,12 @@ namespace ft
 		 */
 		void		swap(list& other) throw()
 		{
-			detail::_list_node_base::swap(this->impl->node, x->impl->node);
+			detail::_list_node_base::swap(this->impl.node, other.impl.node);
 
 			size_t	otherSize = other.get_size();
 
-			other.set_size(this.get_size());
-			this.set_size(otherSize);
+			other.set_size(this->get_size());
+			this->set_size(otherSize);
 
 			node_alloc_traits::on_swap(this->get_node_allocator(),
 				other.get_node_allocator());
@@ -516,9 +691,7 @@ namespace ft
 		{
 			if (!other.empty())
 			{
-				check_equal_allocators(other);
-
-				this->transfer(position._const_cast(), other.begin(), other.end());
+				this->transfer(position, other.begin(), other.end());
 				this->inc_size(other.get_size());
 				other.set_size(0);
 			}
@@ -539,10 +712,7 @@ namespace ft
 			if (position == i || position == j)
 				return;
 
-			if (this != &other)
-				check_equal_allocators(other);
-
-			this->transfer(position._const_cast(), i._const_cast(), j);
+			this->transfer(position, i, j);
 
 			this->inc_size(1);
 			other.dec_size(1);
@@ -562,15 +732,14 @@ namespace ft
 			if (first != last)
 			{
 				if (this != &other)
-					check_equal_allocators(other);
-
-				size_t n = distance(first, last);
+				{
+					size_t n = base::distance(first.node, last.node);
 
-				this->inc_size(n);
-				this->dec_size(n);
+					this->inc_size(n);
+					other.dec_size(n);
+				}
 
-				this->transfer(position._const_cast(), first._const_cast(),
-					last._const_cast());
+				this->transfer(position, first, last);
 			}
 		}
 
@@ -581,7 +750,26 @@ namespace ft
 		 */
 		void	remove(const T& value)
 		{
-			// TODO
+			iterator	first = begin();
+			iterator	last = end();
+			iterator	extra = last;
+
+			while (first != last)
+			{
+				iterator	next = first;
+				++next;
+				if (*first == value)
+				{
+					// value may be a reference to this element.
+					if (&*first != &value)
+						erase_node(first);
+					else
+						extra = first;
+				}
+				first = next;
+			}
+			if (extra != last)
+				erase_node(extra);
 		}
 
 		/**
@@ -590,9 +778,19 @@ namespace ft
 		 * @tparam Predicate	Unary predicate function or object.
 		 */
 		template<typename Predicate>
-		void	remove_if(Predicate)
+		void	remove_if(Predicate pred)
 		{
-			// TODO
+			iterator	first = begin();
+			iterator	last = end();
+
+			while (first != last)
+			{
+				iterator	next = first;
+				++next;
+				if (pred(*first))
+					erase_node(first);
+				first = next;
+			}
 		}
 
 		/**
@@ -600,7 +798,22 @@ namespace ft
 		 */
 		void	unique()
 		{
-			// TODO
+			iterator	first = begin();
+			iterator	last = end();
+
+			if (first == last)
+				return;
+
+			iterator	next = first;
+
+			while (++next != last)
+			{
+				if (*first == *next)
+					erase_node(next);
+				else
+					first = next;
+				next = first;
+			}
 		}
 
 		/**
@@ -609,9 +822,24 @@ namespace ft
 		 * @tparam BinaryPredicate	Binary predicate function or object.
 		 */
 		template<typename BinaryPredicate>
-		void	unique(BinaryPredicate)
+		void	unique(BinaryPredicate pred)
 		{
-			// TODO
+			iterator	first = begin();
+			iterator	last = end();
+
+			if (first == last)
+				return;
+
+			iterator	next = first;
+
+			while (++next != last)
+			{
+				if (pred(*first, *next))
+					erase_node(next);
+				else
+					first = next;
+				next = first;
+			}
 		}
 
 		/**
@@ -620,9 +848,7 @@ namespace ft
 		 * @param other	Sorted list to merge.
 		 */
 		void	merge(list& other)
-		{
-			// TODO
-		}
+		{ merge(other, _list_less()); }
 
 		/**
 		 * @brief Merge sorted lists according to comparison fucntion.
@@ -634,7 +860,30 @@ namespace ft
 		template<typename StrictWeakOrdering>
 		void	merge(list& other, StrictWeakOrdering cmp)
 		{
-			// TODO
+			if (this == &other)
+				return;
+
+			iterator	first1 = begin();
+			iterator	last1 = end();
+			iterator	first2 = other.begin();
+			iterator	last2 = other.end();
+
+			while (first1 != last1 && first2 != last2)
+			{
+				if (cmp(*first2, *first1))
+				{
+					iterator	next = first2;
+					transfer(first1, first2, ++next);
+					first2 = next;
+				}
+				else
+					++first1;
+			}
+			if (first2 != last2)
+				transfer(last1, first2, last2);
+
+			inc_size(other.get_size());
+			other.set_size(0);
 		}
 
 		void	reverse() throw()
@@ -644,25 +893,153 @@ namespace ft
 		 * @brief Sort the list's elements.
 		 */
 		void	sort()
-		{
-			// TODO
-		}
+		{ sort(_list_less()); }
 
 		/**
 		 * @brief Sort the list's elements according to comparison function.
 		 *
+		 * Bottom-up merge sort, that only relinks nodes.
+		 *
 		 * @tparam StrictWeakOrdering	Comparison function defining sort order.
 		 * @param cmp					Comparison functor.
 		 */
 		template<typename StrictWeakOrdering>
 		void	sort(StrictWeakOrdering cmp)
 		{
-			// TODO
+			if (this->impl.node.next == &this->impl.node
+				|| this->impl.node.next->next == &this->impl.node)
+				return;
+
+			list	carry(get_allocator());
+			list	tmp[64];
+			list*	fill = tmp;
+			list*	counter;
+
+			do
+			{
+				carry.splice(carry.begin(), *this, begin());
+
+				for (counter = tmp; counter != fill && !counter->empty();
+					++counter)
+				{
+					counter->merge(carry, cmp);
+					carry.swap(*counter);
+				}
+				carry.swap(*counter);
+				if (counter == fill)
+					++fill;
+			}
+			while (!empty());
+
+			for (counter = tmp + 1; counter != fill; ++counter)
+				counter->merge(*(counter - 1), cmp);
+			swap(*(fill - 1));
 		}
 
+		~list() throw() { }
+
+	protected:
+		struct	_list_less
+		{
+			bool	operator()(T const& a, T const& b) const
+			{ return a < b; }
+		};
 
+		void	transfer(iterator position, iterator first, iterator last)
+			throw()
+		{ position.node->transfer(first.node, last.node); }
 
-		// TODO: const reverse iterator
-		~list();
+		void	erase_node(iterator position) throw()
+		{
+			dec_size(1);
+			position.node->unhook();
+
+			node* const		n = static_cast<node*>(position.node);
+			T_alloc_type	alloc(get_node_allocator());
+
+			alloc.destroy(n->valptr());
+			put_node(n);
+		}
+
+		void	fill_initialize(size_type n, value_type const& x)
+		{
+			for (; n; --n)
+				push_back(x);
+		}
+
+		template<typename Integer>
+		void	initialize_dispatch(Integer n, Integer x, true_type)
+		{ fill_initialize(static_cast<size_type>(n), x); }
+
+		template<typename I>
+		void	initialize_dispatch(I first, I last, false_type)
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		void	fill_assign(size_type n, value_type const& val)
+		{
+			iterator	i = begin();
+
+			for (; i != end() && n > 0; ++i, --n)
+				*i = val;
+			if (n > 0)
+				insert(end(), n, val);
+			else
+				erase(i, end());
+		}
+
+		template<typename Integer>
+		void	assign_dispatch(Integer n, Integer val, true_type)
+		{ fill_assign(static_cast<size_type>(n), val); }
+
+		template<typename I>
+		void	assign_dispatch(I first, I last, false_type)
+		{
+			iterator	first1 = begin();
+			iterator	last1 = end();
+
+			for (; first1 != last1 && first != last; ++first1, ++first)
+				*first1 = *first;
+			if (first == last)
+				erase(first1, last1);
+			else
+				insert(last1, first, last);
+		}
 	};
+
+	template<typename T, typename A>
+	inline bool	operator==(list<T, A> const& x, list<T, A> const& y)
+	{
+		return x.size() == y.size()
+			&& ft::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator!=(list<T, A> const& x, list<T, A> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename A>
+	inline bool	operator<(list<T, A> const& x, list<T, A> const& y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(),
+			y.begin(), y.end());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator>(list<T, A> const& x, list<T, A> const& y)
+	{ return y < x; }
+
+	template<typename T, typename A>
+	inline bool	operator<=(list<T, A> const& x, list<T, A> const& y)
+	{ return !(y < x); }
+
+	template<typename T, typename A>
+	inline bool	operator>=(list<T, A> const& x, list<T, A> const& y)
+	{ return !(x < y); }
+
+	template<typename T, typename A>
+	inline void	swap(list<T, A>& x, list<T, A>& y) throw()
+	{ x.swap(y); }
 }
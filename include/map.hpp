@@ -0,0 +1,622 @@
+#pragma once
+
+#include <exception.hpp>
+#include <functional.hpp>
+#include <pool_allocator.hpp>
+#include <rb_tree.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A sorted associative container of unique keys, each mapped to
+	 * a value.
+	 *
+	 * Lookups, insertions and erasures are O(log n) on a red-black tree,
+	 * and iterators stay valid until their element is erased.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type, rebound to nodes. The default
+	 * pool_allocator recycles nodes without calling malloc.
+	 * @tparam Augment	The node policy. rb_order_statistics adds rank and
+	 * select, and makes distance and advance O(log n).
+	 */
+	template<typename K, typename T, typename Compare = less<K>,
+		typename A = pool_allocator<pair<K const, T> >,
+		typename Augment = rb_no_augment>
+	class	map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Compare				key_compare;
+		typedef	A					allocator_type;
+
+		/**
+		 * @brief Orders values by their keys.
+		 */
+		class	value_compare
+			:	public binary_function<value_type, value_type, bool>
+		{
+			friend class	map;
+
+		protected:
+			Compare	comp;
+
+			value_compare(Compare c)	:	comp(c) { }
+
+		public:
+			bool	operator()(value_type const& x, value_type const& y) const
+			{ return comp(x.first, y.first); }
+		};
+
+	private:
+		typedef	_rb_tree<key_type, value_type, _select1st<value_type>,
+			key_compare, allocator_type, Augment>	tree_type;
+
+		tree_type	tree;
+
+	public:
+		typedef	typename A::pointer							pointer;
+		typedef	typename A::const_pointer					const_pointer;
+		typedef	typename A::reference						reference;
+		typedef	typename A::const_reference					const_reference;
+		typedef	typename tree_type::iterator				iterator;
+		typedef	typename tree_type::const_iterator			const_iterator;
+		typedef	typename tree_type::reverse_iterator		reverse_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			const_reverse_iterator;
+		typedef	typename tree_type::size_type				size_type;
+		typedef	typename tree_type::difference_type			difference_type;
+
+		explicit map(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a) { }
+
+		/**
+		 * @brief Construct a map from a range, in O(n) if it is strictly
+		 * increasing.
+		 */
+		template<typename I>
+		map(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a)
+		{ tree.insert_unique(first, last); }
+
+		map(map const& x)	:	tree(x.tree) { }
+
+		map&	operator=(map const& x)
+		{
+			tree = x.tree;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return tree.get_allocator(); }
+
+		iterator				begin() throw()
+		{ return tree.begin(); }
+
+		const_iterator			begin() const throw()
+		{ return tree.begin(); }
+
+		iterator				end() throw()
+		{ return tree.end(); }
+
+		const_iterator			end() const throw()
+		{ return tree.end(); }
+
+		reverse_iterator		rbegin() throw()
+		{ return tree.rbegin(); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return tree.rbegin(); }
+
+		reverse_iterator		rend() throw()
+		{ return tree.rend(); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return tree.rend(); }
+
+		bool		empty() const throw()
+		{ return tree.empty(); }
+
+		size_type	size() const throw()
+		{ return tree.size(); }
+
+		size_type	max_size() const throw()
+		{ return tree.max_size(); }
+
+		/**
+		 * @brief Returns the value mapped to k, inserting a default one if
+		 * k is not in the map.
+		 */
+		mapped_type&	operator[](key_type const& k)
+		{
+			iterator	i = lower_bound(k);
+
+			if (i == end() || key_comp()(k, i->first))
+				i = tree.insert_unique(value_type(k, mapped_type())).first;
+			return i->second;
+		}
+
+		/**
+		 * @brief Returns the value mapped to k.
+		 *
+		 * @throw OutOfRangeException if k is not in the map.
+		 */
+		mapped_type&		at(key_type const& k)
+		{
+			iterator const	i = find(k);
+
+			if (i == end())
+				throw OutOfRangeException();
+			return i->second;
+		}
+
+		mapped_type const&	at(key_type const& k) const
+		{
+			const_iterator const	i = find(k);
+
+			if (i == end())
+				throw OutOfRangeException();
+			return i->second;
+		}
+
+		/**
+		 * @brief Insert x unless its key is already in the map.
+		 *
+		 * @return pair<iterator, bool>	The element with x's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{ return tree.insert_unique(x); }
+
+		/**
+		 * @brief Insert x unless its key is already in the map, in
+		 * amortized O(1) if x belongs right before or after hint.
+		 */
+		iterator				insert(iterator hint, value_type const& x)
+		{ return tree.insert_unique(hint, x); }
+
+		/**
+		 * @brief Insert a range, in O(n) if the map is empty and the range
+		 * strictly increasing.
+		 */
+		template<typename I>
+		void					insert(I first, I last)
+		{ tree.insert_unique(first, last); }
+
+		void		erase(iterator pos)
+		{ tree.erase(pos); }
+
+		/**
+		 * @brief Erase the element with key k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			iterator const	i = find(k);
+
+			if (i == end())
+				return 0;
+			tree.erase(i);
+			return 1;
+		}
+
+		void		erase(iterator first, iterator last)
+		{ tree.erase(first, last); }
+
+		void		swap(map& x) throw()
+		{ tree.swap(x.tree); }
+
+		void		clear() throw()
+		{ tree.clear(); }
+
+		key_compare		key_comp() const
+		{ return tree.key_comp(); }
+
+		value_compare	value_comp() const
+		{ return value_compare(tree.key_comp()); }
+
+		iterator		find(key_type const& k)
+		{ return tree.find(k); }
+
+		const_iterator	find(key_type const& k) const
+		{ return tree.find(k); }
+
+		size_type		count(key_type const& k) const
+		{ return tree.find(k) == tree.end() ? 0 : 1; }
+
+		iterator		lower_bound(key_type const& k)
+		{ return tree.lower_bound(k); }
+
+		const_iterator	lower_bound(key_type const& k) const
+		{ return tree.lower_bound(k); }
+
+		iterator		upper_bound(key_type const& k)
+		{ return tree.upper_bound(k); }
+
+		const_iterator	upper_bound(key_type const& k) const
+		{ return tree.upper_bound(k); }
+
+		pair<iterator, iterator>				equal_range(
+			key_type const& k)
+		{ return tree.equal_range(k); }
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{ return tree.equal_range(k); }
+
+		/**
+		 * @brief Returns the number of keys less than k, in O(log n).
+		 * Requires rb_order_statistics.
+		 */
+		size_type		rank(key_type const& k) const
+		{ return tree.rank(k); }
+
+		/**
+		 * @brief Returns the element at index i in order, or end() if
+		 * there are no more than i elements, in O(log n). Requires
+		 * rb_order_statistics.
+		 */
+		iterator		select(size_type i)
+		{ return tree.select(i); }
+
+		const_iterator	select(size_type i) const
+		{ return tree.select(i); }
+
+		/**
+		 * @brief Move the elements with a key less than k to left and the
+		 * others to right, leaving this map empty, by relinking nodes in
+		 * O(log n).
+		 *
+		 * left and right are cleared first, and may be this map. Their
+		 * allocators must compare equal to this map's. Without
+		 * rb_order_statistics, counting the elements of each side adds a
+		 * walk over the smaller one.
+		 */
+		void	split(key_type const& k, map& left, map& right)
+		{ tree.split(tree.lower_bound(k), left.tree, right.tree); }
+
+		/**
+		 * @brief Move the elements of left and then those of right to this
+		 * map, leaving them empty, by relinking nodes in O(log n).
+		 *
+		 * @throw InvalidArgumentException unless every key of left is
+		 * less than every key of right.
+		 */
+		void	join(map& left, map& right)
+		{ tree.join(left.tree, right.tree, true); }
+
+		/**
+		 * @brief Move the elements of x whose key is not in this map to it,
+		 * leaving the others in x, by relinking nodes.
+		 *
+		 * Maps of similar sizes are merged in a linear walk, in O(n + m),
+		 * and when one is much smaller its elements are found in the other
+		 * by finger search, in O(m log(n / m)), without a search from the
+		 * root per element. The allocators must compare equal.
+		 */
+		void	merge_union(map& x)
+		{ tree.merge_union(x.tree); }
+
+		/**
+		 * @brief Erase the elements whose key is not in x, in a linear
+		 * walk, or by finger search in x if this map is much smaller.
+		 */
+		void	merge_intersection(map const& x)
+		{ tree.merge_intersection(x.tree); }
+
+		/**
+		 * @brief Erase the elements whose key is in x, in a linear walk,
+		 * or by finger search if either map is much smaller.
+		 */
+		void	merge_difference(map const& x)
+		{ tree.merge_difference(x.tree); }
+
+		friend bool	operator==(map const& x, map const& y)
+		{ return x.tree == y.tree; }
+
+		friend bool	operator<(map const& x, map const& y)
+		{ return x.tree < y.tree; }
+	};
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator!=(map<K, T, C, A, Aug> const& x,
+		map<K, T, C, A, Aug> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator>(map<K, T, C, A, Aug> const& x,
+		map<K, T, C, A, Aug> const& y)
+	{ return y < x; }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator<=(map<K, T, C, A, Aug> const& x,
+		map<K, T, C, A, Aug> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator>=(map<K, T, C, A, Aug> const& x,
+		map<K, T, C, A, Aug> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline void	swap(map<K, T, C, A, Aug>& x,
+		map<K, T, C, A, Aug>& y) throw()
+	{ x.swap(y); }
+
+	/**
+	 * @brief A sorted associative container of keys each mapped to a value,
+	 * where several elements may have equivalent keys.
+	 *
+	 * Elements with equivalent keys keep their insertion order.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type, rebound to nodes.
+	 * @tparam Augment	The node policy. rb_order_statistics adds rank and
+	 * select, and makes distance and advance O(log n).
+	 */
+	template<typename K, typename T, typename Compare = less<K>,
+		typename A = pool_allocator<pair<K const, T> >,
+		typename Augment = rb_no_augment>
+	class	multimap
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Compare				key_compare;
+		typedef	A					allocator_type;
+
+		/**
+		 * @brief Orders values by their keys.
+		 */
+		class	value_compare
+			:	public binary_function<value_type, value_type, bool>
+		{
+			friend class	multimap;
+
+		protected:
+			Compare	comp;
+
+			value_compare(Compare c)	:	comp(c) { }
+
+		public:
+			bool	operator()(value_type const& x, value_type const& y) const
+			{ return comp(x.first, y.first); }
+		};
+
+	private:
+		typedef	_rb_tree<key_type, value_type, _select1st<value_type>,
+			key_compare, allocator_type, Augment>	tree_type;
+
+		tree_type	tree;
+
+	public:
+		typedef	typename A::pointer							pointer;
+		typedef	typename A::const_pointer					const_pointer;
+		typedef	typename A::reference						reference;
+		typedef	typename A::const_reference					const_reference;
+		typedef	typename tree_type::iterator				iterator;
+		typedef	typename tree_type::const_iterator			const_iterator;
+		typedef	typename tree_type::reverse_iterator		reverse_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			const_reverse_iterator;
+		typedef	typename tree_type::size_type				size_type;
+		typedef	typename tree_type::difference_type			difference_type;
+
+		explicit multimap(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a) { }
+
+		/**
+		 * @brief Construct a multimap from a range, in O(n) if it is sorted.
+		 */
+		template<typename I>
+		multimap(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a)
+		{ tree.insert_equal(first, last); }
+
+		multimap(multimap const& x)	:	tree(x.tree) { }
+
+		multimap&	operator=(multimap const& x)
+		{
+			tree = x.tree;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return tree.get_allocator(); }
+
+		iterator				begin() throw()
+		{ return tree.begin(); }
+
+		const_iterator			begin() const throw()
+		{ return tree.begin(); }
+
+		iterator				end() throw()
+		{ return tree.end(); }
+
+		const_iterator			end() const throw()
+		{ return tree.end(); }
+
+		reverse_iterator		rbegin() throw()
+		{ return tree.rbegin(); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return tree.rbegin(); }
+
+		reverse_iterator		rend() throw()
+		{ return tree.rend(); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return tree.rend(); }
+
+		bool		empty() const throw()
+		{ return tree.empty(); }
+
+		size_type	size() const throw()
+		{ return tree.size(); }
+
+		size_type	max_size() const throw()
+		{ return tree.max_size(); }
+
+		/**
+		 * @brief Insert x after the elements with an equivalent key.
+		 */
+		iterator	insert(value_type const& x)
+		{ return tree.insert_equal(x); }
+
+		/**
+		 * @brief Insert x right before or after hint in amortized O(1) if
+		 * that keeps the order, and after the elements with an equivalent
+		 * key otherwise.
+		 */
+		iterator	insert(iterator hint, value_type const& x)
+		{ return tree.insert_equal(hint, x); }
+
+		/**
+		 * @brief Insert a range, in O(n) if the multimap is empty and the
+		 * range sorted.
+		 */
+		template<typename I>
+		void		insert(I first, I last)
+		{ tree.insert_equal(first, last); }
+
+		void		erase(iterator pos)
+		{ tree.erase(pos); }
+
+		/**
+		 * @brief Erase the elements with a key equivalent to k.
+		 *
+		 * @return size_type	The number of elements erased.
+		 */
+		size_type	erase(key_type const& k)
+		{ return tree.erase_key(k); }
+
+		void		erase(iterator first, iterator last)
+		{ tree.erase(first, last); }
+
+		void		swap(multimap& x) throw()
+		{ tree.swap(x.tree); }
+
+		void		clear() throw()
+		{ tree.clear(); }
+
+		key_compare		key_comp() const
+		{ return tree.key_comp(); }
+
+		value_compare	value_comp() const
+		{ return value_compare(tree.key_comp()); }
+
+		iterator		find(key_type const& k)
+		{ return tree.find(k); }
+
+		const_iterator	find(key_type const& k) const
+		{ return tree.find(k); }
+
+		size_type		count(key_type const& k) const
+		{ return tree.count(k); }
+
+		iterator		lower_bound(key_type const& k)
+		{ return tree.lower_bound(k); }
+
+		const_iterator	lower_bound(key_type const& k) const
+		{ return tree.lower_bound(k); }
+
+		iterator		upper_bound(key_type const& k)
+		{ return tree.upper_bound(k); }
+
+		const_iterator	upper_bound(key_type const& k) const
+		{ return tree.upper_bound(k); }
+
+		pair<iterator, iterator>				equal_range(
+			key_type const& k)
+		{ return tree.equal_range(k); }
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{ return tree.equal_range(k); }
+
+		/**
+		 * @brief Returns the number of keys less than k, in O(log n).
+		 * Requires rb_order_statistics.
+		 */
+		size_type		rank(key_type const& k) const
+		{ return tree.rank(k); }
+
+		/**
+		 * @brief Returns the element at index i in order, or end() if
+		 * there are no more than i elements, in O(log n). Requires
+		 * rb_order_statistics.
+		 */
+		iterator		select(size_type i)
+		{ return tree.select(i); }
+
+		const_iterator	select(size_type i) const
+		{ return tree.select(i); }
+
+		/**
+		 * @brief Move the elements with a key less than k to left and the
+		 * others to right, leaving this map empty, by relinking nodes in
+		 * O(log n).
+		 *
+		 * left and right are cleared first, and may be this map. Their
+		 * allocators must compare equal to this map's. Without
+		 * rb_order_statistics, counting the elements of each side adds a
+		 * walk over the smaller one.
+		 */
+		void	split(key_type const& k, multimap& left, multimap& right)
+		{ tree.split(tree.lower_bound(k), left.tree, right.tree); }
+
+		/**
+		 * @brief Move the elements of left and then those of right to this
+		 * map, leaving them empty, by relinking nodes in O(log n).
+		 *
+		 * @throw InvalidArgumentException if a key of right is less
+		 * than one of left.
+		 */
+		void	join(multimap& left, multimap& right)
+		{ tree.join(left.tree, right.tree, false); }
+
+		friend bool	operator==(multimap const& x, multimap const& y)
+		{ return x.tree == y.tree; }
+
+		friend bool	operator<(multimap const& x, multimap const& y)
+		{ return x.tree < y.tree; }
+	};
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator!=(multimap<K, T, C, A, Aug> const& x,
+		multimap<K, T, C, A, Aug> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator>(multimap<K, T, C, A, Aug> const& x,
+		multimap<K, T, C, A, Aug> const& y)
+	{ return y < x; }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator<=(multimap<K, T, C, A, Aug> const& x,
+		multimap<K, T, C, A, Aug> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline bool	operator>=(multimap<K, T, C, A, Aug> const& x,
+		multimap<K, T, C, A, Aug> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename T, typename C, typename A, typename Aug>
+	inline void	swap(multimap<K, T, C, A, Aug>& x,
+		multimap<K, T, C, A, Aug>& y) throw()
+	{ x.swap(y); }
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <new>
 
 #include <exception.hpp>
+#include <type_traits.hpp>
 
 namespace ft
 {
@@ -45,9 +47,30 @@ namespace ft
 	inline void	swap(T (&a)[N], T (&b)[N])
 	{
 		for (size_t n = 0; n < N; n++)
-			swap(a[n], b[n]);
+			ft::swap(a[n], b[n]);
 	}
 
+	/**
+	 * @brief Tells whether an allocator can resize a block in place or move
+	 * it without copying, by declaring the `can_reallocate` member type and
+	 * a `reallocate(p, old_n, new_n)` member.
+	 */
+	template<typename A>
+	struct	_alloc_can_reallocate
+	{
+	private:
+		typedef char	yes;
+		typedef struct { char c[2]; }	no;
+
+		template<typename U>
+		static yes	test(typename U::can_reallocate*);
+		template<typename U>
+		static no	test(...);
+
+	public:
+		enum { value = sizeof(test<A>(0)) == sizeof(yes) };
+	};
+
 	template<typename A, typename = typename A::value_type>
 	struct	_alloc_traits
 	{
@@ -64,18 +87,38 @@ namespace ft
 		static pointer	allocate(A& a, size_type n)
 		{ return a.allocate(n); }
 
-		template<typname H>
+		template<typename Hint>
 		static pointer	allocate(A& a, size_type n, Hint hint)
-		{ return a.allocate(n, hint); };
+		{ return a.allocate(n, hint); }
 
-		static pointer	deallocate(A& a, pointer p, size_type n)
-		{ return a.deallocate(p, n); }
+		static void		deallocate(A& a, pointer p, size_type n)
+		{ a.deallocate(p, n); }
 
 		template<typename T>
 		static void		construct(A& a, pointer p, const T& arg)
 		{ a.construct(p, arg); }
 
-		static size_type	max_size(const Alloc& a)
+		template<typename T>
+		static void		destroy(A& a, T* p)
+		{ a.destroy(p); }
+
+		/**
+		 * @brief Resize a block of n elements to new_n elements, moving its
+		 * bytes as-is if needed.
+		 *
+		 * Only valid for bitwise relocatable elements.
+		 *
+		 * @return pointer	The resized block, or a null pointer if the
+		 * allocator can't reallocate it, in which case p is left untouched.
+		 */
+		static pointer	reallocate(A& a, pointer p, size_type n,
+			size_type new_n)
+		{
+			return reallocate(a, p, n, new_n,
+				integral_constant<bool, _alloc_can_reallocate<A>::value>());
+		}
+
+		static size_type	max_size(const A& a)
 		{ return a.max_size(); }
 
 		static A const& select_on_copy(const A& a)
@@ -83,13 +126,22 @@ namespace ft
 
 		static void		on_swap(A& a, A& b)
 		{
-			if (one != two)
-				swap(a, b);
+			if (a != b)
+				ft::swap(a, b);
 		}
 
 		template<typename T>
 		struct rebind
 		{ typedef typename A::template rebind<T>::other other; };
+
+	private:
+		static pointer	reallocate(A& a, pointer p, size_type n,
+			size_type new_n, true_type)
+		{ return a.reallocate(p, n, new_n); }
+
+		static pointer	reallocate(A&, pointer, size_type, size_type,
+			false_type)
+		{ return pointer(); }
 	};
 
 	template<typename T>
@@ -112,8 +164,8 @@ namespace ft
 
 		new_allocator(new_allocator const&) { }
 
-		template<typename T>
-		new_allocator(new_allocator<T> const&) { }
+		template<typename O>
+		new_allocator(new_allocator<O> const&) { }
 
 		~new_allocator() { }
 
@@ -126,12 +178,13 @@ namespace ft
 		T*				allocate(size_type n,
 			const void* = static_cast<const void*>(0))
 		{
-			if (n <= max_size())
+			if (n > max_size())
 			{
 				if (n > size_type(-1) / sizeof(T))
 					throw BadArrayNewLengthException();
 				throw BadAllocationException();
 			}
+			return static_cast<T*>(::operator new(n * sizeof(T)));
 		}
 
 		void			deallocate(T* p, size_type)
@@ -147,18 +200,18 @@ namespace ft
 		}
 
 		void			construct(pointer p, T const& value)
-		{ ::new(static_cast<void*>p) T(value); }
+		{ ::new(static_cast<void*>(p)) T(value); }
 
 		void			destroy(pointer p)
 		{ p->~T(); }
 
 		template<typename U>
 		friend bool	operator==(const new_allocator&, const new_allocator<U>&)
-		{ return true; };
+		{ return true; }
 
 		template<typename U>
 		friend bool	operator!=(const new_allocator&, const new_allocator<U>&)
-		{ return false; };
+		{ return false; }
 	};
 
 	/**
@@ -168,10 +221,60 @@ namespace ft
 	void destroy(It first, It last, A& alloc)
 	{ for (; first != last; ++first) alloc.destroy(&*first); }
 
-	template<typename It, typename AT>
-	inline void destroy(It first, It last, allocator<AT>&)
-	{ destroy(first, last); }
+	/**
+	 * @brief Copy-construct a range into uninitialized storage, using the
+	 * supplied allocator.
+	 *
+	 * Already constructed elements are destroyed if a constructor throws.
+	 *
+	 * @return F	An iterator past the last constructed element.
+	 */
+	template<typename I, typename F, typename A>
+	F	_uninitialized_copy_a(I first, I last, F result, A& alloc)
+	{
+		F	cur = result;
 
+		try
+		{
+			for (; first != last; ++first, ++cur)
+				alloc.construct(&*cur, *first);
+		}
+		catch (...)
+		{
+			ft::destroy(result, cur, alloc);
+			throw;
+		}
+		return cur;
+	}
+
+	/**
+	 * @brief Construct n copies of x into uninitialized storage, using the
+	 * supplied allocator.
+	 *
+	 * Already constructed elements are destroyed if a constructor throws.
+	 *
+	 * @return F	An iterator past the last constructed element.
+	 */
+	template<typename F, typename Size, typename T, typename A>
+	F	_uninitialized_fill_n_a(F first, Size n, T const& x, A& alloc)
+	{
+		F	cur = first;
+
+		try
+		{
+			for (; n > 0; --n, ++cur)
+				alloc.construct(&*cur, x);
+		}
+		catch (...)
+		{
+			ft::destroy(first, cur, alloc);
+			throw;
+		}
+		return cur;
+	}
+
+	template <typename T>
+	class allocator;
 
 	template <>
 	class allocator<void>
@@ -212,31 +315,14 @@ namespace ft
 
 		~allocator() throw() { }
 
-		friend bool operator==(allocator const&, allocator const&) const throw()
-		{ return true; }
-
-		friend bool operator==(allocator const&, allocator const&) const throw()
-		{ return false; }
-
-		template <typename Ta, typename Tb>
-		inline bool operator==(allocator<Ta> const&, allocator<Tb> const&)
-			const throw()
+		template <typename O>
+		friend bool operator==(allocator const&, allocator<O> const&) throw()
 		{ return true; }
 
-		template <typename Ta, typename Tb>
-		inline bool operator!=(allocator<Ta> const&, allocator<Tb> const&)
-			const throw()
+		template <typename O>
+		friend bool operator!=(allocator const&, allocator<O> const&) throw()
 		{ return false; }
 
-		template<typename T>
-		class allocator<const T>
-		{
-		public:
-			typedef T	value_type;
-			template<typename U>
-			allocator(allocator<U> const&) { }
-		}
-
 		// TODO: Other template constructors
 
 		/**
@@ -245,7 +331,8 @@ namespace ft
 		 * @param x	Reference to object.
 		 * @return pointer	A pointer to the object.
 		 */
-		pointer			address(reference x) const;
+		pointer			address(reference x) const
+		{ return new_allocator<T>::address(x); }
 
 		/**
 		 * @brief Returns the address of a given reference.
@@ -253,7 +340,8 @@ namespace ft
 		 * @param x	Reference to object.
 		 * @return pointer	A pointer to the object.
 		 */
-		const_pointer	address(const_reference x) const;
+		const_pointer	address(const_reference x) const
+		{ return new_allocator<T>::address(x); }
 
 		/**
 		 * @brief Allocate a block of storage
@@ -270,7 +358,8 @@ namespace ft
 		 * @return pointer	A pointer to the initial element in the block of
 		 * storage
 		 */
-		pointer	allocate(size_type n, allocator<void>::const_pointer hint=0);
+		pointer	allocate(size_type n, allocator<void>::const_pointer hint=0)
+		{ return new_allocator<T>::allocate(n, hint); }
 
 		/**
 		 * @brief Release block of storage.
@@ -280,9 +369,11 @@ namespace ft
 		 * @param n	Number of elements allocated on the call to
 		 * `allocator::allocate` for this block of storage.
 		 */
-		void	deallocate(pointer p, size_type n);
+		void	deallocate(pointer p, size_type n)
+		{ new_allocator<T>::deallocate(p, n); }
 
-		size_type	max_size() const throw();
+		size_type	max_size() const throw()
+		{ return new_allocator<T>::max_size(); }
 
 		/**
 		 * @brief Construct an object on the location pointed by p.
@@ -291,6 +382,7 @@ namespace ft
 		 * an element of type value_type.
 		 * @param val
 		 */
-		void	construct(pointer p, const_reference val);
+		void	construct(pointer p, const_reference val)
+		{ new_allocator<T>::construct(p, val); }
 	};
 }
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <sys/mman.h>
+
+#include <memory.hpp>
+
+namespace ft
+{
+	/// Size of a transparent huge page on x86-64 and aarch64 with 4K pages.
+	enum { _huge_page_size = 2 << 20 };
+
+	/**
+	 * @brief An allocator that maps blocks of at least Threshold bytes as
+	 * anonymous memory advised for transparent huge pages, and smaller
+	 * blocks with operator new.
+	 *
+	 * Mapped blocks are rounded up to a whole number of huge pages, and
+	 * grown or shrunk with mremap where it is available, so that a vector
+	 * of trivially copyable elements never copies them once its buffer is
+	 * mapped.
+	 *
+	 * @tparam T			The element type.
+	 * @tparam Threshold	The size in bytes from which blocks are mapped.
+	 */
+	template<typename T, size_t Threshold = _huge_page_size>
+	class mmap_allocator
+	{
+	public:
+		typedef std::size_t		size_type;
+		typedef	std::ptrdiff_t	difference_type;
+		typedef T*				pointer;
+		typedef T const*		const_pointer;
+		typedef T&				reference;
+		typedef	T const&		const_reference;
+		typedef T				value_type;
+
+		/// Marks reallocate() as usable by _alloc_traits.
+		typedef void			can_reallocate;
+
+		template<typename O>
+		struct rebind
+		{ typedef mmap_allocator<O, Threshold> other; };
+
+		mmap_allocator() throw() { }
+
+		mmap_allocator(mmap_allocator const&) throw() { }
+
+		template<typename O>
+		mmap_allocator(mmap_allocator<O, Threshold> const&) throw() { }
+
+		~mmap_allocator() throw() { }
+
+		pointer			address(reference x) const throw()
+		{ return &x; }
+
+		const_pointer	address(const_reference x) const throw()
+		{ return &x; }
+
+		/**
+		 * @brief Allocate storage for n elements, mapping it if it reaches
+		 * the threshold.
+		 */
+		pointer			allocate(size_type n,
+			const void* = static_cast<const void*>(0))
+		{
+			if (n > max_size())
+				throw BadArrayNewLengthException();
+
+			size_type const	bytes = n * sizeof(T);
+
+			if (!is_mapped(bytes))
+				return static_cast<pointer>(::operator new(bytes));
+
+			void* const	p = ::mmap(0, map_length(bytes),
+				PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (p == MAP_FAILED)
+				throw BadAllocationException();
+			advise(p, map_length(bytes));
+			return static_cast<pointer>(p);
+		}
+
+		void			deallocate(pointer p, size_type n) throw()
+		{
+			size_type const	bytes = n * sizeof(T);
+
+			if (is_mapped(bytes))
+				::munmap(p, map_length(bytes));
+			else
+				::operator delete(p);
+		}
+
+		/**
+		 * @brief Resize a mapped block of n elements to new_n elements
+		 * without copying its contents, moving its pages if needed.
+		 *
+		 * @return pointer	The resized block, or a null pointer if either
+		 * size is below the threshold or the block could not be remapped.
+		 */
+		pointer			reallocate(pointer p, size_type n, size_type new_n)
+			throw()
+		{
+			size_type const	bytes = n * sizeof(T);
+			size_type const	new_bytes = new_n * sizeof(T);
+
+			if (new_n > max_size() || !is_mapped(bytes)
+				|| !is_mapped(new_bytes))
+				return pointer();
+			if (map_length(bytes) == map_length(new_bytes))
+				return p;
+#ifdef __linux__
+			void* const	q = ::mremap(p, map_length(bytes),
+				map_length(new_bytes), MREMAP_MAYMOVE);
+
+			if (q == MAP_FAILED)
+				return pointer();
+			advise(q, map_length(new_bytes));
+			return static_cast<pointer>(q);
+#else
+			return pointer();
+#endif
+		}
+
+		size_type		max_size() const throw()
+		{
+#if __PTRDIFF_MAX__ < __SIZE_MAX__
+			return (std::size_t(__PTRDIFF_MAX__) - _huge_page_size)
+				/ sizeof(T);
+#else
+			return (std::size_t(-1) - _huge_page_size) / sizeof(T);
+#endif
+		}
+
+		void			construct(pointer p, T const& value)
+		{ ::new(static_cast<void*>(p)) T(value); }
+
+		void			destroy(pointer p)
+		{ p->~T(); }
+
+		template<typename U>
+		friend bool	operator==(mmap_allocator const&,
+			mmap_allocator<U, Threshold> const&) throw()
+		{ return true; }
+
+		template<typename U>
+		friend bool	operator!=(mmap_allocator const&,
+			mmap_allocator<U, Threshold> const&) throw()
+		{ return false; }
+
+	private:
+		static bool			is_mapped(size_type bytes) throw()
+		{ return bytes >= Threshold && bytes != 0; }
+
+		/// Round a mapping up to a whole number of huge pages.
+		static size_type	map_length(size_type bytes) throw()
+		{
+			return (bytes + size_type(_huge_page_size) - 1)
+				& ~(size_type(_huge_page_size) - 1);
+		}
+
+		static void			advise(void* p, size_type length) throw()
+		{
+#ifdef MADV_HUGEPAGE
+			::madvise(p, length, MADV_HUGEPAGE);
+#else
+			(void)p;
+			(void)length;
+#endif
+		}
+	};
+}
@@ -0,0 +1,451 @@
+#pragma once
+
+#include <cstddef>
+
+#include <functional.hpp>
+#include <memory.hpp>
+#include <vector.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A node of a pairing_heap, linked to its leftmost child and to
+	 * its right sibling.
+	 */
+	template<typename T>
+	struct	_pairing_heap_node
+	{
+		T						value;
+		_pairing_heap_node*		child;
+		_pairing_heap_node*		next;
+		/// The parent of a leftmost child, or the left sibling.
+		_pairing_heap_node*		prev;
+
+		explicit _pairing_heap_node(T const& x)
+			:	value(x), child(), next(), prev() { }
+	};
+
+	/**
+	 * @brief A pairing_heap::handle, that designates an element for as long
+	 * as it is in its heap.
+	 */
+	template<typename T>
+	class	_pairing_heap_handle
+	{
+		template<typename T_, typename C_, typename A_>
+		friend class	pairing_heap;
+
+	private:
+		_pairing_heap_node<T>*	node;
+
+		explicit _pairing_heap_handle(_pairing_heap_node<T>* n) throw()
+			:	node(n) { }
+
+	public:
+		_pairing_heap_handle() throw()	:	node() { }
+
+		T const&	operator*() const throw()
+		{ return node->value; }
+
+		T const*	operator->() const throw()
+		{ return &node->value; }
+
+		friend bool	operator==(_pairing_heap_handle const& x,
+			_pairing_heap_handle const& y) throw()
+		{ return x.node == y.node; }
+
+		friend bool	operator!=(_pairing_heap_handle const& x,
+			_pairing_heap_handle const& y) throw()
+		{ return x.node != y.node; }
+	};
+
+	/**
+	 * @brief A heap-ordered tree of any shape, that gives access to its
+	 * greatest element and hands out stable handles to the others.
+	 *
+	 * Pushing and melding link two trees in O(1). Popping pairs up the
+	 * children of the root from left to right and then links the pairs
+	 * from right to left, in O(log n) amortized. Raising an element cuts
+	 * its subtree and links it back at the root, in o(log n) amortized,
+	 * which makes the heap suited to Dijkstra's and Prim's algorithms.
+	 *
+	 * @tparam T		The element type.
+	 * @tparam Compare	The ordering, the top being the greatest element.
+	 * @tparam A		The allocator type, rebound to nodes. A
+	 * pool_allocator avoids a call to malloc for every push.
+	 */
+	template<typename T, typename Compare = less<T>,
+		typename A = allocator<T> >
+	class	pairing_heap
+	{
+	private:
+		typedef	_pairing_heap_node<T>	node_type;
+		typedef	typename _alloc_traits<A>::template rebind<node_type>::other
+			node_alloc_type;
+		typedef	_alloc_traits<node_alloc_type>	node_alloc_traits;
+
+		struct	_pairing_heap_impl	:	public node_alloc_type
+		{
+			node_type*	root;
+			size_t		size;
+			Compare		comp;
+
+			_pairing_heap_impl(Compare const& c, node_alloc_type const& a)
+				:	node_alloc_type(a), root(), size(0), comp(c) { }
+		};
+
+		_pairing_heap_impl	impl;
+
+	public:
+		typedef	T							value_type;
+		typedef	T const&					const_reference;
+		typedef	size_t						size_type;
+		typedef	Compare						value_compare;
+		typedef	A							allocator_type;
+		typedef	_pairing_heap_handle<T>		handle;
+
+		explicit pairing_heap(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	impl(cmp, node_alloc_type(a)) { }
+
+		pairing_heap(pairing_heap const& x)
+			:	impl(x.impl.comp, node_alloc_traits::select_on_copy(x.impl))
+		{
+			try
+			{
+				copy_from(x);
+			}
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+		}
+
+		~pairing_heap() throw()
+		{ clear(); }
+
+		pairing_heap&	operator=(pairing_heap const& x)
+		{
+			if (&x != this)
+			{
+				pairing_heap	tmp(x);
+
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		value_compare	value_comp() const
+		{ return impl.comp; }
+
+		bool		empty() const throw()
+		{ return impl.root == 0; }
+
+		size_type	size() const throw()
+		{ return impl.size; }
+
+		/**
+		 * @brief Returns a reference to the greatest element.
+		 */
+		const_reference	top() const throw()
+		{ return impl.root->value; }
+
+		/**
+		 * @brief Returns a handle to the greatest element.
+		 */
+		handle			top_handle() const throw()
+		{ return handle(impl.root); }
+
+		/**
+		 * @brief Add an element to the heap.
+		 *
+		 * @param x The data to be added.
+		 * @return handle	A handle to the element, that stays valid until
+		 * the element is removed.
+		 */
+		handle	push(value_type const& x)
+		{
+			node_type* const	n = create_node(x);
+
+			impl.root = impl.root ? link(impl.root, n) : n;
+			++impl.size;
+			return handle(n);
+		}
+
+		/**
+		 * @brief Removes the greatest element.
+		 */
+		void	pop()
+		{
+			node_type* const	old_root = impl.root;
+
+			impl.root = merge_pairs(old_root->child);
+			if (impl.root)
+				impl.root->prev = 0;
+			destroy_node(old_root);
+			--impl.size;
+		}
+
+		/**
+		 * @brief Raise the element of h to x, that must not compare less
+		 * than its current value.
+		 */
+		void	decrease_key(handle h, value_type const& x)
+		{
+			node_type* const	n = h.node;
+
+			n->value = x;
+			if (n == impl.root)
+				return;
+			cut(n);
+			impl.root = link(impl.root, n);
+		}
+
+		/**
+		 * @brief Change the element of h to x, in either direction.
+		 */
+		void	update(handle h, value_type const& x)
+		{
+			if (!impl.comp(x, h.node->value))
+			{
+				decrease_key(h, x);
+				return;
+			}
+
+			node_type* const	n = h.node;
+
+			detach(n);
+			n->value = x;
+			impl.root = impl.root ? link(impl.root, n) : n;
+		}
+
+		/**
+		 * @brief Removes the element of h.
+		 */
+		void	erase(handle h)
+		{
+			node_type* const	n = h.node;
+
+			detach(n);
+			destroy_node(n);
+			--impl.size;
+		}
+
+		/**
+		 * @brief Move the elements of x into this heap in O(1). The handles
+		 * of x stay valid, and now designate elements of this heap.
+		 *
+		 * The allocators of both heaps must compare equal.
+		 */
+		void	meld(pairing_heap& x) throw()
+		{
+			if (&x == this || !x.impl.root)
+				return;
+			impl.root = impl.root ? link(impl.root, x.impl.root) : x.impl.root;
+			impl.size += x.impl.size;
+			x.impl.root = 0;
+			x.impl.size = 0;
+		}
+
+		/**
+		 * @brief Swaps data with another heap.
+		 */
+		void	swap(pairing_heap& x) throw()
+		{
+			ft::swap(impl.root, x.impl.root);
+			ft::swap(impl.size, x.impl.size);
+			ft::swap(impl.comp, x.impl.comp);
+			node_alloc_traits::on_swap(impl, x.impl);
+		}
+
+		/**
+		 * @brief Erases all the elements, without recursion.
+		 */
+		void	clear() throw()
+		{
+			node_type*	n = impl.root;
+
+			// Splice the children of each node after it, so that the tree
+			// is walked as a single list.
+			while (n)
+			{
+				if (n->child)
+				{
+					node_type*	last = n->child;
+
+					while (last->next)
+						last = last->next;
+					last->next = n->next;
+					n->next = n->child;
+				}
+
+				node_type* const	next = n->next;
+
+				destroy_node(n);
+				n = next;
+			}
+			impl.root = 0;
+			impl.size = 0;
+		}
+
+	private:
+		node_type*	create_node(value_type const& x)
+		{
+			node_type* const	n = node_alloc_traits::allocate(impl, 1);
+
+			try
+			{
+				node_alloc_traits::construct(impl, n, node_type(x));
+			}
+			catch (...)
+			{
+				node_alloc_traits::deallocate(impl, n, 1);
+				throw;
+			}
+			return n;
+		}
+
+		void		destroy_node(node_type* n) throw()
+		{
+			node_alloc_traits::destroy(impl, n);
+			node_alloc_traits::deallocate(impl, n, 1);
+		}
+
+		/**
+		 * @brief Make the lesser of two roots the leftmost child of the
+		 * other.
+		 *
+		 * @return node_type*	The root of the linked tree.
+		 */
+		node_type*	link(node_type* a, node_type* b) throw()
+		{
+			if (impl.comp(a->value, b->value))
+				ft::swap(a, b);
+			b->next = a->child;
+			if (b->next)
+				b->next->prev = b;
+			b->prev = a;
+			a->child = b;
+			a->next = 0;
+			a->prev = 0;
+			return a;
+		}
+
+		/**
+		 * @brief Unlink a node that is not the root, with its subtree, from
+		 * its parent and siblings.
+		 */
+		void		cut(node_type* n) throw()
+		{
+			if (n->prev->child == n)
+				n->prev->child = n->next;
+			else
+				n->prev->next = n->next;
+			if (n->next)
+				n->next->prev = n->prev;
+			n->next = 0;
+			n->prev = 0;
+		}
+
+		/**
+		 * @brief Remove a node from the heap, keeping its children in.
+		 */
+		void		detach(node_type* n) throw()
+		{
+			node_type*	children;
+
+			if (n == impl.root)
+			{
+				impl.root = merge_pairs(n->child);
+				if (impl.root)
+					impl.root->prev = 0;
+			}
+			else
+			{
+				cut(n);
+				children = merge_pairs(n->child);
+				if (children)
+					impl.root = link(impl.root, children);
+			}
+			n->child = 0;
+		}
+
+		/**
+		 * @brief Link a list of siblings into one tree, pairing them from
+		 * left to right and then linking the pairs from right to left.
+		 */
+		node_type*	merge_pairs(node_type* first) throw()
+		{
+			node_type*	pairs = 0;
+
+			// First pass, that stacks the pairs through their prev links.
+			while (first)
+			{
+				node_type* const	a = first;
+				node_type* const	b = a->next;
+
+				if (!b)
+				{
+					a->next = 0;
+					a->prev = pairs;
+					pairs = a;
+					break;
+				}
+				first = b->next;
+
+				node_type* const	pair = link(a, b);
+
+				pair->prev = pairs;
+				pairs = pair;
+			}
+
+			node_type*	result = pairs;
+
+			if (!result)
+				return 0;
+			pairs = result->prev;
+			result->prev = 0;
+			while (pairs)
+			{
+				node_type* const	below = pairs->prev;
+
+				pairs->prev = 0;
+				result = link(pairs, result);
+				pairs = below;
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Push the elements of x, walking its tree with an explicit
+		 * stack since it can be as deep as it is large.
+		 */
+		void		copy_from(pairing_heap const& x)
+		{
+			vector<node_type const*>	stack;
+
+			if (x.impl.root)
+				stack.push_back(x.impl.root);
+			while (!stack.empty())
+			{
+				node_type const* const	n = stack.back();
+
+				stack.pop_back();
+				push(n->value);
+				if (n->next)
+					stack.push_back(n->next);
+				if (n->child)
+					stack.push_back(n->child);
+			}
+		}
+	};
+
+	template<typename T, typename C, typename A>
+	inline void	swap(pairing_heap<T, C, A>& x, pairing_heap<T, C, A>& y)
+		throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,642 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <algorithm.hpp>
+#include <atomic.hpp>
+#include <exception.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A node of a persistent_map, shared by every version that holds
+	 * a reference to it, and never changed once built.
+	 */
+	template<typename V>
+	struct	_persistent_node
+	{
+		atomic<size_t>		refs;
+		_persistent_node*	left;
+		_persistent_node*	right;
+		int					height;
+		V					value;
+
+		/// A node with a reference, the caller's, to l and r.
+		_persistent_node(V const& x, _persistent_node* l,
+			_persistent_node* r)
+			:	refs(1), left(l), right(r),
+				height(1 + ft::max(height_of(l), height_of(r))), value(x) { }
+
+		static int	height_of(_persistent_node const* n) throw()
+		{ return n ? n->height : 0; }
+	};
+
+	/**
+	 * @brief A persistent_map::iterator, that keeps the path down to its
+	 * node, as nodes have no parent link to climb back up: a node may have
+	 * a different parent in each version that shares it.
+	 *
+	 * It stays valid as long as the version it was taken from lives.
+	 */
+	template<typename V>
+	class	_persistent_iterator
+	{
+	public:
+		typedef	_persistent_node<V>	node;
+
+		/// The greatest height of an AVL tree that fits in memory.
+		enum { max_depth = 88 };
+
+		typedef	forward_iterator_tag	iterator_category;
+		typedef	V						value_type;
+		typedef	V const*				pointer;
+		typedef	V const&				reference;
+		typedef	ptrdiff_t				difference_type;
+
+	private:
+		/// The node, on top, under the ancestors whose left subtree holds
+		/// it, which are the nodes that come after it. Empty at the end.
+		node const*	path[max_depth];
+		unsigned	depth;
+
+	public:
+		_persistent_iterator() throw()
+			:	depth() { }
+
+		_persistent_iterator(_persistent_iterator const& x) throw()
+			:	depth(x.depth)
+		{ ft::copy(x.path, x.path + depth, path); }
+
+		_persistent_iterator&	operator=(_persistent_iterator const& x)
+			throw()
+		{
+			depth = x.depth;
+			ft::copy(x.path, x.path + depth, path);
+			return *this;
+		}
+
+		reference				operator*() const throw()
+		{ return path[depth - 1]->value; }
+
+		pointer					operator->() const throw()
+		{ return &path[depth - 1]->value; }
+
+		_persistent_iterator&	operator++() throw()
+		{
+			node const* const	n = path[--depth];
+
+			push_leftmost(n->right);
+			return *this;
+		}
+
+		_persistent_iterator	operator++(int) throw()
+		{
+			_persistent_iterator	tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		/// Go down to the first node of n's subtree.
+		void					push_leftmost(node const* n) throw()
+		{
+			for (; n; n = n->left)
+				path[depth++] = n;
+		}
+
+		/// Add a node that comes after the ones to be pushed next.
+		void					push(node const* n) throw()
+		{ path[depth++] = n; }
+
+		friend bool	operator==(_persistent_iterator const& x,
+			_persistent_iterator const& y) throw()
+		{
+			return x.depth == y.depth
+				&& (x.depth == 0 || x.path[x.depth - 1] == y.path[y.depth - 1]);
+		}
+
+		friend bool	operator!=(_persistent_iterator const& x,
+			_persistent_iterator const& y) throw()
+		{ return !(x == y); }
+	};
+
+	/**
+	 * @brief A sorted map of unique keys whose copies are O(1) snapshots,
+	 * as an AVL tree of immutable nodes shared between versions.
+	 *
+	 * Copying a map takes a reference to its root. Changing a map copies
+	 * the O(log n) nodes on the path down to the change, and rebalances
+	 * the copies, leaving every other node shared with the versions it
+	 * came from, which see no change. A node is freed once the last
+	 * version holding it is.
+	 *
+	 * Reference counts are atomic, so that copies of a map may be read,
+	 * changed and destroyed by different threads at once. A single map
+	 * object is no safer to share than any other: a thread that updates a
+	 * map that others take snapshots of must hold a lock around both, but
+	 * only for the time of an O(1) copy.
+	 *
+	 * Elements are immutable, as another version may share them: there
+	 * is no operator[], and insert_or_assign() replaces a value instead.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type, rebound to nodes. Its copies must
+	 * be able to free each other's nodes, as versions share them.
+	 */
+	template<typename K, typename T, typename Compare = less<K>,
+		typename A = allocator<pair<K const, T> > >
+	class	persistent_map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Compare				key_compare;
+		typedef	A					allocator_type;
+		typedef	size_t				size_type;
+		typedef	ptrdiff_t			difference_type;
+
+		typedef	_persistent_iterator<value_type>	iterator;
+		typedef	_persistent_iterator<value_type>	const_iterator;
+
+	private:
+		typedef	_persistent_node<value_type>	node;
+		typedef	typename _alloc_traits<A>::template rebind<node>::other
+			node_alloc_type;
+		typedef	_alloc_traits<node_alloc_type>	node_alloc_traits;
+
+		struct	_persistent_impl	:	public node_alloc_type
+		{
+			Compare	comp;
+			node*	root;
+			size_t	n;
+
+			_persistent_impl(Compare const& c, node_alloc_type const& a)
+				:	node_alloc_type(a), comp(c), root(), n() { }
+		};
+
+		/// Holds a reference to a node until the end of the scope.
+		struct	_node_ref
+		{
+			_persistent_impl&	impl;
+			node* const			n;
+
+			_node_ref(_persistent_impl& i, node* x) throw()
+				:	impl(i), n(x) { }
+
+			~_node_ref() throw()
+			{ release(impl, n); }
+		};
+
+		_persistent_impl	impl;
+
+	public:
+		explicit persistent_map(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	impl(cmp, node_alloc_type(a)) { }
+
+		template<typename I>
+		persistent_map(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	impl(cmp, node_alloc_type(a))
+		{
+			try
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+			catch (...)
+			{
+				release(impl, impl.root);
+				throw;
+			}
+		}
+
+		/// Share x's nodes, in O(1).
+		persistent_map(persistent_map const& x) throw()
+			:	impl(x.impl.comp, node_alloc_traits::select_on_copy(x.impl))
+		{
+			impl.root = retain(x.impl.root);
+			impl.n = x.impl.n;
+		}
+
+		~persistent_map() throw()
+		{ release(impl, impl.root); }
+
+		/// Share x's nodes, in O(1), and release this version's.
+		persistent_map&	operator=(persistent_map const& x) throw()
+		{
+			node* const	old = impl.root;
+
+			impl.root = retain(x.impl.root);
+			impl.n = x.impl.n;
+			impl.comp = x.impl.comp;
+			release(impl, old);
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		iterator	begin() const throw()
+		{
+			iterator	i;
+
+			i.push_leftmost(impl.root);
+			return i;
+		}
+
+		iterator	end() const throw()
+		{ return iterator(); }
+
+		bool		empty() const throw()
+		{ return impl.n == 0; }
+
+		size_type	size() const throw()
+		{ return impl.n; }
+
+		size_type	max_size() const throw()
+		{ return node_alloc_traits::max_size(impl); }
+
+		void		swap(persistent_map& x) throw()
+		{
+			ft::swap(impl.comp, x.impl.comp);
+			ft::swap(impl.root, x.impl.root);
+			ft::swap(impl.n, x.impl.n);
+			node_alloc_traits::on_swap(impl, x.impl);
+		}
+
+		key_compare	key_comp() const
+		{ return impl.comp; }
+
+		/**
+		 * @brief Insert x unless its key is already in the map, leaving
+		 * the other versions unchanged.
+		 *
+		 * @return bool	Whether x was inserted.
+		 */
+		bool		insert(value_type const& x)
+		{ return update(x, false); }
+
+		/**
+		 * @brief Insert x, or replace the element with its key by x,
+		 * leaving the other versions unchanged.
+		 *
+		 * @return bool	Whether x was inserted.
+		 */
+		bool		insert_or_assign(value_type const& x)
+		{ return update(x, true); }
+
+		/**
+		 * @brief Erase the element with key k, if any, leaving the other
+		 * versions unchanged.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			bool		found = false;
+			node* const	root = erase(impl.root, k, found);
+
+			if (!found)
+				return 0;
+			release(impl, impl.root);
+			impl.root = root;
+			--impl.n;
+			return 1;
+		}
+
+		/// Release this version's nodes.
+		void		clear() throw()
+		{
+			release(impl, impl.root);
+			impl.root = 0;
+			impl.n = 0;
+		}
+
+		/**
+		 * @brief Returns the value mapped to k.
+		 *
+		 * @throw OutOfRangeException if k is not in the map.
+		 */
+		mapped_type const&	at(key_type const& k) const
+		{
+			node const* const	n = lookup(k);
+
+			if (!n)
+				throw OutOfRangeException();
+			return n->value.second;
+		}
+
+		iterator	find(key_type const& k) const
+		{
+			iterator const	i = lower_bound(k);
+
+			return i == end() || impl.comp(k, i->first) ? end() : i;
+		}
+
+		size_type	count(key_type const& k) const
+		{ return lookup(k) != 0; }
+
+		/// The first element whose key is not less than k.
+		iterator	lower_bound(key_type const& k) const
+		{
+			iterator	i;
+
+			for (node const* n = impl.root; n;)
+			{
+				if (impl.comp(n->value.first, k))
+					n = n->right;
+				else
+				{
+					i.push(n);
+					n = n->left;
+				}
+			}
+			return i;
+		}
+
+		/// The first element whose key is greater than k.
+		iterator	upper_bound(key_type const& k) const
+		{
+			iterator	i;
+
+			for (node const* n = impl.root; n;)
+			{
+				if (impl.comp(k, n->value.first))
+				{
+					i.push(n);
+					n = n->left;
+				}
+				else
+					n = n->right;
+			}
+			return i;
+		}
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{ return pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+
+		friend bool	operator==(persistent_map const& x,
+			persistent_map const& y)
+		{
+			return x.size() == y.size() && (x.impl.root == y.impl.root
+				|| ft::equal(x.begin(), x.end(), y.begin()));
+		}
+
+		friend bool	operator<(persistent_map const& x,
+			persistent_map const& y)
+		{
+			return ft::lexicographical_compare(x.begin(), x.end(),
+				y.begin(), y.end());
+		}
+
+	private:
+		static node*	retain(node* n) throw()
+		{
+			if (n)
+				n->refs.fetch_add(1, memory_order_relaxed);
+			return n;
+		}
+
+		/**
+		 * @brief Drop a reference to n, and free it along with the nodes
+		 * only it held if it was the last one. The last reference needs no
+		 * atomic decrement, as no other thread can take a new one.
+		 */
+		static void		release(node_alloc_type& a, node* n) throw()
+		{
+			while (n && (n->refs.load(memory_order_acquire) == 1
+				|| n->refs.fetch_sub(1, memory_order_acq_rel) == 1))
+			{
+				node* const	right = n->right;
+
+				release(a, n->left);
+				n->~node();
+				node_alloc_traits::deallocate(a, n, 1);
+				n = right;
+			}
+		}
+
+		node const*	lookup(key_type const& k) const
+		{
+			node const*	n = impl.root;
+
+			while (n)
+			{
+				if (impl.comp(k, n->value.first))
+					n = n->left;
+				else if (impl.comp(n->value.first, k))
+					n = n->right;
+				else
+					break;
+			}
+			return n;
+		}
+
+		bool		update(value_type const& x, bool assign)
+		{
+			bool		inserted = false;
+			node* const	root = insert(impl.root, x, assign, inserted);
+
+			if (!root)
+				return false;
+			release(impl, impl.root);
+			impl.root = root;
+			impl.n += inserted;
+			return inserted;
+		}
+
+		/**
+		 * @brief A new node of x over l and r, which it takes a reference
+		 * to. Nodes are never changed after this, so that they can be
+		 * shared.
+		 */
+		node*		make(value_type const& x, node* l, node* r)
+		{
+			node* const	n = node_alloc_traits::allocate(impl, 1);
+
+			try
+			{
+				::new(static_cast<void*>(n)) node(x, l, r);
+			}
+			catch (...)
+			{
+				node_alloc_traits::deallocate(impl, n, 1);
+				throw;
+			}
+			retain(l);
+			retain(r);
+			return n;
+		}
+
+		/**
+		 * @brief A new subtree of x over l and r, whose heights may differ
+		 * by 2, rotated back into balance. l and r are shared, not copied,
+		 * except for the nodes that rotate.
+		 */
+		node*		balance(value_type const& x, node* l, node* r)
+		{
+			int const	hl = node::height_of(l);
+			int const	hr = node::height_of(r);
+
+			if (hl > hr + 1)
+			{
+				if (node::height_of(l->left) >= node::height_of(l->right))
+				{
+					_node_ref const	b(impl, make(x, l->right, r));
+
+					return make(l->value, l->left, b.n);
+				}
+
+				node* const		lr = l->right;
+				_node_ref const	a(impl, make(l->value, l->left, lr->left));
+				_node_ref const	b(impl, make(x, lr->right, r));
+
+				return make(lr->value, a.n, b.n);
+			}
+			if (hr > hl + 1)
+			{
+				if (node::height_of(r->right) >= node::height_of(r->left))
+				{
+					_node_ref const	a(impl, make(x, l, r->left));
+
+					return make(r->value, a.n, r->right);
+				}
+
+				node* const		rl = r->left;
+				_node_ref const	a(impl, make(x, l, rl->left));
+				_node_ref const	b(impl, make(r->value, rl->right, r->right));
+
+				return make(rl->value, a.n, b.n);
+			}
+			return make(x, l, r);
+		}
+
+		/**
+		 * @brief A copy of t with x inserted, or its element with x's key
+		 * replaced if assign.
+		 *
+		 * @return node*	The new subtree, or 0 if t is left as it is.
+		 */
+		node*		insert(node* t, value_type const& x, bool assign,
+			bool& inserted)
+		{
+			if (!t)
+			{
+				inserted = true;
+				return make(x, 0, 0);
+			}
+			if (impl.comp(x.first, t->value.first))
+			{
+				node* const	l = insert(t->left, x, assign, inserted);
+
+				if (!l)
+					return 0;
+
+				_node_ref const	hold(impl, l);
+
+				return balance(t->value, l, t->right);
+			}
+			if (impl.comp(t->value.first, x.first))
+			{
+				node* const	r = insert(t->right, x, assign, inserted);
+
+				if (!r)
+					return 0;
+
+				_node_ref const	hold(impl, r);
+
+				return balance(t->value, t->left, r);
+			}
+			return assign ? make(x, t->left, t->right) : 0;
+		}
+
+		/**
+		 * @brief A copy of t without its element with key k, if found.
+		 *
+		 * @return node*	The new subtree, if found.
+		 */
+		node*		erase(node* t, key_type const& k, bool& found)
+		{
+			if (!t)
+				return 0;
+			if (impl.comp(k, t->value.first))
+			{
+				node* const	l = erase(t->left, k, found);
+
+				if (!found)
+					return 0;
+
+				_node_ref const	hold(impl, l);
+
+				return balance(t->value, l, t->right);
+			}
+			if (impl.comp(t->value.first, k))
+			{
+				node* const	r = erase(t->right, k, found);
+
+				if (!found)
+					return 0;
+
+				_node_ref const	hold(impl, r);
+
+				return balance(t->value, t->left, r);
+			}
+			found = true;
+			if (!t->left || !t->right)
+				return retain(t->left ? t->left : t->right);
+
+			node const*	m = t->right;
+
+			while (m->left)
+				m = m->left;
+
+			_node_ref const	r(impl, erase_first(t->right));
+
+			return balance(m->value, t->left, r.n);
+		}
+
+		/// A copy of t without its first element.
+		node*		erase_first(node* t)
+		{
+			if (!t->left)
+				return retain(t->right);
+
+			_node_ref const	l(impl, erase_first(t->left));
+
+			return balance(t->value, l.n, t->right);
+		}
+	};
+
+	template<typename K, typename T, typename C, typename A>
+	inline bool	operator!=(persistent_map<K, T, C, A> const& x,
+		persistent_map<K, T, C, A> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename T, typename C, typename A>
+	inline bool	operator>(persistent_map<K, T, C, A> const& x,
+		persistent_map<K, T, C, A> const& y)
+	{ return y < x; }
+
+	template<typename K, typename T, typename C, typename A>
+	inline bool	operator<=(persistent_map<K, T, C, A> const& x,
+		persistent_map<K, T, C, A> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename T, typename C, typename A>
+	inline bool	operator>=(persistent_map<K, T, C, A> const& x,
+		persistent_map<K, T, C, A> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename T, typename C, typename A>
+	inline void	swap(persistent_map<K, T, C, A>& x,
+		persistent_map<K, T, C, A>& y) throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#include <pthread.h>
+
+#include <memory.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A free list of blocks of Size bytes, one per thread, carved out
+	 * of chunks that double in size and are kept until the program exits.
+	 *
+	 * Threads share a depot of free blocks. A thread hands blocks over to
+	 * it by batches, when it holds more free ones than it needs, and when
+	 * it exits. It takes blocks from the depot before carving out a new
+	 * chunk. Blocks freed by another thread than the one that allocated
+	 * them, as with a producer and a consumer, flow back to the allocating
+	 * thread through the depot, so that neither pool grows without bound.
+	 *
+	 * @tparam Size	The block size, a multiple of the block alignment.
+	 */
+	template<size_t Size>
+	class	_node_pool
+	{
+	private:
+		struct	_free_block
+		{ _free_block*	next; };
+
+		struct	_chunk
+		{ _chunk*	next; };
+
+		/// Size of a chunk header, keeping the blocks after it aligned.
+		enum { _header_size = (sizeof(_chunk) + Size - 1) / Size * Size };
+		enum { _min_blocks = 32, _max_blocks = 65536 };
+		/// The blocks moved to or from the depot at once. A thread keeps
+		/// up to twice as many free ones.
+		enum { _batch = 256 };
+
+		_free_block*	free_list;
+		size_t			free_count;
+		/// The part of the last chunk that no block was carved from yet.
+		char*			fresh;
+		char*			fresh_end;
+		size_t			next_blocks;
+
+		static pthread_mutex_t	depot_lock;
+		static _free_block*		depot;
+		/// Every chunk, so that none is lost when its thread exits.
+		static _chunk*			chunks;
+		static pthread_key_t	key;
+		static pthread_once_t	once;
+
+		_node_pool() throw()
+			:	free_list(), free_count(), fresh(), fresh_end(),
+				next_blocks(_min_blocks) { }
+
+		_node_pool(_node_pool const&);
+		_node_pool&	operator=(_node_pool const&);
+
+	public:
+		/**
+		 * @brief Returns the calling thread's pool, shared by every
+		 * allocator of Size bytes on that thread, and whose free blocks go
+		 * to the depot when the thread exits.
+		 */
+		static _node_pool&	instance()
+		{
+			_node_pool*&	pool = local();
+
+			if (!pool)
+			{
+				pthread_once(&once, make_key);
+				pool = new _node_pool();
+				pthread_setspecific(key, pool);
+			}
+			return *pool;
+		}
+
+		void*	allocate()
+		{
+			if (!free_list && fresh == fresh_end)
+				refill();
+			if (!free_list)
+			{
+				void* const	block = fresh;
+
+				fresh += Size;
+				return block;
+			}
+
+			_free_block* const	block = free_list;
+
+			free_list = block->next;
+			--free_count;
+			return block;
+		}
+
+		void	deallocate(void* p) throw()
+		{
+			_free_block* const	block = static_cast<_free_block*>(p);
+
+			block->next = free_list;
+			free_list = block;
+			if (++free_count >= 2 * _batch)
+				give_back(_batch);
+		}
+
+	private:
+		static _node_pool*&	local() throw()
+		{
+			static __thread _node_pool*	pool = 0;
+
+			return pool;
+		}
+
+		static void	make_key()
+		{ pthread_key_create(&key, release); }
+
+		/// Hand the free blocks of a thread that exits over to the depot.
+		static void	release(void* arg)
+		{
+			_node_pool* const	pool = static_cast<_node_pool*>(arg);
+
+			for (; pool->fresh != pool->fresh_end; pool->fresh += Size)
+			{
+				_free_block* const	block
+					= reinterpret_cast<_free_block*>(pool->fresh);
+
+				block->next = pool->free_list;
+				pool->free_list = block;
+				++pool->free_count;
+			}
+			if (pool->free_count)
+				pool->give_back(pool->free_count);
+			local() = 0;
+			delete pool;
+		}
+
+		/// Move the first n free blocks to the depot.
+		void	give_back(size_t n) throw()
+		{
+			_free_block* const	first = free_list;
+			_free_block*		last = first;
+
+			for (size_t i = 1; i < n; ++i)
+				last = last->next;
+			free_list = last->next;
+			free_count -= n;
+			pthread_mutex_lock(&depot_lock);
+			last->next = depot;
+			depot = first;
+			pthread_mutex_unlock(&depot_lock);
+		}
+
+		/**
+		 * @brief Take a batch of blocks from the depot, or allocate a new
+		 * chunk to carve blocks out of if it is empty.
+		 */
+		void	refill()
+		{
+			pthread_mutex_lock(&depot_lock);
+			if (depot)
+			{
+				_free_block*	last = depot;
+				size_t			n = 1;
+
+				for (; n < _batch && last->next; ++n)
+					last = last->next;
+				free_list = depot;
+				depot = last->next;
+				last->next = 0;
+				free_count = n;
+				pthread_mutex_unlock(&depot_lock);
+				return;
+			}
+			pthread_mutex_unlock(&depot_lock);
+
+			size_t const	n = next_blocks;
+			char* const		raw = static_cast<char*>(
+				::operator new(_header_size + n * Size));
+			_chunk* const	chunk = reinterpret_cast<_chunk*>(raw);
+
+			pthread_mutex_lock(&depot_lock);
+			chunk->next = chunks;
+			chunks = chunk;
+			pthread_mutex_unlock(&depot_lock);
+			fresh = raw + _header_size;
+			fresh_end = fresh + n * Size;
+			if (next_blocks < _max_blocks)
+				next_blocks *= 2;
+		}
+	};
+
+	template<size_t Size>
+	pthread_mutex_t	_node_pool<Size>::depot_lock = PTHREAD_MUTEX_INITIALIZER;
+
+	template<size_t Size>
+	typename _node_pool<Size>::_free_block*	_node_pool<Size>::depot = 0;
+
+	template<size_t Size>
+	typename _node_pool<Size>::_chunk*	_node_pool<Size>::chunks = 0;
+
+	template<size_t Size>
+	pthread_key_t	_node_pool<Size>::key;
+
+	template<size_t Size>
+	pthread_once_t	_node_pool<Size>::once = PTHREAD_ONCE_INIT;
+
+	/**
+	 * @brief An allocator that serves single objects from a free list of
+	 * same-sized blocks, and arrays with operator new.
+	 *
+	 * Suits node-based containers, whose nodes it packs densely and
+	 * recycles without calling malloc. Every allocator of the same block
+	 * size shares one pool per thread, so all pool allocators compare
+	 * equal and rebinding is free. Freed blocks are reused by any thread,
+	 * but the chunks they are carved from are kept until the program
+	 * exits.
+	 *
+	 * @tparam T	The element type.
+	 */
+	template<typename T>
+	class	pool_allocator
+	{
+	public:
+		typedef std::size_t		size_type;
+		typedef	std::ptrdiff_t	difference_type;
+		typedef T*				pointer;
+		typedef T const*		const_pointer;
+		typedef T&				reference;
+		typedef	T const&		const_reference;
+		typedef T				value_type;
+
+		template<typename O>
+		struct	rebind
+		{ typedef pool_allocator<O> other; };
+
+	private:
+		enum { _align = __alignof__(T) > sizeof(void*)
+			? __alignof__(T) : sizeof(void*) };
+		enum { _block_size = (sizeof(T) + _align - 1) / _align * _align };
+
+		typedef	_node_pool<_block_size>	pool_type;
+
+	public:
+		pool_allocator() throw() { }
+
+		pool_allocator(pool_allocator const&) throw() { }
+
+		template<typename O>
+		pool_allocator(pool_allocator<O> const&) throw() { }
+
+		~pool_allocator() throw() { }
+
+		pointer			address(reference x) const throw()
+		{ return &x; }
+
+		const_pointer	address(const_reference x) const throw()
+		{ return &x; }
+
+		/**
+		 * @brief Allocate storage for n elements, from the pool if n is 1.
+		 */
+		pointer			allocate(size_type n,
+			const void* = static_cast<const void*>(0))
+		{
+			if (n == 1)
+				return static_cast<pointer>(pool_type::instance().allocate());
+			if (n > max_size())
+				throw BadArrayNewLengthException();
+			return static_cast<pointer>(::operator new(n * sizeof(T)));
+		}
+
+		void			deallocate(pointer p, size_type n) throw()
+		{
+			if (n == 1)
+				pool_type::instance().deallocate(p);
+			else
+				::operator delete(p);
+		}
+
+		size_type		max_size() const throw()
+		{ return size_type(-1) / sizeof(T); }
+
+		void			construct(pointer p, T const& value)
+		{ ::new(static_cast<void*>(p)) T(value); }
+
+		void			destroy(pointer p)
+		{ p->~T(); }
+
+		template<typename U>
+		friend bool	operator==(pool_allocator const&,
+			pool_allocator<U> const&) throw()
+		{ return true; }
+
+		template<typename U>
+		friend bool	operator!=(pool_allocator const&,
+			pool_allocator<U> const&) throw()
+		{ return false; }
+	};
+}
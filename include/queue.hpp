@@ -0,0 +1,927 @@
+#pragma once
+
+#include <atomic.hpp>
+#include <circular_buffer.hpp>
+#include <deque.hpp>
+#include <functional.hpp>
+#include <memory.hpp>
+#include <vector.hpp>
+
+namespace ft
+{
+	namespace detail
+	{
+		template<typename C, typename T>
+		inline void	_queue_push(C& c, T const& x)
+		{ c.push_back(x); }
+
+		/// A full circular_buffer that rejects the push would lose x.
+		template<typename T, typename A>
+		inline void	_queue_push(circular_buffer<T, A>& c, T const& x)
+		{
+			if (!c.push_back(x))
+				throw LengthErrorException();
+		}
+	}
+
+	/**
+	 * @brief A first-in first-out adapter over a sequence container.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam C	The underlying container, that must provide front(),
+	 * back(), push_back() and pop_front().
+	 */
+	template<typename T, typename C = deque<T> >
+	class	queue
+	{
+		template<typename T_, typename C_>
+		friend bool	operator==(queue<T_, C_> const&, queue<T_, C_> const&);
+
+		template<typename T_, typename C_>
+		friend bool	operator<(queue<T_, C_> const&, queue<T_, C_> const&);
+
+	public:
+		typedef typename C::value_type		value_type;
+		typedef typename C::reference		reference;
+		typedef typename C::const_reference	const_reference;
+		typedef typename C::size_type		size_type;
+		typedef C							container_type;
+
+	protected:
+		C	c;
+
+	public:
+		explicit queue(C const& container = C())	:	c(container) { }
+
+		/**
+		 * @brief Returns true if the queue is empty.
+		 */
+		bool	empty() const
+		{ return c.empty(); }
+
+		/**
+		 * @brief Returns the number of elements in the queue.
+		 */
+		size_type	size() const
+		{ return c.size(); }
+
+		/**
+		 * @brief Returns a reference to the oldest element.
+		 */
+		reference		front()
+		{ return c.front(); }
+
+		const_reference	front() const
+		{ return c.front(); }
+
+		/**
+		 * @brief Returns a reference to the newest element.
+		 */
+		reference		back()
+		{ return c.back(); }
+
+		const_reference	back() const
+		{ return c.back(); }
+
+		/**
+		 * @brief Add data at the end of the queue.
+		 *
+		 * @param x The data to be added.
+		 * @throw LengthErrorException if the container is a full
+		 * circular_buffer that rejects pushes when full.
+		 */
+		void	push(value_type const& x)
+		{ detail::_queue_push(c, x); }
+
+		/**
+		 * @brief Removes the oldest element.
+		 */
+		void	pop()
+		{ c.pop_front(); }
+	};
+
+	template<typename T, typename C>
+	inline bool	operator==(queue<T, C> const& x, queue<T, C> const& y)
+	{ return x.c == y.c; }
+
+	template<typename T, typename C>
+	inline bool	operator<(queue<T, C> const& x, queue<T, C> const& y)
+	{ return x.c < y.c; }
+
+	template<typename T, typename C>
+	inline bool	operator!=(queue<T, C> const& x, queue<T, C> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename C>
+	inline bool	operator>(queue<T, C> const& x, queue<T, C> const& y)
+	{ return y < x; }
+
+	template<typename T, typename C>
+	inline bool	operator<=(queue<T, C> const& x, queue<T, C> const& y)
+	{ return !(y < x); }
+
+	template<typename T, typename C>
+	inline bool	operator>=(queue<T, C> const& x, queue<T, C> const& y)
+	{ return !(x < y); }
+
+
+	namespace detail
+	{
+		/**
+		 * @brief Heap operations on a random access range where each node
+		 * has D children, the children of i being D * i + 1 to D * i + D.
+		 *
+		 * Compared to a binary heap, a 4-ary heap is half as deep and the
+		 * children of a node usually share a cache line, at the cost of
+		 * more comparisons per level when sifting down.
+		 */
+		template<size_t D>
+		struct	_dary_heap
+		{
+			/**
+			 * @brief Move value up from hole until its parent does not
+			 * compare less than it.
+			 */
+			template<typename R, typename T, typename Compare>
+			static void	sift_up(R first, ptrdiff_t hole, T const& value,
+				Compare& cmp)
+			{
+				while (hole > 0)
+				{
+					ptrdiff_t const	parent = (hole - 1) / ptrdiff_t(D);
+
+					if (!cmp(first[parent], value))
+						break;
+					first[hole] = first[parent];
+					hole = parent;
+				}
+				first[hole] = value;
+			}
+
+			/**
+			 * @brief Returns the greatest of the children of a node, the
+			 * first of which is child, in a heap of len elements.
+			 */
+			template<typename R, typename Compare>
+			static ptrdiff_t	best_child(R first, ptrdiff_t child,
+				ptrdiff_t len, Compare& cmp)
+			{
+				ptrdiff_t	best = child;
+
+				// Full nodes get a fixed trip count that can be unrolled.
+				if (child + ptrdiff_t(D) <= len)
+				{
+					for (ptrdiff_t i = child + 1; i < child + ptrdiff_t(D); ++i)
+						best = cmp(first[best], first[i]) ? i : best;
+					return best;
+				}
+				for (ptrdiff_t i = child + 1; i < len; ++i)
+					if (cmp(first[best], first[i]))
+						best = i;
+				return best;
+			}
+
+			/**
+			 * @brief Move value down from hole, in a heap of len elements,
+			 * until none of its children compares greater than it.
+			 */
+			template<typename R, typename T, typename Compare>
+			static void	sift_down(R first, ptrdiff_t hole, ptrdiff_t len,
+				T const& value, Compare& cmp)
+			{
+				for (ptrdiff_t child = ptrdiff_t(D) * hole + 1; child < len;
+					child = ptrdiff_t(D) * hole + 1)
+				{
+					ptrdiff_t const	best = best_child(first, child, len, cmp);
+
+					if (!cmp(value, first[best]))
+						break;
+					first[hole] = first[best];
+					hole = best;
+				}
+				first[hole] = value;
+			}
+
+			/**
+			 * @brief Rearrange a range into a heap bottom-up, in linear time.
+			 */
+			template<typename R, typename Compare>
+			static void	make(R first, R last, Compare& cmp)
+			{
+				typedef typename iterator_traits<R>::value_type	T;
+
+				ptrdiff_t const	len = last - first;
+
+				if (len < 2)
+					return;
+				for (ptrdiff_t i = (len - 2) / ptrdiff_t(D); i >= 0; --i)
+				{
+					T const	value = first[i];
+
+					sift_down(first, i, len, value, cmp);
+				}
+			}
+		};
+	}
+
+	/**
+	 * @brief An adapter that gives access to the greatest element of a
+	 * random access container kept as a D-ary heap.
+	 *
+	 * @tparam T		The element type.
+	 * @tparam C		The underlying container, that must provide random
+	 * access iterators, push_back() and pop_back().
+	 * @tparam Compare	The ordering, the top being the greatest element.
+	 * @tparam D		The number of children of each node.
+	 */
+	template<typename T, typename C = vector<T>,
+		typename Compare = less<typename C::value_type>, size_t D = 4>
+	class	priority_queue
+	{
+	private:
+		typedef	detail::_dary_heap<D>	heap;
+
+	public:
+		typedef typename C::value_type		value_type;
+		typedef typename C::reference		reference;
+		typedef typename C::const_reference	const_reference;
+		typedef typename C::size_type		size_type;
+		typedef C							container_type;
+		typedef Compare						value_compare;
+
+		/// The number of children of each node.
+		static size_t const	arity = D;
+
+	protected:
+		C		c;
+		Compare	comp;
+
+	public:
+		explicit priority_queue(Compare const& cmp = Compare(),
+			C const& container = C())
+			:	c(container), comp(cmp)
+		{ heap::make(c.begin(), c.end(), comp); }
+
+		/**
+		 * @brief Construct a queue of the elements of container and of the
+		 * range [first, last), heapified in linear time.
+		 */
+		template<typename I>
+		priority_queue(I first, I last, Compare const& cmp = Compare(),
+			C const& container = C())
+			:	c(container), comp(cmp)
+		{
+			c.insert(c.end(), first, last);
+			heap::make(c.begin(), c.end(), comp);
+		}
+
+		/**
+		 * @brief Returns true if the queue is empty.
+		 */
+		bool	empty() const
+		{ return c.empty(); }
+
+		/**
+		 * @brief Returns the number of elements in the queue.
+		 */
+		size_type	size() const
+		{ return c.size(); }
+
+		/**
+		 * @brief Returns a reference to the greatest element.
+		 */
+		const_reference	top() const
+		{ return c.front(); }
+
+		/**
+		 * @brief Add an element to the queue.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	push(value_type const& x)
+		{
+			c.push_back(x);
+
+			value_type const	value = c.back();
+
+			heap::sift_up(c.begin(), ptrdiff_t(c.size() - 1), value, comp);
+		}
+
+		/**
+		 * @brief Add the elements of [first, last) to the queue.
+		 *
+		 * When the range is at least as long as the queue, the heap is
+		 * rebuilt in linear time instead of sifting each element up.
+		 */
+		template<typename I>
+		void	push_range(I first, I last)
+		{
+			size_type const	old_size = c.size();
+
+			c.insert(c.end(), first, last);
+
+			size_type const	added = c.size() - old_size;
+
+			if (added >= old_size)
+			{
+				heap::make(c.begin(), c.end(), comp);
+				return;
+			}
+			for (size_type i = old_size; i < c.size(); ++i)
+			{
+				value_type const	value = c[i];
+
+				heap::sift_up(c.begin(), ptrdiff_t(i), value, comp);
+			}
+		}
+
+		/**
+		 * @brief Removes the greatest element.
+		 */
+		void	pop()
+		{
+			value_type const	value = c.back();
+
+			c.pop_back();
+			if (!c.empty())
+				heap::sift_down(c.begin(), 0, ptrdiff_t(c.size()), value,
+					comp);
+		}
+
+		/**
+		 * @brief Replace the greatest element with x, in a single sift
+		 * instead of a pop() and a push(). The queue must not be empty.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	pop_push(value_type const& x)
+		{
+			value_type const	value = x;
+
+			heap::sift_down(c.begin(), 0, ptrdiff_t(c.size()), value, comp);
+		}
+
+		/**
+		 * @brief Swaps data with another queue.
+		 */
+		void	swap(priority_queue& x)
+		{
+			ft::swap(c, x.c);
+			ft::swap(comp, x.comp);
+		}
+	};
+
+	template<typename T, typename C, typename Compare, size_t D>
+	size_t const	priority_queue<T, C, Compare, D>::arity;
+
+	template<typename T, typename C, typename Compare, size_t D>
+	inline void	swap(priority_queue<T, C, Compare, D>& x,
+		priority_queue<T, C, Compare, D>& y)
+	{ x.swap(y); }
+
+	/**
+	 * @brief A bounded wait-free queue between exactly one producer thread
+	 * and one consumer thread.
+	 *
+	 * The producer only writes the tail and the consumer only writes the
+	 * head, each on its own cache line. Each side also keeps a cached copy
+	 * of the other side's index, and only reloads it when the cached value
+	 * says the ring is full or empty, so that in steady state the cache
+	 * lines do not bounce between cores on every operation.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename A = allocator<T> >
+	class	spsc_queue
+	{
+	private:
+		typedef	typename _alloc_traits<A>::template rebind<T>::other
+			T_alloc_type;
+		typedef	_alloc_traits<T_alloc_type>		T_alloc_traits;
+
+	public:
+		typedef	T		value_type;
+		typedef	size_t	size_type;
+		typedef	A		allocator_type;
+
+	private:
+		/// The index owned by one side, on a cache line of its own.
+		struct	_side
+		{
+			atomic<size_t>	index;
+			/// The last index of the other side seen by this side.
+			size_t			other;
+			char			pad[cache_line_size - 2 * sizeof(size_t)];
+
+			_side() throw()	:	index(0), other(0) { }
+		};
+
+		struct	_spsc_queue_impl	:	public T_alloc_type
+		{
+			T*		buf;
+			size_t	mask;
+			char	pad[cache_line_size];
+			_side	producer;
+			_side	consumer;
+
+			_spsc_queue_impl(T_alloc_type const& a)
+				:	T_alloc_type(a), buf(), mask(0) { }
+		};
+
+		_spsc_queue_impl	impl;
+
+		spsc_queue(spsc_queue const&);
+		spsc_queue&	operator=(spsc_queue const&);
+
+	public:
+		/**
+		 * @brief Construct an empty queue that holds at least n elements.
+		 *
+		 * @param n	The minimal capacity, rounded up to a power of two.
+		 */
+		explicit spsc_queue(size_type n,
+			allocator_type const& a = allocator_type())
+			:	impl(a)
+		{
+			size_t const	capacity = detail::_ceil_pow2(n ? n : 1);
+
+			if (capacity < n || capacity > T_alloc_traits::max_size(impl))
+				throw LengthErrorException();
+			impl.buf = T_alloc_traits::allocate(impl, capacity);
+			impl.mask = capacity - 1;
+		}
+
+		~spsc_queue() throw()
+		{
+			size_t const	tail = load_tail(memory_order_acquire);
+
+			for (size_t i = load_head(memory_order_relaxed);
+				i != tail; ++i)
+				T_alloc_traits::destroy(impl, slot(i));
+			T_alloc_traits::deallocate(impl, impl.buf, capacity());
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		size_type	capacity() const throw()
+		{ return impl.mask + 1; }
+
+		/**
+		 * @brief Returns the number of elements in the queue, which is only
+		 * a snapshot while the other side is running.
+		 */
+		size_type	size() const throw()
+		{
+			size_t const	head = load_head(memory_order_acquire);
+
+			return load_tail(memory_order_acquire) - head;
+		}
+
+		bool		empty() const throw()
+		{ return size() == 0; }
+
+		/**
+		 * @brief Add data at the end of the queue. Producer only.
+		 *
+		 * @param x The data to be added.
+		 * @return bool	false if the queue is full.
+		 */
+		bool	try_push(value_type const& x)
+		{
+			size_t const	tail = load_tail(memory_order_relaxed);
+
+			if (writable(tail, 1) == 0)
+				return false;
+			T_alloc_traits::construct(impl, slot(tail), x);
+			impl.producer.index.store(tail + 1, memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief Copy the oldest element into x and remove it. Consumer only.
+		 *
+		 * @return bool	false if the queue is empty.
+		 */
+		bool	try_pop(value_type& x)
+		{
+			value_type* const	p = front();
+
+			if (!p)
+				return false;
+			x = *p;
+			pop();
+			return true;
+		}
+
+		/**
+		 * @brief Returns a pointer to the oldest element, or a null pointer
+		 * if the queue is empty. Consumer only.
+		 */
+		value_type*	front()
+		{
+			size_t const	head = load_head(memory_order_relaxed);
+
+			return readable(head, 1) ? slot(head) : 0;
+		}
+
+		/**
+		 * @brief Removes the oldest element, that front() returned.
+		 * Consumer only.
+		 */
+		void	pop() throw()
+		{
+			size_t const	head = load_head(memory_order_relaxed);
+
+			T_alloc_traits::destroy(impl, slot(head));
+			impl.consumer.index.store(head + 1, memory_order_release);
+		}
+
+		/**
+		 * @brief Push up to n elements from first in at most two contiguous
+		 * copies, and publish them all at once. Producer only.
+		 *
+		 * @return size_type	The number of elements that were pushed.
+		 */
+		template<typename I>
+		size_type	push_n(I first, size_type n)
+		{
+			size_t const	tail = load_tail(memory_order_relaxed);
+
+			n = ft::min(n, writable(tail, n));
+			if (n == 0)
+				return 0;
+
+			size_t const	first_len = contiguous(tail, n);
+			I				mid = first;
+			I				last;
+
+			ft::advance(mid, first_len);
+			last = mid;
+			ft::advance(last, n - first_len);
+			_uninitialized_copy_a(first, mid, slot(tail), impl);
+			try
+			{
+				_uninitialized_copy_a(mid, last, impl.buf, impl);
+			}
+			catch (...)
+			{
+				ft::destroy(slot(tail), slot(tail) + first_len, impl);
+				throw;
+			}
+			impl.producer.index.store(tail + n, memory_order_release);
+			return n;
+		}
+
+		/**
+		 * @brief Pop up to n of the oldest elements into out in at most two
+		 * contiguous copies, and release their slots all at once. Consumer
+		 * only.
+		 *
+		 * @return size_type	The number of elements that were popped.
+		 */
+		template<typename O>
+		size_type	pop_n(O out, size_type n)
+		{
+			size_t const	head = load_head(memory_order_relaxed);
+
+			n = ft::min(n, readable(head, n));
+			if (n == 0)
+				return 0;
+
+			size_t const	first_len = contiguous(head, n);
+
+			out = ft::copy(slot(head), slot(head) + first_len, out);
+			ft::copy(impl.buf, impl.buf + (n - first_len), out);
+			ft::destroy(slot(head), slot(head) + first_len, impl);
+			ft::destroy(impl.buf, impl.buf + (n - first_len), impl);
+			impl.consumer.index.store(head + n, memory_order_release);
+			return n;
+		}
+
+	private:
+		size_t	load_head(memory_order order) const throw()
+		{ return impl.consumer.index.load(order); }
+
+		size_t	load_tail(memory_order order) const throw()
+		{ return impl.producer.index.load(order); }
+
+		T*		slot(size_t i) const throw()
+		{ return impl.buf + (i & impl.mask); }
+
+		/// Returns how many of n slots from i are contiguous in the ring.
+		size_t	contiguous(size_t i, size_t n) const throw()
+		{ return ft::min(n, capacity() - (i & impl.mask)); }
+
+		/**
+		 * @brief Returns the number of free slots after tail, reloading the
+		 * consumer's index only if the cached one leaves less than n.
+		 */
+		size_t	writable(size_t tail, size_t n) throw()
+		{
+			_side&	p = impl.producer;
+
+			if (capacity() - (tail - p.other) < n)
+				p.other = load_head(memory_order_acquire);
+			return capacity() - (tail - p.other);
+		}
+
+		/**
+		 * @brief Returns the number of elements after head, reloading the
+		 * producer's index only if the cached one leaves less than n.
+		 */
+		size_t	readable(size_t head, size_t n) throw()
+		{
+			_side&	c = impl.consumer;
+
+			if (c.other - head < n)
+				c.other = load_tail(memory_order_acquire);
+			return c.other - head;
+		}
+	};
+
+	/**
+	 * @brief A bounded lock-free queue for any number of producer and
+	 * consumer threads, after Dmitry Vyukov's design.
+	 *
+	 * Each slot carries a sequence number that tells which lap of the ring
+	 * it is ready for, so that producers and consumers only contend on the
+	 * index they advance with a compare-and-swap, and never on the slots.
+	 * The blocking operations spin for a while before they sleep on a
+	 * futex, and the other side only makes a system call when somebody
+	 * sleeps.
+	 *
+	 * The copy constructor of T must not throw, since a claimed slot cannot
+	 * be given back.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename A = allocator<T> >
+	class	mpmc_queue
+	{
+	private:
+		struct	_cell
+		{
+			atomic<size_t>	seq;
+			T				value;
+		};
+
+		typedef	typename _alloc_traits<A>::template rebind<T>::other
+			T_alloc_type;
+		typedef	_alloc_traits<T_alloc_type>		T_alloc_traits;
+		typedef	typename _alloc_traits<A>::template rebind<_cell>::other
+			cell_alloc_type;
+		typedef	_alloc_traits<cell_alloc_type>	cell_alloc_traits;
+
+	public:
+		typedef	T		value_type;
+		typedef	size_t	size_type;
+		typedef	A		allocator_type;
+
+		/// Number of failed attempts before a blocking operation sleeps.
+		enum { spin_limit = 256 };
+
+	private:
+		/// An index advanced by one side, on a cache line of its own.
+		struct	_side
+		{
+			atomic<size_t>	index;
+			char			pad[cache_line_size - sizeof(size_t)];
+
+			_side() throw()	:	index(0) { }
+		};
+
+		/// Wakes up one side, on a cache line of its own.
+		struct	_waiters
+		{
+			event_count		event;
+			char			pad[cache_line_size - sizeof(event_count)];
+		};
+
+		struct	_mpmc_queue_impl	:	public cell_alloc_type
+		{
+			_cell*		cells;
+			size_t		mask;
+			char		pad[cache_line_size];
+			_side		producer;
+			_side		consumer;
+			_waiters	not_empty;
+			_waiters	not_full;
+
+			_mpmc_queue_impl(cell_alloc_type const& a)
+				:	cell_alloc_type(a), cells(), mask(0) { }
+		};
+
+		_mpmc_queue_impl	impl;
+
+		mpmc_queue(mpmc_queue const&);
+		mpmc_queue&	operator=(mpmc_queue const&);
+
+	public:
+		/**
+		 * @brief Construct an empty queue that holds at least n elements.
+		 *
+		 * @param n	The minimal capacity, rounded up to a power of two of at
+		 * least 2.
+		 */
+		explicit mpmc_queue(size_type n,
+			allocator_type const& a = allocator_type())
+			:	impl(cell_alloc_type(a))
+		{
+			size_t const	capacity = detail::_ceil_pow2(n < 2 ? 2 : n);
+
+			if (capacity < n
+				|| capacity > cell_alloc_traits::max_size(impl))
+				throw LengthErrorException();
+			impl.cells = cell_alloc_traits::allocate(impl, capacity);
+			impl.mask = capacity - 1;
+			for (size_t i = 0; i < capacity; ++i)
+				::new(static_cast<void*>(&impl.cells[i].seq)) atomic<size_t>(i);
+		}
+
+		~mpmc_queue() throw()
+		{
+			T_alloc_type	alloc(impl);
+			size_t const	tail = load_tail(memory_order_acquire);
+
+			for (size_t i = load_head(memory_order_relaxed); i != tail; ++i)
+				T_alloc_traits::destroy(alloc, &cell(i).value);
+			cell_alloc_traits::deallocate(impl, impl.cells, capacity());
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		size_type	capacity() const throw()
+		{ return impl.mask + 1; }
+
+		/**
+		 * @brief Returns the number of elements in the queue, which is only
+		 * a snapshot while other threads are running.
+		 */
+		size_type	size() const throw()
+		{
+			size_t const	head = load_head(memory_order_acquire);
+			size_t const	tail = load_tail(memory_order_acquire);
+
+			return tail - head <= capacity() ? tail - head : 0;
+		}
+
+		bool		empty() const throw()
+		{ return size() == 0; }
+
+		/**
+		 * @brief Add data at the end of the queue, unless it is full.
+		 *
+		 * @param x The data to be added.
+		 * @return bool	false if the queue is full.
+		 */
+		bool	try_push(value_type const& x)
+		{
+			size_t	pos;
+			_cell*	c = claim(impl.producer, 0, pos);
+
+			if (!c)
+				return false;
+
+			T_alloc_type	alloc(impl);
+
+			T_alloc_traits::construct(alloc, &c->value, x);
+			c->seq.store(pos + 1, memory_order_release);
+			impl.not_empty.event.notify_one();
+			return true;
+		}
+
+		/**
+		 * @brief Copy the oldest element into x and remove it, unless the
+		 * queue is empty.
+		 *
+		 * @return bool	false if the queue is empty.
+		 */
+		bool	try_pop(value_type& x)
+		{
+			size_t	pos;
+			_cell*	c = claim(impl.consumer, 1, pos);
+
+			if (!c)
+				return false;
+
+			T_alloc_type	alloc(impl);
+
+			try
+			{
+				x = c->value;
+			}
+			catch (...)
+			{
+				release(c, pos, alloc);
+				throw;
+			}
+			release(c, pos, alloc);
+			return true;
+		}
+
+		/**
+		 * @brief Add data at the end of the queue, waiting for room if it
+		 * is full.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	push(value_type const& x)
+		{
+			for (unsigned spins = 0; !try_push(x); ++spins)
+			{
+				if (spins < spin_limit)
+				{
+					cpu_relax();
+					continue;
+				}
+
+				event_count&	e = impl.not_full.event;
+				int const		key = e.prepare_wait();
+
+				if (try_push(x))
+				{
+					e.cancel_wait();
+					return;
+				}
+				e.wait(key);
+			}
+		}
+
+		/**
+		 * @brief Copy the oldest element into x and remove it, waiting for
+		 * one if the queue is empty.
+		 */
+		void	pop(value_type& x)
+		{
+			for (unsigned spins = 0; !try_pop(x); ++spins)
+			{
+				if (spins < spin_limit)
+				{
+					cpu_relax();
+					continue;
+				}
+
+				event_count&	e = impl.not_empty.event;
+				int const		key = e.prepare_wait();
+
+				if (try_pop(x))
+				{
+					e.cancel_wait();
+					return;
+				}
+				e.wait(key);
+			}
+		}
+
+	private:
+		size_t	load_head(memory_order order) const throw()
+		{ return impl.consumer.index.load(order); }
+
+		size_t	load_tail(memory_order order) const throw()
+		{ return impl.producer.index.load(order); }
+
+		_cell&	cell(size_t pos) const throw()
+		{ return impl.cells[pos & impl.mask]; }
+
+		/**
+		 * @brief Claim the next slot of a side, that is ready when its
+		 * sequence number is its position plus lag.
+		 *
+		 * @return _cell*	The claimed cell, whose position is stored in
+		 * pos, or a null pointer if the queue is full or empty.
+		 */
+		_cell*	claim(_side& side, size_t lag, size_t& pos) throw()
+		{
+			pos = side.index.load(memory_order_relaxed);
+			for (;;)
+			{
+				_cell&			c = cell(pos);
+				size_t const	seq = c.seq.load(memory_order_acquire);
+				ptrdiff_t const	diff = ptrdiff_t(seq - (pos + lag));
+
+				if (diff == 0)
+				{
+					if (side.index.compare_exchange_weak(pos, pos + 1,
+						memory_order_relaxed, memory_order_relaxed))
+						return &c;
+				}
+				else if (diff < 0)
+					return 0;
+				else
+					pos = side.index.load(memory_order_relaxed);
+			}
+		}
+
+		/// Free a popped cell for the producers of the next lap.
+		void	release(_cell* c, size_t pos, T_alloc_type& alloc) throw()
+		{
+			T_alloc_traits::destroy(alloc, &c->value);
+			c->seq.store(pos + capacity(), memory_order_release);
+			impl.not_full.event.notify_one();
+		}
+	};
+}
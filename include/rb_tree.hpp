@@ -0,0 +1,2127 @@
+#pragma once
+
+#include <cstddef>
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	namespace detail
+	{
+		/**
+		 * @brief The links of a red-black tree node, in three words: the
+		 * colour is kept in the low bit of the parent pointer, which nodes'
+		 * alignment leaves clear.
+		 *
+		 * The tree's header is a red node whose parent is the root and whose
+		 * children are the leftmost and rightmost nodes. The root's parent is
+		 * the header, which is how decrementing end() finds the last node.
+		 */
+		struct	_rb_tree_node_base
+		{
+			enum	colour { red = 0, black = 1 };
+
+			/// Parent pointer, with the colour in its low bit.
+			size_t					parent_colour;
+			_rb_tree_node_base*		left;
+			_rb_tree_node_base*		right;
+
+			_rb_tree_node_base*	parent() const throw()
+			{
+				return reinterpret_cast<_rb_tree_node_base*>(
+					parent_colour & ~size_t(1));
+			}
+
+			void	set_parent(_rb_tree_node_base* p) throw()
+			{
+				parent_colour = reinterpret_cast<size_t>(p)
+					| (parent_colour & 1);
+			}
+
+			colour	get_colour() const throw()
+			{ return colour(parent_colour & 1); }
+
+			void	set_colour(colour c) throw()
+			{ parent_colour = (parent_colour & ~size_t(1)) | c; }
+
+			bool	is_red() const throw()
+			{ return (parent_colour & 1) == red; }
+
+			static _rb_tree_node_base*	minimum(_rb_tree_node_base* x) throw()
+			{
+				while (x->left)
+					x = x->left;
+				return x;
+			}
+
+			static _rb_tree_node_base*	maximum(_rb_tree_node_base* x) throw()
+			{
+				while (x->right)
+					x = x->right;
+				return x;
+			}
+
+			_rb_tree_node_base*	increment() throw();
+			_rb_tree_node_base*	decrement() throw();
+		};
+
+		typedef	_rb_tree_node_base	_rb_node;
+
+		/// The links of a node that also counts the nodes of its subtree.
+		struct	_rb_size_node	:	public _rb_tree_node_base
+		{
+			size_t	size;
+		};
+
+		/// Returns true if x is a red node, null nodes being black.
+		inline bool	_rb_red(_rb_node const* x) throw()
+		{ return x && x->is_red(); }
+
+		/**
+		 * @brief Returns the in-order successor of this node, the header
+		 * following the last node.
+		 */
+		inline _rb_node*	_rb_tree_node_base::increment() throw()
+		{
+			_rb_node*	x = this;
+
+			if (x->right)
+				return minimum(x->right);
+
+			_rb_node*	y = x->parent();
+
+			while (x == y->right)
+			{
+				x = y;
+				y = y->parent();
+			}
+			// Only false when x is the root and has no right child, in which
+			// case y is the header and x already its successor.
+			return x->right != y ? y : x;
+		}
+
+		/**
+		 * @brief Returns the in-order predecessor of this node, the last
+		 * node preceding the header.
+		 */
+		inline _rb_node*	_rb_tree_node_base::decrement() throw()
+		{
+			_rb_node*	x = this;
+
+			if (x->is_red() && x->parent()->parent() == x)
+				return x->right;
+			if (x->left)
+				return maximum(x->left);
+
+			_rb_node*	y = x->parent();
+
+			while (x == y->left)
+			{
+				x = y;
+				y = y->parent();
+			}
+			return y;
+		}
+
+		/// Replace x by y as the child of p, or as the root.
+		inline void	_rb_replace_child(_rb_node* x, _rb_node* y, _rb_node* p,
+			_rb_node& header) throw()
+		{
+			if (p == &header)
+				header.set_parent(y);
+			else if (p->left == x)
+				p->left = y;
+			else
+				p->right = y;
+		}
+
+		template<typename Augment>
+		inline void	_rb_rotate_left(_rb_node* x, _rb_node& header) throw()
+		{
+			_rb_node* const	y = x->right;
+
+			x->right = y->left;
+			if (y->left)
+				y->left->set_parent(x);
+			y->set_parent(x->parent());
+			_rb_replace_child(x, y, x->parent(), header);
+			y->left = x;
+			x->set_parent(y);
+			Augment::update(x);
+			Augment::update(y);
+		}
+
+		template<typename Augment>
+		inline void	_rb_rotate_right(_rb_node* x, _rb_node& header) throw()
+		{
+			_rb_node* const	y = x->left;
+
+			x->left = y->right;
+			if (y->right)
+				y->right->set_parent(x);
+			y->set_parent(x->parent());
+			_rb_replace_child(x, y, x->parent(), header);
+			y->right = x;
+			x->set_parent(y);
+			Augment::update(x);
+			Augment::update(y);
+		}
+
+		/**
+		 * @brief Restore the red-black properties after linking the red
+		 * node x, by recolouring and at most two rotations. The root may be
+		 * left red.
+		 */
+		template<typename Augment>
+		inline void	_rb_rebalance_after_insert(_rb_node* x, _rb_node& header)
+			throw()
+		{
+			while (x != header.parent() && x->parent()->is_red())
+			{
+				_rb_node*		xp = x->parent();
+				_rb_node* const	xpp = xp->parent();
+
+				if (xp == xpp->left)
+				{
+					_rb_node* const	uncle = xpp->right;
+
+					if (_rb_red(uncle))
+					{
+						xp->set_colour(_rb_node::black);
+						uncle->set_colour(_rb_node::black);
+						xpp->set_colour(_rb_node::red);
+						x = xpp;
+						continue;
+					}
+					if (x == xp->right)
+					{
+						_rb_rotate_left<Augment>(xp, header);
+						x = xp;
+						xp = x->parent();
+					}
+					xp->set_colour(_rb_node::black);
+					xpp->set_colour(_rb_node::red);
+					_rb_rotate_right<Augment>(xpp, header);
+				}
+				else
+				{
+					_rb_node* const	uncle = xpp->left;
+
+					if (_rb_red(uncle))
+					{
+						xp->set_colour(_rb_node::black);
+						uncle->set_colour(_rb_node::black);
+						xpp->set_colour(_rb_node::red);
+						x = xpp;
+						continue;
+					}
+					if (x == xp->left)
+					{
+						_rb_rotate_right<Augment>(xp, header);
+						x = xp;
+						xp = x->parent();
+					}
+					xp->set_colour(_rb_node::black);
+					xpp->set_colour(_rb_node::red);
+					_rb_rotate_left<Augment>(xpp, header);
+				}
+			}
+		}
+
+		/**
+		 * @brief Link x as a child of p, and restore the red-black
+		 * properties by recolouring and at most two rotations.
+		 *
+		 * @param insert_left	true if x goes left of p. Always true for
+		 * the first node, whose parent is the header.
+		 */
+		template<typename Augment>
+		inline void	_rb_insert_and_rebalance(bool insert_left, _rb_node* x,
+			_rb_node* p, _rb_node& header) throw()
+		{
+			x->parent_colour = reinterpret_cast<size_t>(p);
+			x->left = 0;
+			x->right = 0;
+			if (insert_left)
+			{
+				p->left = x;
+				if (p == &header)
+				{
+					header.set_parent(x);
+					header.right = x;
+				}
+				else if (p == header.left)
+					header.left = x;
+			}
+			else
+			{
+				p->right = x;
+				if (p == header.right)
+					header.right = x;
+			}
+			Augment::update_to_root(x, header);
+			_rb_rebalance_after_insert<Augment>(x, header);
+			header.parent()->set_colour(_rb_node::black);
+		}
+
+		/**
+		 * @brief Unlink z from the tree, and restore the red-black
+		 * properties by recolouring and at most three rotations.
+		 *
+		 * A node with two children is replaced by its successor, which is
+		 * relinked rather than copied, so that iterators to it stay valid.
+		 *
+		 * @return _rb_node*	z, which can then be destroyed.
+		 */
+		template<typename Augment>
+		inline _rb_node*	_rb_rebalance_for_erase(_rb_node* const z,
+			_rb_node& header) throw()
+		{
+			_rb_node*	y = z;
+			_rb_node*	x;
+			_rb_node*	xp;
+
+			if (!y->left)
+				x = y->right;
+			else if (!y->right)
+				x = y->left;
+			else
+			{
+				y = _rb_node::minimum(y->right);
+				x = y->right;
+			}
+
+			_rb_node::colour	removed;
+
+			if (y != z)
+			{
+				// Relink y in place of z.
+				z->left->set_parent(y);
+				y->left = z->left;
+				if (y != z->right)
+				{
+					xp = y->parent();
+					if (x)
+						x->set_parent(xp);
+					xp->left = x;
+					y->right = z->right;
+					z->right->set_parent(y);
+				}
+				else
+					xp = y;
+				_rb_replace_child(z, y, z->parent(), header);
+				removed = y->get_colour();
+				y->parent_colour = z->parent_colour;
+			}
+			else
+			{
+				xp = z->parent();
+				if (x)
+					x->set_parent(xp);
+				_rb_replace_child(z, x, xp, header);
+				if (header.left == z)
+					header.left = z->right ? _rb_node::minimum(x) : xp;
+				if (header.right == z)
+					header.right = z->left ? _rb_node::maximum(x) : xp;
+				removed = z->get_colour();
+			}
+			Augment::update_to_root(xp, header);
+			if (removed == _rb_node::red)
+				return z;
+
+			// x carries an extra black, that is pushed up or resolved.
+			while (x != header.parent() && !_rb_red(x))
+			{
+				if (x == xp->left)
+				{
+					_rb_node*	w = xp->right;
+
+					if (w->is_red())
+					{
+						w->set_colour(_rb_node::black);
+						xp->set_colour(_rb_node::red);
+						_rb_rotate_left<Augment>(xp, header);
+						w = xp->right;
+					}
+					if (!_rb_red(w->left) && !_rb_red(w->right))
+					{
+						w->set_colour(_rb_node::red);
+						x = xp;
+						xp = xp->parent();
+						continue;
+					}
+					if (!_rb_red(w->right))
+					{
+						w->left->set_colour(_rb_node::black);
+						w->set_colour(_rb_node::red);
+						_rb_rotate_right<Augment>(w, header);
+						w = xp->right;
+					}
+					w->set_colour(xp->get_colour());
+					xp->set_colour(_rb_node::black);
+					w->right->set_colour(_rb_node::black);
+					_rb_rotate_left<Augment>(xp, header);
+				}
+				else
+				{
+					_rb_node*	w = xp->left;
+
+					if (w->is_red())
+					{
+						w->set_colour(_rb_node::black);
+						xp->set_colour(_rb_node::red);
+						_rb_rotate_right<Augment>(xp, header);
+						w = xp->left;
+					}
+					if (!_rb_red(w->left) && !_rb_red(w->right))
+					{
+						w->set_colour(_rb_node::red);
+						x = xp;
+						xp = xp->parent();
+						continue;
+					}
+					if (!_rb_red(w->left))
+					{
+						w->right->set_colour(_rb_node::black);
+						w->set_colour(_rb_node::red);
+						_rb_rotate_left<Augment>(w, header);
+						w = xp->left;
+					}
+					w->set_colour(xp->get_colour());
+					xp->set_colour(_rb_node::black);
+					w->left->set_colour(_rb_node::black);
+					_rb_rotate_right<Augment>(xp, header);
+				}
+				break;
+			}
+			if (x)
+				x->set_colour(_rb_node::black);
+			return z;
+		}
+
+		/**
+		 * @brief Point the root back at its header after the header moved,
+		 * or make an empty header link to itself.
+		 */
+		inline void	_rb_relink_header(_rb_node& header) throw()
+		{
+			if (header.parent())
+				header.parent()->set_parent(&header);
+			else
+				header.left = header.right = &header;
+		}
+
+		/**
+		 * @brief Exchange the trees of two headers.
+		 */
+		inline void	_rb_swap_headers(_rb_node& x, _rb_node& y) throw()
+		{
+			ft::swap(x.parent_colour, y.parent_colour);
+			ft::swap(x.left, y.left);
+			ft::swap(x.right, y.right);
+			_rb_relink_header(x);
+			_rb_relink_header(y);
+		}
+
+		/**
+		 * @brief Build a perfectly balanced tree of the n first nodes of a
+		 * list linked through their right pointers, without rotations, and
+		 * advance list past them.
+		 *
+		 * Subtrees split their nodes evenly, so that leaves are at most one
+		 * level apart: making the nodes at red_depth, the deepest level when
+		 * it is not full, red and all others black gives every path the
+		 * same number of black nodes.
+		 *
+		 * @return _rb_node*	The root of the tree, whose parent is unset.
+		 */
+		template<typename Augment>
+		inline _rb_node*	_rb_build_balanced(_rb_node*& list, size_t n,
+			size_t depth, size_t red_depth) throw()
+		{
+			if (n == 0)
+				return 0;
+
+			size_t const	half = (n - 1) / 2;
+			_rb_node* const	left = _rb_build_balanced<Augment>(list, half,
+				depth + 1, red_depth);
+			_rb_node* const	x = list;
+
+			list = x->right;
+			x->parent_colour = depth == red_depth
+				? _rb_node::red : _rb_node::black;
+			x->left = left;
+			if (left)
+				left->set_parent(x);
+			x->right = _rb_build_balanced<Augment>(list, n - 1 - half,
+				depth + 1, red_depth);
+			if (x->right)
+				x->right->set_parent(x);
+			Augment::update(x);
+			return x;
+		}
+
+		/**
+		 * @brief Returns the number of black nodes on every path from x
+		 * down to a leaf.
+		 */
+		inline size_t	_rb_black_height(_rb_node const* x) throw()
+		{
+			size_t	h = 0;
+
+			for (; x; x = x->left)
+				h += !x->is_red();
+			return h;
+		}
+
+		/**
+		 * @brief Make the detached subtree of x, whose black height is h,
+		 * black-rooted, and return its new black height.
+		 */
+		inline size_t	_rb_make_root(_rb_node* x, size_t h) throw()
+		{
+			if (!_rb_red(x))
+				return h;
+			x->set_colour(_rb_node::black);
+			return h + 1;
+		}
+
+		/**
+		 * @brief Join two black-rooted trees l and r, of black heights lh
+		 * and rh, with the node x ordered between them.
+		 *
+		 * x replaces the first black node of black height min(lh, rh) on
+		 * the right spine of l, or the left spine of r, taking it as a
+		 * child, and is then rebalanced like an inserted node. This costs
+		 * O(|lh - rh| + 1).
+		 *
+		 * @param h	Set to the black height of the result.
+		 * @return _rb_node*	The black root of the result, whose parent is
+		 * unset.
+		 */
+		template<typename Augment>
+		inline _rb_node*	_rb_join(_rb_node* l, size_t lh, _rb_node* x,
+			_rb_node* r, size_t rh, size_t& h) throw()
+		{
+			if (lh == rh)
+			{
+				x->parent_colour = _rb_node::black;
+				x->left = l;
+				x->right = r;
+				if (l)
+					l->set_parent(x);
+				if (r)
+					r->set_parent(x);
+				Augment::update(x);
+				h = lh + 1;
+				return x;
+			}
+
+			// The taller tree hangs from a header of its own while x is
+			// rebalanced, as rotations may replace its root.
+			bool const		down_right = lh > rh;
+			size_t const	low = down_right ? rh : lh;
+			_rb_node		header;
+			_rb_node*		root = down_right ? l : r;
+			_rb_node*		p = 0;
+			_rb_node*		y = root;
+
+			h = down_right ? lh : rh;
+			for (size_t yh = h; yh > low || _rb_red(y); yh -= !p->is_red())
+			{
+				p = y;
+				y = down_right ? y->right : y->left;
+			}
+			x->parent_colour = reinterpret_cast<size_t>(p);
+			x->left = down_right ? y : l;
+			x->right = down_right ? r : y;
+			if (x->left)
+				x->left->set_parent(x);
+			if (x->right)
+				x->right->set_parent(x);
+			(down_right ? p->right : p->left) = x;
+			header.parent_colour = reinterpret_cast<size_t>(root);
+			header.left = 0;
+			header.right = 0;
+			root->set_parent(&header);
+			Augment::update_to_root(x, header);
+			_rb_rebalance_after_insert<Augment>(x, header);
+			root = header.parent();
+			h += _rb_make_root(root, 0);
+			return root;
+		}
+
+		/**
+		 * @brief Split the tree of header, relinking its nodes, into the
+		 * tree of the nodes before pos and that of pos and the nodes after
+		 * it, and leave header stale.
+		 *
+		 * The subtrees hanging off the path from pos up to the root are
+		 * joined bottom up, onto the left tree if they precede pos and onto
+		 * the right one otherwise. Each join costs the difference of black
+		 * heights of its operands, which adds up to O(log n).
+		 *
+		 * @param l	Set to the black root of the left tree, whose parent is
+		 * unset.
+		 * @param r	Set to the black root of the right tree, whose parent
+		 * is unset.
+		 */
+		template<typename Augment>
+		inline void	_rb_split(_rb_node* pos, _rb_node& header, _rb_node*& l,
+			_rb_node*& r) throw()
+		{
+			size_t			h = _rb_black_height(pos);
+			size_t const	ch = h - !pos->is_red();
+			size_t			lh = _rb_make_root(pos->left, ch);
+			size_t			rh = _rb_make_root(pos->right, ch);
+			_rb_node*		y = pos;
+			_rb_node*		p = pos->parent();
+
+			l = pos->left;
+			r = _rb_join<Augment>(0, 0, pos, pos->right, rh, rh);
+			while (p != &header)
+			{
+				// Read p before the join relinks it.
+				_rb_node* const	up = p->parent();
+				size_t const	sh = h;
+
+				h += !p->is_red();
+				if (y == p->left)
+				{
+					_rb_node* const	s = p->right;
+
+					r = _rb_join<Augment>(r, rh, p, s, _rb_make_root(s, sh),
+						rh);
+				}
+				else
+				{
+					_rb_node* const	s = p->left;
+
+					l = _rb_join<Augment>(s, _rb_make_root(s, sh), p, l, lh,
+						lh);
+				}
+				y = p;
+				p = up;
+			}
+		}
+
+		/**
+		 * @brief Unlink the n nodes of the tree of header into a list linked
+		 * in order through their right pointers, and leave header stale.
+		 *
+		 * The nodes are taken from the last one back, as walking backwards
+		 * only reads the right pointers of nodes not yet taken.
+		 *
+		 * @return _rb_node*	The first node of the list.
+		 */
+		inline _rb_node*	_rb_flatten(_rb_node& header, size_t n) throw()
+		{
+			_rb_node*	list = 0;
+			_rb_node*	x = header.right;
+
+			for (; n > 0; --n)
+			{
+				_rb_node* const	previous = n > 1 ? x->decrement() : 0;
+
+				x->right = list;
+				list = x;
+				x = previous;
+			}
+			return list;
+		}
+
+		/**
+		 * @brief Put the detached node y in the place of x in the tree of
+		 * header, detaching x.
+		 */
+		template<typename Augment>
+		inline void	_rb_replace_node(_rb_node* x, _rb_node* y,
+			_rb_node& header) throw()
+		{
+			y->parent_colour = x->parent_colour;
+			y->left = x->left;
+			y->right = x->right;
+			if (y->left)
+				y->left->set_parent(y);
+			if (y->right)
+				y->right->set_parent(y);
+			_rb_replace_child(x, y, x->parent(), header);
+			if (header.left == x)
+				header.left = y;
+			if (header.right == x)
+				header.right = y;
+			Augment::copy(y, x);
+		}
+	}
+
+	/**
+	 * @brief The default node policy of map, multimap, set and multiset,
+	 * whose nodes keep nothing but their links and values.
+	 *
+	 * A node policy names the base of the tree's nodes, and is told to
+	 * update a node when its subtree changes, so that it can maintain data
+	 * about the subtree in the node.
+	 */
+	struct	rb_no_augment
+	{
+		typedef	detail::_rb_tree_node_base	node_base;
+
+		/// Update x from its children.
+		static void	update(detail::_rb_node*) throw() { }
+
+		/// Update x and its ancestors, bottom up.
+		static void	update_to_root(detail::_rb_node*,
+			detail::_rb_node const&) throw() { }
+
+		/// Copy the data of y to x, which has the same subtree.
+		static void	copy(detail::_rb_node*, detail::_rb_node const*) throw()
+		{ }
+
+		/**
+		 * @brief Returns the in-order index of x in the tree of header,
+		 * which has n nodes, by walking from both ends in O(min(i, n - i)).
+		 */
+		static size_t	index(detail::_rb_node const* x,
+			detail::_rb_node const& header, size_t n) throw()
+		{
+			detail::_rb_node*	first = header.left;
+			detail::_rb_node*	last = const_cast<detail::_rb_node*>(&header);
+
+			for (size_t i = 0; ; ++i)
+			{
+				if (first == x)
+					return i;
+				if (last == x)
+					return n - i;
+				first = first->increment();
+				last = last->decrement();
+			}
+		}
+	};
+
+	/**
+	 * @brief A node policy that counts the nodes of every subtree, for
+	 * O(log n) rank and select on the tree, and distance and advance on
+	 * its iterators. This costs a word per node and a walk to the root on
+	 * every insertion and erasure.
+	 */
+	struct	rb_order_statistics
+	{
+		typedef	detail::_rb_size_node	node_base;
+
+		/// The number of nodes in the subtree of x, which may be null.
+		static size_t	size(detail::_rb_node const* x) throw()
+		{ return x ? static_cast<node_base const*>(x)->size : 0; }
+
+		static void	update(detail::_rb_node* x) throw()
+		{
+			static_cast<node_base*>(x)->size
+				= size(x->left) + size(x->right) + 1;
+		}
+
+		static void	update_to_root(detail::_rb_node* x,
+			detail::_rb_node const& header) throw()
+		{
+			for (; x != &header; x = x->parent())
+				update(x);
+		}
+
+		static void	copy(detail::_rb_node* x, detail::_rb_node const* y)
+			throw()
+		{
+			static_cast<node_base*>(x)->size
+				= static_cast<node_base const*>(y)->size;
+		}
+
+		/**
+		 * @brief Returns the in-order index of x, the size of the tree for
+		 * its header, and sets header to the tree's header.
+		 */
+		static size_t	index(detail::_rb_node const* x,
+			detail::_rb_node const*& header) throw()
+		{
+			if (x->is_red() && (!x->parent() || x->parent()->parent() == x))
+			{
+				header = x;
+				return size(x->parent());
+			}
+
+			size_t	i = size(x->left);
+
+			// Only the header is the parent of its parent.
+			for (detail::_rb_node const* p = x->parent(); p->parent() != x;
+				x = p, p = p->parent())
+				if (x == p->right)
+					i += size(p->left) + 1;
+			header = x->parent();
+			return i;
+		}
+
+		/// Returns the in-order index of x, in O(log n).
+		static size_t	index(detail::_rb_node const* x,
+			detail::_rb_node const&, size_t) throw()
+		{
+			detail::_rb_node const*	header;
+
+			return index(x, header);
+		}
+
+		/**
+		 * @brief Returns the node at in-order index i, or the header if i is
+		 * the size of the tree.
+		 */
+		static detail::_rb_node*	select(detail::_rb_node const& header,
+			size_t i) throw()
+		{
+			detail::_rb_node*	x = header.parent();
+
+			if (i >= size(x))
+				return const_cast<detail::_rb_node*>(&header);
+			for (;;)
+			{
+				size_t const	left = size(x->left);
+
+				if (i == left)
+					return x;
+				if (i < left)
+					x = x->left;
+				else
+				{
+					i -= left + 1;
+					x = x->right;
+				}
+			}
+		}
+	};
+
+	template<typename T, typename Base = detail::_rb_tree_node_base>
+	struct	_rb_tree_node	:	public Base
+	{
+		T	data;
+		T*			valptr() { return &data; }
+		T const*	valptr() const { return &data; }
+	};
+
+	/**
+	 * @brief A _rb_tree::iterator.
+	 *
+	 * @tparam T	The tree's value type.
+	 * @tparam Base	The base of the tree's nodes.
+	 */
+	template<typename T, typename Base = detail::_rb_tree_node_base>
+	struct	_rb_tree_iterator
+	{
+		typedef	_rb_tree_iterator<T, Base>	_self;
+		typedef	_rb_tree_node<T, Base>		_node;
+
+		typedef	ptrdiff_t					difference_type;
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef	T							value_type;
+		typedef	T*							pointer;
+		typedef	T&							reference;
+
+		_rb_tree_iterator() throw()
+			: node() { }
+
+		explicit _rb_tree_iterator(detail::_rb_tree_node_base* x) throw()
+			: node(x) { }
+
+		reference	operator*() const throw()
+		{ return *static_cast<_node*>(node)->valptr(); }
+
+		pointer		operator->() const throw()
+		{ return static_cast<_node*>(node)->valptr(); }
+
+		_self&		operator++() throw()
+		{
+			node = node->increment();
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	previous = *this;
+			node = node->increment();
+			return previous;
+		}
+
+		_self&		operator--() throw()
+		{
+			node = node->decrement();
+			return *this;
+		}
+
+		_self		operator--(int) throw()
+		{
+			_self	previous = *this;
+			node = node->decrement();
+			return previous;
+		}
+
+		friend bool	operator==(_self const& x, _self const& y) throw()
+		{ return x.node == y.node; }
+
+		friend bool	operator!=(_self const& x, _self const& y) throw()
+		{ return x.node != y.node; }
+
+		detail::_rb_tree_node_base*	node;
+	};
+
+	/**
+	 * @brief A _rb_tree::const_iterator.
+	 *
+	 * @tparam T	The tree's value type.
+	 * @tparam Base	The base of the tree's nodes.
+	 */
+	template<typename T, typename Base = detail::_rb_tree_node_base>
+	struct	_rb_tree_const_iterator
+	{
+		typedef	_rb_tree_const_iterator<T, Base>	_self;
+		typedef	const _rb_tree_node<T, Base>		_node;
+		typedef	_rb_tree_iterator<T, Base>			iterator;
+
+		typedef	ptrdiff_t					difference_type;
+		typedef bidirectional_iterator_tag	iterator_category;
+		typedef	T							value_type;
+		typedef	T const*					pointer;
+		typedef	T const&					reference;
+
+		_rb_tree_const_iterator() throw()
+			: node() { }
+
+		explicit _rb_tree_const_iterator(
+			detail::_rb_tree_node_base const* x) throw()
+			: node(x) { }
+
+		_rb_tree_const_iterator(iterator const& x) throw()
+			: node(x.node) { }
+
+		iterator	_const_cast() const throw()
+		{ return iterator(const_cast<detail::_rb_tree_node_base*>(node)); }
+
+		reference	operator*() const throw()
+		{ return *static_cast<_node*>(node)->valptr(); }
+
+		pointer		operator->() const throw()
+		{ return static_cast<_node*>(node)->valptr(); }
+
+		_self&		operator++() throw()
+		{
+			node = _const_cast().node->increment();
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	previous = *this;
+			++*this;
+			return previous;
+		}
+
+		_self&		operator--() throw()
+		{
+			node = _const_cast().node->decrement();
+			return *this;
+		}
+
+		_self		operator--(int) throw()
+		{
+			_self	previous = *this;
+			--*this;
+			return previous;
+		}
+
+		friend bool	operator==(_self const& x, _self const& y) throw()
+		{ return x.node == y.node; }
+
+		friend bool	operator!=(_self const& x, _self const& y) throw()
+		{ return x.node != y.node; }
+
+		detail::_rb_tree_node_base const*	node;
+	};
+
+	/**
+	 * @brief Returns the distance between two iterators of a tree with
+	 * rb_order_statistics, in O(log n).
+	 */
+	template<typename T>
+	inline ptrdiff_t	distance(
+		_rb_tree_const_iterator<T, detail::_rb_size_node> first,
+		_rb_tree_const_iterator<T, detail::_rb_size_node> last) throw()
+	{
+		detail::_rb_node const*	header;
+
+		if (first == last)
+			return 0;
+		return ptrdiff_t(rb_order_statistics::index(last.node, header))
+			- ptrdiff_t(rb_order_statistics::index(first.node, header));
+	}
+
+	template<typename T>
+	inline ptrdiff_t	distance(
+		_rb_tree_iterator<T, detail::_rb_size_node> first,
+		_rb_tree_iterator<T, detail::_rb_size_node> last) throw()
+	{
+		return ft::distance(
+			_rb_tree_const_iterator<T, detail::_rb_size_node>(first),
+			_rb_tree_const_iterator<T, detail::_rb_size_node>(last));
+	}
+
+	/**
+	 * @brief Move an iterator of a tree with rb_order_statistics by n
+	 * elements, in O(log n).
+	 */
+	template<typename T, typename Distance>
+	inline void	advance(_rb_tree_const_iterator<T, detail::_rb_size_node>& it,
+		Distance n) throw()
+	{
+		detail::_rb_node const*	header;
+
+		if (n == 0)
+			return;
+
+		ptrdiff_t const	i = rb_order_statistics::index(it.node, header);
+
+		it.node = rb_order_statistics::select(*header, size_t(i + n));
+	}
+
+	template<typename T, typename Distance>
+	inline void	advance(_rb_tree_iterator<T, detail::_rb_size_node>& it,
+		Distance n) throw()
+	{
+		_rb_tree_const_iterator<T, detail::_rb_size_node>	i(it);
+
+		ft::advance(i, n);
+		it = i._const_cast();
+	}
+
+	/**
+	 * @brief A red-black tree of values ordered by their keys, shared by
+	 * map, multimap, set and multiset.
+	 *
+	 * Nodes are a three-word header followed by the value, and come from
+	 * the allocator rebound to nodes.
+	 *
+	 * @tparam K			The key type.
+	 * @tparam V			The value type.
+	 * @tparam KeyOfValue	Extracts the key of a value.
+	 * @tparam Compare		The key ordering.
+	 * @tparam A			The allocator type.
+	 * @tparam Augment		The node policy, rb_no_augment or
+	 * rb_order_statistics.
+	 */
+	template<typename K, typename V, typename KeyOfValue, typename Compare,
+		typename A, typename Augment = rb_no_augment>
+	class	_rb_tree
+	{
+	private:
+		typedef	detail::_rb_tree_node_base	base_type;
+		typedef	_rb_tree_node<V, typename Augment::node_base>
+			node_type;
+		typedef	typename _alloc_traits<A>::template rebind<V>::other
+			V_alloc_type;
+		typedef	typename _alloc_traits<A>::template rebind<node_type>::other
+			node_alloc_type;
+		typedef	_alloc_traits<node_alloc_type>	node_alloc_traits;
+
+		struct	_rb_tree_impl	:	public node_alloc_type
+		{
+			Compare		comp;
+			base_type	header;
+			size_t		node_count;
+
+			_rb_tree_impl(Compare const& c, node_alloc_type const& a)
+				:	node_alloc_type(a), comp(c), node_count(0)
+			{ reset(); }
+
+			void	reset() throw()
+			{
+				header.parent_colour = base_type::red;
+				header.left = &header;
+				header.right = &header;
+				node_count = 0;
+			}
+		};
+
+		_rb_tree_impl	impl;
+
+	public:
+		typedef	K										key_type;
+		typedef	V										value_type;
+		typedef	size_t									size_type;
+		typedef	ptrdiff_t								difference_type;
+		typedef	A										allocator_type;
+		typedef	_rb_tree_iterator<V, typename Augment::node_base>
+			iterator;
+		typedef	_rb_tree_const_iterator<V, typename Augment::node_base>
+			const_iterator;
+		typedef	ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef	ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		_rb_tree(Compare const& cmp, allocator_type const& a)
+			:	impl(cmp, node_alloc_type(a)) { }
+
+		_rb_tree(_rb_tree const& x)
+			:	impl(x.impl.comp, node_alloc_traits::select_on_copy(x.impl))
+		{
+			if (x.root())
+				copy_root(x);
+		}
+
+		~_rb_tree() throw()
+		{ erase_subtree(root()); }
+
+		_rb_tree&	operator=(_rb_tree const& x)
+		{
+			if (this != &x)
+			{
+				clear();
+				impl.comp = x.impl.comp;
+				if (x.root())
+					copy_root(x);
+			}
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		Compare			key_comp() const
+		{ return impl.comp; }
+
+		iterator				begin() throw()
+		{ return iterator(impl.header.left); }
+
+		const_iterator			begin() const throw()
+		{ return const_iterator(impl.header.left); }
+
+		iterator				end() throw()
+		{ return iterator(&impl.header); }
+
+		const_iterator			end() const throw()
+		{ return const_iterator(&impl.header); }
+
+		reverse_iterator		rbegin() throw()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
+		bool		empty() const throw()
+		{ return impl.node_count == 0; }
+
+		size_type	size() const throw()
+		{ return impl.node_count; }
+
+		size_type	max_size() const throw()
+		{ return node_alloc_traits::max_size(impl); }
+
+		/**
+		 * @brief Insert v unless an element with an equivalent key exists.
+		 *
+		 * The rightmost node serves as a cached insertion position: a key
+		 * greater than all others is appended without a search, which
+		 * makes inserting increasing keys amortized O(1) each.
+		 *
+		 * @return pair<iterator, bool>	The element with v's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert_unique(value_type const& v)
+		{
+			K const&	k = KeyOfValue()(v);
+			base_type*	x = root();
+			base_type*	p = &impl.header;
+			bool		go_left = true;
+
+			if (x && impl.comp(key(impl.header.right), k))
+				return pair<iterator, bool>(
+					insert_node(false, impl.header.right, v), true);
+			while (x)
+			{
+				p = x;
+				go_left = impl.comp(k, key(x));
+				x = go_left ? x->left : x->right;
+			}
+
+			iterator	j(p);
+
+			if (go_left)
+			{
+				if (j == begin())
+					return pair<iterator, bool>(insert_node(true, p, v), true);
+				--j;
+			}
+			if (impl.comp(key(j.node), k))
+				return pair<iterator, bool>(insert_node(go_left, p, v), true);
+			return pair<iterator, bool>(j, false);
+		}
+
+		/**
+		 * @brief Insert v after the elements with an equivalent key,
+		 * appending it without a search if no key is greater.
+		 */
+		iterator	insert_equal(value_type const& v)
+		{
+			K const&	k = KeyOfValue()(v);
+			base_type*	x = root();
+			base_type*	p = &impl.header;
+			bool		go_left = true;
+
+			if (x && !impl.comp(k, key(impl.header.right)))
+				return insert_node(false, impl.header.right, v);
+			while (x)
+			{
+				p = x;
+				go_left = impl.comp(k, key(x));
+				x = go_left ? x->left : x->right;
+			}
+			return insert_node(go_left, p, v);
+		}
+
+		/**
+		 * @brief Insert v unless an element with an equivalent key exists,
+		 * in amortized O(1) if v belongs right before or after hint, and
+		 * with a full search otherwise.
+		 *
+		 * @return iterator	The element with v's key.
+		 */
+		iterator	insert_unique(const_iterator hint, value_type const& v)
+		{
+			K const&			k = KeyOfValue()(v);
+			base_type* const	pos = const_cast<base_type*>(hint.node);
+
+			if (pos == &impl.header)
+				return insert_unique(v).first;
+			if (impl.comp(k, key(pos)))
+			{
+				if (pos == impl.header.left)
+					return insert_node(true, pos, v);
+
+				base_type* const	before = pos->decrement();
+
+				if (impl.comp(key(before), k))
+					return before->right ? insert_node(true, pos, v)
+						: insert_node(false, before, v);
+			}
+			else if (impl.comp(key(pos), k))
+			{
+				if (pos == impl.header.right)
+					return insert_node(false, pos, v);
+
+				base_type* const	after = pos->increment();
+
+				if (impl.comp(k, key(after)))
+					return pos->right ? insert_node(true, after, v)
+						: insert_node(false, pos, v);
+			}
+			else
+				return iterator(pos);
+			return insert_unique(v).first;
+		}
+
+		/**
+		 * @brief Insert v right before hint if that keeps the order, or
+		 * right after it, in amortized O(1), and after the elements with an
+		 * equivalent key otherwise.
+		 */
+		iterator	insert_equal(const_iterator hint, value_type const& v)
+		{
+			K const&			k = KeyOfValue()(v);
+			base_type* const	pos = const_cast<base_type*>(hint.node);
+
+			if (pos == &impl.header)
+				return insert_equal(v);
+			if (!impl.comp(key(pos), k))
+			{
+				if (pos == impl.header.left)
+					return insert_node(true, pos, v);
+
+				base_type* const	before = pos->decrement();
+
+				if (!impl.comp(k, key(before)))
+					return before->right ? insert_node(true, pos, v)
+						: insert_node(false, before, v);
+			}
+			else
+			{
+				if (pos == impl.header.right)
+					return insert_node(false, pos, v);
+
+				base_type* const	after = pos->increment();
+
+				if (!impl.comp(key(after), k))
+					return pos->right ? insert_node(true, after, v)
+						: insert_node(false, pos, v);
+			}
+			return insert_equal(v);
+		}
+
+		/**
+		 * @brief Insert a range, in O(n) if the tree is empty and the range
+		 * strictly increasing.
+		 */
+		template<typename I>
+		void	insert_unique(I first, I last)
+		{
+			if (empty())
+				first = build_sorted(first, last, true);
+			for (; first != last; ++first)
+				insert_unique(*first);
+		}
+
+		/**
+		 * @brief Insert a range, in O(n) if the tree is empty and the range
+		 * sorted.
+		 */
+		template<typename I>
+		void	insert_equal(I first, I last)
+		{
+			if (empty())
+				first = build_sorted(first, last, false);
+			for (; first != last; ++first)
+				insert_equal(*first);
+		}
+
+		void		erase(const_iterator pos) throw()
+		{
+			destroy_node(detail::_rb_rebalance_for_erase<Augment>(
+				const_cast<base_type*>(pos.node), impl.header));
+			--impl.node_count;
+		}
+
+		void		erase(const_iterator first, const_iterator last) throw()
+		{
+			if (first == begin() && last == end())
+				clear();
+			else
+				while (first != last)
+					erase(first++);
+		}
+
+		/**
+		 * @brief Erase the elements with a key equivalent to k.
+		 *
+		 * @return size_type	The number of elements erased.
+		 */
+		size_type	erase_key(key_type const& k)
+		{
+			pair<iterator, iterator> const	range = equal_range(k);
+			size_type const					old_size = size();
+
+			erase(range.first, range.second);
+			return old_size - size();
+		}
+
+		void		clear() throw()
+		{
+			erase_subtree(root());
+			impl.reset();
+		}
+
+		void		swap(_rb_tree& x) throw()
+		{
+			detail::_rb_swap_headers(impl.header, x.impl.header);
+			ft::swap(impl.node_count, x.impl.node_count);
+			ft::swap(impl.comp, x.impl.comp);
+			node_alloc_traits::on_swap(impl, x.impl);
+		}
+
+		iterator		find(key_type const& k)
+		{ return iterator(find_node(k)); }
+
+		const_iterator	find(key_type const& k) const
+		{ return const_iterator(find_node(k)); }
+
+		size_type		count(key_type const& k) const
+		{
+			pair<const_iterator, const_iterator> const	range
+				= equal_range(k);
+
+			return size_type(ft::distance(range.first, range.second));
+		}
+
+		/**
+		 * @brief Returns the first element whose key is not less than k.
+		 */
+		iterator		lower_bound(key_type const& k)
+		{ return iterator(lower_bound_node(k)); }
+
+		const_iterator	lower_bound(key_type const& k) const
+		{ return const_iterator(lower_bound_node(k)); }
+
+		/**
+		 * @brief Returns the first element whose key is greater than k.
+		 */
+		iterator		upper_bound(key_type const& k)
+		{ return iterator(upper_bound_node(k)); }
+
+		const_iterator	upper_bound(key_type const& k) const
+		{ return const_iterator(upper_bound_node(k)); }
+
+		pair<iterator, iterator>	equal_range(key_type const& k)
+		{
+			pair<base_type*, base_type*> const	r = equal_range_nodes(k);
+
+			return pair<iterator, iterator>(iterator(r.first),
+				iterator(r.second));
+		}
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{
+			pair<base_type*, base_type*> const	r = equal_range_nodes(k);
+
+			return pair<const_iterator, const_iterator>(
+				const_iterator(r.first), const_iterator(r.second));
+		}
+
+		/**
+		 * @brief Returns the number of elements whose key is less than k,
+		 * in O(log n). Requires rb_order_statistics.
+		 */
+		size_type		rank(key_type const& k) const
+		{
+			base_type const*	x = root();
+			size_type			r = 0;
+
+			while (x)
+			{
+				if (impl.comp(key(x), k))
+				{
+					r += Augment::size(x->left) + 1;
+					x = x->right;
+				}
+				else
+					x = x->left;
+			}
+			return r;
+		}
+
+		/**
+		 * @brief Returns the element at index i in order, or end() if
+		 * there are no more than i elements, in O(log n). Requires
+		 * rb_order_statistics.
+		 */
+		iterator		select(size_type i)
+		{ return iterator(Augment::select(impl.header, i)); }
+
+		const_iterator	select(size_type i) const
+		{ return const_iterator(Augment::select(impl.header, i)); }
+
+		/**
+		 * @brief Move the elements before pos to left and the others to
+		 * right, leaving this tree empty, by relinking nodes in O(log n).
+		 *
+		 * left and right are cleared first, and may be this tree. Their
+		 * allocators must compare equal to this tree's. Counting the
+		 * elements of each side is O(log n) with rb_order_statistics, and
+		 * takes a walk over the smaller side otherwise.
+		 */
+		void		split(const_iterator pos, _rb_tree& left, _rb_tree& right)
+		{
+			base_type* const	x = const_cast<base_type*>(pos.node);
+			base_type* const	first = impl.header.left;
+			base_type* const	last = impl.header.right;
+			base_type* const	before = x == first ? 0 : x->decrement();
+			size_type const		n = size();
+			size_type const		i = Augment::index(x, impl.header, n);
+			base_type*			l = root();
+			base_type*			r = 0;
+
+			left.impl.comp = impl.comp;
+			right.impl.comp = impl.comp;
+			if (x != &impl.header)
+				detail::_rb_split<Augment>(x, impl.header, l, r);
+			impl.reset();
+			if (&left != this)
+				left.clear();
+			if (&right != this)
+				right.clear();
+			left.adopt(l, first, before, i);
+			right.adopt(r, x, last, n - i);
+		}
+
+		/**
+		 * @brief Move the elements of left and then those of right to this
+		 * tree, leaving them empty, by relinking nodes in O(log n).
+		 *
+		 * This tree is cleared first, and may be left or right. Their
+		 * allocators must compare equal to this tree's.
+		 *
+		 * @throw InvalidArgumentException if an element of right is ordered
+		 * before one of left, or is equivalent to one and unique is set.
+		 */
+		void		join(_rb_tree& left, _rb_tree& right, bool unique)
+		{
+			if (left.empty() || right.empty())
+			{
+				_rb_tree&	x = left.empty() ? right : left;
+
+				if (&x != this)
+				{
+					clear();
+					swap(x);
+				}
+				return;
+			}
+
+			base_type* const	first = left.impl.header.left;
+			base_type* const	last = right.impl.header.right;
+			base_type* const	middle = right.impl.header.left;
+			size_type const		n = left.size() + right.size();
+			size_t				h;
+
+			if (unique ? !left.impl.comp(key(left.impl.header.right),
+					key(middle))
+				: left.impl.comp(key(middle), key(left.impl.header.right)))
+				throw InvalidArgumentException();
+			impl.comp = left.impl.comp;
+			if (this != &left && this != &right)
+				clear();
+			detail::_rb_rebalance_for_erase<Augment>(middle,
+				right.impl.header);
+
+			base_type* const	l = left.root();
+			base_type* const	r = right.root();
+			base_type* const	top = detail::_rb_join<Augment>(l,
+				detail::_rb_black_height(l), middle, r,
+				detail::_rb_black_height(r), h);
+
+			left.impl.reset();
+			right.impl.reset();
+			adopt(top, first, last, n);
+		}
+
+		/**
+		 * @brief Move the elements of x whose key is not in this tree to
+		 * it, by relinking nodes, leaving the others in x.
+		 *
+		 * Trees of similar sizes are merged in a linear walk and rebuilt
+		 * balanced, in O(n + m). When one is much smaller, its elements are
+		 * found in the other by finger search from the previous one, in
+		 * O(m log(n / m)): into this tree, or this tree's into x, whose
+		 * displaced elements then go to x instead of this tree's.
+		 *
+		 * The allocators must compare equal. If a comparison throws, both
+		 * trees are left valid, with some of x's elements moved.
+		 */
+		void		merge_union(_rb_tree& x)
+		{
+			if (this == &x || x.empty())
+				return;
+			if (finger_pays(x.size(), size()))
+				finger_union(x, false);
+			else if (finger_pays(size(), x.size()))
+			{
+				x.finger_union(*this, true);
+				swap(x);
+			}
+			else
+				linear_union(x);
+		}
+
+		/**
+		 * @brief Erase the elements whose key is not in x, in O(n + m),
+		 * or in O(n log(m / n)) by finger search in x if this tree is much
+		 * smaller.
+		 */
+		void		merge_intersection(_rb_tree const& x)
+		{
+			if (this != &x)
+				filter(x, true, finger_pays(size(), x.size()));
+		}
+
+		/**
+		 * @brief Erase the elements whose key is in x, in O(n + m), or in
+		 * O(m log(n / m)) by finger search if one tree is much smaller.
+		 */
+		void		merge_difference(_rb_tree const& x)
+		{
+			if (this == &x)
+				clear();
+			else if (!finger_pays(x.size(), size()))
+				filter(x, false, finger_pays(size(), x.size()));
+			else
+			{
+				base_type*	f = impl.header.left;
+
+				for (const_iterator i = x.begin(); i != x.end()
+					&& f != &impl.header; ++i)
+				{
+					K const&			k = KeyOfValue()(*i);
+					base_type* const	pos = finger_lower_bound(f, k);
+
+					f = pos;
+					if (pos != &impl.header && !impl.comp(k, key(pos)))
+					{
+						f = pos->increment();
+						erase(const_iterator(pos));
+					}
+				}
+			}
+		}
+
+	private:
+		base_type*	root() const throw()
+		{ return impl.header.parent(); }
+
+		base_type*	header() const throw()
+		{ return const_cast<base_type*>(&impl.header); }
+
+		static K const&	key(base_type const* x)
+		{ return KeyOfValue()(static_cast<node_type const*>(x)->data); }
+
+		node_type*	create_node(value_type const& v)
+		{
+			node_type* const	n = node_alloc_traits::allocate(impl, 1);
+
+			try
+			{
+				V_alloc_type	alloc(impl);
+
+				alloc.construct(n->valptr(), v);
+			}
+			catch (...)
+			{
+				node_alloc_traits::deallocate(impl, n, 1);
+				throw;
+			}
+			return n;
+		}
+
+		void		destroy_node(base_type* x) throw()
+		{
+			node_type* const	n = static_cast<node_type*>(x);
+			V_alloc_type		alloc(impl);
+
+			alloc.destroy(n->valptr());
+			node_alloc_traits::deallocate(impl, n, 1);
+		}
+
+		/**
+		 * @brief Copy a node's value and colour, without its links.
+		 */
+		base_type*	clone_node(base_type const* x)
+		{
+			base_type* const	n = create_node(
+				static_cast<node_type const*>(x)->data);
+
+			n->parent_colour = x->get_colour();
+			n->left = 0;
+			n->right = 0;
+			Augment::copy(n, x);
+			return n;
+		}
+
+		iterator	insert_node(bool left, base_type* p, value_type const& v)
+		{
+			node_type* const	n = create_node(v);
+
+			detail::_rb_insert_and_rebalance<Augment>(left, n, p,
+				impl.header);
+			++impl.node_count;
+			return iterator(n);
+		}
+
+		/**
+		 * @brief Destroy a subtree, recursing only on right children so
+		 * that the depth is bounded by the tree's height.
+		 */
+		void		erase_subtree(base_type* x) throw()
+		{
+			while (x)
+			{
+				erase_subtree(x->right);
+
+				base_type* const	left = x->left;
+
+				destroy_node(x);
+				x = left;
+			}
+		}
+
+		/**
+		 * @brief Copy the subtree of x with the same shape and colours, as a
+		 * child of p.
+		 */
+		base_type*	copy_subtree(base_type const* x, base_type* p)
+		{
+			base_type* const	top = clone_node(x);
+
+			top->set_parent(p);
+			try
+			{
+				if (x->right)
+					top->right = copy_subtree(x->right, top);
+				p = top;
+				x = x->left;
+				while (x)
+				{
+					base_type* const	y = clone_node(x);
+
+					p->left = y;
+					y->set_parent(p);
+					if (x->right)
+						y->right = copy_subtree(x->right, y);
+					p = y;
+					x = x->left;
+				}
+			}
+			catch (...)
+			{
+				erase_subtree(top);
+				throw;
+			}
+			return top;
+		}
+
+		/**
+		 * @brief Build this empty tree from the sorted prefix of a range,
+		 * strictly increasing if unique, in O(n).
+		 *
+		 * Nodes are created in order and chained through their right
+		 * pointers, so that a single pass also works on input iterators,
+		 * and then linked into a balanced tree.
+		 *
+		 * @return I	The first element out of order, or last.
+		 */
+		template<typename I>
+		I			build_sorted(I first, I last, bool unique)
+		{
+			base_type	list;
+			base_type*	tail = &list;
+			size_type	n = 0;
+
+			list.right = 0;
+			try
+			{
+				for (; first != last; ++first)
+				{
+					value_type const&	v = *first;
+
+					if (n != 0 && (unique
+						? !impl.comp(key(tail), KeyOfValue()(v))
+						: impl.comp(KeyOfValue()(v), key(tail))))
+						break;
+					tail->right = create_node(v);
+					tail = tail->right;
+					tail->right = 0;
+					++n;
+				}
+			}
+			catch (...)
+			{
+				while (list.right)
+				{
+					base_type* const	x = list.right;
+
+					list.right = x->right;
+					destroy_node(x);
+				}
+				throw;
+			}
+			if (n == 0)
+				return first;
+
+			base_type*			x = list.right;
+			base_type* const	r = detail::_rb_build_balanced<Augment>(x, n,
+				0, detail::_lg(n + 1));
+
+			adopt(r, list.right, tail, n);
+			return first;
+		}
+
+		/**
+		 * @brief Make the nodes under r, the first and last of which are
+		 * given, the n nodes of this empty tree.
+		 */
+		void		adopt(base_type* r, base_type* first, base_type* last,
+			size_type n) throw()
+		{
+			if (!r)
+				return;
+			r->set_parent(&impl.header);
+			impl.header.set_parent(r);
+			impl.header.left = first;
+			impl.header.right = last;
+			impl.node_count = n;
+		}
+
+		/**
+		 * @brief Make the n first nodes of list, linked in order through
+		 * their right pointers, the nodes of this empty tree, balanced.
+		 */
+		void		adopt_list(base_type* list, size_type n) throw()
+		{
+			if (n == 0)
+				return;
+
+			base_type* const	first = list;
+			base_type* const	r = detail::_rb_build_balanced<Augment>(list,
+				n, 0, detail::_lg(n + 1));
+
+			adopt(r, first, base_type::maximum(r), n);
+		}
+
+		/// Link the detached node y right before pos.
+		void		link_before(base_type* pos, base_type* y) throw()
+		{
+			if (pos == &impl.header ? !root() : !pos->left)
+				detail::_rb_insert_and_rebalance<Augment>(true, y, pos,
+					impl.header);
+			else
+				detail::_rb_insert_and_rebalance<Augment>(false, y,
+					pos->decrement(), impl.header);
+			++impl.node_count;
+		}
+
+		/**
+		 * @brief Returns true if m finger searches among n elements, in
+		 * O(m log(n / m)), cost less than merging them in O(n + m).
+		 */
+		static bool	finger_pays(size_type m, size_type n) throw()
+		{ return m > 0 && m < n && 2 * m * detail::_lg(n / m) < n; }
+
+		/**
+		 * @brief Returns the first node whose key is not less than k, given
+		 * a node x such that all nodes before it are less than k.
+		 *
+		 * Climbs from x to the first ancestor whose subtree bounds k, and
+		 * searches down from there, which costs O(log d) for a node d
+		 * positions away and adds up to O(m log(n / m)) over m increasing
+		 * keys.
+		 */
+		base_type*	finger_lower_bound(base_type* x, key_type const& k) const
+		{
+			base_type*	y = header();
+
+			if (x == y || !impl.comp(key(x), k))
+				return x;
+			for (base_type* p = x->parent(); p != header(); p = p->parent())
+			{
+				if (x == p->left && !impl.comp(key(p), k))
+				{
+					y = p;
+					break;
+				}
+				x = p;
+			}
+			while (x)
+			{
+				if (!impl.comp(key(x), k))
+				{
+					y = x;
+					x = x->left;
+				}
+				else
+					x = x->right;
+			}
+			return y;
+		}
+
+		/**
+		 * @brief Returns the first node whose key is not less than k,
+		 * walking forward from a node x such that all nodes before it are
+		 * less than k.
+		 */
+		base_type*	scan_lower_bound(base_type* x, key_type const& k) const
+		{
+			while (x != header() && impl.comp(key(x), k))
+				x = x->increment();
+			return x;
+		}
+
+		/**
+		 * @brief Keep the elements whose key is in x if common is set, or
+		 * those whose key is not otherwise, and rebuild this tree balanced.
+		 *
+		 * @param finger	true to find each key in x by finger search, and
+		 * false to walk x alongside this tree.
+		 */
+		void		filter(_rb_tree const& x, bool common, bool finger)
+		{
+			size_type	rest = size();
+			base_type*	a = detail::_rb_flatten(impl.header, rest);
+			base_type	kept;
+			base_type*	tail = &kept;
+			size_type	n = 0;
+			base_type*	b = x.impl.header.left;
+
+			impl.reset();
+			try
+			{
+				for (; a; --rest)
+				{
+					b = finger ? x.finger_lower_bound(b, key(a))
+						: x.scan_lower_bound(b, key(a));
+
+					bool const			found = b != x.header()
+						&& !impl.comp(key(a), key(b));
+					base_type* const	next = a->right;
+
+					if (found == common)
+					{
+						tail->right = a;
+						tail = a;
+						++n;
+					}
+					else
+						destroy_node(a);
+					a = next;
+				}
+			}
+			catch (...)
+			{
+				tail->right = a;
+				adopt_list(kept.right, n + rest);
+				throw;
+			}
+			adopt_list(kept.right, n);
+		}
+
+		/**
+		 * @brief Merge the nodes of x into this tree in a linear walk,
+		 * leaving x those whose key is already in this tree.
+		 */
+		void		linear_union(_rb_tree& x)
+		{
+			size_type	ra = size();
+			size_type	rb = x.size();
+			base_type*	a = detail::_rb_flatten(impl.header, ra);
+			base_type*	b = detail::_rb_flatten(x.impl.header, rb);
+			base_type	out;
+			base_type*	tail = &out;
+			size_type	n = 0;
+			base_type	dups;
+			base_type*	dups_tail = &dups;
+			size_type	d = 0;
+
+			impl.reset();
+			x.impl.reset();
+			try
+			{
+				for (; a && b; ++n)
+				{
+					if (impl.comp(key(b), key(a)))
+					{
+						tail = tail->right = b;
+						b = b->right;
+						--rb;
+						continue;
+					}
+					if (!impl.comp(key(a), key(b)))
+					{
+						dups_tail = dups_tail->right = b;
+						b = b->right;
+						--rb;
+						++d;
+					}
+					tail = tail->right = a;
+					a = a->right;
+					--ra;
+				}
+			}
+			catch (...)
+			{
+				tail->right = a;
+				dups_tail->right = b;
+				adopt_list(out.right, n + ra);
+				x.adopt_list(dups.right, d + rb);
+				throw;
+			}
+			tail->right = a ? a : b;
+			adopt_list(out.right, n + ra + rb);
+			x.adopt_list(dups.right, d);
+		}
+
+		/**
+		 * @brief Link the nodes of src into this tree by finger search,
+		 * leaving src those whose key is already in this tree, or, if
+		 * replace is set, putting them in the place of this tree's nodes
+		 * and leaving src those.
+		 */
+		void		finger_union(_rb_tree& src, bool replace)
+		{
+			size_type	rest = src.size();
+			base_type*	list = detail::_rb_flatten(src.impl.header, rest);
+			base_type	dups;
+			base_type*	tail = &dups;
+			size_type	d = 0;
+			base_type*	f = impl.header.left;
+
+			src.impl.reset();
+			try
+			{
+				for (; list; --rest)
+				{
+					base_type* const	y = list;
+					base_type* const	pos = finger_lower_bound(f, key(y));
+					bool const			fresh = pos == &impl.header
+						|| impl.comp(key(y), key(pos));
+
+					list = y->right;
+					if (fresh)
+					{
+						link_before(pos, y);
+						f = y;
+						continue;
+					}
+					if (replace)
+					{
+						detail::_rb_replace_node<Augment>(pos, y, impl.header);
+						tail = tail->right = pos;
+						f = y;
+					}
+					else
+					{
+						tail = tail->right = y;
+						f = pos;
+					}
+					++d;
+				}
+			}
+			catch (...)
+			{
+				tail->right = list;
+				src.adopt_list(dups.right, d + rest);
+				throw;
+			}
+			src.adopt_list(dups.right, d);
+		}
+
+		/// Copy the tree of x into this empty tree.
+		void		copy_root(_rb_tree const& x)
+		{
+			base_type* const	r = copy_subtree(x.root(), &impl.header);
+
+			impl.header.set_parent(r);
+			impl.header.left = base_type::minimum(r);
+			impl.header.right = base_type::maximum(r);
+			impl.node_count = x.impl.node_count;
+		}
+
+		base_type*	lower_bound_node(key_type const& k) const
+		{
+			base_type*	x = root();
+			base_type*	y = header();
+
+			while (x)
+			{
+				if (!impl.comp(key(x), k))
+				{
+					y = x;
+					x = x->left;
+				}
+				else
+					x = x->right;
+			}
+			return y;
+		}
+
+		base_type*	upper_bound_node(key_type const& k) const
+		{
+			base_type*	x = root();
+			base_type*	y = header();
+
+			while (x)
+			{
+				if (impl.comp(k, key(x)))
+				{
+					y = x;
+					x = x->left;
+				}
+				else
+					x = x->right;
+			}
+			return y;
+		}
+
+		/**
+		 * @brief Descend to the first element equivalent to k, and only
+		 * then split into a lower bound search of its left subtree and an
+		 * upper bound search of its right one.
+		 */
+		pair<base_type*, base_type*>	equal_range_nodes(
+			key_type const& k) const
+		{
+			base_type*	x = root();
+			base_type*	y = header();
+
+			while (x)
+			{
+				if (impl.comp(key(x), k))
+					x = x->right;
+				else if (impl.comp(k, key(x)))
+				{
+					y = x;
+					x = x->left;
+				}
+				else
+				{
+					base_type*	lo = x->left;
+					base_type*	lower = x;
+					base_type*	hi = x->right;
+
+					while (lo)
+					{
+						if (!impl.comp(key(lo), k))
+						{
+							lower = lo;
+							lo = lo->left;
+						}
+						else
+							lo = lo->right;
+					}
+					while (hi)
+					{
+						if (impl.comp(k, key(hi)))
+						{
+							y = hi;
+							hi = hi->left;
+						}
+						else
+							hi = hi->right;
+					}
+					return pair<base_type*, base_type*>(lower, y);
+				}
+			}
+			return pair<base_type*, base_type*>(y, y);
+		}
+
+		base_type*	find_node(key_type const& k) const
+		{
+			base_type* const	j = lower_bound_node(k);
+
+			return j == header() || impl.comp(k, key(j)) ? header() : j;
+		}
+	};
+
+	template<typename K, typename V, typename KoV, typename C, typename A,
+		typename Aug>
+	inline bool	operator==(_rb_tree<K, V, KoV, C, A, Aug> const& x,
+		_rb_tree<K, V, KoV, C, A, Aug> const& y)
+	{
+		return x.size() == y.size()
+			&& ft::equal(x.begin(), x.end(), y.begin());
+	}
+
+	template<typename K, typename V, typename KoV, typename C, typename A,
+		typename Aug>
+	inline bool	operator<(_rb_tree<K, V, KoV, C, A, Aug> const& x,
+		_rb_tree<K, V, KoV, C, A, Aug> const& y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(),
+			y.begin(), y.end());
+	}
+}
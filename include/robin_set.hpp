@@ -0,0 +1,622 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A robin_set::iterator, that walks the probe distances along
+	 * with the slots, skipping empty ones.
+	 */
+	template<typename T>
+	struct	_robin_iterator
+	{
+		typedef	_robin_iterator	_self;
+
+		typedef	forward_iterator_tag	iterator_category;
+		typedef	T						value_type;
+		typedef	T const*				pointer;
+		typedef	T const&				reference;
+		typedef	ptrdiff_t				difference_type;
+
+		unsigned char const*	dist;
+		T const*				slot;
+
+		_robin_iterator() throw()
+			:	dist(), slot() { }
+
+		_robin_iterator(unsigned char const* d, T const* s) throw()
+			:	dist(d), slot(s) { }
+
+		reference	operator*() const throw()
+		{ return *slot; }
+
+		pointer		operator->() const throw()
+		{ return slot; }
+
+		_self&		operator++() throw()
+		{
+			++dist;
+			++slot;
+			skip();
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		/// Move on to the first full slot from here, or to the sentinel.
+		void		skip() throw()
+		{
+			while (!*dist)
+			{
+				++dist;
+				++slot;
+			}
+		}
+
+		friend bool	operator==(_self const& x, _self const& y) throw()
+		{ return x.dist == y.dist; }
+
+		friend bool	operator!=(_self const& x, _self const& y) throw()
+		{ return x.dist != y.dist; }
+	};
+
+	/**
+	 * @brief An unordered set of unique keys in an open addressing table
+	 * with Robin Hood hashing, meant for integers and other small keys
+	 * that copy without throwing.
+	 *
+	 * Keys are stored inline in one flat array of slots, alongside a byte
+	 * per slot that holds its key's distance from the slot it hashes to,
+	 * plus one, or 0 for an empty slot. That is sizeof(T) + 1 bytes per
+	 * slot, where a chained table takes a node per key and a pointer per
+	 * bucket.
+	 *
+	 * An insertion takes the slot of the first key that is nearer its own
+	 * slot than the new one would be, and shifts the run of keys after it
+	 * one slot further. Keys are thus sorted by the slot they hash to, and
+	 * probe distances stay even and short at load factors up to 0.9: a
+	 * lookup stops at the first key nearer its slot than the one it is
+	 * after, which makes misses about as fast as hits. An erasure shifts
+	 * the following keys back instead of leaving a tombstone.
+	 *
+	 * Insertions invalidate every iterator when they rehash, and the ones
+	 * after the new key otherwise. Erasures invalidate the iterators to
+	 * the keys that are shifted back.
+	 *
+	 * @tparam T	The key type.
+	 * @tparam Hash	The hash function. Its bits are mixed by the table.
+	 * @tparam Pred	The key equality.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename Hash = hash<T>, typename Pred = equal_to<T>,
+		typename A = allocator<T> >
+	class	robin_set
+	{
+	public:
+		typedef	T		key_type;
+		typedef	T		value_type;
+		typedef	Hash	hasher;
+		typedef	Pred	key_equal;
+		typedef	A		allocator_type;
+
+	private:
+		typedef	_alloc_traits<A>	alloc_traits;
+		typedef	typename alloc_traits::template rebind<unsigned char>::other
+			dist_alloc_type;
+		typedef	_alloc_traits<dist_alloc_type>	dist_alloc_traits;
+
+		enum
+		{
+			min_capacity = 8,
+			/// The greatest probe distance, plus one, a key may have.
+			max_dist = 254,
+			/// The distance byte after the last slot, that ends iteration.
+			sentinel = 255
+		};
+
+		struct	_robin_impl	:	public A
+		{
+			Hash			hash;
+			Pred			eq;
+			unsigned char*	dist;
+			T*				slots;
+			/// The number of slots, a power of two, or 0.
+			size_t			capacity;
+			size_t			size;
+			/// The number of keys past which the table grows.
+			size_t			limit;
+			/// 64 minus the base 2 logarithm of capacity.
+			unsigned		shift;
+			float			max_load;
+
+			_robin_impl(Hash const& h, Pred const& e, A const& a)
+				:	A(a), hash(h), eq(e), dist(), slots(), capacity(0),
+					size(0), limit(0), shift(0), max_load(0.875f) { }
+		};
+
+		_robin_impl	impl;
+
+	public:
+		typedef	typename A::pointer			pointer;
+		typedef	typename A::const_pointer	const_pointer;
+		typedef	typename A::reference		reference;
+		typedef	typename A::const_reference	const_reference;
+		typedef	_robin_iterator<T>			iterator;
+		typedef	_robin_iterator<T>			const_iterator;
+		typedef	size_t						size_type;
+		typedef	ptrdiff_t					difference_type;
+
+		/**
+		 * @brief Construct an empty set, with room for n keys.
+		 */
+		explicit robin_set(size_type n = 0, hasher const& h = hasher(),
+			key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	impl(h, eq, a)
+		{ reserve(n); }
+
+		template<typename I>
+		robin_set(I first, I last, size_type n = 0,
+			hasher const& h = hasher(), key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	impl(h, eq, a)
+		{
+			try
+			{
+				reserve(n);
+				insert(first, last);
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+		}
+
+		robin_set(robin_set const& x)
+			:	impl(x.impl.hash, x.impl.eq,
+					alloc_traits::select_on_copy(x.impl))
+		{
+			impl.max_load = x.impl.max_load;
+			try
+			{
+				reserve(x.size());
+				for (const_iterator i = x.begin(); i != x.end(); ++i)
+					insert(*i);
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+		}
+
+		~robin_set() throw()
+		{ release(); }
+
+		robin_set&	operator=(robin_set const& x)
+		{
+			if (this != &x)
+			{
+				robin_set	tmp(x);
+
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		iterator	begin() const throw()
+		{
+			iterator	i(impl.dist, impl.slots);
+
+			if (impl.capacity)
+				i.skip();
+			return i;
+		}
+
+		iterator	end() const throw()
+		{
+			return iterator(impl.dist + impl.capacity,
+				impl.slots + impl.capacity);
+		}
+
+		bool		empty() const throw()
+		{ return impl.size == 0; }
+
+		size_type	size() const throw()
+		{ return impl.size; }
+
+		size_type	max_size() const throw()
+		{ return alloc_traits::max_size(impl) / 2; }
+
+		/**
+		 * @brief Insert x unless an equal key is already in the set.
+		 *
+		 * @return pair<iterator, bool>	The element equal to x, and whether
+		 * it was inserted.
+		 *
+		 * @throw LengthErrorException if too many keys hash alike to fit in
+		 * the table however large it grows.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{
+			size_t const	h = hash_of(x);
+
+			for (;;)
+			{
+				size_t	i = home(h);
+				size_t	d = 1;
+
+				if (impl.capacity)
+				{
+					for (; impl.dist[i] >= d; ++d, i = (i + 1) & mask())
+						if (impl.dist[i] == d && impl.eq(impl.slots[i], x))
+							return pair<iterator, bool>(at(i), false);
+					if (impl.size < impl.limit && place(x, i, d))
+						return pair<iterator, bool>(at(i), true);
+					// A probe this long in a table this sparse means that
+					// the hash maps too many keys to the same slot.
+					if (impl.size < impl.limit / 2)
+						throw LengthErrorException();
+				}
+				rehash_to(impl.capacity ? impl.capacity * 2
+					: capacity_for(1));
+			}
+		}
+
+		/**
+		 * @brief Insert x unless an equal key is already in the set. The
+		 * hint is not used.
+		 */
+		iterator				insert(iterator, value_type const& x)
+		{ return insert(x).first; }
+
+		template<typename I>
+		void					insert(I first, I last)
+		{
+			for (; first != last; ++first)
+				insert(*first);
+		}
+
+		/// Erase a key, shifting the keys after it back.
+		void		erase(iterator pos) throw()
+		{ erase_at(size_t(pos.slot - impl.slots)); }
+
+		/**
+		 * @brief Erase the key equal to k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			size_t const	i = find_index(k);
+
+			if (i == impl.capacity)
+				return 0;
+			erase_at(i);
+			return 1;
+		}
+
+		void		swap(robin_set& x) throw()
+		{
+			ft::swap(impl.hash, x.impl.hash);
+			ft::swap(impl.eq, x.impl.eq);
+			ft::swap(impl.dist, x.impl.dist);
+			ft::swap(impl.slots, x.impl.slots);
+			ft::swap(impl.capacity, x.impl.capacity);
+			ft::swap(impl.size, x.impl.size);
+			ft::swap(impl.limit, x.impl.limit);
+			ft::swap(impl.shift, x.impl.shift);
+			ft::swap(impl.max_load, x.impl.max_load);
+			alloc_traits::on_swap(impl, x.impl);
+		}
+
+		/// Erase every key, keeping the table's capacity.
+		void		clear() throw()
+		{
+			destroy_all();
+			if (impl.capacity)
+				std::memset(impl.dist, 0, impl.capacity);
+			impl.size = 0;
+		}
+
+		hasher		hash_function() const
+		{ return impl.hash; }
+
+		key_equal	key_eq() const
+		{ return impl.eq; }
+
+		iterator	find(key_type const& k) const
+		{ return at(find_index(k)); }
+
+		size_type	count(key_type const& k) const
+		{ return find_index(k) != impl.capacity; }
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{
+			iterator	i = find(k);
+
+			return pair<iterator, iterator>(i, i == end() ? i : ++iterator(i));
+		}
+
+		/// The number of slots in the table.
+		size_type	bucket_count() const throw()
+		{ return impl.capacity; }
+
+		float		load_factor() const throw()
+		{ return impl.capacity ? float(impl.size) / impl.capacity : 0; }
+
+		float		max_load_factor() const throw()
+		{ return impl.max_load; }
+
+		/**
+		 * @brief Set the load factor past which the table grows, rehashing
+		 * it if it is already past it.
+		 *
+		 * @throw InvalidArgumentException if z is not between 0.1 and 0.95.
+		 */
+		void		max_load_factor(float z)
+		{
+			if (!(z >= 0.1f && z <= 0.95f))
+				throw InvalidArgumentException();
+			impl.max_load = z;
+			impl.limit = growth_limit(impl.capacity);
+			if (impl.size > impl.limit)
+				rehash(impl.size);
+		}
+
+		/**
+		 * @brief Rebuild the table with room for at least n keys, shrinking
+		 * it if it is larger than needed.
+		 */
+		void		rehash(size_type n)
+		{
+			size_t const	cap = capacity_for(n > impl.size ? n : impl.size);
+
+			if (cap == 0)
+				release();
+			else if (cap != impl.capacity)
+				rehash_to(cap);
+		}
+
+		/// Make room for n keys, so that inserting them does not rehash.
+		void		reserve(size_type n)
+		{
+			if (n > impl.limit)
+				rehash_to(capacity_for(n));
+		}
+
+		/**
+		 * @brief Returns the longest probe a lookup of a key in the set
+		 * takes, counting the slots it reads. Takes a scan of the table.
+		 */
+		size_type	max_probe_length() const throw()
+		{
+			unsigned char	m = 0;
+
+			for (size_t i = 0; i < impl.capacity; ++i)
+				m = ft::max(m, impl.dist[i]);
+			return m;
+		}
+
+		friend bool	operator==(robin_set const& x, robin_set const& y)
+		{
+			if (x.size() != y.size())
+				return false;
+			for (const_iterator i = x.begin(); i != x.end(); ++i)
+				if (!y.count(*i))
+					return false;
+			return true;
+		}
+
+	private:
+		size_t		mask() const throw()
+		{ return impl.capacity - 1; }
+
+		iterator	at(size_t i) const throw()
+		{ return iterator(impl.dist + i, impl.slots + i); }
+
+		/**
+		 * @brief Hash k, and mix the bits of the result by Fibonacci
+		 * hashing. The table takes the high bits of the product, which
+		 * depend on all of the hash's.
+		 */
+		size_t		hash_of(key_type const& k) const
+		{ return impl.hash(k) * size_t(0x9E3779B97F4A7C15UL); }
+
+		/// The slot a hash h belongs in.
+		size_t		home(size_t h) const throw()
+		{ return impl.capacity ? h >> impl.shift : 0; }
+
+		/// The number of keys a table of cap slots holds before growing.
+		size_t		growth_limit(size_t cap) const throw()
+		{
+			size_t const	n = size_t(double(cap) * impl.max_load);
+
+			return n < cap || !cap ? n : cap - 1;
+		}
+
+		/// The smallest capacity that holds n keys, 0 for none.
+		size_t		capacity_for(size_t n) const throw()
+		{
+			size_t	cap = min_capacity;
+
+			if (n == 0)
+				return 0;
+			while (growth_limit(cap) < n)
+				cap *= 2;
+			return cap;
+		}
+
+		/// Returns the slot of k, or capacity.
+		size_t		find_index(key_type const& k) const
+		{
+			if (!impl.size)
+				return impl.capacity;
+
+			size_t	i = home(hash_of(k));
+
+			for (size_t d = 1; impl.dist[i] >= d; ++d, i = (i + 1) & mask())
+				if (impl.dist[i] == d && impl.eq(impl.slots[i], k))
+					return i;
+			return impl.capacity;
+		}
+
+		/**
+		 * @brief Put x in slot i, at distance d from its own, shifting the
+		 * keys from i to the next empty slot one slot further.
+		 *
+		 * @return bool	false, leaving the table unchanged, if a key would
+		 * be too far from its slot.
+		 */
+		bool		place(value_type const& x, size_t i, size_t d) throw()
+		{
+			size_t	j = i;
+
+			if (d > max_dist)
+				return false;
+			for (; impl.dist[j]; j = (j + 1) & mask())
+				if (impl.dist[j] == max_dist)
+					return false;
+			for (; j != i; j = (j - 1) & mask())
+			{
+				size_t const	k = (j - 1) & mask();
+
+				alloc_traits::construct(impl, impl.slots + j, impl.slots[k]);
+				alloc_traits::destroy(impl, impl.slots + k);
+				impl.dist[j] = impl.dist[k] + 1;
+			}
+			alloc_traits::construct(impl, impl.slots + i, x);
+			impl.dist[i] = static_cast<unsigned char>(d);
+			++impl.size;
+			return true;
+		}
+
+		/// Erase slot i, shifting back the keys after it that are not in
+		/// their own slot.
+		void		erase_at(size_t i) throw()
+		{
+			size_t	j = (i + 1) & mask();
+
+			alloc_traits::destroy(impl, impl.slots + i);
+			for (; impl.dist[j] > 1; i = j, j = (j + 1) & mask())
+			{
+				alloc_traits::construct(impl, impl.slots + i, impl.slots[j]);
+				alloc_traits::destroy(impl, impl.slots + j);
+				impl.dist[i] = impl.dist[j] - 1;
+			}
+			impl.dist[i] = 0;
+			--impl.size;
+		}
+
+		/**
+		 * @brief Move the keys to new arrays of cap slots, leaving the
+		 * table unchanged if hashing or copying a key throws.
+		 *
+		 * @throw LengthErrorException if the keys do not fit, as too many
+		 * hash alike.
+		 */
+		void		rehash_to(size_t cap)
+		{
+			robin_set	tmp(impl, cap);
+
+			for (size_t i = 0; i < impl.capacity; ++i)
+			{
+				if (!impl.dist[i])
+					continue;
+
+				value_type const&	x = impl.slots[i];
+				size_t				j = tmp.home(tmp.hash_of(x));
+				size_t				d = 1;
+
+				for (; tmp.impl.dist[j] >= d; ++d, j = (j + 1) & tmp.mask())
+					;
+				if (!tmp.place(x, j, d))
+					throw LengthErrorException();
+			}
+			swap(tmp);
+		}
+
+		/// Construct an empty table of cap slots, with the functions, the
+		/// allocator and the load factor of x, for rehash_to().
+		robin_set(_robin_impl const& x, size_t cap)
+			:	impl(x.hash, x.eq, x)
+		{
+			dist_alloc_type	dist_alloc(impl);
+
+			impl.max_load = x.max_load;
+			impl.slots = alloc_traits::allocate(impl, cap);
+			try
+			{
+				impl.dist = dist_alloc_traits::allocate(dist_alloc, cap + 1);
+			}
+			catch (...)
+			{
+				alloc_traits::deallocate(impl, impl.slots, cap);
+				throw;
+			}
+			std::memset(impl.dist, 0, cap);
+			impl.dist[cap] = sentinel;
+			impl.capacity = cap;
+			impl.limit = growth_limit(cap);
+			impl.shift = sizeof(size_t) * 8 - _lg(cap);
+		}
+
+		static unsigned	_lg(size_t n) throw()
+		{ return sizeof(n) * 8 - 1 - __builtin_clzl(n); }
+
+		void		destroy_all() throw()
+		{
+			for (size_t i = 0; i < impl.capacity; ++i)
+				if (impl.dist[i])
+					alloc_traits::destroy(impl, impl.slots + i);
+		}
+
+		/// Destroy the keys and free the arrays.
+		void		release() throw()
+		{
+			if (!impl.capacity)
+				return;
+			destroy_all();
+
+			dist_alloc_type	dist_alloc(impl);
+
+			dist_alloc_traits::deallocate(dist_alloc, impl.dist,
+				impl.capacity + 1);
+			alloc_traits::deallocate(impl, impl.slots, impl.capacity);
+			impl.dist = 0;
+			impl.slots = 0;
+			impl.capacity = 0;
+			impl.size = 0;
+			impl.limit = 0;
+			impl.shift = 0;
+		}
+	};
+
+	template<typename T, typename H, typename P, typename A>
+	inline bool	operator!=(robin_set<T, H, P, A> const& x,
+		robin_set<T, H, P, A> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename H, typename P, typename A>
+	inline void	swap(robin_set<T, H, P, A>& x, robin_set<T, H, P, A>& y)
+		throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,494 @@
+#pragma once
+
+#include <functional.hpp>
+#include <pool_allocator.hpp>
+#include <rb_tree.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A sorted associative container of unique keys.
+	 *
+	 * Lookups, insertions and erasures are O(log n) on a red-black tree,
+	 * and iterators stay valid until their element is erased. Elements are
+	 * constant, since changing one could break the order.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type, rebound to nodes. The default
+	 * pool_allocator recycles nodes without calling malloc.
+	 * @tparam Augment	The node policy. rb_order_statistics adds rank and
+	 * select, and makes distance and advance O(log n).
+	 */
+	template<typename K, typename Compare = less<K>,
+		typename A = pool_allocator<K>,
+		typename Augment = rb_no_augment>
+	class	set
+	{
+	public:
+		typedef	K			key_type;
+		typedef	K			value_type;
+		typedef	Compare		key_compare;
+		typedef	Compare		value_compare;
+		typedef	A			allocator_type;
+
+	private:
+		typedef	_rb_tree<key_type, value_type, _identity<value_type>,
+			key_compare, allocator_type, Augment>	tree_type;
+
+		tree_type	tree;
+
+	public:
+		typedef	typename A::pointer							pointer;
+		typedef	typename A::const_pointer					const_pointer;
+		typedef	typename A::reference						reference;
+		typedef	typename A::const_reference					const_reference;
+		typedef	typename tree_type::const_iterator			iterator;
+		typedef	typename tree_type::const_iterator			const_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			reverse_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			const_reverse_iterator;
+		typedef	typename tree_type::size_type				size_type;
+		typedef	typename tree_type::difference_type			difference_type;
+
+		explicit set(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a) { }
+
+		/**
+		 * @brief Construct a set from a range, in O(n) if it is strictly
+		 * increasing.
+		 */
+		template<typename I>
+		set(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a)
+		{ tree.insert_unique(first, last); }
+
+		set(set const& x)	:	tree(x.tree) { }
+
+		set&	operator=(set const& x)
+		{
+			tree = x.tree;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return tree.get_allocator(); }
+
+		iterator			begin() const throw()
+		{ return tree.begin(); }
+
+		iterator			end() const throw()
+		{ return tree.end(); }
+
+		reverse_iterator	rbegin() const throw()
+		{ return tree.rbegin(); }
+
+		reverse_iterator	rend() const throw()
+		{ return tree.rend(); }
+
+		bool		empty() const throw()
+		{ return tree.empty(); }
+
+		size_type	size() const throw()
+		{ return tree.size(); }
+
+		size_type	max_size() const throw()
+		{ return tree.max_size(); }
+
+		/**
+		 * @brief Insert x unless an equivalent key is already in the set.
+		 *
+		 * @return pair<iterator, bool>	The element equivalent to x, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{
+			pair<typename tree_type::iterator, bool> const	p
+				= tree.insert_unique(x);
+
+			return pair<iterator, bool>(p.first, p.second);
+		}
+
+		/**
+		 * @brief Insert x unless an equivalent key is already in the set, in
+		 * amortized O(1) if x belongs right before or after hint.
+		 */
+		iterator				insert(iterator hint, value_type const& x)
+		{ return tree.insert_unique(hint, x); }
+
+		/**
+		 * @brief Insert a range, in O(n) if the set is empty and the range
+		 * strictly increasing.
+		 */
+		template<typename I>
+		void					insert(I first, I last)
+		{ tree.insert_unique(first, last); }
+
+		void		erase(iterator pos)
+		{ tree.erase(pos); }
+
+		/**
+		 * @brief Erase the key equivalent to k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{
+			iterator const	i = find(k);
+
+			if (i == end())
+				return 0;
+			tree.erase(i);
+			return 1;
+		}
+
+		void		erase(iterator first, iterator last)
+		{ tree.erase(first, last); }
+
+		void		swap(set& x) throw()
+		{ tree.swap(x.tree); }
+
+		void		clear() throw()
+		{ tree.clear(); }
+
+		key_compare		key_comp() const
+		{ return tree.key_comp(); }
+
+		value_compare	value_comp() const
+		{ return tree.key_comp(); }
+
+		iterator	find(key_type const& k) const
+		{ return tree.find(k); }
+
+		size_type	count(key_type const& k) const
+		{ return tree.find(k) == tree.end() ? 0 : 1; }
+
+		iterator	lower_bound(key_type const& k) const
+		{ return tree.lower_bound(k); }
+
+		iterator	upper_bound(key_type const& k) const
+		{ return tree.upper_bound(k); }
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{ return tree.equal_range(k); }
+
+		/**
+		 * @brief Returns the number of keys less than k, in O(log n).
+		 * Requires rb_order_statistics.
+		 */
+		size_type	rank(key_type const& k) const
+		{ return tree.rank(k); }
+
+		/**
+		 * @brief Returns the element at index i in order, or end() if
+		 * there are no more than i elements, in O(log n). Requires
+		 * rb_order_statistics.
+		 */
+		iterator	select(size_type i) const
+		{ return tree.select(i); }
+
+		/**
+		 * @brief Move the elements less than k to left and the others to
+		 * right, leaving this set empty, by relinking nodes in O(log n).
+		 *
+		 * left and right are cleared first, and may be this set. Their
+		 * allocators must compare equal to this set's. Without
+		 * rb_order_statistics, counting the elements of each side adds a
+		 * walk over the smaller one.
+		 */
+		void	split(key_type const& k, set& left, set& right)
+		{ tree.split(tree.lower_bound(k), left.tree, right.tree); }
+
+		/**
+		 * @brief Move the elements of left and then those of right to this
+		 * set, leaving them empty, by relinking nodes in O(log n).
+		 *
+		 * @throw InvalidArgumentException unless every element of left is
+		 * less than every element of right.
+		 */
+		void	join(set& left, set& right)
+		{ tree.join(left.tree, right.tree, true); }
+
+		/**
+		 * @brief Move the elements of x not in this set to it,
+		 * leaving the others in x, by relinking nodes.
+		 *
+		 * Sets of similar sizes are merged in a linear walk, in O(n + m),
+		 * and when one is much smaller its elements are found in the other
+		 * by finger search, in O(m log(n / m)), without a search from the
+		 * root per element. The allocators must compare equal.
+		 */
+		void	merge_union(set& x)
+		{ tree.merge_union(x.tree); }
+
+		/**
+		 * @brief Erase the elements not in x, in a linear
+		 * walk, or by finger search in x if this set is much smaller.
+		 */
+		void	merge_intersection(set const& x)
+		{ tree.merge_intersection(x.tree); }
+
+		/**
+		 * @brief Erase the elements in x, in a linear walk,
+		 * or by finger search if either set is much smaller.
+		 */
+		void	merge_difference(set const& x)
+		{ tree.merge_difference(x.tree); }
+
+		friend bool	operator==(set const& x, set const& y)
+		{ return x.tree == y.tree; }
+
+		friend bool	operator<(set const& x, set const& y)
+		{ return x.tree < y.tree; }
+	};
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator!=(set<K, C, A, Aug> const& x,
+		set<K, C, A, Aug> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator>(set<K, C, A, Aug> const& x,
+		set<K, C, A, Aug> const& y)
+	{ return y < x; }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator<=(set<K, C, A, Aug> const& x,
+		set<K, C, A, Aug> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator>=(set<K, C, A, Aug> const& x,
+		set<K, C, A, Aug> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline void	swap(set<K, C, A, Aug>& x,
+		set<K, C, A, Aug>& y) throw()
+	{ x.swap(y); }
+
+	/**
+	 * @brief A sorted associative container of keys, where several
+	 * elements may be equivalent.
+	 *
+	 * Equivalent elements keep their insertion order.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam Compare	The key ordering.
+	 * @tparam A		The allocator type, rebound to nodes.
+	 * @tparam Augment	The node policy. rb_order_statistics adds rank and
+	 * select, and makes distance and advance O(log n).
+	 */
+	template<typename K, typename Compare = less<K>,
+		typename A = pool_allocator<K>,
+		typename Augment = rb_no_augment>
+	class	multiset
+	{
+	public:
+		typedef	K			key_type;
+		typedef	K			value_type;
+		typedef	Compare		key_compare;
+		typedef	Compare		value_compare;
+		typedef	A			allocator_type;
+
+	private:
+		typedef	_rb_tree<key_type, value_type, _identity<value_type>,
+			key_compare, allocator_type, Augment>	tree_type;
+
+		tree_type	tree;
+
+	public:
+		typedef	typename A::pointer							pointer;
+		typedef	typename A::const_pointer					const_pointer;
+		typedef	typename A::reference						reference;
+		typedef	typename A::const_reference					const_reference;
+		typedef	typename tree_type::const_iterator			iterator;
+		typedef	typename tree_type::const_iterator			const_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			reverse_iterator;
+		typedef	typename tree_type::const_reverse_iterator
+			const_reverse_iterator;
+		typedef	typename tree_type::size_type				size_type;
+		typedef	typename tree_type::difference_type			difference_type;
+
+		explicit multiset(Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a) { }
+
+		/**
+		 * @brief Construct a multiset from a range, in O(n) if it is sorted.
+		 */
+		template<typename I>
+		multiset(I first, I last, Compare const& cmp = Compare(),
+			allocator_type const& a = allocator_type())
+			:	tree(cmp, a)
+		{ tree.insert_equal(first, last); }
+
+		multiset(multiset const& x)	:	tree(x.tree) { }
+
+		multiset&	operator=(multiset const& x)
+		{
+			tree = x.tree;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return tree.get_allocator(); }
+
+		iterator			begin() const throw()
+		{ return tree.begin(); }
+
+		iterator			end() const throw()
+		{ return tree.end(); }
+
+		reverse_iterator	rbegin() const throw()
+		{ return tree.rbegin(); }
+
+		reverse_iterator	rend() const throw()
+		{ return tree.rend(); }
+
+		bool		empty() const throw()
+		{ return tree.empty(); }
+
+		size_type	size() const throw()
+		{ return tree.size(); }
+
+		size_type	max_size() const throw()
+		{ return tree.max_size(); }
+
+		/**
+		 * @brief Insert x after the equivalent elements.
+		 */
+		iterator	insert(value_type const& x)
+		{ return tree.insert_equal(x); }
+
+		/**
+		 * @brief Insert x right before or after hint in amortized O(1) if
+		 * that keeps the order, and after the equivalent elements
+		 * otherwise.
+		 */
+		iterator	insert(iterator hint, value_type const& x)
+		{ return tree.insert_equal(hint, x); }
+
+		/**
+		 * @brief Insert a range, in O(n) if the multiset is empty and the
+		 * range sorted.
+		 */
+		template<typename I>
+		void		insert(I first, I last)
+		{ tree.insert_equal(first, last); }
+
+		void		erase(iterator pos)
+		{ tree.erase(pos); }
+
+		/**
+		 * @brief Erase the elements equivalent to k.
+		 *
+		 * @return size_type	The number of elements erased.
+		 */
+		size_type	erase(key_type const& k)
+		{ return tree.erase_key(k); }
+
+		void		erase(iterator first, iterator last)
+		{ tree.erase(first, last); }
+
+		void		swap(multiset& x) throw()
+		{ tree.swap(x.tree); }
+
+		void		clear() throw()
+		{ tree.clear(); }
+
+		key_compare		key_comp() const
+		{ return tree.key_comp(); }
+
+		value_compare	value_comp() const
+		{ return tree.key_comp(); }
+
+		iterator	find(key_type const& k) const
+		{ return tree.find(k); }
+
+		size_type	count(key_type const& k) const
+		{ return tree.count(k); }
+
+		iterator	lower_bound(key_type const& k) const
+		{ return tree.lower_bound(k); }
+
+		iterator	upper_bound(key_type const& k) const
+		{ return tree.upper_bound(k); }
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{ return tree.equal_range(k); }
+
+		/**
+		 * @brief Returns the number of keys less than k, in O(log n).
+		 * Requires rb_order_statistics.
+		 */
+		size_type	rank(key_type const& k) const
+		{ return tree.rank(k); }
+
+		/**
+		 * @brief Returns the element at index i in order, or end() if
+		 * there are no more than i elements, in O(log n). Requires
+		 * rb_order_statistics.
+		 */
+		iterator	select(size_type i) const
+		{ return tree.select(i); }
+
+		/**
+		 * @brief Move the elements less than k to left and the others to
+		 * right, leaving this set empty, by relinking nodes in O(log n).
+		 *
+		 * left and right are cleared first, and may be this set. Their
+		 * allocators must compare equal to this set's. Without
+		 * rb_order_statistics, counting the elements of each side adds a
+		 * walk over the smaller one.
+		 */
+		void	split(key_type const& k, multiset& left, multiset& right)
+		{ tree.split(tree.lower_bound(k), left.tree, right.tree); }
+
+		/**
+		 * @brief Move the elements of left and then those of right to this
+		 * set, leaving them empty, by relinking nodes in O(log n).
+		 *
+		 * @throw InvalidArgumentException if a element of right is less
+		 * than one of left.
+		 */
+		void	join(multiset& left, multiset& right)
+		{ tree.join(left.tree, right.tree, false); }
+
+		friend bool	operator==(multiset const& x, multiset const& y)
+		{ return x.tree == y.tree; }
+
+		friend bool	operator<(multiset const& x, multiset const& y)
+		{ return x.tree < y.tree; }
+	};
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator!=(multiset<K, C, A, Aug> const& x,
+		multiset<K, C, A, Aug> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator>(multiset<K, C, A, Aug> const& x,
+		multiset<K, C, A, Aug> const& y)
+	{ return y < x; }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator<=(multiset<K, C, A, Aug> const& x,
+		multiset<K, C, A, Aug> const& y)
+	{ return !(y < x); }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline bool	operator>=(multiset<K, C, A, Aug> const& x,
+		multiset<K, C, A, Aug> const& y)
+	{ return !(x < y); }
+
+	template<typename K, typename C, typename A, typename Aug>
+	inline void	swap(multiset<K, C, A, Aug>& x,
+		multiset<K, C, A, Aug>& y) throw()
+	{ x.swap(y); }
+}
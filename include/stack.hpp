@@ -0,0 +1,95 @@
+#pragma once
+
+#include <deque.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A last-in first-out adapter over a sequence container.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam C	The underlying container, that must provide back(),
+	 * push_back() and pop_back().
+	 */
+	template<typename T, typename C = deque<T> >
+	class	stack
+	{
+		template<typename T_, typename C_>
+		friend bool	operator==(stack<T_, C_> const&, stack<T_, C_> const&);
+
+		template<typename T_, typename C_>
+		friend bool	operator<(stack<T_, C_> const&, stack<T_, C_> const&);
+
+	public:
+		typedef typename C::value_type		value_type;
+		typedef typename C::reference		reference;
+		typedef typename C::const_reference	const_reference;
+		typedef typename C::size_type		size_type;
+		typedef C							container_type;
+
+	protected:
+		C	c;
+
+	public:
+		explicit stack(C const& container = C())	:	c(container) { }
+
+		/**
+		 * @brief Returns true if the stack is empty.
+		 */
+		bool	empty() const
+		{ return c.empty(); }
+
+		/**
+		 * @brief Returns the number of elements in the stack.
+		 */
+		size_type	size() const
+		{ return c.size(); }
+
+		/**
+		 * @brief Returns a reference to the top element.
+		 */
+		reference		top()
+		{ return c.back(); }
+
+		const_reference	top() const
+		{ return c.back(); }
+
+		/**
+		 * @brief Add data on top of the stack.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	push(value_type const& x)
+		{ c.push_back(x); }
+
+		/**
+		 * @brief Removes the top element.
+		 */
+		void	pop()
+		{ c.pop_back(); }
+	};
+
+	template<typename T, typename C>
+	inline bool	operator==(stack<T, C> const& x, stack<T, C> const& y)
+	{ return x.c == y.c; }
+
+	template<typename T, typename C>
+	inline bool	operator<(stack<T, C> const& x, stack<T, C> const& y)
+	{ return x.c < y.c; }
+
+	template<typename T, typename C>
+	inline bool	operator!=(stack<T, C> const& x, stack<T, C> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename C>
+	inline bool	operator>(stack<T, C> const& x, stack<T, C> const& y)
+	{ return y < x; }
+
+	template<typename T, typename C>
+	inline bool	operator<=(stack<T, C> const& x, stack<T, C> const& y)
+	{ return !(y < x); }
+
+	template<typename T, typename C>
+	inline bool	operator>=(stack<T, C> const& x, stack<T, C> const& y)
+	{ return !(x < y); }
+}
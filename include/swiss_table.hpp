@@ -0,0 +1,766 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+#include <algorithm.hpp>
+#include <functional.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	namespace detail
+	{
+		/**
+		 * @brief The control byte of a slot. That of a full slot holds the 7
+		 * low bits of its element's hash, and is non-negative.
+		 */
+		enum
+		{
+			_ctrl_empty = -128,
+			_ctrl_deleted = -2,
+			_ctrl_sentinel = -1
+		};
+
+#ifdef __SSE2__
+		/**
+		 * @brief The control bytes of 16 consecutive slots, compared all at
+		 * once with SSE2. Masks have bit i set for each matching slot i.
+		 */
+		struct	_swiss_group
+		{
+			enum { width = 16 };
+
+			__m128i	ctrl;
+
+			explicit _swiss_group(signed char const* p) throw()
+				:	ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)))
+			{ }
+
+			/// The slots whose control byte is c.
+			unsigned long	match(signed char c) const throw()
+			{
+				return static_cast<unsigned>(_mm_movemask_epi8(
+					_mm_cmpeq_epi8(_mm_set1_epi8(c), ctrl)));
+			}
+
+			unsigned long	match_empty() const throw()
+			{ return match(_ctrl_empty); }
+
+			unsigned long	match_empty_or_deleted() const throw()
+			{
+				return static_cast<unsigned>(_mm_movemask_epi8(
+					_mm_cmpgt_epi8(_mm_set1_epi8(_ctrl_sentinel), ctrl)));
+			}
+
+			/// The number of empty or deleted slots the group starts with.
+			size_t			count_leading_empty_or_deleted() const throw()
+			{ return __builtin_ctzl(~match_empty_or_deleted()); }
+
+			/// The first slot of a mask that is not empty.
+			static size_t	first(unsigned long m) throw()
+			{ return __builtin_ctzl(m); }
+
+			/// The number of slots after the last one of a mask, width if it
+			/// is empty.
+			static size_t	after_last(unsigned long m) throw()
+			{
+				return m ? __builtin_clzl(m) - (sizeof(m) * 8 - width)
+					: size_t(width);
+			}
+		};
+#else
+		/**
+		 * @brief The control bytes of 8 consecutive slots, compared all at
+		 * once in a 64-bit word. Masks have the high bit of byte i set for
+		 * each matching slot i.
+		 *
+		 * match() may report a false positive right after a true one, which
+		 * the comparison of keys then rules out. The other masks are exact.
+		 */
+		struct	_swiss_group
+		{
+			enum { width = 8 };
+
+			unsigned long	ctrl;
+
+			explicit _swiss_group(signed char const* p) throw()
+			{
+				std::memcpy(&ctrl, p, sizeof(ctrl));
+# if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+				ctrl = __builtin_bswap64(ctrl);
+# endif
+			}
+
+			static unsigned long	lsbs() throw()
+			{ return 0x0101010101010101UL; }
+
+			static unsigned long	msbs() throw()
+			{ return 0x8080808080808080UL; }
+
+			/// The bytes that are c: those that are zero once xored with c.
+			unsigned long	match(signed char c) const throw()
+			{
+				unsigned long const	x = ctrl
+					^ (lsbs() * static_cast<unsigned char>(c));
+
+				return (x - lsbs()) & ~x & msbs();
+			}
+
+			/// The bytes whose high bit is set, and bit 1 clear.
+			unsigned long	match_empty() const throw()
+			{ return ctrl & ~(ctrl << 6) & msbs(); }
+
+			/// The bytes whose high bit is set, and bit 0 clear.
+			unsigned long	match_empty_or_deleted() const throw()
+			{ return ctrl & ~(ctrl << 7) & msbs(); }
+
+			size_t			count_leading_empty_or_deleted() const throw()
+			{
+				unsigned long const	m = ~match_empty_or_deleted() & msbs();
+
+				return m ? first(m) : size_t(width);
+			}
+
+			static size_t	first(unsigned long m) throw()
+			{ return __builtin_ctzl(m) >> 3; }
+
+			static size_t	after_last(unsigned long m) throw()
+			{ return m ? __builtin_clzl(m) >> 3 : size_t(width); }
+		};
+#endif
+
+		/**
+		 * @brief The control bytes of a table without slots: a sentinel, so
+		 * that iteration ends at once, and empty bytes, so that lookups do.
+		 */
+		template<typename Dummy>
+		struct	_swiss_empty
+		{ static signed char const	ctrl[_swiss_group::width]; };
+
+		template<typename Dummy>
+		signed char const	_swiss_empty<Dummy>::ctrl[_swiss_group::width] = {
+			_ctrl_sentinel, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+			_ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+#ifdef __SSE2__
+			_ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+			_ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty
+#endif
+		};
+	}
+
+	/**
+	 * @brief A _swiss_table::iterator, that walks the control bytes along
+	 * with the slots, a group at a time over empty ones.
+	 */
+	template<typename V, typename Ref, typename Ptr>
+	struct	_swiss_iterator
+	{
+		typedef	_swiss_iterator<V, V&, V*>	iterator;
+		typedef	_swiss_iterator				_self;
+
+		typedef	forward_iterator_tag	iterator_category;
+		typedef	V						value_type;
+		typedef	Ptr						pointer;
+		typedef	Ref						reference;
+		typedef	ptrdiff_t				difference_type;
+
+		signed char const*	ctrl;
+		V*					slot;
+
+		_swiss_iterator() throw()
+			:	ctrl(), slot() { }
+
+		_swiss_iterator(signed char const* c, V* s) throw()
+			:	ctrl(c), slot(s) { }
+
+		_swiss_iterator(iterator const& x) throw()
+			:	ctrl(x.ctrl), slot(x.slot) { }
+
+		reference	operator*() const throw()
+		{ return *slot; }
+
+		pointer		operator->() const throw()
+		{ return slot; }
+
+		_self&		operator++() throw()
+		{
+			++ctrl;
+			++slot;
+			skip();
+			return *this;
+		}
+
+		_self		operator++(int) throw()
+		{
+			_self	tmp = *this;
+			++*this;
+			return tmp;
+		}
+
+		/// Move on to the first full slot from here, or to the sentinel.
+		void		skip() throw()
+		{
+			while (*ctrl < detail::_ctrl_sentinel)
+			{
+				size_t const	n = detail::_swiss_group(ctrl)
+					.count_leading_empty_or_deleted();
+
+				ctrl += n;
+				slot += n;
+			}
+		}
+	};
+
+	template<typename V, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator==(_swiss_iterator<V, Rl, Pl> const& x,
+		_swiss_iterator<V, Rr, Pr> const& y) throw()
+	{ return x.ctrl == y.ctrl; }
+
+	template<typename V, typename Rl, typename Pl, typename Rr, typename Pr>
+	inline bool	operator!=(_swiss_iterator<V, Rl, Pl> const& x,
+		_swiss_iterator<V, Rr, Pr> const& y) throw()
+	{ return x.ctrl != y.ctrl; }
+
+	/**
+	 * @brief An open addressing hash table of unique keys, shared by
+	 * unordered_map and unordered_set, in the layout of Google's Swiss
+	 * tables.
+	 *
+	 * Elements are stored flat in an array of slots, alongside an array of
+	 * one control byte per slot that tells whether it is empty, deleted or
+	 * full, and holds 7 bits of a full slot's hash. A lookup starts at a
+	 * position given by the other bits of the hash, and compares the
+	 * control bytes of a whole group of slots with the 7 bits at once, so
+	 * that keys are only compared for likely matches, and it stops at the
+	 * first group with an empty slot. Groups are probed quadratically.
+	 *
+	 * The capacity is a power of two minus one, with a sentinel control
+	 * byte after the last slot, followed by a copy of the first group's
+	 * bytes so that groups can be loaded from any position. The table
+	 * grows when 7/8 of the slots are used.
+	 *
+	 * An erased slot becomes empty again when a group around it was never
+	 * full, as no probe can then have gone past it, and a tombstone
+	 * otherwise. Tombstones are reused by insertions, and cleared when
+	 * they fill half the table by rehashing the elements into new arrays
+	 * of the same capacity.
+	 *
+	 * Iterators are invalidated by insertions that rehash, and pointers to
+	 * elements as well. Erasures only invalidate the erased element.
+	 *
+	 * @tparam K			The key type.
+	 * @tparam V			The value type.
+	 * @tparam KeyOfValue	Extracts the key of a value.
+	 * @tparam Hash			The hash function.
+	 * @tparam Pred			The key equality.
+	 * @tparam A			The allocator type.
+	 */
+	template<typename K, typename V, typename KeyOfValue, typename Hash,
+		typename Pred, typename A>
+	class	_swiss_table
+	{
+	private:
+		typedef	detail::_swiss_group	group;
+		typedef	typename _alloc_traits<A>::template rebind<V>::other
+			V_alloc_type;
+		typedef	_alloc_traits<V_alloc_type>	V_alloc_traits;
+		typedef	typename _alloc_traits<A>::template rebind<signed char>
+			::other						ctrl_alloc_type;
+		typedef	_alloc_traits<ctrl_alloc_type>	ctrl_alloc_traits;
+
+		enum { min_capacity = group::width - 1 };
+
+		struct	_swiss_impl	:	public V_alloc_type
+		{
+			Hash			hash;
+			Pred			eq;
+			signed char*	ctrl;
+			V*				slots;
+			size_t			capacity;
+			size_t			size;
+			/// Number of empty slots that can be filled before growing.
+			size_t			growth_left;
+
+			_swiss_impl(Hash const& h, Pred const& e, V_alloc_type const& a)
+				:	V_alloc_type(a), hash(h), eq(e), ctrl(), slots(),
+					capacity(0), size(0), growth_left(0)
+			{ reset(); }
+
+			void	reset() throw()
+			{
+				ctrl = const_cast<signed char*>(
+					detail::_swiss_empty<void>::ctrl);
+				slots = 0;
+				capacity = 0;
+				size = 0;
+				growth_left = 0;
+			}
+		};
+
+		_swiss_impl	impl;
+
+		static size_t const	npos = size_t(-1);
+
+	public:
+		typedef	K									key_type;
+		typedef	V									value_type;
+		typedef	size_t								size_type;
+		typedef	ptrdiff_t							difference_type;
+		typedef	A									allocator_type;
+		typedef	_swiss_iterator<V, V&, V*>			iterator;
+		typedef	_swiss_iterator<V, V const&, V const*>	const_iterator;
+
+		_swiss_table(size_type n, Hash const& h, Pred const& eq,
+			allocator_type const& a)
+			:	impl(h, eq, V_alloc_type(a))
+		{ reserve(n); }
+
+		_swiss_table(_swiss_table const& x)
+			:	impl(x.impl.hash, x.impl.eq,
+					V_alloc_traits::select_on_copy(x.impl))
+		{
+			try
+			{
+				copy_from(x);
+			}
+			catch (...)
+			{
+				release();
+				throw;
+			}
+		}
+
+		~_swiss_table() throw()
+		{ release(); }
+
+		_swiss_table&	operator=(_swiss_table const& x)
+		{
+			if (this != &x)
+			{
+				_swiss_table	tmp(x);
+
+				swap(tmp);
+			}
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		Hash		hash_function() const
+		{ return impl.hash; }
+
+		Pred		key_eq() const
+		{ return impl.eq; }
+
+		iterator		begin() throw()
+		{
+			iterator	i(impl.ctrl, impl.slots);
+
+			i.skip();
+			return i;
+		}
+
+		const_iterator	begin() const throw()
+		{ return const_cast<_swiss_table*>(this)->begin(); }
+
+		iterator		end() throw()
+		{ return iterator(impl.ctrl + impl.capacity, 0); }
+
+		const_iterator	end() const throw()
+		{ return const_iterator(impl.ctrl + impl.capacity, 0); }
+
+		bool		empty() const throw()
+		{ return impl.size == 0; }
+
+		size_type	size() const throw()
+		{ return impl.size; }
+
+		size_type	max_size() const throw()
+		{ return V_alloc_traits::max_size(impl) / 2; }
+
+		/// The number of slots.
+		size_type	bucket_count() const throw()
+		{ return impl.capacity; }
+
+		float		load_factor() const throw()
+		{ return impl.capacity ? float(impl.size) / impl.capacity : 0; }
+
+		float		max_load_factor() const throw()
+		{ return 0.875f; }
+
+		/**
+		 * @brief Insert v unless an element with an equivalent key exists.
+		 *
+		 * @return pair<iterator, bool>	The element with v's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert_unique(value_type const& v)
+		{
+			key_type const&	k = KeyOfValue()(v);
+			size_t const	h = hash_of(k);
+			size_t const	i = find_index(k, h);
+
+			if (i != npos)
+				return pair<iterator, bool>(at(i), false);
+			return pair<iterator, bool>(insert_new(v, h), true);
+		}
+
+		template<typename I>
+		void		insert_unique(I first, I last)
+		{
+			for (; first != last; ++first)
+				insert_unique(*first);
+		}
+
+		void		erase(const_iterator pos) throw()
+		{
+			size_t const		i = size_t(pos.slot - impl.slots);
+			size_t const		before = (i - group::width) & impl.capacity;
+			unsigned long const	empty_after
+				= group(impl.ctrl + i).match_empty();
+			unsigned long const	empty_before
+				= group(impl.ctrl + before).match_empty();
+			// Fewer than a group of non-empty slots around i: no probe has
+			// found a full group there, nor gone on past i.
+			bool const			never_full = empty_before && empty_after
+				&& group::first(empty_after) + group::after_last(empty_before)
+				< size_t(group::width);
+
+			V_alloc_traits::destroy(impl, impl.slots + i);
+			set_ctrl(impl.ctrl, impl.capacity, i,
+				static_cast<signed char>(never_full ? detail::_ctrl_empty
+					: detail::_ctrl_deleted));
+			impl.growth_left += never_full;
+			--impl.size;
+		}
+
+		void		erase(const_iterator first, const_iterator last) throw()
+		{
+			while (first != last)
+				erase(first++);
+		}
+
+		/**
+		 * @brief Erase the element with a key equivalent to k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase_key(key_type const& k)
+		{
+			size_t const	i = find_index(k, hash_of(k));
+
+			if (i == npos)
+				return 0;
+			erase(at(i));
+			return 1;
+		}
+
+		/// Destroy the elements, keeping the slots.
+		void		clear() throw()
+		{
+			if (!impl.capacity)
+				return;
+			destroy_all();
+			reset_ctrl(impl.ctrl, impl.capacity);
+			impl.size = 0;
+			impl.growth_left = growth_limit(impl.capacity);
+		}
+
+		void		swap(_swiss_table& x) throw()
+		{
+			ft::swap(impl.hash, x.impl.hash);
+			ft::swap(impl.eq, x.impl.eq);
+			ft::swap(impl.ctrl, x.impl.ctrl);
+			ft::swap(impl.slots, x.impl.slots);
+			ft::swap(impl.capacity, x.impl.capacity);
+			ft::swap(impl.size, x.impl.size);
+			ft::swap(impl.growth_left, x.impl.growth_left);
+			V_alloc_traits::on_swap(impl, x.impl);
+		}
+
+		iterator		find(key_type const& k)
+		{
+			size_t const	i = find_index(k, hash_of(k));
+
+			return i == npos ? end() : at(i);
+		}
+
+		const_iterator	find(key_type const& k) const
+		{ return const_cast<_swiss_table*>(this)->find(k); }
+
+		/**
+		 * @brief Make room for n elements without growing, and clear the
+		 * tombstones.
+		 */
+		void		rehash(size_type n)
+		{
+			size_t const	cap = capacity_for(n > impl.size ? n : impl.size);
+
+			if (cap == 0)
+				release();
+			else
+				rehash_to(cap);
+		}
+
+		/// Make room for n elements without growing.
+		void		reserve(size_type n)
+		{
+			if (n > impl.size + impl.growth_left)
+				rehash_to(capacity_for(n));
+		}
+
+		friend bool	operator==(_swiss_table const& x, _swiss_table const& y)
+		{
+			if (x.size() != y.size())
+				return false;
+			for (const_iterator i = x.begin(); i != x.end(); ++i)
+			{
+				const_iterator const	j = y.find(KeyOfValue()(*i));
+
+				if (j == y.end() || !(*i == *j))
+					return false;
+			}
+			return true;
+		}
+
+	private:
+		static key_type const&	key_of(V const* slot)
+		{ return KeyOfValue()(*slot); }
+
+		iterator	at(size_t i) throw()
+		{ return iterator(impl.ctrl + i, impl.slots + i); }
+
+		/**
+		 * @brief Hash k, and mix the bits of the result by Fibonacci
+		 * hashing, so that both the high bits that pick the first group
+		 * and the low bits kept in the control bytes depend on all of them.
+		 */
+		size_t		hash_of(key_type const& k) const
+		{
+			size_t const	h = impl.hash(k) * size_t(0x9E3779B97F4A7C15UL);
+
+			return h ^ (h >> (sizeof(size_t) * 4));
+		}
+
+		static signed char	h2(size_t h) throw()
+		{ return static_cast<signed char>(h & 0x7f); }
+
+		/**
+		 * @brief Slots that can be filled before growing a table of cap
+		 * slots, always leaving one empty so that lookups end.
+		 */
+		static size_t	growth_limit(size_t cap) throw()
+		{ return cap < 8 ? cap - 1 : cap - cap / 8; }
+
+		/// The smallest capacity that holds n elements, 0 for none.
+		static size_t	capacity_for(size_t n) throw()
+		{
+			size_t	cap = min_capacity;
+
+			if (n == 0)
+				return 0;
+			while (growth_limit(cap) < n)
+				cap = cap * 2 + 1;
+			return cap;
+		}
+
+		/**
+		 * @brief Set the control byte of slot i, and its copy after the
+		 * sentinel if i is in the first group.
+		 */
+		static void	set_ctrl(signed char* ctrl, size_t cap, size_t i,
+			signed char c) throw()
+		{
+			ctrl[i] = c;
+			ctrl[((i - (group::width - 1)) & cap) + (group::width - 1)] = c;
+		}
+
+		static void	reset_ctrl(signed char* ctrl, size_t cap) throw()
+		{
+			std::memset(ctrl, detail::_ctrl_empty, cap + group::width);
+			ctrl[cap] = detail::_ctrl_sentinel;
+		}
+
+		/// Returns the slot of k, or npos.
+		size_t		find_index(key_type const& k, size_t h) const
+		{
+			size_t			pos = (h >> 7) & impl.capacity;
+			size_t			step = 0;
+			signed char const	c = h2(h);
+
+			for (;;)
+			{
+				group const	g(impl.ctrl + pos);
+
+				for (unsigned long m = g.match(c); m; m &= m - 1)
+				{
+					size_t const	i = (pos + group::first(m)) & impl.capacity;
+
+					if (impl.eq(key_of(impl.slots + i), k))
+						return i;
+				}
+				if (g.match_empty())
+					return npos;
+				step += group::width;
+				pos = (pos + step) & impl.capacity;
+			}
+		}
+
+		/**
+		 * @brief Returns the first empty or deleted slot on the probe
+		 * sequence of hash h. The table must have one.
+		 */
+		static size_t	find_slot(signed char const* ctrl, size_t cap,
+			size_t h) throw()
+		{
+			size_t	pos = (h >> 7) & cap;
+			size_t	step = 0;
+
+			for (;;)
+			{
+				unsigned long const	m
+					= group(ctrl + pos).match_empty_or_deleted();
+
+				if (m)
+					return (pos + group::first(m)) & cap;
+				step += group::width;
+				pos = (pos + step) & cap;
+			}
+		}
+
+		/// Insert v, whose key is not in the table and hashes to h.
+		iterator	insert_new(value_type const& v, size_t h)
+		{
+			size_t	i = find_slot(impl.ctrl, impl.capacity, h);
+
+			if (impl.growth_left == 0
+				&& impl.ctrl[i] != detail::_ctrl_deleted)
+			{
+				grow();
+				i = find_slot(impl.ctrl, impl.capacity, h);
+			}
+			V_alloc_traits::construct(impl, impl.slots + i, v);
+			impl.growth_left -= impl.ctrl[i] == detail::_ctrl_empty;
+			set_ctrl(impl.ctrl, impl.capacity, i, h2(h));
+			++impl.size;
+			return at(i);
+		}
+
+		/**
+		 * @brief Make room for an element, doubling the capacity, or only
+		 * clearing the tombstones, by rehashing at the same capacity, if
+		 * they take up half the table.
+		 */
+		void		grow()
+		{
+			if (impl.capacity && impl.size * 2 <= growth_limit(impl.capacity))
+				rehash_to(impl.capacity);
+			else
+				rehash_to(impl.capacity ? impl.capacity * 2 + 1
+					: size_t(min_capacity));
+		}
+
+		/**
+		 * @brief Move the elements to new arrays of cap slots, leaving the
+		 * table unchanged if hashing or copying an element throws.
+		 */
+		void		rehash_to(size_t cap)
+		{
+			ctrl_alloc_type		ctrl_alloc(impl);
+			signed char* const	ctrl = ctrl_alloc_traits::allocate(ctrl_alloc,
+				cap + group::width);
+			V*					slots;
+
+			try
+			{
+				slots = V_alloc_traits::allocate(impl, cap);
+			}
+			catch (...)
+			{
+				ctrl_alloc_traits::deallocate(ctrl_alloc, ctrl,
+					cap + group::width);
+				throw;
+			}
+			reset_ctrl(ctrl, cap);
+			try
+			{
+				for (size_t i = 0; i < impl.capacity; ++i)
+				{
+					if (impl.ctrl[i] < 0)
+						continue;
+
+					size_t const	h = hash_of(key_of(impl.slots + i));
+					size_t const	j = find_slot(ctrl, cap, h);
+
+					V_alloc_traits::construct(impl, slots + j, impl.slots[i]);
+					set_ctrl(ctrl, cap, j, h2(h));
+				}
+			}
+			catch (...)
+			{
+				destroy_all(ctrl, slots, cap);
+				V_alloc_traits::deallocate(impl, slots, cap);
+				ctrl_alloc_traits::deallocate(ctrl_alloc, ctrl,
+					cap + group::width);
+				throw;
+			}
+
+			size_t const	n = impl.size;
+
+			release();
+			impl.ctrl = ctrl;
+			impl.slots = slots;
+			impl.capacity = cap;
+			impl.size = n;
+			impl.growth_left = growth_limit(cap) - n;
+		}
+
+		/// Copy the elements of x into this empty table.
+		void		copy_from(_swiss_table const& x)
+		{
+			if (x.empty())
+				return;
+			rehash_to(capacity_for(x.size()));
+			for (const_iterator i = x.begin(); i != x.end(); ++i)
+				insert_new(*i, hash_of(key_of(&*i)));
+		}
+
+		void		destroy_all(signed char const* ctrl, V* slots, size_t cap)
+			throw()
+		{
+			for (size_t i = 0; i < cap; ++i)
+				if (ctrl[i] >= 0)
+					V_alloc_traits::destroy(impl, slots + i);
+		}
+
+		void		destroy_all() throw()
+		{ destroy_all(impl.ctrl, impl.slots, impl.capacity); }
+
+		/// Destroy the elements and free the arrays.
+		void		release() throw()
+		{
+			if (!impl.capacity)
+				return;
+			destroy_all();
+
+			ctrl_alloc_type	ctrl_alloc(impl);
+
+			ctrl_alloc_traits::deallocate(ctrl_alloc, impl.ctrl,
+				impl.capacity + group::width);
+			V_alloc_traits::deallocate(impl, impl.slots, impl.capacity);
+			impl.reset();
+		}
+	};
+
+	template<typename K, typename V, typename KoV, typename H, typename P,
+		typename A>
+	size_t const	_swiss_table<K, V, KoV, H, P, A>::npos;
+}
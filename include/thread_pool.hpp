@@ -0,0 +1,480 @@
+#pragma once
+
+#include <cstddef>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm.hpp>
+#include <atomic.hpp>
+#include <exception.hpp>
+#include <queue.hpp>
+#include <vector.hpp>
+#include <ws_deque.hpp>
+
+namespace ft
+{
+	class ThreadCreationException	:	public exception
+	{ char const*	what() throw() { return "Could not create a thread!"; } };
+
+	/**
+	 * @brief A unit of work run by a thread_pool, that deletes itself once
+	 * it is done.
+	 */
+	class	_pool_task
+	{
+	public:
+		virtual			~_pool_task() { }
+		virtual void	execute() = 0;
+	};
+
+	class	thread_pool;
+
+	/// The worker the calling thread runs, if any.
+	struct	_pool_worker
+	{
+		thread_pool*			pool;
+		ws_deque<_pool_task*>	tasks;
+		pthread_t				thread;
+		unsigned long			seed;
+
+		_pool_worker()	:	pool(), tasks(256), thread(), seed(0) { }
+	};
+
+	inline _pool_worker*&	_current_worker() throw()
+	{
+		static __thread _pool_worker*	worker = 0;
+
+		return worker;
+	}
+
+	/**
+	 * @brief A fixed set of worker threads that balance tasks by stealing
+	 * them from each other.
+	 *
+	 * Each worker pushes the tasks it spawns on its own ws_deque and runs
+	 * them newest first, which keeps fork-join work local to a cache,
+	 * while idle workers steal the oldest and usually largest tasks of the
+	 * others. Tasks submitted from other threads go through a shared
+	 * mpmc_queue. Workers that find nothing to do sleep on an event_count.
+	 */
+	class	thread_pool
+	{
+	private:
+		/// Number of empty searches before an idle worker sleeps.
+		enum { _idle_spins = 64 };
+
+		vector<_pool_worker*>	workers;
+		mpmc_queue<_pool_task*>	injected;
+		event_count				idle;
+		atomic<int>				stopping;
+
+		thread_pool(thread_pool const&);
+		thread_pool&	operator=(thread_pool const&);
+
+	public:
+		/**
+		 * @brief Start n workers, or one per online processor if n is 0.
+		 *
+		 * @throw ThreadCreationException if a worker cannot be started.
+		 */
+		explicit thread_pool(size_t n = 0)	:	injected(4096), stopping(0)
+		{
+			if (n == 0)
+				n = hardware_concurrency();
+			workers.reserve(n);
+			for (size_t i = 0; i < n; ++i)
+				workers.push_back(new _pool_worker());
+			for (size_t i = 0; i < n; ++i)
+			{
+				workers[i]->pool = this;
+				workers[i]->seed = i + 1;
+				if (pthread_create(&workers[i]->thread, 0, worker_main,
+					workers[i]) == 0)
+					continue;
+				stop(i);
+				throw ThreadCreationException();
+			}
+		}
+
+		/**
+		 * @brief Stop the workers once they are idle. Tasks that are still
+		 * queued are not run.
+		 */
+		~thread_pool()
+		{ stop(workers.size()); }
+
+		/**
+		 * @brief Returns the number of online processors, at least 1.
+		 */
+		static size_t	hardware_concurrency() throw()
+		{
+			long const	n = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+			return n > 0 ? size_t(n) : 1;
+		}
+
+		size_t	size() const throw()
+		{ return workers.size(); }
+
+		/**
+		 * @brief Queue a task, on the calling worker's own deque if it is
+		 * one of ours.
+		 */
+		void	submit(_pool_task* t)
+		{
+			_pool_worker* const	self = _current_worker();
+
+			if (self && self->pool == this)
+				self->tasks.push(t);
+			else
+				injected.push(t);
+			idle.notify_one();
+		}
+
+		/**
+		 * @brief Run one queued task on the calling thread, if there is
+		 * one, so that a thread waiting on tasks can help with them.
+		 *
+		 * @return bool	false if no task could be found.
+		 */
+		bool	run_one()
+		{
+			_pool_worker* const	self = _current_worker();
+			_pool_task*			t;
+
+			if (!find_task(self && self->pool == this ? self : 0, t))
+				return false;
+			t->execute();
+			return true;
+		}
+
+	private:
+		static void*	worker_main(void* arg)
+		{
+			_pool_worker* const	self = static_cast<_pool_worker*>(arg);
+
+			_current_worker() = self;
+			self->pool->work(self);
+			return 0;
+		}
+
+		void	work(_pool_worker* self)
+		{
+			_pool_task*	t;
+			unsigned	spins = 0;
+
+			while (!stopping.load(memory_order_acquire))
+			{
+				if (find_task(self, t))
+				{
+					t->execute();
+					spins = 0;
+					continue;
+				}
+				if (++spins < _idle_spins)
+				{
+					::sched_yield();
+					continue;
+				}
+
+				int const	key = idle.prepare_wait();
+
+				if (find_task(self, t))
+				{
+					idle.cancel_wait();
+					t->execute();
+				}
+				else if (stopping.load(memory_order_acquire))
+					idle.cancel_wait();
+				else
+					idle.wait(key);
+				spins = 0;
+			}
+		}
+
+		/**
+		 * @brief Look for a task in self's deque, in the shared queue, and
+		 * then in the other workers' deques, starting from a random one.
+		 */
+		bool	find_task(_pool_worker* self, _pool_task*& t)
+		{
+			if (self && self->tasks.pop(t))
+				return true;
+			if (injected.try_pop(t))
+				return true;
+
+			size_t const	n = workers.size();
+			size_t const	first = self ? next_random(self->seed) % n : 0;
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				_pool_worker* const	victim = workers[(first + i) % n];
+
+				if (victim != self && victim->tasks.steal(t))
+					return true;
+			}
+			return false;
+		}
+
+		static unsigned long	next_random(unsigned long& seed) throw()
+		{
+			seed ^= seed << 13;
+			seed ^= seed >> 7;
+			seed ^= seed << 17;
+			return seed;
+		}
+
+		/// Stop and join the n first workers, and free them all.
+		void	stop(size_t n) throw()
+		{
+			stopping.store(1, memory_order_release);
+			idle.notify_all();
+			for (size_t i = 0; i < n; ++i)
+				pthread_join(workers[i]->thread, 0);
+			for (size_t i = 0; i < workers.size(); ++i)
+				delete workers[i];
+			workers.clear();
+		}
+	};
+
+	/**
+	 * @brief Runs functions on a thread_pool, and waits for all of them to
+	 * complete.
+	 *
+	 * The functions may themselves run more functions in the same group,
+	 * which is how the parallel algorithms fork. They must not throw.
+	 */
+	class	task_group
+	{
+	private:
+		template<typename F>
+		class	_group_task	:	public _pool_task
+		{
+		private:
+			task_group&	group;
+			F			f;
+
+		public:
+			_group_task(task_group& g, F const& fn)	:	group(g), f(fn) { }
+
+			void	execute()
+			{
+				task_group&	g = group;
+
+				f();
+				delete this;
+				g.pending.fetch_sub(1, memory_order_release);
+			}
+		};
+
+		thread_pool&	pool;
+		atomic<size_t>	pending;
+
+		task_group(task_group const&);
+		task_group&	operator=(task_group const&);
+
+	public:
+		explicit task_group(thread_pool& p)	:	pool(p), pending(0) { }
+
+		~task_group()
+		{ wait(); }
+
+		/**
+		 * @brief Run a copy of f on the pool.
+		 */
+		template<typename F>
+		void	run(F const& f)
+		{
+			_pool_task*	t;
+
+			pending.fetch_add(1, memory_order_relaxed);
+			try
+			{
+				t = new _group_task<F>(*this, f);
+			}
+			catch (...)
+			{
+				pending.fetch_sub(1, memory_order_relaxed);
+				throw;
+			}
+			pool.submit(t);
+		}
+
+		/**
+		 * @brief Run queued tasks until every function of the group has
+		 * completed.
+		 */
+		void	wait()
+		{
+			while (pending.load(memory_order_acquire) != 0)
+				if (!pool.run_one())
+					::sched_yield();
+		}
+	};
+
+	namespace detail
+	{
+		/**
+		 * @brief Returns a chunk size that splits n elements into about 8
+		 * chunks per worker, so that stealing can even out uneven chunks.
+		 */
+		inline ptrdiff_t	_parallel_grain(thread_pool& pool, ptrdiff_t n,
+			ptrdiff_t minimum)
+		{
+			ptrdiff_t const	grain = n / ptrdiff_t(8 * pool.size());
+
+			return grain > minimum ? grain : minimum;
+		}
+
+		/**
+		 * @brief Splits a range in halves, running the upper ones in the
+		 * group, until it is at most grain long, and applies body to what
+		 * remains.
+		 */
+		template<typename R, typename Body>
+		struct	_parallel_split
+		{
+			task_group*	group;
+			R			first;
+			R			last;
+			ptrdiff_t	grain;
+			Body		body;
+
+			_parallel_split(task_group* g, R f, R l, ptrdiff_t n, Body b)
+				:	group(g), first(f), last(l), grain(n), body(b) { }
+
+			void	operator()()
+			{
+				while (last - first > grain)
+				{
+					R const	mid = first + (last - first) / 2;
+
+					group->run(_parallel_split(group, mid, last, grain, body));
+					last = mid;
+				}
+				body(first, last);
+			}
+		};
+
+		template<typename F>
+		struct	_for_each_body
+		{
+			F	f;
+
+			explicit _for_each_body(F fn)	:	f(fn) { }
+
+			template<typename R>
+			void	operator()(R first, R last)
+			{ ft::for_each(first, last, f); }
+		};
+
+		template<typename T>
+		struct	_fill_body
+		{
+			T const*	value;
+
+			explicit _fill_body(T const& x)	:	value(&x) { }
+
+			template<typename R>
+			void	operator()(R first, R last)
+			{ ft::fill(first, last, *value); }
+		};
+
+		/**
+		 * @brief Partitions a range, running the upper parts in the group,
+		 * until it is at most grain long or too many partitions were bad,
+		 * and sorts what remains.
+		 */
+		template<typename R, typename Compare>
+		struct	_parallel_sort_task
+		{
+			task_group*	group;
+			R			first;
+			R			last;
+			ptrdiff_t	grain;
+			ptrdiff_t	depth;
+			Compare		cmp;
+
+			_parallel_sort_task(task_group* g, R f, R l, ptrdiff_t n,
+				ptrdiff_t d, Compare c)
+				:	group(g), first(f), last(l), grain(n), depth(d), cmp(c) { }
+
+			void	operator()()
+			{
+				while (last - first > grain && depth > 0)
+				{
+					R const	cut = _partition_pivot(first, last, cmp);
+
+					--depth;
+					group->run(_parallel_sort_task(group, cut, last, grain,
+						depth, cmp));
+					last = cut;
+				}
+				ft::sort(first, last, cmp);
+			}
+		};
+
+		template<typename R, typename Body>
+		void	_parallel_apply(thread_pool& pool, R first, R last, Body body)
+		{
+			task_group	group(pool);
+
+			_parallel_split<R, Body>(&group, first, last,
+				_parallel_grain(pool, last - first, 1), body)();
+			group.wait();
+		}
+	}
+
+	/**
+	 * @brief Apply a function to every element of a random access range,
+	 * using the workers of pool and the calling thread.
+	 *
+	 * f is copied for each chunk, and must be safe to call concurrently on
+	 * distinct elements.
+	 */
+	template<typename R, typename F>
+	void	parallel_for_each(thread_pool& pool, R first, R last, F f)
+	{
+		detail::_parallel_apply(pool, first, last,
+			detail::_for_each_body<F>(f));
+	}
+
+	/**
+	 * @brief Assign value to every element of a random access range, using
+	 * the workers of pool and the calling thread.
+	 */
+	template<typename R, typename T>
+	void	parallel_fill(thread_pool& pool, R first, R last, T const& value)
+	{
+		detail::_parallel_apply(pool, first, last,
+			detail::_fill_body<T>(value));
+	}
+
+	/**
+	 * @brief Sort a random access range using the workers of pool and the
+	 * calling thread. The sort is not stable.
+	 *
+	 * The top levels of quicksort run as tasks, and each part that is
+	 * small enough is sorted with ft::sort.
+	 */
+	template<typename R, typename Compare>
+	void	parallel_sort(thread_pool& pool, R first, R last, Compare cmp)
+	{
+		ptrdiff_t const	n = last - first;
+		task_group		group(pool);
+
+		detail::_parallel_sort_task<R, Compare>(&group, first, last,
+			detail::_parallel_grain(pool, n, 4096), 2 * detail::_lg(n),
+			cmp)();
+		group.wait();
+	}
+
+	template<typename R>
+	void	parallel_sort(thread_pool& pool, R first, R last)
+	{
+		ft::parallel_sort(pool, first, last,
+			less<typename iterator_traits<R>::value_type>());
+	}
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <cstddef>
+
+#include <list.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A timeout that can be armed on a timer_wheel, meant to be
+	 * embedded in or derived from by the object it times out.
+	 *
+	 * A timer is linked into one bucket of its wheel while it is armed, and
+	 * links to itself otherwise.
+	 */
+	class	timer	:	private detail::_list_node_base
+	{
+		template<unsigned Bits, unsigned Levels>
+		friend class	timer_wheel;
+
+	private:
+		unsigned long	expiry;
+
+		timer(timer const&);
+		timer&	operator=(timer const&);
+
+		void	reset() throw()
+		{ next = prev = this; }
+
+	public:
+		timer() throw()	:	expiry(0)
+		{ reset(); }
+
+		/**
+		 * @brief A timer must be cancelled before it is destroyed.
+		 */
+		~timer() throw() { }
+
+		/**
+		 * @brief Returns true if the timer is waiting to expire.
+		 */
+		bool			armed() const throw()
+		{ return next != this; }
+
+		/**
+		 * @brief Returns the tick the timer expires or last expired at.
+		 */
+		unsigned long	expires() const throw()
+		{ return expiry; }
+	};
+
+	/**
+	 * @brief A hierarchical timing wheel, that arms, re-arms and cancels
+	 * timers in O(1) and expires them in O(1) per tick plus O(1) per timer.
+	 *
+	 * Level k has 2^Bits buckets that each hold the timers of a span of
+	 * 2^(Bits * k) ticks. When the level below wraps around, the bucket of
+	 * the current span is spliced out whole and its timers are spread over
+	 * the lower levels, so that every timer is moved at most Levels - 1
+	 * times. Timers further away than the wheel's range wait in its top
+	 * level, and are cascaded until they come in range.
+	 *
+	 * @tparam Bits		The base-2 logarithm of the number of buckets per
+	 * level.
+	 * @tparam Levels	The number of levels.
+	 */
+	template<unsigned Bits = 8, unsigned Levels = 4>
+	class	timer_wheel
+	{
+	private:
+		typedef	detail::_list_node_base	bucket_type;
+
+		enum { _slots = 1u << Bits, _mask = _slots - 1 };
+
+		bucket_type		buckets[Levels][_slots];
+		/// The next tick to process.
+		unsigned long	current;
+		size_t			count;
+
+		timer_wheel(timer_wheel const&);
+		timer_wheel&	operator=(timer_wheel const&);
+
+	public:
+		/**
+		 * @brief Construct an empty wheel, whose next tick is now.
+		 */
+		explicit timer_wheel(unsigned long now = 0) throw()
+			:	current(now), count(0)
+		{
+			for (unsigned level = 0; level < Levels; ++level)
+				for (unsigned slot = 0; slot < _slots; ++slot)
+					buckets[level][slot].next = buckets[level][slot].prev
+						= &buckets[level][slot];
+		}
+
+		/**
+		 * @brief Disarm the remaining timers.
+		 */
+		~timer_wheel() throw()
+		{
+			for (unsigned level = 0; level < Levels; ++level)
+				for (unsigned slot = 0; slot < _slots; ++slot)
+					while (buckets[level][slot].next != &buckets[level][slot])
+						disarm(*static_cast<timer*>(buckets[level][slot].next));
+		}
+
+		/**
+		 * @brief Returns the number of armed timers.
+		 */
+		size_t			size() const throw()
+		{ return count; }
+
+		bool			empty() const throw()
+		{ return count == 0; }
+
+		/**
+		 * @brief Returns the next tick that advance() will process.
+		 */
+		unsigned long	now() const throw()
+		{ return current; }
+
+		/**
+		 * @brief Arm t to expire at tick expiry, or re-arm it if it is
+		 * already armed. A tick that is already processed expires on the
+		 * next one.
+		 */
+		void	schedule(timer& t, unsigned long expiry) throw()
+		{
+			if (t.armed())
+				t.unhook();
+			else
+				++count;
+			t.expiry = expiry;
+			t.hook(bucket_for(expiry));
+		}
+
+		/**
+		 * @brief Disarm t, if it is armed.
+		 */
+		void	cancel(timer& t) throw()
+		{
+			if (t.armed())
+				disarm(t);
+		}
+
+		/**
+		 * @brief Process every tick up to and including now, calling f on
+		 * each timer that expires, after it is disarmed.
+		 *
+		 * f may schedule or cancel any timer, including the one it is given.
+		 * If f throws, the timers of its tick that did not expire yet are
+		 * moved on to the next tick, so that the next call expires them.
+		 *
+		 * @return size_t	The number of timers that expired.
+		 */
+		template<typename F>
+		size_t	advance(unsigned long now, F f)
+		{
+			size_t	expired = 0;
+
+			while (long(now - current) >= 0)
+			{
+				unsigned long const	slot = current & _mask;
+
+				if (slot == 0)
+					cascade(1);
+
+				bucket_type	due;
+
+				due.next = due.prev = &due;
+				splice(due, buckets[0][slot]);
+				// The tick is processed before f runs, so that a timer f
+				// re-arms for it lands on the next tick, not a lap later.
+				++current;
+				try
+				{
+					while (due.next != &due)
+					{
+						timer&	t = *static_cast<timer*>(due.next);
+
+						disarm(t);
+						++expired;
+						f(t);
+					}
+				}
+				catch (...)
+				{
+					splice(buckets[0][current & _mask], due);
+					throw;
+				}
+			}
+			return expired;
+		}
+
+	private:
+		static unsigned	shift(unsigned level) throw()
+		{ return Bits * level; }
+
+		void	disarm(timer& t) throw()
+		{
+			t.unhook();
+			t.reset();
+			--count;
+		}
+
+		/**
+		 * @brief Returns the bucket of the lowest level whose range
+		 * includes expiry, clamping far timers to the end of the top level.
+		 */
+		bucket_type*	bucket_for(unsigned long expiry) throw()
+		{
+			if (long(expiry - current) < 0)
+				expiry = current;
+
+			unsigned long const	delta = expiry - current;
+
+			for (unsigned level = 0; level + 1 < Levels; ++level)
+				if (delta >> shift(level + 1) == 0)
+					return &buckets[level][(expiry >> shift(level)) & _mask];
+
+			unsigned long const	top_range = shift(Levels) < 8 * sizeof(long)
+				? (1UL << shift(Levels)) - 1 : ~0UL;
+
+			if (delta > top_range)
+				expiry = current + top_range;
+			return &buckets[Levels - 1][(expiry >> shift(Levels - 1)) & _mask];
+		}
+
+		/// Move all the timers of from to the end of to, in O(1).
+		static void		splice(bucket_type& to, bucket_type& from) throw()
+		{
+			if (from.next != &from)
+				to.transfer(from.next, &from);
+		}
+
+		/**
+		 * @brief Spread the bucket of the current span of a level over the
+		 * levels below, after cascading the level above if this one wrapped
+		 * around.
+		 */
+		void	cascade(unsigned level) throw()
+		{
+			if (level >= Levels)
+				return;
+
+			unsigned long const	slot = (current >> shift(level)) & _mask;
+
+			if (slot == 0)
+				cascade(level + 1);
+
+			bucket_type	moving;
+
+			moving.next = moving.prev = &moving;
+			splice(moving, buckets[level][slot]);
+			while (moving.next != &moving)
+			{
+				timer&	t = *static_cast<timer*>(moving.next);
+
+				t.unhook();
+				t.hook(bucket_for(t.expiry));
+			}
+		}
+	};
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+namespace ft
+{
+	/**
+	 * @brief Wraps a compile-time constant of type T.
+	 */
+	template<typename T, T v>
+	struct	integral_constant
+	{
+		static const T	value = v;
+
+		typedef T						value_type;
+		typedef integral_constant<T, v>	type;
+	};
+
+	template<typename T, T v>
+	const T	integral_constant<T, v>::value;
+
+	typedef integral_constant<bool, true>	true_type;
+	typedef integral_constant<bool, false>	false_type;
+
+	/**
+	 * @brief Defines the member type `type` only if B is true.
+	 */
+	template<bool B, typename T = void>
+	struct	enable_if { };
+
+	template<typename T>
+	struct	enable_if<true, T> { typedef T	type; };
+
+	template<typename A, typename B>
+	struct	is_same	:	public false_type { };
+
+	template<typename T>
+	struct	is_same<T, T>	:	public true_type { };
+
+	template<typename T>
+	struct	remove_const { typedef T	type; };
+
+	template<typename T>
+	struct	remove_const<T const> { typedef T	type; };
+
+	/**
+	 * @brief Tells whether T is one of the built-in integer types.
+	 *
+	 * Used to tell `container(n, value)` apart from `container(first, last)`
+	 * when both arguments have the same integral type.
+	 */
+	template<typename T>
+	struct	is_integer	:	public false_type { };
+
+	template<typename T>
+	struct	is_integer<T const>	:	public is_integer<T> { };
+
+	template<> struct	is_integer<bool>			:	public true_type { };
+	template<> struct	is_integer<char>			:	public true_type { };
+	template<> struct	is_integer<signed char>		:	public true_type { };
+	template<> struct	is_integer<unsigned char>	:	public true_type { };
+	template<> struct	is_integer<wchar_t>			:	public true_type { };
+	template<> struct	is_integer<short>			:	public true_type { };
+	template<> struct	is_integer<unsigned short>	:	public true_type { };
+	template<> struct	is_integer<int>				:	public true_type { };
+	template<> struct	is_integer<unsigned int>	:	public true_type { };
+	template<> struct	is_integer<long>			:	public true_type { };
+	template<> struct	is_integer<unsigned long>	:	public true_type { };
+
+	/**
+	 * @brief Tells whether T can be copied with memcpy and needs no
+	 * destructor call, so that its storage can be moved around as raw bytes.
+	 */
+	template<typename T>
+	struct	is_trivially_copyable
+		:	public integral_constant<bool, __is_trivially_copyable(T)> { };
+
+	/**
+	 * @brief Tells whether Derived is Base or publicly derives from it.
+	 */
+	template<typename Base, typename Derived>
+	struct	is_base_of
+	{
+	private:
+		typedef char	yes;
+		typedef struct { char c[2]; }	no;
+
+		static yes	test(Base const volatile*);
+		static no	test(...);
+
+	public:
+		enum { value = sizeof(test(static_cast<Derived*>(0))) == sizeof(yes) };
+	};
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <exception.hpp>
+#include <functional.hpp>
+#include <memory.hpp>
+#include <swiss_table.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief An unordered associative container of unique keys, each
+	 * mapped to a value, in an open addressing Swiss table.
+	 *
+	 * Elements are stored flat in the table rather than in nodes, and a
+	 * lookup reads a group of control bytes and then, most of the time,
+	 * only the element it is after. Iterators and pointers to elements are
+	 * invalidated by insertions that grow the table, but not by erasures
+	 * of other elements.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam T		The mapped type.
+	 * @tparam Hash		The hash function. Its bits are mixed by the table.
+	 * @tparam Pred		The key equality.
+	 * @tparam A		The allocator type.
+	 */
+	template<typename K, typename T, typename Hash = hash<K>,
+		typename Pred = equal_to<K>, typename A = allocator<pair<K const, T> > >
+	class	unordered_map
+	{
+	public:
+		typedef	K					key_type;
+		typedef	T					mapped_type;
+		typedef	pair<K const, T>	value_type;
+		typedef	Hash				hasher;
+		typedef	Pred				key_equal;
+		typedef	A					allocator_type;
+
+	private:
+		typedef	_swiss_table<key_type, value_type, _select1st<value_type>,
+			hasher, key_equal, allocator_type>	table_type;
+
+		table_type	table;
+
+	public:
+		typedef	typename A::pointer					pointer;
+		typedef	typename A::const_pointer			const_pointer;
+		typedef	typename A::reference				reference;
+		typedef	typename A::const_reference			const_reference;
+		typedef	typename table_type::iterator		iterator;
+		typedef	typename table_type::const_iterator	const_iterator;
+		typedef	typename table_type::size_type		size_type;
+		typedef	typename table_type::difference_type	difference_type;
+
+		/**
+		 * @brief Construct an empty map, with room for n elements.
+		 */
+		explicit unordered_map(size_type n = 0, hasher const& h = hasher(),
+			key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	table(n, h, eq, a) { }
+
+		template<typename I>
+		unordered_map(I first, I last, size_type n = 0,
+			hasher const& h = hasher(), key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	table(n, h, eq, a)
+		{ table.insert_unique(first, last); }
+
+		unordered_map(unordered_map const& x)	:	table(x.table) { }
+
+		unordered_map&	operator=(unordered_map const& x)
+		{
+			table = x.table;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return table.get_allocator(); }
+
+		iterator		begin() throw()
+		{ return table.begin(); }
+
+		const_iterator	begin() const throw()
+		{ return table.begin(); }
+
+		iterator		end() throw()
+		{ return table.end(); }
+
+		const_iterator	end() const throw()
+		{ return table.end(); }
+
+		bool		empty() const throw()
+		{ return table.empty(); }
+
+		size_type	size() const throw()
+		{ return table.size(); }
+
+		size_type	max_size() const throw()
+		{ return table.max_size(); }
+
+		/**
+		 * @brief Returns the value mapped to k, inserting a default one if
+		 * k is not in the map.
+		 */
+		mapped_type&	operator[](key_type const& k)
+		{
+			iterator	i = find(k);
+
+			if (i == end())
+				i = table.insert_unique(value_type(k, mapped_type())).first;
+			return i->second;
+		}
+
+		/**
+		 * @brief Returns the value mapped to k.
+		 *
+		 * @throw OutOfRangeException if k is not in the map.
+		 */
+		mapped_type&		at(key_type const& k)
+		{
+			iterator const	i = find(k);
+
+			if (i == end())
+				throw OutOfRangeException();
+			return i->second;
+		}
+
+		mapped_type const&	at(key_type const& k) const
+		{
+			const_iterator const	i = find(k);
+
+			if (i == end())
+				throw OutOfRangeException();
+			return i->second;
+		}
+
+		/**
+		 * @brief Insert x unless its key is already in the map.
+		 *
+		 * @return pair<iterator, bool>	The element with x's key, and
+		 * whether it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{ return table.insert_unique(x); }
+
+		/**
+		 * @brief Insert x unless its key is already in the map. The hint is
+		 * not used.
+		 */
+		iterator				insert(const_iterator, value_type const& x)
+		{ return table.insert_unique(x).first; }
+
+		template<typename I>
+		void					insert(I first, I last)
+		{ table.insert_unique(first, last); }
+
+		void		erase(const_iterator pos) throw()
+		{ table.erase(pos); }
+
+		/**
+		 * @brief Erase the element with key k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{ return table.erase_key(k); }
+
+		void		erase(const_iterator first, const_iterator last) throw()
+		{ table.erase(first, last); }
+
+		void		swap(unordered_map& x) throw()
+		{ table.swap(x.table); }
+
+		/// Erase every element, keeping the table's capacity.
+		void		clear() throw()
+		{ table.clear(); }
+
+		hasher		hash_function() const
+		{ return table.hash_function(); }
+
+		key_equal	key_eq() const
+		{ return table.key_eq(); }
+
+		iterator		find(key_type const& k)
+		{ return table.find(k); }
+
+		const_iterator	find(key_type const& k) const
+		{ return table.find(k); }
+
+		size_type		count(key_type const& k) const
+		{ return table.find(k) == table.end() ? 0 : 1; }
+
+		pair<iterator, iterator>				equal_range(
+			key_type const& k)
+		{
+			iterator	i = find(k);
+
+			return pair<iterator, iterator>(i, i == end() ? i : ++iterator(i));
+		}
+
+		pair<const_iterator, const_iterator>	equal_range(
+			key_type const& k) const
+		{
+			const_iterator	i = find(k);
+
+			return pair<const_iterator, const_iterator>(i,
+				i == end() ? i : ++const_iterator(i));
+		}
+
+		/// The number of slots in the table.
+		size_type	bucket_count() const throw()
+		{ return table.bucket_count(); }
+
+		float		load_factor() const throw()
+		{ return table.load_factor(); }
+
+		/// The load factor past which the table grows, fixed at 7/8.
+		float		max_load_factor() const throw()
+		{ return table.max_load_factor(); }
+
+		/**
+		 * @brief Rebuild the table with room for at least n elements,
+		 * which also clears the slots left by erasures.
+		 */
+		void		rehash(size_type n)
+		{ table.rehash(n); }
+
+		/// Make room for n elements, so that inserting them does not rehash.
+		void		reserve(size_type n)
+		{ table.reserve(n); }
+
+		friend bool	operator==(unordered_map const& x, unordered_map const& y)
+		{ return x.table == y.table; }
+	};
+
+	template<typename K, typename T, typename H, typename P, typename A>
+	inline bool	operator!=(unordered_map<K, T, H, P, A> const& x,
+		unordered_map<K, T, H, P, A> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename T, typename H, typename P, typename A>
+	inline void	swap(unordered_map<K, T, H, P, A>& x,
+		unordered_map<K, T, H, P, A>& y) throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <functional.hpp>
+#include <memory.hpp>
+#include <swiss_table.hpp>
+#include <utility.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief An unordered associative container of unique keys, in an
+	 * open addressing Swiss table.
+	 *
+	 * Iterators and pointers to elements are invalidated by insertions
+	 * that grow the table, but not by erasures of other elements.
+	 *
+	 * @tparam K		The key type.
+	 * @tparam Hash		The hash function. Its bits are mixed by the table.
+	 * @tparam Pred		The key equality.
+	 * @tparam A		The allocator type.
+	 */
+	template<typename K, typename Hash = hash<K>, typename Pred = equal_to<K>,
+		typename A = allocator<K> >
+	class	unordered_set
+	{
+	public:
+		typedef	K		key_type;
+		typedef	K		value_type;
+		typedef	Hash	hasher;
+		typedef	Pred	key_equal;
+		typedef	A		allocator_type;
+
+	private:
+		typedef	_swiss_table<key_type, value_type, _identity<value_type>,
+			hasher, key_equal, allocator_type>	table_type;
+
+		table_type	table;
+
+	public:
+		typedef	typename A::pointer					pointer;
+		typedef	typename A::const_pointer			const_pointer;
+		typedef	typename A::reference				reference;
+		typedef	typename A::const_reference			const_reference;
+		typedef	typename table_type::const_iterator	iterator;
+		typedef	typename table_type::const_iterator	const_iterator;
+		typedef	typename table_type::size_type		size_type;
+		typedef	typename table_type::difference_type	difference_type;
+
+		/**
+		 * @brief Construct an empty set, with room for n elements.
+		 */
+		explicit unordered_set(size_type n = 0, hasher const& h = hasher(),
+			key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	table(n, h, eq, a) { }
+
+		template<typename I>
+		unordered_set(I first, I last, size_type n = 0,
+			hasher const& h = hasher(), key_equal const& eq = key_equal(),
+			allocator_type const& a = allocator_type())
+			:	table(n, h, eq, a)
+		{ table.insert_unique(first, last); }
+
+		unordered_set(unordered_set const& x)	:	table(x.table) { }
+
+		unordered_set&	operator=(unordered_set const& x)
+		{
+			table = x.table;
+			return *this;
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return table.get_allocator(); }
+
+		iterator	begin() const throw()
+		{ return table.begin(); }
+
+		iterator	end() const throw()
+		{ return table.end(); }
+
+		bool		empty() const throw()
+		{ return table.empty(); }
+
+		size_type	size() const throw()
+		{ return table.size(); }
+
+		size_type	max_size() const throw()
+		{ return table.max_size(); }
+
+		/**
+		 * @brief Insert x unless an equal key is already in the set.
+		 *
+		 * @return pair<iterator, bool>	The element equal to x, and whether
+		 * it was inserted.
+		 */
+		pair<iterator, bool>	insert(value_type const& x)
+		{
+			pair<typename table_type::iterator, bool> const	p
+				= table.insert_unique(x);
+
+			return pair<iterator, bool>(p.first, p.second);
+		}
+
+		/**
+		 * @brief Insert x unless an equal key is already in the set. The
+		 * hint is not used.
+		 */
+		iterator				insert(iterator, value_type const& x)
+		{ return table.insert_unique(x).first; }
+
+		template<typename I>
+		void					insert(I first, I last)
+		{ table.insert_unique(first, last); }
+
+		void		erase(iterator pos) throw()
+		{ table.erase(pos); }
+
+		/**
+		 * @brief Erase the key equal to k, if any.
+		 *
+		 * @return size_type	The number of elements erased, 0 or 1.
+		 */
+		size_type	erase(key_type const& k)
+		{ return table.erase_key(k); }
+
+		void		erase(iterator first, iterator last) throw()
+		{ table.erase(first, last); }
+
+		void		swap(unordered_set& x) throw()
+		{ table.swap(x.table); }
+
+		/// Erase every key, keeping the table's capacity.
+		void		clear() throw()
+		{ table.clear(); }
+
+		hasher		hash_function() const
+		{ return table.hash_function(); }
+
+		key_equal	key_eq() const
+		{ return table.key_eq(); }
+
+		iterator	find(key_type const& k) const
+		{ return table.find(k); }
+
+		size_type	count(key_type const& k) const
+		{ return table.find(k) == table.end() ? 0 : 1; }
+
+		pair<iterator, iterator>	equal_range(key_type const& k) const
+		{
+			iterator	i = find(k);
+
+			return pair<iterator, iterator>(i, i == end() ? i : ++iterator(i));
+		}
+
+		/// The number of slots in the table.
+		size_type	bucket_count() const throw()
+		{ return table.bucket_count(); }
+
+		float		load_factor() const throw()
+		{ return table.load_factor(); }
+
+		/// The load factor past which the table grows, fixed at 7/8.
+		float		max_load_factor() const throw()
+		{ return table.max_load_factor(); }
+
+		/**
+		 * @brief Rebuild the table with room for at least n keys, which
+		 * also clears the slots left by erasures.
+		 */
+		void		rehash(size_type n)
+		{ table.rehash(n); }
+
+		/// Make room for n keys, so that inserting them does not rehash.
+		void		reserve(size_type n)
+		{ table.reserve(n); }
+
+		friend bool	operator==(unordered_set const& x, unordered_set const& y)
+		{ return x.table == y.table; }
+	};
+
+	template<typename K, typename H, typename P, typename A>
+	inline bool	operator!=(unordered_set<K, H, P, A> const& x,
+		unordered_set<K, H, P, A> const& y)
+	{ return !(x == y); }
+
+	template<typename K, typename H, typename P, typename A>
+	inline void	swap(unordered_set<K, H, P, A>& x, unordered_set<K, H, P, A>& y)
+		throw()
+	{ x.swap(y); }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+namespace ft
+{
+	/**
+	 * @brief Holds two values of possibly different types.
+	 *
+	 * @tparam T1	The type of first.
+	 * @tparam T2	The type of second.
+	 */
+	template<typename T1, typename T2>
+	struct	pair
+	{
+		typedef	T1	first_type;
+		typedef	T2	second_type;
+
+		T1	first;
+		T2	second;
+
+		pair()	:	first(), second() { }
+
+		pair(T1 const& a, T2 const& b)	:	first(a), second(b) { }
+
+		template<typename U1, typename U2>
+		pair(pair<U1, U2> const& p)	:	first(p.first), second(p.second) { }
+	};
+
+	/**
+	 * @brief Returns a pair of x and y, deducing its type.
+	 */
+	template<typename T1, typename T2>
+	inline pair<T1, T2>	make_pair(T1 x, T2 y)
+	{ return pair<T1, T2>(x, y); }
+
+	template<typename T1, typename T2>
+	inline bool	operator==(pair<T1, T2> const& x, pair<T1, T2> const& y)
+	{ return x.first == y.first && x.second == y.second; }
+
+	/**
+	 * @brief Compares first, and then second if the firsts are equivalent.
+	 */
+	template<typename T1, typename T2>
+	inline bool	operator<(pair<T1, T2> const& x, pair<T1, T2> const& y)
+	{
+		return x.first < y.first
+			|| (!(y.first < x.first) && x.second < y.second);
+	}
+
+	template<typename T1, typename T2>
+	inline bool	operator!=(pair<T1, T2> const& x, pair<T1, T2> const& y)
+	{ return !(x == y); }
+
+	template<typename T1, typename T2>
+	inline bool	operator>(pair<T1, T2> const& x, pair<T1, T2> const& y)
+	{ return y < x; }
+
+	template<typename T1, typename T2>
+	inline bool	operator<=(pair<T1, T2> const& x, pair<T1, T2> const& y)
+	{ return !(y < x); }
+
+	template<typename T1, typename T2>
+	inline bool	operator>=(pair<T1, T2> const& x, pair<T1, T2> const& y)
+	{ return !(x < y); }
+}
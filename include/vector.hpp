@@ -0,0 +1,1816 @@
+#pragma once
+
+#include <climits>
+
+#include <algorithm.hpp>
+#include <exception.hpp>
+#include <iterator.hpp>
+#include <memory.hpp>
+#include <type_traits.hpp>
+
+namespace ft
+{
+	template<typename T, typename A>
+	class	_vector_base
+	{
+	protected:
+		typedef	typename _alloc_traits<A>::template rebind<T>::other
+			T_alloc_type;
+		typedef	_alloc_traits<T_alloc_type>		T_alloc_traits;
+		typedef	typename T_alloc_traits::pointer	pointer;
+
+		struct	_vector_impl	:	public T_alloc_type
+		{
+			pointer	start;
+			pointer	finish;
+			pointer	end_of_storage;
+
+			_vector_impl()
+				:	T_alloc_type(), start(), finish(), end_of_storage() { }
+
+			_vector_impl(T_alloc_type const& a)
+				:	T_alloc_type(a), start(), finish(), end_of_storage() { }
+
+			void	swap_data(_vector_impl& x) throw()
+			{
+				ft::swap(start, x.start);
+				ft::swap(finish, x.finish);
+				ft::swap(end_of_storage, x.end_of_storage);
+			}
+		};
+
+		_vector_impl	impl;
+
+		pointer	allocate(size_t n)
+		{ return n != 0 ? T_alloc_traits::allocate(impl, n) : pointer(); }
+
+		void	deallocate(pointer p, size_t n)
+		{
+			if (p)
+				T_alloc_traits::deallocate(impl, p, n);
+		}
+
+		void	create_storage(size_t n)
+		{
+			impl.start = allocate(n);
+			impl.finish = impl.start;
+			impl.end_of_storage = impl.start + n;
+		}
+
+	public:
+		typedef	A	allocator_type;
+
+		T_alloc_type&		get_T_allocator() throw()
+		{ return impl; }
+
+		T_alloc_type const&	get_T_allocator() const throw()
+		{ return impl; }
+
+		allocator_type		get_allocator() const throw()
+		{ return allocator_type(get_T_allocator()); }
+
+		_vector_base() { }
+
+		_vector_base(allocator_type const& a)	:	impl(a) { }
+
+		_vector_base(size_t n, allocator_type const& a)	:	impl(a)
+		{ create_storage(n); }
+
+		~_vector_base() throw()
+		{ deallocate(impl.start, impl.end_of_storage - impl.start); }
+	};
+
+	/**
+	 * @brief A sequence of elements stored contiguously, with amortized
+	 * constant time insertion at the end.
+	 *
+	 * @tparam T	The element type.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename A = allocator<T> >
+	class	vector	:	protected _vector_base<T, A>
+	{
+	private:
+		typedef	_vector_base<T, A>				base;
+		typedef	typename base::T_alloc_type		T_alloc_type;
+		typedef	typename base::T_alloc_traits	T_alloc_traits;
+
+	public:
+		typedef T											value_type;
+		typedef typename T_alloc_traits::pointer			pointer;
+		typedef typename T_alloc_traits::const_pointer		const_pointer;
+		typedef typename T_alloc_traits::reference			reference;
+		typedef typename T_alloc_traits::const_reference	const_reference;
+
+		typedef _normal_iterator<pointer, vector>		iterator;
+		typedef _normal_iterator<const_pointer, vector>	const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		typedef size_t					size_type;
+		typedef ptrdiff_t				difference_type;
+		typedef A						allocator_type;
+
+	protected:
+		using	base::impl;
+		using	base::allocate;
+		using	base::deallocate;
+		using	base::get_T_allocator;
+
+	public:
+		vector() { }
+
+		explicit vector(allocator_type const& a)	:	base(a) { }
+
+		explicit vector(size_type n, value_type const& value = value_type(),
+			allocator_type const& a = allocator_type())
+			:	base(check_init_len(n), a)
+		{ fill_initialize(n, value); }
+
+		vector(vector const& x)
+			:	base(x.size(),
+				T_alloc_traits::select_on_copy(x.get_T_allocator()))
+		{
+			impl.finish = _uninitialized_copy_a(x.begin(), x.end(),
+				impl.start, get_T_allocator());
+		}
+
+		template<typename I>
+		vector(I first, I last, allocator_type const& a = allocator_type())
+			:	base(a)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			initialize_dispatch(first, last, Integral());
+		}
+
+		~vector() throw()
+		{ ft::destroy(impl.start, impl.finish, get_T_allocator()); }
+
+		vector&	operator=(vector const& x)
+		{
+			if (&x != this)
+				assign(x.begin(), x.end());
+			return *this;
+		}
+
+		/**
+		 * @brief Replace the contents with n copies of val.
+		 */
+		void	assign(size_type n, value_type const& val)
+		{ fill_assign(n, val); }
+
+		/**
+		 * @brief Replace the contents with a copy of the range [first, last).
+		 */
+		template<typename I>
+		void	assign(I first, I last)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			assign_dispatch(first, last, Integral());
+		}
+
+		using	base::get_allocator;
+
+		iterator				begin() throw()
+		{ return iterator(impl.start); }
+
+		const_iterator			begin() const throw()
+		{ return const_iterator(impl.start); }
+
+		iterator				end() throw()
+		{ return iterator(impl.finish); }
+
+		const_iterator			end() const throw()
+		{ return const_iterator(impl.finish); }
+
+		reverse_iterator		rbegin() throw()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
+		/**
+		 * @brief Returns the number of elements in the vector.
+		 */
+		size_type	size() const throw()
+		{ return size_type(impl.finish - impl.start); }
+
+		/**
+		 * @brief Returns the size of the largest possible vector.
+		 */
+		size_type	max_size() const throw()
+		{ return T_alloc_traits::max_size(get_T_allocator()); }
+
+		/**
+		 * @brief Resizes the vector to the specified number of elements.
+		 *
+		 * Longer vectors are truncated, otherwise it is extended with copies
+		 * of the given value.
+		 *
+		 * @param new_size	The new number of elements
+		 * @param x			The new elements value
+		 */
+		void	resize(size_type new_size, value_type x = value_type())
+		{
+			if (new_size > size())
+				fill_insert(end(), new_size - size(), x);
+			else if (new_size < size())
+				erase_at_end(impl.start + new_size);
+		}
+
+		/**
+		 * @brief Returns the number of elements that fit in the allocated
+		 * storage.
+		 */
+		size_type	capacity() const throw()
+		{ return size_type(impl.end_of_storage - impl.start); }
+
+		/**
+		 * @brief Returns true if the vector is empty.
+		 */
+		bool	empty() const throw()
+		{ return impl.start == impl.finish; }
+
+		/**
+		 * @brief Make sure that at least n elements fit without
+		 * reallocating.
+		 *
+		 * @param n	The number of elements.
+		 */
+		void	reserve(size_type n)
+		{
+			if (n > max_size())
+				throw LengthErrorException();
+			if (capacity() < n && !reallocate_storage(n))
+			{
+				size_type const	old_size = size();
+				pointer			tmp = allocate_and_copy(n, impl.start,
+					impl.finish);
+
+				ft::destroy(impl.start, impl.finish, get_T_allocator());
+				deallocate(impl.start, capacity());
+				impl.start = tmp;
+				impl.finish = tmp + old_size;
+				impl.end_of_storage = tmp + n;
+			}
+		}
+
+		reference		operator[](size_type n) throw()
+		{ return impl.start[n]; }
+
+		const_reference	operator[](size_type n) const throw()
+		{ return impl.start[n]; }
+
+		/**
+		 * @brief Returns a reference to the element at index n.
+		 *
+		 * @throw OutOfRangeException if n is not less than size().
+		 */
+		reference		at(size_type n)
+		{ range_check(n); return (*this)[n]; }
+
+		const_reference	at(size_type n) const
+		{ range_check(n); return (*this)[n]; }
+
+		reference		front() throw()
+		{ return *begin(); }
+
+		const_reference	front() const throw()
+		{ return *begin(); }
+
+		reference		back() throw()
+		{ return *(end() - 1); }
+
+		const_reference	back() const throw()
+		{ return *(end() - 1); }
+
+		pointer			data() throw()
+		{ return impl.start; }
+
+		const_pointer	data() const throw()
+		{ return impl.start; }
+
+		/**
+		 * @brief Add data to the end of the vector.
+		 *
+		 * @param x The data to be added.
+		 */
+		void	push_back(value_type const& x)
+		{
+			if (impl.finish != impl.end_of_storage)
+			{
+				get_T_allocator().construct(impl.finish, x);
+				++impl.finish;
+			}
+			else
+				fill_insert(end(), 1, x);
+		}
+
+		/**
+		 * @brief Removes the vector's last element.
+		 */
+		void	pop_back() throw()
+		{
+			--impl.finish;
+			get_T_allocator().destroy(impl.finish);
+		}
+
+		/**
+		 * @brief Insert given value before the specified iterator.
+		 *
+		 * @param position	The next element's iterator.
+		 * @param x			The data to be added.
+		 * @return			The new element's iterator.
+		 */
+		iterator	insert(iterator position, value_type const& x)
+		{
+			difference_type const	n = position - begin();
+
+			if (impl.finish != impl.end_of_storage && position == end())
+				push_back(x);
+			else
+				fill_insert(position, 1, x);
+			return begin() + n;
+		}
+
+		/**
+		 * @brief Insert given value before the specified iterator multiple
+		 * times.
+		 *
+		 * @param position	The next element's iterator.
+		 * @param n			The number of elements to add.
+		 * @param x			The data to be added.
+		 */
+		void	insert(iterator position, size_type n, value_type const& x)
+		{ fill_insert(position, n, x); }
+
+		/**
+		 * @brief Inserts a range into the vector.
+		 *
+		 * @param position	The next element's iterator.
+		 * @param first		An input iterator.
+		 * @param last		An input iterator.
+		 */
+		template<typename I>
+		void	insert(iterator position, I first, I last)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			insert_dispatch(position, first, last, Integral());
+		}
+
+		iterator	erase(iterator position)
+		{
+			if (position + 1 != end())
+				ft::copy(position + 1, end(), position);
+			--impl.finish;
+			get_T_allocator().destroy(impl.finish);
+			return position;
+		}
+
+		iterator	erase(iterator first, iterator last)
+		{
+			if (first != last)
+			{
+				if (last != end())
+					ft::copy(last, end(), first);
+				erase_at_end(first.base() + (end() - last));
+			}
+			return first;
+		}
+
+		/**
+		 * @brief Swaps data with another vector.
+		 *
+		 * @param x	A vector of the same element and allocator types.
+		 */
+		void	swap(vector& x) throw()
+		{
+			impl.swap_data(x.impl);
+			T_alloc_traits::on_swap(get_T_allocator(), x.get_T_allocator());
+		}
+
+		/**
+		 * @brief Erases all the elements.
+		 */
+		void	clear() throw()
+		{ erase_at_end(impl.start); }
+
+	protected:
+		size_type	check_init_len(size_type n)
+		{
+			if (n > max_size())
+				throw LengthErrorException();
+			return n;
+		}
+
+		/**
+		 * @brief Returns the new capacity to use when inserting n elements
+		 * into a full vector, doubling the current size.
+		 */
+		size_type	check_len(size_type n) const
+		{
+			if (max_size() - size() < n)
+				throw LengthErrorException();
+
+			size_type const	len = size() + ft::max(size(), n);
+
+			return (len < size() || len > max_size()) ? max_size() : len;
+		}
+
+		void	range_check(size_type n) const
+		{
+			if (n >= size())
+				throw OutOfRangeException();
+		}
+
+		template<typename I>
+		pointer	allocate_and_copy(size_type n, I first, I last)
+		{
+			pointer	result = allocate(n);
+
+			try
+			{
+				_uninitialized_copy_a(first, last, result, get_T_allocator());
+			}
+			catch (...)
+			{
+				deallocate(result, n);
+				throw;
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Resize the storage to len elements without copying them,
+		 * if the allocator supports reallocate() and T is trivially
+		 * copyable.
+		 *
+		 * @return bool	true if the storage was resized.
+		 */
+		bool	reallocate_storage(size_type len)
+		{
+			if (!is_trivially_copyable<T>::value || !impl.start)
+				return false;
+
+			size_type const	old_size = size();
+			pointer const	p = T_alloc_traits::reallocate(get_T_allocator(),
+				impl.start, capacity(), len);
+
+			if (!p)
+				return false;
+			impl.start = p;
+			impl.finish = p + old_size;
+			impl.end_of_storage = p + len;
+			return true;
+		}
+
+		void	erase_at_end(pointer pos) throw()
+		{
+			ft::destroy(pos, impl.finish, get_T_allocator());
+			impl.finish = pos;
+		}
+
+		void	fill_initialize(size_type n, value_type const& value)
+		{
+			impl.finish = _uninitialized_fill_n_a(impl.start, n, value,
+				get_T_allocator());
+		}
+
+		template<typename Integer>
+		void	initialize_dispatch(Integer n, Integer value, true_type)
+		{
+			base::create_storage(check_init_len(static_cast<size_type>(n)));
+			fill_initialize(static_cast<size_type>(n), value);
+		}
+
+		template<typename I>
+		void	initialize_dispatch(I first, I last, false_type)
+		{
+			range_initialize(first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		template<typename I>
+		void	range_initialize(I first, I last, input_iterator_tag)
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		template<typename F>
+		void	range_initialize(F first, F last, forward_iterator_tag)
+		{
+			size_type const	n = check_init_len(ft::distance(first, last));
+
+			base::create_storage(n);
+			impl.finish = _uninitialized_copy_a(first, last, impl.start,
+				get_T_allocator());
+		}
+
+		void	fill_assign(size_type n, value_type const& val)
+		{
+			if (n > capacity())
+			{
+				vector	tmp(n, val, get_allocator());
+				tmp.swap(*this);
+			}
+			else if (n > size())
+			{
+				ft::fill(begin(), end(), val);
+				impl.finish = _uninitialized_fill_n_a(impl.finish, n - size(),
+					val, get_T_allocator());
+			}
+			else
+				erase_at_end(ft::fill_n(impl.start, n, val));
+		}
+
+		template<typename Integer>
+		void	assign_dispatch(Integer n, Integer val, true_type)
+		{ fill_assign(static_cast<size_type>(n), val); }
+
+		template<typename I>
+		void	assign_dispatch(I first, I last, false_type)
+		{
+			assign_aux(first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		template<typename I>
+		void	assign_aux(I first, I last, input_iterator_tag)
+		{
+			pointer	cur = impl.start;
+
+			for (; first != last && cur != impl.finish; ++cur, ++first)
+				*cur = *first;
+			if (first == last)
+				erase_at_end(cur);
+			else
+				range_insert(end(), first, last, input_iterator_tag());
+		}
+
+		template<typename F>
+		void	assign_aux(F first, F last, forward_iterator_tag)
+		{
+			size_type const	len = ft::distance(first, last);
+
+			if (len > capacity())
+			{
+				pointer	tmp = allocate_and_copy(check_init_len(len), first,
+					last);
+
+				ft::destroy(impl.start, impl.finish, get_T_allocator());
+				deallocate(impl.start, capacity());
+				impl.start = tmp;
+				impl.finish = impl.end_of_storage = tmp + len;
+			}
+			else if (size() >= len)
+				erase_at_end(ft::copy(first, last, impl.start));
+			else
+			{
+				F	mid = first;
+
+				ft::advance(mid, size());
+				ft::copy(first, mid, impl.start);
+				impl.finish = _uninitialized_copy_a(mid, last, impl.finish,
+					get_T_allocator());
+			}
+		}
+
+		template<typename Integer>
+		void	insert_dispatch(iterator pos, Integer n, Integer val, true_type)
+		{ fill_insert(pos, static_cast<size_type>(n), val); }
+
+		template<typename I>
+		void	insert_dispatch(iterator pos, I first, I last, false_type)
+		{
+			range_insert(pos, first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		template<typename I>
+		void	range_insert(iterator pos, I first, I last, input_iterator_tag)
+		{
+			if (pos == end())
+			{
+				for (; first != last; ++first)
+					push_back(*first);
+			}
+			else if (first != last)
+			{
+				vector	tmp(first, last, get_allocator());
+
+				range_insert(pos, tmp.begin(), tmp.end(),
+					forward_iterator_tag());
+			}
+		}
+
+		template<typename F>
+		void	range_insert(iterator position, F first, F last,
+			forward_iterator_tag)
+		{
+			if (first == last)
+				return;
+
+			size_type const	n = ft::distance(first, last);
+			pointer const	pos = position.base();
+
+			if (size_type(impl.end_of_storage - impl.finish) >= n)
+			{
+				size_type const	elems_after = impl.finish - pos;
+				pointer const	old_finish = impl.finish;
+
+				if (elems_after > n)
+				{
+					_uninitialized_copy_a(impl.finish - n, impl.finish,
+						impl.finish, get_T_allocator());
+					impl.finish += n;
+					ft::copy_backward(pos, old_finish - n, old_finish);
+					ft::copy(first, last, pos);
+				}
+				else
+				{
+					F	mid = first;
+
+					ft::advance(mid, elems_after);
+					_uninitialized_copy_a(mid, last, impl.finish,
+						get_T_allocator());
+					impl.finish += n - elems_after;
+					_uninitialized_copy_a(pos, old_finish, impl.finish,
+						get_T_allocator());
+					impl.finish += elems_after;
+					ft::copy(first, mid, pos);
+				}
+			}
+			else
+			{
+				size_type const	len = check_len(n);
+
+				if (pos == impl.finish && reallocate_storage(len))
+				{
+					impl.finish = _uninitialized_copy_a(first, last,
+						impl.finish, get_T_allocator());
+					return;
+				}
+
+				pointer			new_start = allocate(len);
+				pointer			new_finish = new_start;
+
+				try
+				{
+					new_finish = _uninitialized_copy_a(impl.start, pos,
+						new_start, get_T_allocator());
+					new_finish = _uninitialized_copy_a(first, last,
+						new_finish, get_T_allocator());
+					new_finish = _uninitialized_copy_a(pos, impl.finish,
+						new_finish, get_T_allocator());
+				}
+				catch (...)
+				{
+					ft::destroy(new_start, new_finish, get_T_allocator());
+					deallocate(new_start, len);
+					throw;
+				}
+				replace_storage(new_start, new_finish, len);
+			}
+		}
+
+		void	fill_insert(iterator position, size_type n, value_type const& x)
+		{
+			if (n == 0)
+				return;
+
+			pointer const	pos = position.base();
+
+			if (size_type(impl.end_of_storage - impl.finish) >= n)
+			{
+				value_type const	x_copy = x;
+				size_type const		elems_after = impl.finish - pos;
+				pointer const		old_finish = impl.finish;
+
+				if (elems_after > n)
+				{
+					_uninitialized_copy_a(impl.finish - n, impl.finish,
+						impl.finish, get_T_allocator());
+					impl.finish += n;
+					ft::copy_backward(pos, old_finish - n, old_finish);
+					ft::fill(pos, pos + n, x_copy);
+				}
+				else
+				{
+					impl.finish = _uninitialized_fill_n_a(impl.finish,
+						n - elems_after, x_copy, get_T_allocator());
+					_uninitialized_copy_a(pos, old_finish, impl.finish,
+						get_T_allocator());
+					impl.finish += elems_after;
+					ft::fill(pos, old_finish, x_copy);
+				}
+			}
+			else
+			{
+				size_type const	len = check_len(n);
+
+				if (pos == impl.finish && is_trivially_copyable<T>::value)
+				{
+					value_type const	x_copy = x;
+
+					if (reallocate_storage(len))
+					{
+						impl.finish = _uninitialized_fill_n_a(impl.finish, n,
+							x_copy, get_T_allocator());
+						return;
+					}
+				}
+
+				size_type const	elems_before = pos - impl.start;
+				pointer			new_start = allocate(len);
+				pointer			new_finish = pointer();
+
+				try
+				{
+					_uninitialized_fill_n_a(new_start + elems_before, n, x,
+						get_T_allocator());
+					new_finish = _uninitialized_copy_a(impl.start, pos,
+						new_start, get_T_allocator());
+					new_finish += n;
+					new_finish = _uninitialized_copy_a(pos, impl.finish,
+						new_finish, get_T_allocator());
+				}
+				catch (...)
+				{
+					if (!new_finish)
+						ft::destroy(new_start + elems_before,
+							new_start + elems_before + n, get_T_allocator());
+					else
+						ft::destroy(new_start, new_finish, get_T_allocator());
+					deallocate(new_start, len);
+					throw;
+				}
+				replace_storage(new_start, new_finish, len);
+			}
+		}
+
+		/**
+		 * @brief Release the current storage and adopt the given one.
+		 */
+		void	replace_storage(pointer new_start, pointer new_finish,
+			size_type len) throw()
+		{
+			ft::destroy(impl.start, impl.finish, get_T_allocator());
+			deallocate(impl.start, capacity());
+			impl.start = new_start;
+			impl.finish = new_finish;
+			impl.end_of_storage = new_start + len;
+		}
+	};
+
+	template<typename T, typename A>
+	inline bool	operator==(vector<T, A> const& x, vector<T, A> const& y)
+	{ return x.size() == y.size() && ft::equal(x.begin(), x.end(), y.begin()); }
+
+	template<typename T, typename A>
+	inline bool	operator!=(vector<T, A> const& x, vector<T, A> const& y)
+	{ return !(x == y); }
+
+	template<typename T, typename A>
+	inline bool	operator<(vector<T, A> const& x, vector<T, A> const& y)
+	{
+		return ft::lexicographical_compare(x.begin(), x.end(),
+			y.begin(), y.end());
+	}
+
+	template<typename T, typename A>
+	inline bool	operator>(vector<T, A> const& x, vector<T, A> const& y)
+	{ return y < x; }
+
+	template<typename T, typename A>
+	inline bool	operator<=(vector<T, A> const& x, vector<T, A> const& y)
+	{ return !(y < x); }
+
+	template<typename T, typename A>
+	inline bool	operator>=(vector<T, A> const& x, vector<T, A> const& y)
+	{ return !(x < y); }
+
+	template<typename T, typename A>
+	inline void	swap(vector<T, A>& x, vector<T, A>& y) throw()
+	{ x.swap(y); }
+
+	/// The storage unit of vector<bool>: one machine word of bits.
+	typedef unsigned long	_bit_word;
+
+	enum { _word_bit = int(CHAR_BIT * sizeof(_bit_word)) };
+
+	namespace detail
+	{
+		inline unsigned	_bit_popcount(_bit_word w) throw()
+		{ return __builtin_popcountl(w); }
+
+		/// Index of the lowest set bit, w must not be 0.
+		inline unsigned	_bit_ctz(_bit_word w) throw()
+		{ return __builtin_ctzl(w); }
+
+		/// Mask of the bits at and above offset.
+		inline _bit_word	_bit_mask_from(unsigned offset) throw()
+		{ return ~_bit_word(0) << offset; }
+
+		/// Mask of the bits below offset.
+		inline _bit_word	_bit_mask_to(unsigned offset) throw()
+		{ return offset ? ~_bit_word(0) >> (_word_bit - offset) : 0; }
+	}
+
+	/**
+	 * @brief A proxy reference to a single bit of a vector<bool>.
+	 */
+	struct	_bit_reference
+	{
+		_bit_word*	p;
+		_bit_word	mask;
+
+		_bit_reference(_bit_word* x, _bit_word y) throw()
+			:	p(x), mask(y) { }
+
+		_bit_reference() throw()
+			:	p(0), mask(0) { }
+
+		operator bool() const throw()
+		{ return (*p & mask) != 0; }
+
+		_bit_reference&	operator=(bool x) throw()
+		{
+			if (x)
+				*p |= mask;
+			else
+				*p &= ~mask;
+			return *this;
+		}
+
+		_bit_reference&	operator=(_bit_reference const& x) throw()
+		{ return *this = bool(x); }
+
+		bool	operator==(_bit_reference const& x) const throw()
+		{ return bool(*this) == bool(x); }
+
+		bool	operator<(_bit_reference const& x) const throw()
+		{ return !bool(*this) && bool(x); }
+
+		void	flip() throw()
+		{ *p ^= mask; }
+	};
+
+	inline void	swap(_bit_reference x, _bit_reference y) throw()
+	{
+		bool	tmp = x;
+		x = y;
+		y = tmp;
+	}
+
+	inline void	swap(_bit_reference x, bool& y) throw()
+	{
+		bool	tmp = x;
+		x = y;
+		y = tmp;
+	}
+
+	inline void	swap(bool& x, _bit_reference y) throw()
+	{
+		bool	tmp = x;
+		x = y;
+		y = tmp;
+	}
+
+	/**
+	 * @brief The position of a bit within a word array, shared by the
+	 * vector<bool> iterators.
+	 */
+	struct	_bit_iterator_base
+		:	public iterator<random_access_iterator_tag, bool>
+	{
+		_bit_word*	p;
+		unsigned	offset;
+
+		_bit_iterator_base(_bit_word* x, unsigned y) throw()
+			:	p(x), offset(y) { }
+
+		void	bump_up() throw()
+		{
+			if (offset++ == unsigned(_word_bit) - 1)
+			{
+				offset = 0;
+				++p;
+			}
+		}
+
+		void	bump_down() throw()
+		{
+			if (offset-- == 0)
+			{
+				offset = unsigned(_word_bit) - 1;
+				--p;
+			}
+		}
+
+		void	incr(ptrdiff_t i) throw()
+		{
+			difference_type	n = i + offset;
+
+			p += n / int(_word_bit);
+			n = n % int(_word_bit);
+			if (n < 0)
+			{
+				n += int(_word_bit);
+				--p;
+			}
+			offset = static_cast<unsigned>(n);
+		}
+
+		friend bool	operator==(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{ return x.p == y.p && x.offset == y.offset; }
+
+		friend bool	operator!=(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{ return !(x == y); }
+
+		friend bool	operator<(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{ return x.p < y.p || (x.p == y.p && x.offset < y.offset); }
+
+		friend bool	operator>(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{ return y < x; }
+
+		friend bool	operator<=(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{ return !(y < x); }
+
+		friend bool	operator>=(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{ return !(x < y); }
+
+		friend ptrdiff_t	operator-(_bit_iterator_base const& x,
+			_bit_iterator_base const& y) throw()
+		{
+			return ptrdiff_t(_word_bit) * (x.p - y.p)
+				+ ptrdiff_t(x.offset) - ptrdiff_t(y.offset);
+		}
+	};
+
+	/**
+	 * @brief A vector<bool>::iterator.
+	 */
+	struct	_bit_iterator	:	public _bit_iterator_base
+	{
+		typedef	_bit_reference	reference;
+		typedef	_bit_reference*	pointer;
+		typedef	_bit_iterator	iterator;
+
+		_bit_iterator() throw()
+			:	_bit_iterator_base(0, 0) { }
+
+		_bit_iterator(_bit_word* x, unsigned y) throw()
+			:	_bit_iterator_base(x, y) { }
+
+		reference	operator*() const throw()
+		{ return reference(p, _bit_word(1) << offset); }
+
+		iterator&	operator++() throw()
+		{ bump_up(); return *this; }
+
+		iterator	operator++(int) throw()
+		{ iterator	tmp = *this; bump_up(); return tmp; }
+
+		iterator&	operator--() throw()
+		{ bump_down(); return *this; }
+
+		iterator	operator--(int) throw()
+		{ iterator	tmp = *this; bump_down(); return tmp; }
+
+		iterator&	operator+=(difference_type i) throw()
+		{ incr(i); return *this; }
+
+		iterator&	operator-=(difference_type i) throw()
+		{ incr(-i); return *this; }
+
+		iterator	operator+(difference_type i) const throw()
+		{ iterator	tmp = *this; return tmp += i; }
+
+		iterator	operator-(difference_type i) const throw()
+		{ iterator	tmp = *this; return tmp -= i; }
+
+		reference	operator[](difference_type i) const throw()
+		{ return *(*this + i); }
+	};
+
+	inline _bit_iterator	operator+(ptrdiff_t n, _bit_iterator const& x)
+		throw()
+	{ return x + n; }
+
+	/**
+	 * @brief A vector<bool>::const_iterator.
+	 */
+	struct	_bit_const_iterator	:	public _bit_iterator_base
+	{
+		typedef	bool				reference;
+		typedef	bool				const_reference;
+		typedef	bool const*			pointer;
+		typedef	_bit_const_iterator	const_iterator;
+
+		_bit_const_iterator() throw()
+			:	_bit_iterator_base(0, 0) { }
+
+		_bit_const_iterator(_bit_word* x, unsigned y) throw()
+			:	_bit_iterator_base(x, y) { }
+
+		_bit_const_iterator(_bit_iterator const& x) throw()
+			:	_bit_iterator_base(x.p, x.offset) { }
+
+		_bit_iterator	_const_cast() const throw()
+		{ return _bit_iterator(p, offset); }
+
+		const_reference	operator*() const throw()
+		{ return (*p & (_bit_word(1) << offset)) != 0; }
+
+		const_iterator&	operator++() throw()
+		{ bump_up(); return *this; }
+
+		const_iterator	operator++(int) throw()
+		{ const_iterator	tmp = *this; bump_up(); return tmp; }
+
+		const_iterator&	operator--() throw()
+		{ bump_down(); return *this; }
+
+		const_iterator	operator--(int) throw()
+		{ const_iterator	tmp = *this; bump_down(); return tmp; }
+
+		const_iterator&	operator+=(difference_type i) throw()
+		{ incr(i); return *this; }
+
+		const_iterator&	operator-=(difference_type i) throw()
+		{ incr(-i); return *this; }
+
+		const_iterator	operator+(difference_type i) const throw()
+		{ const_iterator	tmp = *this; return tmp += i; }
+
+		const_iterator	operator-(difference_type i) const throw()
+		{ const_iterator	tmp = *this; return tmp -= i; }
+
+		const_reference	operator[](difference_type i) const throw()
+		{ return *(*this + i); }
+	};
+
+	inline _bit_const_iterator	operator+(ptrdiff_t n,
+		_bit_const_iterator const& x) throw()
+	{ return x + n; }
+
+	namespace detail
+	{
+		/**
+		 * @brief Count the set bits of a range, one word at a time.
+		 */
+		inline ptrdiff_t	_bit_count(_bit_const_iterator first,
+			_bit_const_iterator last) throw()
+		{
+			if (first == last)
+				return 0;
+
+			_bit_word const	head = _bit_mask_from(first.offset);
+
+			if (first.p == last.p)
+				return _bit_popcount(*first.p & head
+					& _bit_mask_to(last.offset));
+
+			ptrdiff_t	n = _bit_popcount(*first.p & head);
+
+			for (_bit_word const* w = first.p + 1; w != last.p; ++w)
+				n += _bit_popcount(*w);
+			if (last.offset)
+				n += _bit_popcount(*last.p & _bit_mask_to(last.offset));
+			return n;
+		}
+
+		/**
+		 * @brief Find the first bit of a range that equals value, one word
+		 * at a time.
+		 *
+		 * @return	The bit's iterator, or last if there is none.
+		 */
+		inline _bit_const_iterator	_bit_find(_bit_const_iterator first,
+			_bit_const_iterator last, bool value) throw()
+		{
+			if (first == last)
+				return last;
+
+			_bit_word const	flip = value ? 0 : ~_bit_word(0);
+			_bit_word*		p = first.p;
+			_bit_word		w = (*p ^ flip) & _bit_mask_from(first.offset);
+
+			if (p == last.p)
+			{
+				w &= _bit_mask_to(last.offset);
+				return w ? _bit_const_iterator(p, _bit_ctz(w)) : last;
+			}
+			while (!w)
+			{
+				if (++p == last.p)
+				{
+					if (!last.offset)
+						return last;
+					w = (*p ^ flip) & _bit_mask_to(last.offset);
+					return w ? _bit_const_iterator(p, _bit_ctz(w)) : last;
+				}
+				w = *p ^ flip;
+			}
+			return _bit_const_iterator(p, _bit_ctz(w));
+		}
+
+		/**
+		 * @brief Assign value to a range of bits, one word at a time.
+		 */
+		inline void	_bit_fill(_bit_iterator first, _bit_iterator last,
+			bool value) throw()
+		{
+			if (first == last)
+				return;
+
+			_bit_word const	fill = value ? ~_bit_word(0) : 0;
+
+			if (first.p == last.p)
+			{
+				_bit_word const	mask = _bit_mask_from(first.offset)
+					& _bit_mask_to(last.offset);
+
+				*first.p = (*first.p & ~mask) | (fill & mask);
+				return;
+			}
+
+			_bit_word const	head = _bit_mask_from(first.offset);
+
+			*first.p = (*first.p & ~head) | (fill & head);
+			for (_bit_word* w = first.p + 1; w != last.p; ++w)
+				*w = fill;
+			if (last.offset)
+			{
+				_bit_word const	tail = _bit_mask_to(last.offset);
+
+				*last.p = (*last.p & ~tail) | (fill & tail);
+			}
+		}
+	}
+
+	/// Word-level overloads of the generic algorithms for bit iterators.
+
+	inline ptrdiff_t	count(_bit_const_iterator first,
+		_bit_const_iterator last, bool const& value) throw()
+	{
+		ptrdiff_t const	ones = detail::_bit_count(first, last);
+
+		return value ? ones : (last - first) - ones;
+	}
+
+	inline ptrdiff_t	count(_bit_iterator first, _bit_iterator last,
+		bool const& value) throw()
+	{
+		return count(_bit_const_iterator(first), _bit_const_iterator(last),
+			value);
+	}
+
+	inline _bit_const_iterator	find(_bit_const_iterator first,
+		_bit_const_iterator last, bool const& value) throw()
+	{ return detail::_bit_find(first, last, value); }
+
+	inline _bit_iterator	find(_bit_iterator first, _bit_iterator last,
+		bool const& value) throw()
+	{ return detail::_bit_find(first, last, value)._const_cast(); }
+
+	inline void	fill(_bit_iterator first, _bit_iterator last,
+		bool const& value) throw()
+	{ detail::_bit_fill(first, last, value); }
+
+	template<typename A>
+	class	_bvector_base
+	{
+	protected:
+		typedef	typename _alloc_traits<A>::template rebind<_bit_word>::other
+			word_alloc_type;
+		typedef	_alloc_traits<word_alloc_type>	word_alloc_traits;
+
+		struct	_bvector_impl	:	public word_alloc_type
+		{
+			_bit_iterator	start;
+			_bit_iterator	finish;
+			_bit_word*		end_of_storage;
+
+			_bvector_impl()
+				:	word_alloc_type(), start(), finish(), end_of_storage(0)
+			{ }
+
+			_bvector_impl(word_alloc_type const& a)
+				:	word_alloc_type(a), start(), finish(), end_of_storage(0)
+			{ }
+
+			void	swap_data(_bvector_impl& x) throw()
+			{
+				ft::swap(start, x.start);
+				ft::swap(finish, x.finish);
+				ft::swap(end_of_storage, x.end_of_storage);
+			}
+		};
+
+		_bvector_impl	impl;
+
+		static size_t	words_for(size_t n) throw()
+		{ return (n + _word_bit - 1) / _word_bit; }
+
+		_bit_word*	allocate(size_t n)
+		{
+			return n != 0 ? word_alloc_traits::allocate(impl, words_for(n))
+				: 0;
+		}
+
+		void		deallocate() throw()
+		{
+			if (impl.start.p)
+				word_alloc_traits::deallocate(impl, impl.start.p,
+					impl.end_of_storage - impl.start.p);
+		}
+
+	public:
+		typedef	A	allocator_type;
+
+		word_alloc_type&		get_word_allocator() throw()
+		{ return impl; }
+
+		word_alloc_type const&	get_word_allocator() const throw()
+		{ return impl; }
+
+		allocator_type			get_allocator() const throw()
+		{ return allocator_type(get_word_allocator()); }
+
+		_bvector_base() { }
+
+		_bvector_base(allocator_type const& a)	:	impl(a) { }
+
+		~_bvector_base() throw()
+		{ deallocate(); }
+	};
+
+	/**
+	 * @brief A space-efficient vector of bools, that stores one bit per
+	 * element in machine words.
+	 *
+	 * Elements are accessed through the _bit_reference proxy, and the count,
+	 * find, flip and bitwise operations process a whole word at a time.
+	 * Bits past size() in the last word are unspecified and are masked out
+	 * by every word-level operation.
+	 *
+	 * @tparam A	The allocator type, rebound to _bit_word.
+	 */
+	template<typename A>
+	class	vector<bool, A>	:	protected _bvector_base<A>
+	{
+	private:
+		typedef	_bvector_base<A>					base;
+		typedef	typename base::word_alloc_type		word_alloc_type;
+		typedef	typename base::word_alloc_traits	word_alloc_traits;
+
+	public:
+		typedef	bool				value_type;
+		typedef	size_t				size_type;
+		typedef	ptrdiff_t			difference_type;
+		typedef	_bit_reference		reference;
+		typedef	bool				const_reference;
+		typedef	_bit_reference*		pointer;
+		typedef	bool const*			const_pointer;
+		typedef	_bit_iterator		iterator;
+		typedef	_bit_const_iterator	const_iterator;
+		typedef ft::reverse_iterator<iterator>			reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef	A					allocator_type;
+
+		/// Returned by the find functions when no bit matches.
+		static const size_type	npos = size_type(-1);
+
+	protected:
+		using	base::impl;
+		using	base::allocate;
+		using	base::deallocate;
+		using	base::words_for;
+
+	public:
+		vector() { }
+
+		explicit vector(allocator_type const& a)	:	base(a) { }
+
+		explicit vector(size_type n, bool const& value = bool(),
+			allocator_type const& a = allocator_type())
+			:	base(a)
+		{
+			initialize(n);
+			detail::_bit_fill(impl.start, impl.finish, value);
+		}
+
+		vector(vector const& x)
+			:	base(word_alloc_traits::select_on_copy(
+				x.get_word_allocator()))
+		{
+			initialize(x.size());
+			copy_aligned(x.begin(), x.end(), impl.start);
+		}
+
+		template<typename I>
+		vector(I first, I last, allocator_type const& a = allocator_type())
+			:	base(a)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			initialize_dispatch(first, last, Integral());
+		}
+
+		vector&	operator=(vector const& x)
+		{
+			if (&x == this)
+				return *this;
+			if (x.size() > capacity())
+			{
+				deallocate();
+				impl.start = impl.finish = iterator();
+				impl.end_of_storage = 0;
+				initialize(x.size());
+			}
+			impl.finish = copy_aligned(x.begin(), x.end(), begin());
+			return *this;
+		}
+
+		void	assign(size_type n, bool const& val)
+		{
+			resize(n);
+			detail::_bit_fill(begin(), end(), val);
+		}
+
+		template<typename I>
+		void	assign(I first, I last)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			assign_dispatch(first, last, Integral());
+		}
+
+		using	base::get_allocator;
+
+		iterator				begin() throw()
+		{ return impl.start; }
+
+		const_iterator			begin() const throw()
+		{ return impl.start; }
+
+		iterator				end() throw()
+		{ return impl.finish; }
+
+		const_iterator			end() const throw()
+		{ return impl.finish; }
+
+		reverse_iterator		rbegin() throw()
+		{ return reverse_iterator(end()); }
+
+		const_reverse_iterator	rbegin() const throw()
+		{ return const_reverse_iterator(end()); }
+
+		reverse_iterator		rend() throw()
+		{ return reverse_iterator(begin()); }
+
+		const_reverse_iterator	rend() const throw()
+		{ return const_reverse_iterator(begin()); }
+
+		size_type	size() const throw()
+		{ return size_type(end() - begin()); }
+
+		size_type	max_size() const throw()
+		{
+			size_type const	words
+				= word_alloc_traits::max_size(this->get_word_allocator());
+			size_type const	bits = size_type(-1) / _word_bit;
+
+			return (words < bits ? words : bits) * _word_bit;
+		}
+
+		size_type	capacity() const throw()
+		{
+			return size_type(const_iterator(impl.end_of_storage, 0)
+				- begin());
+		}
+
+		bool		empty() const throw()
+		{ return begin() == end(); }
+
+		void		reserve(size_type n)
+		{
+			if (n > max_size())
+				throw LengthErrorException();
+			if (capacity() < n)
+			{
+				_bit_word*		q = allocate(n);
+				iterator const	start(q, 0);
+
+				impl.finish = copy_aligned(begin(), end(), start);
+				deallocate();
+				impl.start = start;
+				impl.end_of_storage = q + words_for(n);
+			}
+		}
+
+		void		resize(size_type new_size, bool x = bool())
+		{
+			if (new_size < size())
+				impl.finish = begin() + difference_type(new_size);
+			else
+				insert(end(), new_size - size(), x);
+		}
+
+		reference		operator[](size_type n) throw()
+		{ return begin()[difference_type(n)]; }
+
+		const_reference	operator[](size_type n) const throw()
+		{ return begin()[difference_type(n)]; }
+
+		reference		at(size_type n)
+		{ range_check(n); return (*this)[n]; }
+
+		const_reference	at(size_type n) const
+		{ range_check(n); return (*this)[n]; }
+
+		reference		front() throw()
+		{ return *begin(); }
+
+		const_reference	front() const throw()
+		{ return *begin(); }
+
+		reference		back() throw()
+		{ return *(end() - 1); }
+
+		const_reference	back() const throw()
+		{ return *(end() - 1); }
+
+		/**
+		 * @brief Returns the underlying word array.
+		 */
+		_bit_word*			data() throw()
+		{ return impl.start.p; }
+
+		_bit_word const*	data() const throw()
+		{ return impl.start.p; }
+
+		void	push_back(bool x)
+		{
+			if (impl.finish.p != impl.end_of_storage)
+				*impl.finish++ = x;
+			else
+				insert_aux(end(), x);
+		}
+
+		void	pop_back() throw()
+		{ --impl.finish; }
+
+		iterator	insert(iterator position, bool const& x = bool())
+		{
+			difference_type const	n = position - begin();
+
+			if (impl.finish.p != impl.end_of_storage && position == end())
+				*impl.finish++ = x;
+			else
+				insert_aux(position, x);
+			return begin() + n;
+		}
+
+		void	insert(iterator position, size_type n, bool const& x)
+		{ fill_insert(position, n, x); }
+
+		template<typename I>
+		void	insert(iterator position, I first, I last)
+		{
+			typedef	typename is_integer<I>::type	Integral;
+			insert_dispatch(position, first, last, Integral());
+		}
+
+		iterator	erase(iterator position) throw()
+		{
+			if (position + 1 != end())
+				ft::copy(position + 1, end(), position);
+			--impl.finish;
+			return position;
+		}
+
+		iterator	erase(iterator first, iterator last) throw()
+		{
+			if (first != last)
+				impl.finish = ft::copy(last, end(), first);
+			return first;
+		}
+
+		void	swap(vector& x) throw()
+		{
+			impl.swap_data(x.impl);
+			word_alloc_traits::on_swap(this->get_word_allocator(),
+				x.get_word_allocator());
+		}
+
+		/**
+		 * @brief Swaps two bits, that may belong to different vectors.
+		 */
+		static void	swap(reference x, reference y) throw()
+		{ ft::swap(x, y); }
+
+		void	clear() throw()
+		{ impl.finish = impl.start; }
+
+		/**
+		 * @brief Invert every bit, a whole word at a time.
+		 */
+		void	flip() throw()
+		{
+			_bit_word* const	last = end_word();
+
+			for (_bit_word* w = impl.start.p; w != last; ++w)
+				*w = ~*w;
+		}
+
+		/**
+		 * @brief Returns the number of set bits, using popcount on whole
+		 * words.
+		 */
+		size_type	count() const throw()
+		{ return detail::_bit_count(begin(), end()); }
+
+		/**
+		 * @brief Returns true if any bit is set.
+		 */
+		bool		any() const throw()
+		{ return find_first() != npos; }
+
+		/**
+		 * @brief Returns true if no bit is set.
+		 */
+		bool		none() const throw()
+		{ return !any(); }
+
+		/**
+		 * @brief Returns the index of the first set bit, or npos if there
+		 * is none.
+		 */
+		size_type	find_first() const throw()
+		{ return to_index(detail::_bit_find(begin(), end(), true)); }
+
+		/**
+		 * @brief Returns the index of the first set bit after pos, or npos
+		 * if there is none.
+		 */
+		size_type	find_next(size_type pos) const throw()
+		{
+			if (pos >= size() || pos + 1 == size())
+				return npos;
+			return to_index(detail::_bit_find(
+				begin() + difference_type(pos + 1), end(), true));
+		}
+
+		/**
+		 * @brief Bitwise operations with a vector of the same size, a whole
+		 * word at a time.
+		 */
+		vector&	operator&=(vector const& x) throw()
+		{
+			_bit_word const*	src = x.impl.start.p;
+			_bit_word* const	last = end_word();
+
+			for (_bit_word* w = impl.start.p; w != last; ++w, ++src)
+				*w &= *src;
+			return *this;
+		}
+
+		vector&	operator|=(vector const& x) throw()
+		{
+			_bit_word const*	src = x.impl.start.p;
+			_bit_word* const	last = end_word();
+
+			for (_bit_word* w = impl.start.p; w != last; ++w, ++src)
+				*w |= *src;
+			return *this;
+		}
+
+		vector&	operator^=(vector const& x) throw()
+		{
+			_bit_word const*	src = x.impl.start.p;
+			_bit_word* const	last = end_word();
+
+			for (_bit_word* w = impl.start.p; w != last; ++w, ++src)
+				*w ^= *src;
+			return *this;
+		}
+
+	protected:
+		/**
+		 * @brief Returns the word past the last one that holds an element.
+		 */
+		_bit_word*	end_word() const throw()
+		{ return impl.finish.p + (impl.finish.offset != 0); }
+
+		size_type	to_index(const_iterator it) const throw()
+		{ return it == end() ? npos : size_type(it - begin()); }
+
+		void	range_check(size_type n) const
+		{
+			if (n >= size())
+				throw OutOfRangeException();
+		}
+
+		size_type	check_len(size_type n) const
+		{
+			if (max_size() - size() < n)
+				throw LengthErrorException();
+
+			size_type const	len = size() + ft::max(size(), n);
+
+			return (len < size() || len > max_size()) ? max_size() : len;
+		}
+
+		void	initialize(size_type n)
+		{
+			if (n > max_size())
+				throw LengthErrorException();
+
+			_bit_word* const	q = allocate(n);
+
+			impl.end_of_storage = q + words_for(n);
+			impl.start = iterator(q, 0);
+			impl.finish = impl.start + difference_type(n);
+		}
+
+		/**
+		 * @brief Copy [first, last) to result, copying whole words when
+		 * first and result are word-aligned.
+		 */
+		iterator	copy_aligned(const_iterator first, const_iterator last,
+			iterator result) throw()
+		{
+			if (first.offset == 0 && result.offset == 0)
+			{
+				_bit_word*	q = result.p;
+
+				for (_bit_word const* w = first.p; w != last.p; ++w, ++q)
+					*q = *w;
+				return ft::copy(const_iterator(last.p, 0), last,
+					iterator(q, 0));
+			}
+			return ft::copy(first, last, result);
+		}
+
+		template<typename Integer>
+		void	initialize_dispatch(Integer n, Integer x, true_type)
+		{
+			initialize(static_cast<size_type>(n));
+			detail::_bit_fill(impl.start, impl.finish, x);
+		}
+
+		template<typename I>
+		void	initialize_dispatch(I first, I last, false_type)
+		{
+			range_initialize(first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		template<typename I>
+		void	range_initialize(I first, I last, input_iterator_tag)
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		template<typename F>
+		void	range_initialize(F first, F last, forward_iterator_tag)
+		{
+			initialize(ft::distance(first, last));
+			ft::copy(first, last, impl.start);
+		}
+
+		template<typename Integer>
+		void	assign_dispatch(Integer n, Integer val, true_type)
+		{ assign(static_cast<size_type>(n), bool(val)); }
+
+		template<typename I>
+		void	assign_dispatch(I first, I last, false_type)
+		{
+			clear();
+			insert(end(), first, last);
+		}
+
+		template<typename Integer>
+		void	insert_dispatch(iterator pos, Integer n, Integer x, true_type)
+		{ fill_insert(pos, static_cast<size_type>(n), bool(x)); }
+
+		template<typename I>
+		void	insert_dispatch(iterator pos, I first, I last, false_type)
+		{
+			range_insert(pos, first, last,
+				typename iterator_traits<I>::iterator_category());
+		}
+
+		template<typename I>
+		void	range_insert(iterator pos, I first, I last, input_iterator_tag)
+		{
+			for (; first != last; ++first)
+			{
+				pos = insert(pos, *first);
+				++pos;
+			}
+		}
+
+		template<typename F>
+		void	range_insert(iterator position, F first, F last,
+			forward_iterator_tag)
+		{
+			if (first == last)
+				return;
+
+			size_type const	n = ft::distance(first, last);
+
+			if (capacity() - size() >= n)
+			{
+				ft::copy_backward(position, end(),
+					impl.finish + difference_type(n));
+				ft::copy(first, last, position);
+				impl.finish += difference_type(n);
+			}
+			else
+			{
+				size_type const		len = check_len(n);
+				_bit_word* const	q = allocate(len);
+				iterator			start(q, 0);
+				iterator			i = copy_aligned(begin(), position, start);
+
+				i = ft::copy(first, last, i);
+				impl.finish = ft::copy(position, end(), i);
+				deallocate();
+				impl.end_of_storage = q + words_for(len);
+				impl.start = start;
+			}
+		}
+
+		void	fill_insert(iterator position, size_type n, bool x)
+		{
+			if (n == 0)
+				return;
+			if (capacity() - size() >= n)
+			{
+				ft::copy_backward(position, end(),
+					impl.finish + difference_type(n));
+				detail::_bit_fill(position, position + difference_type(n), x);
+				impl.finish += difference_type(n);
+			}
+			else
+			{
+				size_type const		len = check_len(n);
+				_bit_word* const	q = allocate(len);
+				iterator			start(q, 0);
+				iterator			i = copy_aligned(begin(), position, start);
+
+				detail::_bit_fill(i, i + difference_type(n), x);
+				impl.finish = ft::copy(position, end(),
+					i + difference_type(n));
+				deallocate();
+				impl.end_of_storage = q + words_for(len);
+				impl.start = start;
+			}
+		}
+
+		void	insert_aux(iterator position, bool x)
+		{ fill_insert(position, 1, x); }
+	};
+
+	template<typename A>
+	const typename vector<bool, A>::size_type	vector<bool, A>::npos;
+
+	template<typename A>
+	inline vector<bool, A>	operator&(vector<bool, A> const& x,
+		vector<bool, A> const& y)
+	{
+		vector<bool, A>	result(x);
+		return result &= y;
+	}
+
+	template<typename A>
+	inline vector<bool, A>	operator|(vector<bool, A> const& x,
+		vector<bool, A> const& y)
+	{
+		vector<bool, A>	result(x);
+		return result |= y;
+	}
+
+	template<typename A>
+	inline vector<bool, A>	operator^(vector<bool, A> const& x,
+		vector<bool, A> const& y)
+	{
+		vector<bool, A>	result(x);
+		return result ^= y;
+	}
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <atomic.hpp>
+#include <circular_buffer.hpp>
+#include <exception.hpp>
+#include <memory.hpp>
+
+namespace ft
+{
+	/**
+	 * @brief A growable ring of atomic slots, that keeps a link to the
+	 * smaller ring it replaced.
+	 */
+	template<typename T>
+	struct	_ws_array
+	{
+		size_t			mask;
+		atomic<T>*		slots;
+		_ws_array*		prev;
+
+		T		get(ptrdiff_t i) const throw()
+		{ return slots[size_t(i) & mask].load(memory_order_relaxed); }
+
+		void	put(ptrdiff_t i, T x) throw()
+		{ slots[size_t(i) & mask].store(x, memory_order_relaxed); }
+	};
+
+	/**
+	 * @brief A Chase-Lev work-stealing deque: its owner thread pushes and
+	 * pops at the bottom, while any number of thieves steal from the top.
+	 *
+	 * The owner only synchronizes with thieves when the deque holds at most
+	 * one element. When the ring is full, the owner copies it into one twice
+	 * as large without blocking the thieves. The rings that were replaced
+	 * may still be read by a late thief, so they are only freed with the
+	 * deque.
+	 *
+	 * Follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+	 * by Lê, Pop, Cohen and Zappa Nardelli.
+	 *
+	 * @tparam T	A pointer or integral type, such as a task pointer.
+	 * @tparam A	The allocator type.
+	 */
+	template<typename T, typename A = allocator<T> >
+	class	ws_deque
+	{
+	private:
+		typedef	_ws_array<T>	array_type;
+		typedef	typename _alloc_traits<A>::template rebind<atomic<T> >::other
+			slot_alloc_type;
+		typedef	_alloc_traits<slot_alloc_type>		slot_alloc_traits;
+		typedef	typename _alloc_traits<A>::template rebind<array_type>::other
+			array_alloc_type;
+		typedef	_alloc_traits<array_alloc_type>		array_alloc_traits;
+
+	public:
+		typedef	T		value_type;
+		typedef	size_t	size_type;
+		typedef	A		allocator_type;
+
+	private:
+		struct	_ws_deque_impl	:	public slot_alloc_type
+		{
+			atomic<array_type*>	array;
+			char				pad0[cache_line_size];
+			/// Index of the oldest element, advanced by thieves.
+			atomic<ptrdiff_t>	top;
+			char				pad1[cache_line_size];
+			/// Index past the newest element, written by the owner.
+			atomic<ptrdiff_t>	bottom;
+
+			_ws_deque_impl(slot_alloc_type const& a)
+				:	slot_alloc_type(a), array(), top(0), bottom(0) { }
+		};
+
+		_ws_deque_impl	impl;
+
+		ws_deque(ws_deque const&);
+		ws_deque&	operator=(ws_deque const&);
+
+	public:
+		/**
+		 * @brief Construct an empty deque with room for at least n elements
+		 * before it grows.
+		 */
+		explicit ws_deque(size_type n = 64,
+			allocator_type const& a = allocator_type())
+			:	impl(slot_alloc_type(a))
+		{ impl.array.store(create_array(detail::_ceil_pow2(n ? n : 1), 0)); }
+
+		~ws_deque() throw()
+		{
+			array_type*	a = impl.array.load(memory_order_relaxed);
+
+			while (a)
+			{
+				array_type* const	prev = a->prev;
+
+				destroy_array(a);
+				a = prev;
+			}
+		}
+
+		allocator_type	get_allocator() const throw()
+		{ return allocator_type(impl); }
+
+		/**
+		 * @brief Returns the number of elements, which is only a snapshot
+		 * while other threads are running.
+		 */
+		size_type	size() const throw()
+		{
+			ptrdiff_t const	b = impl.bottom.load(memory_order_relaxed);
+			ptrdiff_t const	t = impl.top.load(memory_order_relaxed);
+
+			return b > t ? size_type(b - t) : 0;
+		}
+
+		bool		empty() const throw()
+		{ return size() == 0; }
+
+		/**
+		 * @brief Push x at the bottom, growing the ring if it is full.
+		 * Owner only.
+		 */
+		void	push(value_type x)
+		{
+			ptrdiff_t const	b = impl.bottom.load(memory_order_relaxed);
+			ptrdiff_t const	t = impl.top.load(memory_order_acquire);
+			array_type*		a = impl.array.load(memory_order_relaxed);
+
+			if (size_t(b - t) > a->mask)
+			{
+				a = grow(a, b, t);
+				impl.array.store(a, memory_order_release);
+			}
+			a->put(b, x);
+			impl.bottom.store(b + 1, memory_order_release);
+		}
+
+		/**
+		 * @brief Take the newest element into x. Owner only.
+		 *
+		 * @return bool	false if the deque is empty, or if a thief took the
+		 * last element first.
+		 */
+		bool	pop(value_type& x) throw()
+		{
+			ptrdiff_t const		b = impl.bottom.load(memory_order_relaxed) - 1;
+			array_type* const	a = impl.array.load(memory_order_relaxed);
+
+			impl.bottom.store(b, memory_order_relaxed);
+			atomic_thread_fence(memory_order_seq_cst);
+
+			ptrdiff_t	t = impl.top.load(memory_order_relaxed);
+
+			if (t > b)
+			{
+				impl.bottom.store(b + 1, memory_order_relaxed);
+				return false;
+			}
+			x = a->get(b);
+			if (t < b)
+				return true;
+
+			bool const	won = impl.top.compare_exchange_strong(t, t + 1,
+				memory_order_seq_cst, memory_order_relaxed);
+
+			impl.bottom.store(b + 1, memory_order_relaxed);
+			return won;
+		}
+
+		/**
+		 * @brief Take the oldest element into x. Any thread.
+		 *
+		 * @return bool	false if the deque is empty, or if another thread
+		 * took the element first.
+		 */
+		bool	steal(value_type& x) throw()
+		{
+			ptrdiff_t	t = impl.top.load(memory_order_acquire);
+
+			atomic_thread_fence(memory_order_seq_cst);
+
+			ptrdiff_t const	b = impl.bottom.load(memory_order_acquire);
+
+			if (t >= b)
+				return false;
+
+			array_type* const	a = impl.array.load(memory_order_acquire);
+
+			x = a->get(t);
+			return impl.top.compare_exchange_strong(t, t + 1,
+				memory_order_seq_cst, memory_order_relaxed);
+		}
+
+	private:
+		array_type*	create_array(size_t capacity, array_type* prev)
+		{
+			array_alloc_type	alloc(impl);
+
+			if (capacity == 0
+				|| capacity > slot_alloc_traits::max_size(impl))
+				throw LengthErrorException();
+
+			array_type* const	a = array_alloc_traits::allocate(alloc, 1);
+
+			try
+			{
+				a->slots = slot_alloc_traits::allocate(impl, capacity);
+			}
+			catch (...)
+			{
+				array_alloc_traits::deallocate(alloc, a, 1);
+				throw;
+			}
+			for (size_t i = 0; i < capacity; ++i)
+				::new(static_cast<void*>(a->slots + i)) atomic<T>();
+			a->mask = capacity - 1;
+			a->prev = prev;
+			return a;
+		}
+
+		void		destroy_array(array_type* a) throw()
+		{
+			array_alloc_type	alloc(impl);
+
+			slot_alloc_traits::deallocate(impl, a->slots, a->mask + 1);
+			array_alloc_traits::deallocate(alloc, a, 1);
+		}
+
+		/**
+		 * @brief Copy the elements in [t, b) to a ring twice as large.
+		 */
+		array_type*	grow(array_type* a, ptrdiff_t b, ptrdiff_t t)
+		{
+			array_type* const	bigger = create_array(2 * (a->mask + 1), a);
+
+			for (ptrdiff_t i = t; i != b; ++i)
+				bigger->put(i, a->get(i));
+			return bigger;
+		}
+	};
+}
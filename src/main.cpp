@@ -2,7 +2,7 @@
 
 int	main()
 {
-	ft::list<int>	lst();
+	ft::list<int>	lst;
 
 
 